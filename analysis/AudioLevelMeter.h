@@ -0,0 +1,196 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOLEVELMETER_H
+#define ABL_AUDIOLEVELMETER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+#include "../buffers/AudioBufferViewConcepts.h"
+#include "../datatypes/SamplesRange.h"
+#include "../kernels/AudioKernels.h"
+#include "../memory/CacheLineSize.h"
+
+namespace abl {
+
+struct AudioLevelMeterOptions {
+	//Samples of the window of the running RMS, rounded up to a multiple of AudioLevelMeter::chunkSize
+	size_t rmsWindowSize = 8192;
+	//Samples for which the held peak stay still before decaying
+	size_t peakHoldSamples = 24000;
+	//Factor applied to the held peak for every sample after the hold
+	double peakDecayPerSample = 0.99995;
+};
+
+//Levels of a channel, in the same unit of the samples
+template <typename LevelType>
+struct AudioChannelLevels {
+	//Higher absolute sample of the last metered block
+	LevelType peak;
+	//Higher absolute sample held for peakHoldSamples, then decaying
+	LevelType heldPeak;
+	//Higher absolute sample since the creation or the last resetMaxPeaks (for the clip indicators)
+	LevelType maxPeak;
+	LevelType rms;
+};
+
+//Incremental meter of the blocks written in a buffer: it keeps for every channel the sums of squares of the last chunks of samples (for the running RMS)
+//and the held peak, so polling the levels never rescan the buffer.
+//Only one thread (usually the one that write the buffer) can process the blocks, while the levels are published with atomics and can be read by any thread without locks
+template <NumericType AudioSampleType>
+class AudioLevelMeter {
+public:
+	using LevelType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+	//The running RMS is updated every chunkSize samples, using the sums of squares of the last chunks
+	static constexpr size_t chunkSize = 256;
+
+	explicit AudioLevelMeter(size_t channelsCount, const AudioLevelMeterOptions& options = {})
+			: m_channelsCount{channelsCount},
+			  m_windowChunksCount{std::max((options.rmsWindowSize + chunkSize - 1) / chunkSize, size_t(1))},
+			  m_peakHoldSamples{options.peakHoldSamples},
+			  m_peakDecayPerSample{options.peakDecayPerSample},
+			  m_channelsStates{std::make_unique<ChannelState[]>(channelsCount)},
+			  m_chunksSquaresSums{std::make_unique<double[]>(channelsCount * m_windowChunksCount)},
+			  m_publishedLevels{std::make_unique<PublishedLevels[]>(channelsCount)} {
+		std::fill_n(m_chunksSquaresSums.get(), channelsCount * m_windowChunksCount, 0.0);
+	}
+
+	//Meter a block of samples of all the channels
+	void process(const AudioBufferReadableType<AudioSampleType> auto &buffer, const SamplesRange &samplesRange = {}) noexcept {
+		auto samplesCount = samplesRange.getRealSamplesCount(buffer.getBufferSize());
+		assert(samplesRange.startSample + samplesCount <= buffer.getBufferSize());
+		assert(buffer.getChannelsCount() >= m_channelsCount);
+		for(size_t channel = 0; channel < m_channelsCount; ++channel) {
+			if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(buffer)>, AudioSampleType>) {
+				processChannelPart(channel, buffer.getChannelRawData(channel, samplesRange.startSample), samplesCount);
+			} else {
+				AudioSampleType samples[chunkSize];
+				for(size_t startSample = 0; startSample < samplesCount; startSample += chunkSize) {
+					auto partSamplesCount = std::min(chunkSize, samplesCount - startSample);
+					for(size_t index = 0; index < partSamplesCount; ++index) {
+						samples[index] = buffer.getSample(channel, samplesRange.startSample + startSample + index);
+					}
+					processChannelPart(channel, samples, partSamplesCount);
+				}
+			}
+		}
+		finishBlock(samplesCount);
+	}
+
+	//Meter a contiguous part of the block of a channel. After all the parts of all the channels, finishBlock publish the new levels
+	void processChannelPart(size_t channel, const AudioSampleType* samples, size_t samplesCount) noexcept {
+		assert(channel < m_channelsCount);
+		auto& state = m_channelsStates[channel];
+		auto chunksSquaresSums = m_chunksSquaresSums.get() + channel * m_windowChunksCount;
+		for(size_t index = 0; index < samplesCount;) {
+			auto chunkSamplesCount = std::min(chunkSize - state.chunkFill, samplesCount - index);
+			auto analysis = AudioKernels<AudioSampleType>::analyze(samples + index, chunkSamplesCount);
+			auto peak = std::max(std::abs(static_cast<LevelType>(analysis.min)), std::abs(static_cast<LevelType>(analysis.max)));
+
+			state.chunkSquaresSum += static_cast<double>(analysis.squaresSum);
+			state.blockPeak = std::max(state.blockPeak, peak);
+			state.chunkFill += chunkSamplesCount;
+			index += chunkSamplesCount;
+			if(state.chunkFill == chunkSize) {
+				chunksSquaresSums[state.chunkPosition] = state.chunkSquaresSum;
+				state.chunkPosition = (state.chunkPosition + 1) % m_windowChunksCount;
+				state.completedChunksCount = std::min(state.completedChunksCount + 1, m_windowChunksCount);
+				state.chunkSquaresSum = 0;
+				state.chunkFill = 0;
+				state.rmsChanged = true;
+			}
+		}
+	}
+
+	//Update the held peaks with the samplesCount samples of the block and publish the levels of all the channels
+	void finishBlock(size_t samplesCount) noexcept {
+		bool resetMaxPeaks = m_resetMaxPeaksRequested.exchange(false, std::memory_order_acquire);
+		for(size_t channel = 0; channel < m_channelsCount; ++channel) {
+			auto& state = m_channelsStates[channel];
+			auto& levels = m_publishedLevels[channel];
+			if(state.blockPeak >= state.heldPeak) {
+				state.heldPeak = state.blockPeak;
+				state.holdRemainingSamples = m_peakHoldSamples;
+			} else if(state.holdRemainingSamples >= samplesCount) {
+				state.holdRemainingSamples -= samplesCount;
+			} else {
+				auto decaySamples = samplesCount - state.holdRemainingSamples;
+				state.holdRemainingSamples = 0;
+				state.heldPeak = std::max(static_cast<LevelType>(state.heldPeak * std::pow(m_peakDecayPerSample, static_cast<double>(decaySamples))), state.blockPeak);
+			}
+			state.maxPeak = resetMaxPeaks ? state.blockPeak : std::max(state.maxPeak, state.blockPeak);
+
+			if(state.rmsChanged) {
+				//Recomputed from the chunks every time, so the errors of a running sum never accumulate
+				auto chunksSquaresSums = m_chunksSquaresSums.get() + channel * m_windowChunksCount;
+				double squaresSum = 0;
+				for(size_t chunk = 0; chunk < state.completedChunksCount; ++chunk) {
+					squaresSum += chunksSquaresSums[chunk];
+				}
+				levels.rms.store(static_cast<LevelType>(std::sqrt(squaresSum / static_cast<double>(state.completedChunksCount * chunkSize))), std::memory_order_relaxed);
+				state.rmsChanged = false;
+			}
+			levels.peak.store(state.blockPeak, std::memory_order_relaxed);
+			levels.heldPeak.store(state.heldPeak, std::memory_order_relaxed);
+			levels.maxPeak.store(state.maxPeak, std::memory_order_relaxed);
+			state.blockPeak = 0;
+		}
+		m_processedSamplesCount.fetch_add(samplesCount, std::memory_order_release);
+	}
+
+	//Can be called by any thread, the levels of the different channels (and the different fields) can come from consecutive blocks
+	[[nodiscard]] AudioChannelLevels<LevelType> getLevels(size_t channel) const noexcept {
+		assert(channel < m_channelsCount);
+		const auto& levels = m_publishedLevels[channel];
+		return {levels.peak.load(std::memory_order_relaxed), levels.heldPeak.load(std::memory_order_relaxed), levels.maxPeak.load(std::memory_order_relaxed), levels.rms.load(std::memory_order_relaxed)};
+	}
+
+	[[nodiscard]] LevelType getRMSLevel(size_t channel) const noexcept { return getLevels(channel).rms; }
+	[[nodiscard]] LevelType getHeldPeak(size_t channel) const noexcept { return getLevels(channel).heldPeak; }
+
+	//Can be called by any thread: the max peaks restart from the next processed block
+	void resetMaxPeaks() noexcept { m_resetMaxPeaksRequested.store(true, std::memory_order_release); }
+
+	//Samples metered since the creation, can be used by the readers to know if the levels changed since the last poll
+	[[nodiscard]] size_t getProcessedSamplesCount() const noexcept { return m_processedSamplesCount.load(std::memory_order_acquire); }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return m_channelsCount; }
+
+private:
+	//Used only by the processing thread
+	struct ChannelState {
+		double chunkSquaresSum = 0;
+		size_t chunkFill = 0;
+		size_t chunkPosition = 0;
+		size_t completedChunksCount = 0;
+		bool rmsChanged = false;
+		LevelType blockPeak = 0;
+		LevelType heldPeak = 0;
+		LevelType maxPeak = 0;
+		size_t holdRemainingSamples = 0;
+	};
+
+	struct alignas(cacheLineSize) PublishedLevels {
+		std::atomic<LevelType> peak{0};
+		std::atomic<LevelType> heldPeak{0};
+		std::atomic<LevelType> maxPeak{0};
+		std::atomic<LevelType> rms{0};
+	};
+
+	size_t m_channelsCount;
+	size_t m_windowChunksCount;
+	size_t m_peakHoldSamples;
+	double m_peakDecayPerSample;
+	std::unique_ptr<ChannelState[]> m_channelsStates;
+	std::unique_ptr<double[]> m_chunksSquaresSums;
+	std::unique_ptr<PublishedLevels[]> m_publishedLevels;
+	alignas(cacheLineSize) std::atomic<size_t> m_processedSamplesCount{0};
+	std::atomic<bool> m_resetMaxPeaksRequested{false};
+};
+
+} // abl
+
+#endif //ABL_AUDIOLEVELMETER_H
@@ -0,0 +1,175 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOSTATISTICS_H
+#define ABL_AUDIOSTATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include "../datatypes/CircularSpans.h"
+#include "../datatypes/NumericConcept.h"
+#include "../kernels/AudioKernels.h"
+
+namespace abl {
+
+template <NumericType AudioSampleType>
+struct AudioStatistics {
+	using LevelType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+
+	//Sample with the higher absolute value, with its sign (the first one when a positive and a negative sample have the same absolute value)
+	AudioSampleType peak = 0;
+	AudioSampleType min = 0;
+	AudioSampleType max = 0;
+	LevelType rms = 0;
+	//Average of the samples
+	LevelType dcOffset = 0;
+	//Absolute peak divided by the RMS, 0 for the silence
+	LevelType crestFactor = 0;
+	size_t samplesCount = 0;
+};
+
+//Single pass statistics of the samples given to process, in the order they're given (the contiguous parts of a circular buffer, or the channels of a
+//multichannel view). The samples are analyzed by the SIMD kernels in short blocks, and the sums of the blocks are added in wider accumulators:
+//int64 for the sums of the integral samples up to 32 bits and for the sums of squares up to 16 bits (that are exact, the blocks sums of these
+//types are exact in double), and double with a compensated (Kahan-Babuska) sum for all the others
+template <NumericType AudioSampleType>
+class AudioStatisticsAccumulator {
+public:
+	using LevelType = typename AudioStatistics<AudioSampleType>::LevelType;
+	//The float blocks are summed in float lanes, so they're kept shorter
+	static constexpr size_t blockSize = std::is_same_v<AudioSampleType, float> ? 256 : 4096;
+	//Samples copied on the stack at a time by the strided process
+	static constexpr size_t copyBlockSize = 256;
+
+	void process(const AudioSampleType* data, size_t samplesCount) noexcept {
+		for(size_t startSample = 0; startSample < samplesCount; startSample += blockSize) {
+			processBlock(data + startSample, std::min(blockSize, samplesCount - startSample));
+		}
+	}
+
+	void process(const CircularSpans<AudioSampleType>& spans) noexcept {
+		forEachContiguousPart(spans, [this](const AudioSampleType* data, size_t samplesCount, size_t) { process(data, samplesCount); });
+	}
+
+	//Samples spaced by stride (like a channel of an interleaved buffer), copied in blocks on the stack to be analyzed by the kernels
+	void process(const AudioSampleType* data, size_t samplesCount, size_t stride) noexcept {
+		if(stride == 1) {
+			process(data, samplesCount);
+			return;
+		}
+
+		AudioSampleType block[copyBlockSize];
+		for(size_t startSample = 0; startSample < samplesCount; startSample += copyBlockSize) {
+			auto blockSamplesCount = std::min(copyBlockSize, samplesCount - startSample);
+			for(size_t index = 0; index < blockSamplesCount; ++index) {
+				block[index] = data[(startSample + index) * stride];
+			}
+			processBlock(block, blockSamplesCount);
+		}
+	}
+
+	//Add the samples of another accumulator, as if they were processed after the ones of this
+	void merge(const AudioStatisticsAccumulator& otherAccumulator) noexcept {
+		if(otherAccumulator.m_samplesCount == 0) {
+			return;
+		}
+
+		if(m_samplesCount == 0) {
+			*this = otherAccumulator;
+			return;
+		}
+
+		if(std::abs(static_cast<LevelType>(otherAccumulator.m_peak)) > std::abs(static_cast<LevelType>(m_peak))) {
+			m_peak = otherAccumulator.m_peak;
+		}
+		m_min = std::min(m_min, otherAccumulator.m_min);
+		m_max = std::max(m_max, otherAccumulator.m_max);
+		addToSum(m_sum, m_sumCompensation, otherAccumulator.m_sum);
+		addToSum(m_sum, m_sumCompensation, otherAccumulator.m_sumCompensation);
+		addToSum(m_squaresSum, m_squaresSumCompensation, otherAccumulator.m_squaresSum);
+		addToSum(m_squaresSum, m_squaresSumCompensation, otherAccumulator.m_squaresSumCompensation);
+		m_samplesCount += otherAccumulator.m_samplesCount;
+	}
+
+	void reset() noexcept { *this = AudioStatisticsAccumulator{}; }
+
+	[[nodiscard]] AudioStatistics<AudioSampleType> getStatistics() const noexcept {
+		AudioStatistics<AudioSampleType> statistics;
+		if(m_samplesCount == 0) {
+			return statistics;
+		}
+
+		auto samplesCount = static_cast<double>(m_samplesCount);
+		auto rms = std::sqrt(std::max((static_cast<double>(m_squaresSum) + m_squaresSumCompensation) / samplesCount, 0.0));
+		statistics.peak = m_peak;
+		statistics.min = m_min;
+		statistics.max = m_max;
+		statistics.rms = static_cast<LevelType>(rms);
+		statistics.dcOffset = static_cast<LevelType>((static_cast<double>(m_sum) + m_sumCompensation) / samplesCount);
+		statistics.crestFactor = rms > 0 ? static_cast<LevelType>(std::abs(static_cast<double>(m_peak)) / rms) : LevelType(0);
+		statistics.samplesCount = m_samplesCount;
+		return statistics;
+	}
+
+	[[nodiscard]] size_t getSamplesCount() const noexcept { return m_samplesCount; }
+
+private:
+	using SumType = typename std::conditional<std::is_integral_v<AudioSampleType> && sizeof(AudioSampleType) <= sizeof(int32_t), int64_t, double>::type;
+	using SquaresSumType = typename std::conditional<std::is_integral_v<AudioSampleType> && sizeof(AudioSampleType) <= sizeof(int16_t), int64_t, double>::type;
+
+	template<typename AccumulatorType, typename ValueType>
+	static void addToSum(AccumulatorType& sum, double& compensation, ValueType value) noexcept {
+		if constexpr (std::is_integral_v<AccumulatorType>) {
+			sum += static_cast<AccumulatorType>(value);
+		} else {
+			auto doubleValue = static_cast<double>(value);
+			auto newSum = sum + doubleValue;
+			compensation += std::abs(sum) >= std::abs(doubleValue) ? (sum - newSum) + doubleValue : (doubleValue - newSum) + sum;
+			sum = newSum;
+		}
+	}
+
+	void processBlock(const AudioSampleType* data, size_t samplesCount) noexcept {
+		auto analysis = AudioKernels<AudioSampleType>::analyze(data, samplesCount);
+		auto blockMin = static_cast<AudioSampleType>(analysis.min);
+		auto blockMax = static_cast<AudioSampleType>(analysis.max);
+		auto absoluteMin = std::abs(static_cast<LevelType>(blockMin));
+		auto absoluteMax = std::abs(static_cast<LevelType>(blockMax));
+		AudioSampleType blockPeak = absoluteMin > absoluteMax ? blockMin : blockMax;
+		if(absoluteMin == absoluteMax && blockMin != blockMax) {
+			//Only the order of the samples tells which of the two is the peak
+			blockPeak = *std::find_if(data, data + samplesCount, [blockMin, blockMax](AudioSampleType sample) { return sample == blockMin || sample == blockMax; });
+		}
+
+		if(m_samplesCount == 0) {
+			m_peak = blockPeak;
+			m_min = blockMin;
+			m_max = blockMax;
+		} else {
+			if(std::abs(static_cast<LevelType>(blockPeak)) > std::abs(static_cast<LevelType>(m_peak))) {
+				m_peak = blockPeak;
+			}
+			m_min = std::min(m_min, blockMin);
+			m_max = std::max(m_max, blockMax);
+		}
+		addToSum(m_sum, m_sumCompensation, analysis.sum);
+		addToSum(m_squaresSum, m_squaresSumCompensation, analysis.squaresSum);
+		m_samplesCount += samplesCount;
+	}
+
+	AudioSampleType m_peak = 0;
+	AudioSampleType m_min = 0;
+	AudioSampleType m_max = 0;
+	SumType m_sum = 0;
+	double m_sumCompensation = 0;
+	SquaresSumType m_squaresSum = 0;
+	double m_squaresSumCompensation = 0;
+	size_t m_samplesCount = 0;
+};
+
+} // abl
+
+#endif //ABL_AUDIOSTATISTICS_H
@@ -0,0 +1,192 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_WAVEFORMOVERVIEW_H
+#define ABL_WAVEFORMOVERVIEW_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "../buffers/AudioBufferView.h"
+#include "../kernels/AudioKernels.h"
+
+namespace abl {
+
+//Min, max and RMS of a samples range of a channel
+template <NumericType AudioSampleType>
+struct WaveformSummary {
+	using LevelType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+
+	AudioSampleType min = 0;
+	AudioSampleType max = 0;
+	LevelType rms = 0;
+};
+
+//Summary index of the channels of a buffer for the waveform overviews: for every channel a pyramid of min, max and sum of squares of the blocks of
+//blockSize samples, then of the pairs of blocks, of the pairs of pairs and so on (about two entries every blockSize samples in total).
+//A range is answered with the samples of the partial blocks at its ends and O(log n) entries of the pyramid, whatever its length, so every zoom level
+//of a view cost the same. The index is built in the constructor and must be updated with update after writing the buffer (only the changed blocks
+//and their parents are recomputed). It refers to the memory of the view, that must outlive it, and it's not thread safe
+template <NumericType AudioSampleType>
+class WaveformOverview {
+public:
+	using LevelType = typename WaveformSummary<AudioSampleType>::LevelType;
+
+	explicit WaveformOverview(const AudioBufferView<AudioSampleType>& buffer, size_t blockSize = 256)
+			: m_buffer{buffer},
+			  m_blockSize{std::bit_ceil(std::max(blockSize, size_t(1)))},
+			  m_blocksCount{(buffer.getBufferSize() + m_blockSize - 1) / m_blockSize} {
+		//Every level has half of the entries (rounded up) of the one below, until a single entry
+		auto levelEntriesCount = m_blocksCount;
+		size_t entriesCount = 0;
+		do {
+			m_levelsOffsets.push_back(entriesCount);
+			m_levelsEntriesCounts.push_back(levelEntriesCount);
+			entriesCount += levelEntriesCount;
+			levelEntriesCount = (levelEntriesCount + 1) / 2;
+		} while(m_levelsEntriesCounts.back() > 1);
+		m_entriesPerChannel = entriesCount;
+		m_entries.resize(entriesCount * buffer.getChannelsCount());
+		update();
+	}
+
+	//Recompute the blocks containing the written range, and their entries in the upper levels
+	void update(const SamplesRange& samplesRange = {}) noexcept {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_buffer.getBufferSize());
+		assert(samplesRange.startSample + samplesCount <= m_buffer.getBufferSize());
+		if(samplesCount == 0) {
+			return;
+		}
+
+		auto firstBlock = samplesRange.startSample / m_blockSize;
+		auto lastBlock = (samplesRange.startSample + samplesCount - 1) / m_blockSize;
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			auto entries = m_entries.data() + channel * m_entriesPerChannel;
+			for(auto block = firstBlock; block <= lastBlock; ++block) {
+				auto startSample = block * m_blockSize;
+				entries[block] = analyze(channel, startSample, std::min(m_blockSize, m_buffer.getBufferSize() - startSample));
+			}
+
+			auto firstEntry = firstBlock;
+			auto lastEntry = lastBlock;
+			for(size_t level = 1; level < m_levelsOffsets.size(); ++level) {
+				firstEntry /= 2;
+				lastEntry /= 2;
+				auto levelEntries = entries + m_levelsOffsets[level];
+				auto lowerLevelEntries = entries + m_levelsOffsets[level - 1];
+				for(auto entry = firstEntry; entry <= lastEntry; ++entry) {
+					levelEntries[entry] = lowerLevelEntries[2 * entry];
+					if(2 * entry + 1 < m_levelsEntriesCounts[level - 1]) {
+						levelEntries[entry].merge(lowerLevelEntries[2 * entry + 1]);
+					}
+				}
+			}
+		}
+	}
+
+	[[nodiscard]] WaveformSummary<AudioSampleType> getSummary(size_t channel, const SamplesRange& samplesRange = {}) const noexcept {
+		assert(channel < getChannelsCount());
+		auto samplesCount = samplesRange.getRealSamplesCount(m_buffer.getBufferSize());
+		assert(samplesCount > 0);
+		assert(samplesRange.startSample + samplesCount <= m_buffer.getBufferSize());
+		auto endSample = samplesRange.startSample + samplesCount;
+		auto firstFullBlock = (samplesRange.startSample + m_blockSize - 1) / m_blockSize;
+		auto endFullBlock = endSample == m_buffer.getBufferSize() ? m_blocksCount : endSample / m_blockSize;
+		if(firstFullBlock >= endFullBlock) {
+			return analyze(channel, samplesRange.startSample, samplesCount).toSummary(samplesCount);
+		}
+
+		Entry summary = queryBlocks(channel, firstFullBlock, endFullBlock);
+		auto headSamplesCount = firstFullBlock * m_blockSize - samplesRange.startSample;
+		if(headSamplesCount > 0) {
+			summary.merge(analyze(channel, samplesRange.startSample, headSamplesCount));
+		}
+		auto tailStartSample = std::min(endFullBlock * m_blockSize, endSample);
+		if(tailStartSample < endSample) {
+			summary.merge(analyze(channel, tailStartSample, endSample - tailStartSample));
+		}
+		return summary.toSummary(samplesCount);
+	}
+
+	//Summaries of columns.size() equal parts of the range, like the pixels columns of a waveform view at any zoom level.
+	//When the columns are more than the samples, every column get the sample under its start
+	void getColumns(size_t channel, std::span<WaveformSummary<AudioSampleType>> columns, const SamplesRange& samplesRange = {}) const noexcept {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_buffer.getBufferSize());
+		for(size_t column = 0; column < columns.size(); ++column) {
+			auto startSample = samplesRange.startSample + column * samplesCount / columns.size();
+			auto endSample = samplesRange.startSample + (column + 1) * samplesCount / columns.size();
+			columns[column] = getSummary(channel, SamplesRange(startSample, std::max(endSample, startSample + 1) - startSample));
+		}
+	}
+
+	[[nodiscard]] size_t getBlockSize() const noexcept { return m_blockSize; }
+	[[nodiscard]] size_t getLevelsCount() const noexcept { return m_levelsOffsets.size(); }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return m_buffer.getChannelsCount(); }
+	[[nodiscard]] size_t getBufferSize() const noexcept { return m_buffer.getBufferSize(); }
+
+private:
+	//The float samples are summed in float lanes by the kernel, so they're analyzed in short parts
+	static constexpr size_t analysisPartSize = 256;
+
+	struct Entry {
+		AudioSampleType min;
+		AudioSampleType max;
+		double squaresSum;
+
+		void merge(const Entry& otherEntry) noexcept {
+			min = std::min(min, otherEntry.min);
+			max = std::max(max, otherEntry.max);
+			squaresSum += otherEntry.squaresSum;
+		}
+
+		[[nodiscard]] WaveformSummary<AudioSampleType> toSummary(size_t samplesCount) const noexcept {
+			return {min, max, static_cast<LevelType>(std::sqrt(squaresSum / static_cast<double>(samplesCount)))};
+		}
+	};
+
+	Entry analyze(size_t channel, size_t startSample, size_t samplesCount) const noexcept {
+		auto data = m_buffer.getChannelRawData(channel, startSample);
+		Entry entry{data[0], data[0], 0.0};
+		for(size_t partStart = 0; partStart < samplesCount; partStart += analysisPartSize) {
+			auto analysis = AudioKernels<AudioSampleType>::analyze(data + partStart, std::min(analysisPartSize, samplesCount - partStart));
+			entry.merge(Entry{static_cast<AudioSampleType>(analysis.min), static_cast<AudioSampleType>(analysis.max), static_cast<double>(analysis.squaresSum)});
+		}
+		return entry;
+	}
+
+	//Merge the entries covering the blocks [firstBlock, endBlock), going up a level every time the ends are aligned to a pair
+	Entry queryBlocks(size_t channel, size_t firstBlock, size_t endBlock) const noexcept {
+		auto entries = m_entries.data() + channel * m_entriesPerChannel;
+		Entry summary = entries[firstBlock];
+		auto firstEntry = firstBlock + 1;
+		auto endEntry = endBlock;
+		for(size_t level = 0; firstEntry < endEntry; ++level) {
+			auto levelEntries = entries + m_levelsOffsets[level];
+			if(firstEntry % 2 == 1) {
+				summary.merge(levelEntries[firstEntry++]);
+			}
+			if(endEntry % 2 == 1 && firstEntry < endEntry) {
+				summary.merge(levelEntries[--endEntry]);
+			}
+			firstEntry /= 2;
+			endEntry /= 2;
+		}
+		return summary;
+	}
+
+	AudioBufferView<AudioSampleType> m_buffer;
+	size_t m_blockSize;
+	size_t m_blocksCount;
+	std::vector<size_t> m_levelsOffsets;
+	std::vector<size_t> m_levelsEntriesCounts;
+	size_t m_entriesPerChannel = 0;
+	std::vector<Entry> m_entries;
+};
+
+} // abl
+
+#endif //ABL_WAVEFORMOVERVIEW_H
@@ -9,20 +9,22 @@
 
 namespace abl {
 
-template <NumericType AudioSampleType>
-class AudioBuffer : public AudioBufferView<AudioSampleType>, public AudioBufferWithMemoryManagement<AudioSampleType> {
+template <NumericType AudioSampleType, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
+class AudioBuffer : public AudioBufferWithMemoryManagement<AudioSampleType, Allocator>, public AudioBufferView<AudioSampleType> {
 public:
+	using MemoryManagement = AudioBufferWithMemoryManagement<AudioSampleType, Allocator>;
+
 	//@todo empty constructor? (no size or channel count)
 
-	explicit AudioBuffer(size_t bufferSize, size_t channelsCount = 2, const std::vector<size_t>& channelsMapping = {})
-		: AudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize), channelsCount, bufferSize, channelsMapping)
+	explicit AudioBuffer(size_t bufferSize, size_t channelsCount = 2, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), AudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize), channelsCount, bufferSize, channelsMapping)
 	{
 		//assert(bufferSize > 0);
 		//assert(channelsCount > 0);
 	}
 
-	explicit AudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, const std::vector<size_t>& channelsMapping = {})
-		: AudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, channelsMapping)
+	explicit AudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), AudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, channelsMapping)
 	{
 		//assert(sourceData);
 		//assert(bufferSize > 0);
@@ -44,8 +46,8 @@ public:
 //		}
 //	}
 
-	explicit AudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const std::vector<size_t>& channelsMapping = {})
-		: AudioBufferView<AudioSampleType>(prepareAllocatedSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), channelsMapping)
+	explicit AudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), AudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), channelsMapping)
 	{
 		if(!sourceBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < sourceBuffer.getChannelsCount(); ++channel) {
@@ -57,7 +59,7 @@ public:
 	}
 
 	AudioBuffer(const AudioBuffer &otherBuffer)
-		: AudioBufferView<AudioSampleType>(prepareAllocatedSpace(otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.isEmpty()), otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.getChannelsMapping())
+		: MemoryManagement(otherBuffer.m_allocator), AudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.isEmpty()), otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.getChannelsMapping())
 	{
 		if(!otherBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < otherBuffer.getChannelsCount(); ++channel) {
@@ -67,10 +69,15 @@ public:
 	}
 
 	AudioBuffer& operator= (const AudioBuffer &otherBuffer) {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		AudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.getChannelsCount();
 		AudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.getBufferSize();
 
-		AudioBufferView<AudioSampleType>::m_data = prepareAllocatedSpace(otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.isEmpty());
+		//The old data is released with the current allocator, that is kept
+		setInternalData(prepareAllocatedSpace(otherBuffer.getChannelsCount(), otherBuffer.getBufferSize(), otherBuffer.isEmpty()));
 		if(!otherBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < otherBuffer.getChannelsCount(); ++channel) {
 				std::copy(otherBuffer.m_data[channel], otherBuffer.m_data[channel] + otherBuffer.getBufferSize(), AudioBufferView<AudioSampleType>::m_data[channel]);
@@ -82,7 +89,7 @@ public:
 	}
 
 	AudioBuffer (AudioBuffer&& otherBuffer) noexcept
-		: AudioBufferView<AudioSampleType>(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.m_channelsMapping) {
+		: MemoryManagement(otherBuffer.m_allocator), AudioBufferView<AudioSampleType>(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.m_channelsMapping) {
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_bufferChannelsCount = 0;
@@ -90,9 +97,15 @@ public:
 	}
 
 	AudioBuffer& operator= (AudioBuffer&& otherBuffer) noexcept {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		AudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
 		AudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
-		AudioBufferView<AudioSampleType>::m_data = otherBuffer.m_data;
+		//The old data is released with the current allocator, the moved data will be released with the allocator that created it
+		setInternalData(otherBuffer.m_data);
+		MemoryManagement::m_allocator = otherBuffer.m_allocator;
 		AudioBufferView<AudioSampleType>::m_channelsMapping = std::move(otherBuffer.m_channelsMapping);
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
@@ -109,7 +122,7 @@ public:
 			return;
 		}
 
-		AudioBufferWithMemoryManagement<AudioSampleType>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
+		AudioBufferWithMemoryManagement<AudioSampleType, Allocator>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
 																   AudioBufferView<AudioSampleType>::m_bufferChannelsCount,
 																   AudioBufferView<AudioSampleType>::m_bufferSize,
 																   AudioBufferView<AudioSampleType>::m_data);
@@ -120,14 +133,13 @@ public:
 
 protected:
 	AudioSampleType** prepareAllocatedSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) override {
-		//@todo use preallocated space? (like string that have a basic space, and if you don't use more than that it already come with the object)
-
-		return allocateContiguous2DArray<AudioSampleType>(channelsCount, bufferSize, zeroData);
+		//for the small buffers with the space inside the object see SmallAudioBuffer
+		return MemoryManagement::allocateSpace(channelsCount, bufferSize, zeroData);
 	}
 
 	void setInternalData(AudioSampleType** newData, bool deleteOld = true) override {
 		if(deleteOld && AudioBufferView<AudioSampleType>::m_data) {
-			deallocateContiguous2DArray<AudioSampleType>(AudioBufferView<AudioSampleType>::m_data);
+			MemoryManagement::deallocateSpace(AudioBufferView<AudioSampleType>::m_data);
 		}
 		AudioBufferView<AudioSampleType>::m_data = newData;
 	}
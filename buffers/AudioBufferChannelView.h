@@ -8,9 +8,10 @@
 #include <span>
 
 #include "AudioBufferChannelViewConcepts.h"
+#include "../analysis/AudioStatistics.h"
 #include "../memory/GenericPointerIterator.h"
-#include "../memory/CircularIterator.h"
-#include "../memory/VariantRandomAccessIteratorWrapper.h"
+#include "../memory/SegmentedIterator.h"
+#include "../kernels/AudioKernels.h"
 
 namespace abl {
 
@@ -36,9 +37,9 @@ public:
 
 	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
 	using iterator = GenericPointerIterator<AudioSampleType>;
-	using wrapperIterator = VariantRandomAccessIteratorWrapper<AudioSampleType, GenericPointerIterator<AudioSampleType>, CircularIterator<AudioSampleType>>;
-	wrapperIterator begin() const noexcept { return wrapperIterator(iterator(&m_data[0])); }
-	wrapperIterator end() const noexcept { return wrapperIterator(iterator(&m_data[m_bufferSize])); }
+	using wrapperIterator = SegmentedIterator<AudioSampleType>;
+	wrapperIterator begin() const noexcept { return wrapperIterator(getReadSpans(), 0); }
+	wrapperIterator end() const noexcept { auto spans = getReadSpans(); return wrapperIterator(spans, spans.size()); }
 
 	iterator unwrapper_begin() const noexcept { return iterator(&m_data[0]); }
 	iterator unwrapped_end() const noexcept { return iterator(&m_data[m_bufferSize]); }
@@ -74,8 +75,14 @@ public:
 		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + destinationSamplesRange.startSample] = sourceBufferChannel.getSample(index) * gain;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [gain](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t) {
+				AudioKernels<AudioSampleType>::copy(destination, source, partSamplesCount, gain);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				m_data[index + destinationSamplesRange.startSample] = sourceBufferChannel.getSample(index) * gain;
+			}
 		}
 	}
 
@@ -88,11 +95,15 @@ public:
 		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + destinationSamplesRange.startSample] = sourceBufferChannel.getSample(index) * currentGain;
-			currentGain += baseGainIncrement;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [startGain, baseGainIncrement](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+				AudioKernels<AudioSampleType>::copyWithRamp(destination, source, partSamplesCount, startGain + static_cast<GainType>(processedSamplesCount) * baseGainIncrement, baseGainIncrement);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				m_data[index + destinationSamplesRange.startSample] = sourceBufferChannel.getSample(index) * (startGain + static_cast<GainType>(index) * baseGainIncrement);
+			}
 		}
 	}
 
@@ -100,33 +111,40 @@ public:
 		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + destinationSamplesRange.startSample] += sourceBufferChannel.getSample(index) * gain;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [gain](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t) {
+				AudioKernels<AudioSampleType>::add(destination, source, partSamplesCount, gain);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				m_data[index + destinationSamplesRange.startSample] += sourceBufferChannel.getSample(index) * gain;
+			}
 		}
 	}
 
 	void addWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
 		if(startGain == endGain) {
-			copyFrom(sourceBufferChannel, destinationSamplesRange, startGain);
+			addFrom(sourceBufferChannel, destinationSamplesRange, startGain);
 			return;
 		}
 
 		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + destinationSamplesRange.startSample] += sourceBufferChannel.getSample(index) * currentGain;
-			currentGain += baseGainIncrement;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [startGain, baseGainIncrement](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+				AudioKernels<AudioSampleType>::addWithRamp(destination, source, partSamplesCount, startGain + static_cast<GainType>(processedSamplesCount) * baseGainIncrement, baseGainIncrement);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				m_data[index + destinationSamplesRange.startSample] += sourceBufferChannel.getSample(index) * (startGain + static_cast<GainType>(index) * baseGainIncrement);
+			}
 		}
 	}
 
 	void applyGain(GainType gain, const SamplesRange& samplesRange = {}) noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + samplesRange.startSample] *= gain;
-		}
+		AudioKernels<AudioSampleType>::applyGain(m_data + samplesRange.startSample, getSamplesCountFromRange(samplesRange), gain);
 	}
 
 	void applyGainRamp(GainType startGain, GainType endGain, const SamplesRange& samplesRange = {}) noexcept {
@@ -137,32 +155,38 @@ public:
 
 		auto samplesCount = getSamplesCountFromRange(samplesRange);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
-
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + samplesRange.startSample] *= currentGain;
-			currentGain += baseGainIncrement;
-		}
+		AudioKernels<AudioSampleType>::applyGainRamp(m_data + samplesRange.startSample, samplesCount, startGain, baseGainIncrement);
 	}
 
 	void clear(const SamplesRange& samplesRange = {}) noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		for(size_t index = 0; index < samplesCount; ++index) {
-			m_data[index + samplesRange.startSample] = 0;
-		}
+		std::fill_n(m_data + samplesRange.startSample, getSamplesCountFromRange(samplesRange), AudioSampleType(0));
 	}
 
 	void reverse(const SamplesRange& samplesRange = {}) noexcept {
 		std::reverse(m_data + samplesRange.startSample, m_data + samplesRange.startSample + getSamplesCountFromRange(samplesRange));
 	}
 
+	//Peak, min/max, RMS, DC offset and crest factor of the range in a single pass of the SIMD kernels
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange& samplesRange = {}) const noexcept {
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		accumulator.process(m_data + samplesRange.startSample, getSamplesCountFromRange(samplesRange));
+		return accumulator.getStatistics();
+	}
+
 	AudioSampleType getHigherPeak(const SamplesRange& samplesRange = {}) const noexcept {
-		return *std::max_element(m_data + samplesRange.startSample, m_data + samplesRange.startSample + getSamplesCountFromRange(samplesRange), [](AudioSampleType a, AudioSampleType b) { return std::abs(a) < std::abs(b); });
+		return getStatistics(samplesRange).peak;
 	}
 
 	AudioSampleType getRMSLevel(const SamplesRange& samplesRange = {}) const noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		return std::accumulate(m_data + samplesRange.startSample, m_data + samplesRange.startSample + samplesCount, AudioSampleType(0)) / samplesCount;
+		return static_cast<AudioSampleType>(getStatistics(samplesRange).rms);
+	}
+
+	[[nodiscard]] CircularSpans<AudioSampleType> getReadSpans(const SamplesRange& samplesRange = {}) const noexcept {
+		return CircularSpans<AudioSampleType>(std::span<AudioSampleType>(m_data + samplesRange.startSample, getSamplesCountFromRange(samplesRange)));
+	}
+
+	[[nodiscard]] CircularSpans<AudioSampleType> getWriteSpans(const SamplesRange& samplesRange = {}) const noexcept {
+		return getReadSpans(samplesRange);
 	}
 
 	[[nodiscard]] size_t getBufferSize() const noexcept { return m_bufferSize; }
@@ -8,6 +8,8 @@
 
 #include "../datatypes/NumericConcept.h"
 #include "../datatypes/SamplesRange.h"
+#include "../datatypes/CircularSpans.h"
+#include "../analysis/AudioStatistics.h"
 
 namespace abl {
 
@@ -21,9 +23,17 @@ concept AudioBufferChannelReadableType = NumericType<SampleType> && requires(T a
 	{ audioBufferChannel.getSample(index) } -> std::same_as<SampleType>;
 	{ audioBufferChannel.getHigherPeak(samplesRange) } -> std::same_as<SampleType>;
 	{ audioBufferChannel.getRMSLevel(samplesRange) } -> std::same_as<SampleType>;
+	{ audioBufferChannel.getStatistics(samplesRange) } -> std::same_as<AudioStatistics<SampleType>>;
 	{ audioBufferChannel.getBufferSize() } -> std::same_as<size_t>;
 };
 
+//Channel views that can expose the samples of a range as (at most two) contiguous spans, used to process them with the SIMD kernels
+template<typename T, typename SampleType>
+concept AudioBufferChannelSpansReadableType = AudioBufferChannelReadableType<T, SampleType> && requires(const T audioBufferChannel, SamplesRange samplesRange)
+{
+	{ audioBufferChannel.getReadSpans(samplesRange) } -> std::same_as<CircularSpans<SampleType>>;
+};
+
 template<typename T, typename SampleType>
 concept AudioBufferChannelType = AudioBufferChannelReadableType<T, SampleType> &&
                                  requires(T audioBufferChannel, size_t index, SampleType sampleType, SamplesRange samplesRange, T::GainType gainType)
@@ -6,9 +6,8 @@
 
 #include "../datatypes/SamplesRange.h"
 #include "../datatypes/NumericConcept.h"
-#include "../memory/GenericPointerIterator.h"
-#include "../memory/CircularIterator.h"
-#include "../memory/VariantRandomAccessIteratorWrapper.h"
+#include "../datatypes/CircularSpans.h"
+#include "../memory/SegmentedIterator.h"
 #include "AudioBufferChannelView.h"
 #include "CircularAudioBufferChannelView.h"
 #include "OffsettedReadCircularAudioBufferChannelView.h"
@@ -27,9 +26,10 @@ public:
 	AudioBufferChannelViewWrapper(AudioBufferChannelViewWrapper const&) = default;
 	AudioBufferChannelViewWrapper(AudioBufferChannelViewWrapper&&) = default;
 
-	using iterator =VariantRandomAccessIteratorWrapper<AudioSampleType, GenericPointerIterator<AudioSampleType>, CircularIterator<AudioSampleType>>;
-	constexpr iterator begin() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> iterator { return audioBufferChannelView.begin(); }, m_channelView); }
-	constexpr iterator end() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> iterator { return audioBufferChannelView.end(); }, m_channelView); }
+	//All the wrapped views use the same segmented iterator, so the variant is visited only in begin()/end() and not on every increment
+	using iterator = SegmentedIterator<AudioSampleType>;
+	iterator begin() const noexcept { return iterator(getReadSpans(), 0); }
+	iterator end() const noexcept { auto spans = getReadSpans(); return iterator(spans, spans.size()); }
 
 	constexpr bool isEmpty() { return boost::variant2::visit([](auto&& audioBufferChannelView) -> bool { return audioBufferChannelView.isEmpty(); }, m_channelView); }
 
@@ -52,9 +52,29 @@ public:
 
 	constexpr AudioSampleType getHigherPeak(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> AudioSampleType { return audioBufferChannelView.getHigherPeak(samplesRange); }, m_channelView); }
 	constexpr AudioSampleType getRMSLevel(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> AudioSampleType { return audioBufferChannelView.getRMSLevel(samplesRange); }, m_channelView); }
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> AudioStatistics<AudioSampleType> { return audioBufferChannelView.getStatistics(samplesRange); }, m_channelView); }
 
 	[[nodiscard]] constexpr size_t getBufferSize() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> size_t { return audioBufferChannelView.getBufferSize(); }, m_channelView); }
 
+	[[nodiscard]] CircularSpans<AudioSampleType> getReadSpans(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> CircularSpans<AudioSampleType> { return audioBufferChannelView.getReadSpans(samplesRange); }, m_channelView); }
+	[[nodiscard]] CircularSpans<AudioSampleType> getWriteSpans(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> CircularSpans<AudioSampleType> { return audioBufferChannelView.getWriteSpans(samplesRange); }, m_channelView); }
+
+	//Block level access: the variant is visited only once, then the function work directly on the resolved view (withResolvedView)
+	//or on the raw samples (visitContiguous, called as function(data, samplesCount, processedSamplesCount) for each contiguous part, at most two).
+	//Use them for the per-sample work, that through the functions above would pay a visit for every sample
+	template<typename Function>
+	constexpr decltype(auto) withResolvedView(Function&& function) { return boost::variant2::visit(std::forward<Function>(function), m_channelView); }
+
+	template<typename Function>
+	constexpr decltype(auto) withResolvedView(Function&& function) const { return boost::variant2::visit(std::forward<Function>(function), m_channelView); }
+
+	template<typename Function>
+	void visitContiguous(Function&& function, const SamplesRange& samplesRange = {}) const { forEachContiguousPart(getReadSpans(samplesRange), std::forward<Function>(function)); }
+
+	//Like visitContiguous, on the samples written by setSample (different from the read ones only in the OffsettedReadCircularAudioBufferChannelView)
+	template<typename Function>
+	void visitContiguousForWrite(Function&& function, const SamplesRange& samplesRange = {}) const { forEachContiguousPart(getWriteSpans(samplesRange), std::forward<Function>(function)); }
+
 	//isAudioBufferChannelView()
 	//isCircularAudioBufferChannelView()
 	//getAudioBufferChannelView()
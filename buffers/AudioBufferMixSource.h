@@ -0,0 +1,63 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOBUFFERMIXSOURCE_H
+#define ABL_AUDIOBUFFERMIXSOURCE_H
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "../datatypes/NumericConcept.h"
+#include "../kernels/AudioKernels.h"
+
+namespace abl {
+
+template <NumericType AudioSampleType>
+class AudioBufferView;
+
+//Source of the mixFrom functions: a buffer added with a constant gain, or with a gain ramp from startGain to endGain over the mixed samples
+template <NumericType AudioSampleType>
+struct AudioBufferMixSource {
+	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+
+	AudioBufferMixSource(const AudioBufferView<AudioSampleType>& sourceBuffer, GainType gain = GainType(1))
+			: buffer{&sourceBuffer}, startGain{gain}, endGain{gain} {}
+
+	AudioBufferMixSource(const AudioBufferView<AudioSampleType>& sourceBuffer, GainType rampStartGain, GainType rampEndGain)
+			: buffer{&sourceBuffer}, startGain{rampStartGain}, endGain{rampEndGain} {}
+
+	const AudioBufferView<AudioSampleType>* buffer;
+	GainType startGain;
+	GainType endGain;
+};
+
+namespace mixing {
+
+//The kernel sources are kept on the stack, so more sources are mixed in more passes
+inline constexpr size_t maxSourcesPerPass = 16;
+
+//Mix a channel of the sources into a contiguous part of the destination channel.
+//processedSamplesCount is the position of the part inside the samplesCount mixed samples, used to offset the sources and their ramps
+template <NumericType AudioSampleType>
+void mixSourcesIntoChannel(AudioSampleType* destination, size_t partSamplesCount, size_t channel, std::span<const AudioBufferMixSource<AudioSampleType>> sources, size_t processedSamplesCount, size_t samplesCount) noexcept {
+	using GainType = typename AudioBufferMixSource<AudioSampleType>::GainType;
+	std::array<kernels::KernelMixSource<AudioSampleType>, maxSourcesPerPass> kernelSources;
+	for(size_t firstSource = 0; firstSource < sources.size(); firstSource += maxSourcesPerPass) {
+		auto passSourcesCount = std::min(maxSourcesPerPass, sources.size() - firstSource);
+		for(size_t source = 0; source < passSourcesCount; ++source) {
+			const auto& mixSource = sources[firstSource + source];
+			assert(channel < mixSource.buffer->getChannelsCount());
+			assert(samplesCount <= mixSource.buffer->getBufferSize());
+			GainType gainIncrement = mixSource.startGain == mixSource.endGain ? GainType(0) : (mixSource.endGain - mixSource.startGain) / static_cast<GainType>(samplesCount);
+			kernelSources[source] = {mixSource.buffer->getChannelRawData(channel, processedSamplesCount), mixSource.startGain + static_cast<GainType>(processedSamplesCount) * gainIncrement, gainIncrement};
+		}
+		AudioKernels<AudioSampleType>::mix(destination, kernelSources.data(), passSourcesCount, partSamplesCount);
+	}
+}
+
+} // mixing
+
+} // abl
+
+#endif //ABL_AUDIOBUFFERMIXSOURCE_H
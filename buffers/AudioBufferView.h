@@ -4,6 +4,7 @@
 #ifndef ABL_AUDIOBUFFERVIEW_H
 #define ABL_AUDIOBUFFERVIEW_H
 
+#include <array>
 #include <memory>
 #include <numeric>
 #include <span>
@@ -11,7 +12,10 @@
 #include "AudioBufferViewConcepts.h"
 #include "AudioBufferChannelView.h"
 #include "AudioBufferChannelViewWrapper.h"
+#include "AudioBufferMixSource.h"
 #include "../memory/ParentReferencingIterator.h"
+#include "../parallel/ParallelExecutionPolicy.h"
+#include "../kernels/InterleaveKernels.h"
 
 namespace abl {
 
@@ -25,7 +29,7 @@ public:
 //			  m_channelsMapping(channelsMapping),
 //			  m_bufferStartOffset{bufferStartOffset} {}
 
-	AudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, const std::vector<size_t>& channelsMapping = {}, size_t bufferStartOffset = 0)
+	AudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, const ChannelsMapping& channelsMapping = {}, size_t bufferStartOffset = 0)
 			: m_data(data),
 			  m_bufferSize(bufferSize),
 			  m_bufferChannelsCount(channelsCount),
@@ -71,6 +75,13 @@ public:
 
 //	[[nodiscard]] AudioSampleType* const* getRawData() const { return m_data; }
 
+	//Return the pointer to the first sample of the channel, with the channels mapping and the start offset already applied
+	[[nodiscard]] AudioSampleType* getChannelRawData(size_t channel, size_t startSample = 0) const noexcept {
+		assert(channel < getChannelsCount());
+		assert(startSample <= m_bufferSize);
+		return m_data[getMappedChannel(channel)] + m_bufferStartOffset + startSample;
+	}
+
 	AudioBufferChannelViewWrapper<AudioSampleType> operator[](size_t channel) {
 		return getChannelView(channel);
 	}
@@ -114,15 +125,59 @@ public:
 	void copyFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
 		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		if constexpr (InterleavedAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+			if(sourceBuffer.hasSequentialChannels() && sourceBuffer.getFrameChannelsCount() == getChannelsCount() && getChannelsCount() <= ChannelsMapping::inlineMappedChannels) {
+				assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+				assert(samplesCount <= sourceBuffer.getBufferSize());
+				std::array<AudioSampleType*, ChannelsMapping::inlineMappedChannels> destinationChannels;
+				for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+					destinationChannels[destinationChannel] = getChannelRawData(destinationChannel, destinationSamplesRange.startSample);
+				}
+
+				InterleaveKernels<AudioSampleType>::deinterleave(destinationChannels.data(), sourceBuffer.getInterleavedRawData(), getChannelsCount(), samplesCount);
+				for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+					AudioKernels<AudioSampleType>::applyGain(destinationChannels[destinationChannel], samplesCount, gain);
+				}
+				return;
+			}
+		}
+
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); destinationChannel++) {
-//			getTemporaryChannelView(destinationChannel).copyFrom(sourceBuffer.getChannelView(), destinationSamplesRange, gain);
-			auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+				assert(samplesCount <= sourceBuffer.getBufferSize());
+				AudioKernels<AudioSampleType>::copy(getChannelRawData(destinationChannel, destinationSamplesRange.startSample), sourceBuffer.getChannelRawData(destinationChannel), samplesCount, gain);
+			} else {
+				auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+				}
 			}
 		}
 	}
 
+	void copyFrom(const ParallelExecutionPolicy& policy, const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount)) {
+			copyFrom(sourceBuffer, destinationSamplesRange, gain);
+			return;
+		}
+
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+		assert(samplesCount <= sourceBuffer.getBufferSize());
+		parallelism::forEachChannelBlock(policy, getChannelsCount(), samplesCount, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+			auto destination = getChannelRawData(channel, destinationSamplesRange.startSample + startSample);
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				AudioKernels<AudioSampleType>::copy(destination, sourceBuffer.getChannelRawData(channel, startSample), blockSamplesCount, gain);
+			} else {
+				for(size_t index = 0; index < blockSamplesCount; ++index) {
+					destination[index] = sourceBuffer.getSample(channel, startSample + index) * gain;
+				}
+			}
+		});
+	}
+
 	void copyWithRampFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
 		if(startGain == endGain) {
 			copyFrom(sourceBuffer, destinationSamplesRange, startGain);
@@ -133,15 +188,18 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
 		assert(samplesCount > 0);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
-			auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * currentGain);
-				currentGain += baseGainIncrement;
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+				assert(samplesCount <= sourceBuffer.getBufferSize());
+				AudioKernels<AudioSampleType>::copyWithRamp(getChannelRawData(destinationChannel, destinationSamplesRange.startSample), sourceBuffer.getChannelRawData(destinationChannel), samplesCount, startGain, baseGainIncrement);
+			} else {
+				auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+				}
 			}
-			currentGain = startGain;
 		}
 	}
 
@@ -159,16 +217,44 @@ public:
 		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); destinationChannel++) {
-			auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+				assert(samplesCount <= sourceBuffer.getBufferSize());
+				AudioKernels<AudioSampleType>::add(getChannelRawData(destinationChannel, destinationSamplesRange.startSample), sourceBuffer.getChannelRawData(destinationChannel), samplesCount, gain);
+			} else {
+				auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+				}
 			}
 		}
 	}
 
+	void addFrom(const ParallelExecutionPolicy& policy, const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount)) {
+			addFrom(sourceBuffer, destinationSamplesRange, gain);
+			return;
+		}
+
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+		assert(samplesCount <= sourceBuffer.getBufferSize());
+		parallelism::forEachChannelBlock(policy, getChannelsCount(), samplesCount, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+			auto destination = getChannelRawData(channel, destinationSamplesRange.startSample + startSample);
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				AudioKernels<AudioSampleType>::add(destination, sourceBuffer.getChannelRawData(channel, startSample), blockSamplesCount, gain);
+			} else {
+				for(size_t index = 0; index < blockSamplesCount; ++index) {
+					destination[index] += sourceBuffer.getSample(channel, startSample + index) * gain;
+				}
+			}
+		});
+	}
+
 	void addWithRampFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
 		if(startGain == endGain) {
-			copyFrom(sourceBuffer, destinationSamplesRange, startGain);
+			addFrom(sourceBuffer, destinationSamplesRange, startGain);
 			return;
 		}
 
@@ -176,15 +262,18 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
 		assert(samplesCount > 0);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
-			auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * currentGain);
-				currentGain += baseGainIncrement;
+			if constexpr (isContiguousBuffer<decltype(sourceBuffer)>) {
+				assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+				assert(samplesCount <= sourceBuffer.getBufferSize());
+				AudioKernels<AudioSampleType>::addWithRamp(getChannelRawData(destinationChannel, destinationSamplesRange.startSample), sourceBuffer.getChannelRawData(destinationChannel), samplesCount, startGain, baseGainIncrement);
+			} else {
+				auto destinationChannelView = getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+				}
 			}
-			currentGain = startGain;
 		}
 	}
 
@@ -198,12 +287,37 @@ public:
 		getTemporaryChannelView(destinationChannel).addWithRampFrom(sourceBufferChannel, startGain, endGain, destinationSamplesRange);
 	}
 
+	//Add all the sources, each one with its gain or gain ramp, writing every destination sample once (instead of an addFrom pass for every source)
+	void mixFrom(std::span<const AudioBufferMixSource<AudioSampleType>> sources, const SamplesRange &destinationSamplesRange = {}) {
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			mixing::mixSourcesIntoChannel(getChannelRawData(destinationChannel, destinationSamplesRange.startSample), samplesCount, destinationChannel, sources, 0, samplesCount);
+		}
+	}
+
+	void mixFrom(std::initializer_list<AudioBufferMixSource<AudioSampleType>> sources, const SamplesRange &destinationSamplesRange = {}) {
+		mixFrom(std::span(sources.begin(), sources.size()), destinationSamplesRange);
+	}
+
 	void applyGain(GainType gain, const SamplesRange &samplesRange = {}) {
 		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
 			getTemporaryChannelView(channel).applyGain(gain, samplesRange);
 		}
 	}
 
+	void applyGain(const ParallelExecutionPolicy& policy, GainType gain, const SamplesRange &samplesRange = {}) {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount)) {
+			applyGain(gain, samplesRange);
+			return;
+		}
+
+		parallelism::forEachChannelBlock(policy, getChannelsCount(), samplesCount, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+			getTemporaryRangedChannelView(channel, samplesRange.startSample + startSample, blockSamplesCount).applyGain(gain);
+		});
+	}
+
 	void applyGainToChannel(GainType gain, size_t channel, const SamplesRange &samplesRange = {}) {
 		assert(channel < getChannelsCount());
 		getTemporaryChannelView(channel).applyGain(gain, samplesRange);
@@ -226,6 +340,18 @@ public:
 		}
 	}
 
+	void clear(const ParallelExecutionPolicy& policy, const SamplesRange &samplesRange = {}) {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount)) {
+			clear(samplesRange);
+			return;
+		}
+
+		parallelism::forEachChannelBlock(policy, getChannelsCount(), samplesCount, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+			getTemporaryRangedChannelView(channel, samplesRange.startSample + startSample, blockSamplesCount).clear();
+		});
+	}
+
 	void clearChannel(size_t channel, const SamplesRange &samplesRange = {}) {
 		assert(channel < getChannelsCount());
 		getTemporaryChannelView(channel).clear(samplesRange);
@@ -237,6 +363,21 @@ public:
 		}
 	}
 
+	//The blocks swap the samples of the first half of the range with the ones of the second half
+	void reverse(const ParallelExecutionPolicy& policy, const SamplesRange &samplesRange = {}) {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount / 2)) {
+			reverse(samplesRange);
+			return;
+		}
+
+		assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+		parallelism::forEachChannelBlock(policy, getChannelsCount(), samplesCount / 2, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+			auto channelData = getChannelRawData(channel, samplesRange.startSample);
+			std::swap_ranges(channelData + startSample, channelData + startSample + blockSamplesCount, std::reverse_iterator(channelData + samplesCount - startSample));
+		});
+	}
+
 	void reverseChannel(size_t channel, const SamplesRange &samplesRange = {}) {
 		assert(channel < getChannelsCount());
 		getTemporaryChannelView(channel).reverse(samplesRange);
@@ -250,6 +391,39 @@ public:
 		return higherPeak;
 	}
 
+	//Every task find the peak of its blocks, then the peaks are combined in the order of the serial version (so the result is the same)
+	AudioSampleType getHigherPeak(const ParallelExecutionPolicy& policy, const SamplesRange &samplesRange = {}) const {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		if(!parallelism::shouldRunInParallel(policy, getChannelsCount(), samplesCount)) {
+			return getHigherPeak(samplesRange);
+		}
+
+		constexpr size_t maxTasksCount = 256;
+		std::array<AudioSampleType, maxTasksCount> tasksPeaks;
+		parallelism::ChannelsPartition partition{policy, getChannelsCount(), samplesCount, maxTasksCount};
+		policy.executor->parallelFor(partition.getTasksCount(), [&](size_t taskIndex) {
+			AudioSampleType taskPeak = 0;
+			partition.forEachBlockOfTask(taskIndex, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+				auto blockPeak = getTemporaryRangedChannelView(channel, samplesRange.startSample + startSample, blockSamplesCount).getHigherPeak();
+				taskPeak = partition.getBlocksPerChannel() > 1 ? blockPeak : std::max(blockPeak, taskPeak);
+			});
+			tasksPeaks[taskIndex] = taskPeak;
+		});
+
+		AudioSampleType higherPeak = 0;
+		auto blocksPerChannel = partition.getBlocksPerChannel();
+		for(size_t firstTask = 0; firstTask < partition.getTasksCount(); firstTask += blocksPerChannel) {
+			auto channelPeak = tasksPeaks[firstTask];
+			for(size_t block = 1; block < blocksPerChannel; ++block) {
+				if(std::abs(channelPeak) < std::abs(tasksPeaks[firstTask + block])) {
+					channelPeak = tasksPeaks[firstTask + block];
+				}
+			}
+			higherPeak = std::max(channelPeak, higherPeak);
+		}
+		return higherPeak;
+	}
+
 	AudioSampleType getHigherPeakForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
 		assert(channel < getChannelsCount());
 		return getTemporaryChannelView(channel).getHigherPeak(samplesRange);
@@ -260,22 +434,37 @@ public:
 		return getTemporaryChannelView(channel).getRMSLevel(samplesRange);
 	}
 
+	//Statistics of the samples of all the channels together, analyzed channel after channel
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange &samplesRange = {}) const {
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			accumulator.process(getTemporaryChannelView(channel).getReadSpans(samplesRange));
+		}
+		return accumulator.getStatistics();
+	}
+
+	AudioStatistics<AudioSampleType> getStatisticsForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		return getTemporaryChannelView(channel).getStatistics(samplesRange);
+	}
+
 	[[nodiscard]] size_t getBufferSize() const noexcept { return m_bufferSize; }
 	[[nodiscard]] size_t getChannelsCount() const noexcept { return !m_channelsMapping.empty() ? m_channelsMapping.size() : m_bufferChannelsCount; }
 
-	[[nodiscard]] const std::vector<size_t>& getChannelsMapping() const noexcept { return m_channelsMapping; }
-	void setChannelsMapping(const std::vector<size_t>& channelsMapping) { m_channelsMapping = channelsMapping; }
+	[[nodiscard]] const ChannelsMapping& getChannelsMapping() const noexcept { return m_channelsMapping; }
+	void setChannelsMapping(const ChannelsMapping& channelsMapping) { m_channelsMapping = channelsMapping; }
 	void createSequentialChannelsMapping(size_t startChannel, size_t channelsCount) {
 		assert(channelsCount > 0);
 		assert(startChannel < channelsCount);
 		assert(channelsCount <= m_bufferChannelsCount);
-		if(m_channelsMapping.size() != channelsCount) {
-			m_channelsMapping.resize(channelsCount);
-		}
-		std::iota(m_channelsMapping.begin(), m_channelsMapping.end(), startChannel);
+		m_channelsMapping.createSequential(startChannel, channelsCount);
 	}
 
 protected:
+	//AudioBufferView and AudioBuffer store every channel in a contiguous memory area, so the copy and add can work directly on the raw channels pointers
+	template<typename BufferType>
+	static constexpr bool isContiguousBuffer = std::is_base_of_v<AudioBufferView<AudioSampleType>, std::remove_cvref_t<BufferType>>;
+
 	[[nodiscard]] inline size_t getMappedChannel(size_t channel) const noexcept {
 		if(!m_channelsMapping.empty()) {
 			assert(channel < m_channelsMapping.size());
@@ -297,7 +486,7 @@ protected:
 	AudioSampleType** m_data;
 	size_t m_bufferSize = 0;
 	size_t m_bufferChannelsCount = 0;
-	std::vector<size_t> m_channelsMapping;
+	ChannelsMapping m_channelsMapping;
 	size_t m_bufferStartOffset = 0;
 };
 
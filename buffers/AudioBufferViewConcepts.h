@@ -8,6 +8,8 @@
 
 #include "../datatypes/NumericConcept.h"
 #include "../datatypes/SamplesRange.h"
+#include "../datatypes/ChannelsMapping.h"
+#include "AudioBufferChannelViewConcepts.h"
 #include "AudioBufferChannelViewWrapper.h"
 
 namespace abl {
@@ -16,23 +18,41 @@ template<typename T, typename SampleType>
 concept AudioBufferReadableType = NumericType<SampleType> && requires(T audioBuffer, size_t channel, size_t index, SamplesRange samplesRange)
 {
 	{ audioBuffer.isEmpty() } -> std::same_as<bool>;
-	{ audioBuffer.operator[](index) } -> std::same_as<AudioBufferChannelViewWrapper<SampleType>>;
+	{ audioBuffer.operator[](index) } -> AudioBufferChannelReadableType<SampleType>;
 	//@todo test const operator[]
 	//@todo test getRangedView?
-	{ audioBuffer.getChannelView(index, samplesRange) } -> std::same_as<AudioBufferChannelViewWrapper<SampleType>>;
+	{ audioBuffer.getChannelView(index, samplesRange) } -> AudioBufferChannelReadableType<SampleType>;
 	{ audioBuffer.getSample(channel, index) } -> std::same_as<SampleType>;
 	{ audioBuffer.getHigherPeak(samplesRange) } -> std::same_as<SampleType>;
 	{ audioBuffer.getHigherPeakForChannel(channel, samplesRange) } -> std::same_as<SampleType>;
 	{ audioBuffer.getRMSLevelForChannel(channel, samplesRange) } -> std::same_as<SampleType>;
+	{ audioBuffer.getStatistics(samplesRange) } -> std::same_as<AudioStatistics<SampleType>>;
+	{ audioBuffer.getStatisticsForChannel(channel, samplesRange) } -> std::same_as<AudioStatistics<SampleType>>;
 	{ audioBuffer.getBufferSize() } -> std::same_as<size_t>;
 	{ audioBuffer.getChannelsCount() } -> std::same_as<size_t>;
-	{ audioBuffer.getChannelsMapping() } -> std::same_as<const std::vector<size_t>&>;
+	{ audioBuffer.getChannelsMapping() } -> std::same_as<const ChannelsMapping&>;
+};
+
+//Buffers that store every channel in a contiguous memory area, that can be read directly from the channel pointer
+template<typename T, typename SampleType>
+concept ContiguousAudioBufferReadableType = AudioBufferReadableType<T, SampleType> && requires(const T audioBuffer, size_t channel, size_t startSample)
+{
+	{ audioBuffer.getChannelRawData(channel, startSample) } -> std::same_as<SampleType*>;
+};
+
+//Buffers that store the samples of all the channels frame after frame, that can be read directly from the frame pointer when the channels are sequential
+template<typename T, typename SampleType>
+concept InterleavedAudioBufferReadableType = AudioBufferReadableType<T, SampleType> && requires(const T audioBuffer, size_t startFrame)
+{
+	{ audioBuffer.getInterleavedRawData(startFrame) } -> std::same_as<SampleType*>;
+	{ audioBuffer.getFrameChannelsCount() } -> std::same_as<size_t>;
+	{ audioBuffer.hasSequentialChannels() } -> std::same_as<bool>;
 };
 
 template<typename T, typename SampleType>
 concept AudioBufferType = AudioBufferReadableType<T, SampleType> &&
                                  requires(T audioBuffer, size_t channel, size_t index, SampleType sampleType, SamplesRange samplesRange,
-										 T::GainType gainType, const std::vector<size_t>& channelsMapping, size_t startChannel, size_t channelsCount)
+										 T::GainType gainType, const ChannelsMapping& channelsMapping, size_t startChannel, size_t channelsCount)
 {
 	{ audioBuffer.setSample(channel, index, sampleType) };
 	{ audioBuffer.addSample(channel, index, sampleType) };
@@ -67,12 +67,14 @@ public:
 	constexpr AudioSampleType getHigherPeak(const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> AudioSampleType { return audioBufferChannelView.getHigherPeak(samplesRange); }, m_bufferView); }
 	constexpr AudioSampleType getHigherPeakForChannel(size_t channel, const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([channel, &samplesRange](auto&& audioBufferChannelView) -> AudioSampleType { return audioBufferChannelView.getHigherPeakForChannel(channel, samplesRange); }, m_bufferView); }
 	constexpr AudioSampleType getRMSLevelForChannel(size_t channel, const SamplesRange& samplesRange = {}) const noexcept { return boost::variant2::visit([channel, &samplesRange](auto&& audioBufferChannelView) -> AudioSampleType { return audioBufferChannelView.getRMSLevelForChannel(channel, samplesRange); }, m_bufferView); }
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange& samplesRange = {}) const { return boost::variant2::visit([&samplesRange](auto&& audioBufferChannelView) -> AudioStatistics<AudioSampleType> { return audioBufferChannelView.getStatistics(samplesRange); }, m_bufferView); }
+	AudioStatistics<AudioSampleType> getStatisticsForChannel(size_t channel, const SamplesRange& samplesRange = {}) const { return boost::variant2::visit([channel, &samplesRange](auto&& audioBufferChannelView) -> AudioStatistics<AudioSampleType> { return audioBufferChannelView.getStatisticsForChannel(channel, samplesRange); }, m_bufferView); }
 
 	[[nodiscard]] constexpr size_t getBufferSize() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> size_t { return audioBufferChannelView.getBufferSize(); }, m_bufferView); }
 	[[nodiscard]] constexpr size_t getChannelsCount() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> size_t { return audioBufferChannelView.getChannelsCount(); }, m_bufferView); }
 
-	[[nodiscard]] constexpr const std::vector<size_t>& getChannelsMapping() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> size_t { return audioBufferChannelView.getChannelsMapping(); }, m_bufferView); }
-	constexpr void setChannelsMapping(const std::vector<size_t>& channelsMapping) noexcept { boost::variant2::visit([&channelsMapping](auto&& audioBufferChannelView) -> void { audioBufferChannelView.setChannelsMapping(channelsMapping); }, m_bufferView); }
+	[[nodiscard]] constexpr const ChannelsMapping& getChannelsMapping() const noexcept { return boost::variant2::visit([](auto&& audioBufferChannelView) -> const ChannelsMapping& { return audioBufferChannelView.getChannelsMapping(); }, m_bufferView); }
+	constexpr void setChannelsMapping(const ChannelsMapping& channelsMapping) noexcept { boost::variant2::visit([&channelsMapping](auto&& audioBufferChannelView) -> void { audioBufferChannelView.setChannelsMapping(channelsMapping); }, m_bufferView); }
 	constexpr void createSequentialChannelsMapping(size_t startChannel, size_t channelsCount) noexcept { boost::variant2::visit([startChannel, channelsCount](auto&& audioBufferChannelView) -> void { audioBufferChannelView.createSequentialChannelsMapping(startChannel, channelsCount); }, m_bufferView); }
 
 	//isAudioBufferView()
@@ -10,15 +10,28 @@
 
 namespace abl {
 
-template <NumericType AudioSampleType>
+template <NumericType AudioSampleType, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
 class AudioBufferWithMemoryManagement {
 public:
+	explicit AudioBufferWithMemoryManagement(const Allocator& allocator = Allocator()) : m_allocator{allocator} {}
+
 	virtual void resize(size_t channelsCount, size_t bufferSize, bool keepExistingContent = false, bool clearExtraSpace = true, bool avoidReallocating = false) = 0;
 
+	[[nodiscard]] const Allocator& getAllocator() const noexcept { return m_allocator; }
+
 protected:
 	virtual void setInternalData(AudioSampleType** newData, bool deleteOld = true) = 0;
 	virtual AudioSampleType** prepareAllocatedSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) = 0;
 
+	//Not virtual, can be used in the derived classes constructors (this base is constructed before the view that receive the data)
+	AudioSampleType** allocateSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) {
+		return m_allocator.template allocate<AudioSampleType>(channelsCount, bufferSize, zeroData);
+	}
+
+	void deallocateSpace(AudioSampleType** data) {
+		m_allocator.template deallocate<AudioSampleType>(data);
+	}
+
 	void doResize(size_t channelsCount, size_t bufferSize, bool keepExistingContent, bool clearExtraSpace, bool avoidReallocating, size_t currentChannelsCount, size_t currentBufferSize, AudioSampleType** currentData) {
 		if(channelsCount == currentChannelsCount && bufferSize == currentBufferSize) {
 			return;
@@ -30,12 +43,13 @@ protected:
 		}
 
 		if(channelsCount > currentChannelsCount || bufferSize > currentBufferSize) {
-			auto currentSize = currentBufferSize * currentChannelsCount;
-			auto newSize = channelsCount * bufferSize;
+			//The sizes include the rows padding added by the allocator
+			auto currentSize = m_allocator.template getRowStride<AudioSampleType>(currentBufferSize) * currentChannelsCount;
+			auto newSize = channelsCount * m_allocator.template getRowStride<AudioSampleType>(bufferSize);
 			//If avoidReallocating = true, try to save the space already allocated
 			if(avoidReallocating && !keepExistingContent && (currentSize >= newSize) && channelsCount <= currentChannelsCount) {
 				//to permit channelsCount > currentChannelsCount a new pointers array should be created
-				rearrangeContiguous2DArray<AudioSampleType>(currentData, currentChannelsCount, currentBufferSize, channelsCount, bufferSize);
+				rearrangeContiguous2DArray<AudioSampleType>(currentData, currentChannelsCount, m_allocator.template getRowStride<AudioSampleType>(currentBufferSize), channelsCount, m_allocator.template getRowStride<AudioSampleType>(bufferSize));
 
 				for(size_t channel = 0; channel < channelsCount; ++channel) {
 					for(size_t i = 0; i < bufferSize; ++i) {
@@ -46,7 +60,7 @@ protected:
 			}
 
 			//Otherwise I need to reallocate because the space required is bigger. Even if only the channels count have grown it's better to reallocate to a contiguous space
-			auto newData = allocateContiguous2DArray<AudioSampleType>(channelsCount, bufferSize, !keepExistingContent);
+			auto newData = m_allocator.template allocate<AudioSampleType>(channelsCount, bufferSize, !keepExistingContent);
 
 			if(keepExistingContent) {
 				for(size_t channel = 0; channel < channelsCount; ++channel) {
@@ -76,7 +90,7 @@ protected:
 				}
 			}
 		} else {
-			auto newData = allocateContiguous2DArray<AudioSampleType>(channelsCount, bufferSize, !keepExistingContent);
+			auto newData = m_allocator.template allocate<AudioSampleType>(channelsCount, bufferSize, !keepExistingContent);
 
 			if(keepExistingContent) {
 				for(size_t channel = 0; channel < channelsCount; ++channel) {
@@ -87,6 +101,8 @@ protected:
 			setInternalData(newData);
 		}
 	}
+
+	[[no_unique_address]] Allocator m_allocator;
 };
 
 } // engine::showmanager
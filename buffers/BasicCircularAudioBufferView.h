@@ -5,10 +5,13 @@
 #define ABL_BASICCIRCULARAUDIOBUFFERVIEW_H
 
 #include "AudioBufferViewConcepts.h"
+#include "AudioBufferView.h"
+#include "AudioBufferChannelView.h"
 #include "CircularAudioBufferChannelView.h"
 #include "OffsettedReadCircularAudioBufferChannelView.h"
 #include "AudioBufferChannelViewWrapper.h"
 #include "../memory/ParentReferencingIterator.h"
+#include "../memory/CacheLineSize.h"
 
 namespace abl {
 
@@ -26,7 +29,7 @@ public:
 //			  m_writeSampleOffset{0}
 //	{}
 
-	BasicCircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {})
+	BasicCircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {})
 			: m_data(data),
 			  m_bufferSize(bufferSize),
 			  m_singleBufferSize(singleBufferSize),
@@ -45,8 +48,8 @@ public:
 			  m_channelsMapping{otherBuffer.m_channelsMapping},
 			  m_bufferStartOffset{otherBuffer.m_bufferStartOffset}
 	{
-		m_readSampleOffset.store(otherBuffer.m_readSampleOffset.load());
-		m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset.load());
+		m_readSampleOffset.store(otherBuffer.m_readSampleOffset.load(std::memory_order_relaxed));
+		m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset.load(std::memory_order_relaxed));
 	}
 
 	BasicCircularAudioBufferView(BasicCircularAudioBufferView&& otherBuffer) noexcept
@@ -57,8 +60,8 @@ public:
 			  m_channelsMapping{otherBuffer.m_channelsMapping},
 			  m_bufferStartOffset{otherBuffer.m_bufferStartOffset}
 	{
-		m_readSampleOffset.store(otherBuffer.m_readSampleOffset.load());
-		m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset.load());
+		m_readSampleOffset.store(otherBuffer.m_readSampleOffset.load(std::memory_order_relaxed));
+		m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset.load(std::memory_order_relaxed));
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_singleBufferSize = 0;
@@ -125,6 +128,13 @@ public:
 		return BasicCircularAudioBufferView(m_data, m_bufferChannelsCount, m_bufferSize, samplesRange.getRealSamplesCount(m_singleBufferSize), sampleOffset, m_channelsMapping);
 	}
 
+	//Return a normal view of a part of the memory area that doesn't cross the end of the buffer (startSample is relative to the buffer start offset, ignoring the read/write indexes)
+	[[nodiscard]] AudioBufferView<AudioSampleType> getContiguousView(size_t startSample, size_t samplesCount) const {
+		auto sampleOffset = (m_bufferStartOffset + startSample) % m_bufferSize;
+		assert(sampleOffset + samplesCount <= m_bufferSize);
+		return AudioBufferView<AudioSampleType>(m_data, m_bufferChannelsCount, samplesCount, m_channelsMapping, sampleOffset);
+	}
+
 	AudioSampleType getSample(size_t channel, size_t index) const {
 		assert(channel < getChannelsCount());
 		return getReadChannelView(channel).getSample(index);
@@ -145,8 +155,12 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_singleBufferSize);
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); destinationChannel++) {
 			auto destinationChannelView = getRangedWriteChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+			if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+				destinationChannelView.copyFrom(AudioBufferChannelView<AudioSampleType>(sourceBuffer.getChannelRawData(destinationChannel), samplesCount), {}, gain);
+			} else {
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+				}
 			}
 		}
 	}
@@ -161,15 +175,16 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_singleBufferSize);
 		assert(samplesCount > 0);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
 			auto destinationChannelView = getRangedWriteChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * currentGain);
-				currentGain += baseGainIncrement;
+			if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+				destinationChannelView.copyWithRampFrom(AudioBufferChannelView<AudioSampleType>(sourceBuffer.getChannelRawData(destinationChannel), samplesCount), startGain, endGain);
+			} else {
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.setSample(index, sourceBuffer.getSample(destinationChannel, index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+				}
 			}
-			currentGain = startGain;
 		}
 	}
 
@@ -188,15 +203,19 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_singleBufferSize);
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); destinationChannel++) {
 			auto destinationChannelView = getRangedWriteChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+			if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+				destinationChannelView.addFrom(AudioBufferChannelView<AudioSampleType>(sourceBuffer.getChannelRawData(destinationChannel), samplesCount), {}, gain);
+			} else {
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * gain);
+				}
 			}
 		}
 	}
 
 	void addWithRampFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
 		if(startGain == endGain) {
-			copyFrom(sourceBuffer, destinationSamplesRange, startGain);
+			addFrom(sourceBuffer, destinationSamplesRange, startGain);
 			return;
 		}
 
@@ -204,15 +223,16 @@ public:
 		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_singleBufferSize);
 		assert(samplesCount > 0);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
 		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
 			auto destinationChannelView = getRangedWriteChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount);
-			for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
-				destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * currentGain);
-				currentGain += baseGainIncrement;
+			if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+				destinationChannelView.addWithRampFrom(AudioBufferChannelView<AudioSampleType>(sourceBuffer.getChannelRawData(destinationChannel), samplesCount), startGain, endGain);
+			} else {
+				for(size_t index = 0; index < destinationChannelView.getBufferSize(); ++index) {
+					destinationChannelView.addSample(index, sourceBuffer.getSample(destinationChannel, index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+				}
 			}
-			currentGain = startGain;
 		}
 	}
 
@@ -226,6 +246,21 @@ public:
 		getWriteChannelView(destinationChannel).addWithRampFrom(sourceBufferChannel, startGain, endGain, destinationSamplesRange);
 	}
 
+	//Add all the sources, each one with its gain or gain ramp, writing every destination sample once (instead of an addFrom pass for every source)
+	void mixFrom(std::span<const AudioBufferMixSource<AudioSampleType>> sources, const SamplesRange &destinationSamplesRange = {}) {
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_singleBufferSize);
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			auto destinationSpans = getRangedWriteChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount).getWriteSpans();
+			forEachContiguousPart(destinationSpans, [&](AudioSampleType* destination, size_t partSamplesCount, size_t processedSamplesCount) {
+				mixing::mixSourcesIntoChannel(destination, partSamplesCount, destinationChannel, sources, processedSamplesCount, samplesCount);
+			});
+		}
+	}
+
+	void mixFrom(std::initializer_list<AudioBufferMixSource<AudioSampleType>> sources, const SamplesRange &destinationSamplesRange = {}) {
+		mixFrom(std::span(sources.begin(), sources.size()), destinationSamplesRange);
+	}
+
 	void applyGain(GainType gain, const SamplesRange &samplesRange = {}) {
 		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
 			getWriteChannelView(channel).applyGain(gain,samplesRange);
@@ -288,19 +323,30 @@ public:
 		return getReadChannelView(channel).getRMSLevel(samplesRange);
 	}
 
+	//Statistics of the samples of all the channels together, analyzed channel after channel
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange &samplesRange = {}) const {
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			accumulator.process(getReadChannelView(channel).getReadSpans(samplesRange));
+		}
+		return accumulator.getStatistics();
+	}
+
+	AudioStatistics<AudioSampleType> getStatisticsForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		return getReadChannelView(channel).getStatistics(samplesRange);
+	}
+
 	[[nodiscard]] size_t getBufferSize() const noexcept { return m_singleBufferSize; }
 	[[nodiscard]] size_t getChannelsCount() const noexcept { return !m_channelsMapping.empty() ? m_channelsMapping.size() : m_bufferChannelsCount; }
 
-	[[nodiscard]] const std::vector<size_t>& getChannelsMapping() const noexcept { return m_channelsMapping; }
-	void setChannelsMapping(const std::vector<size_t>& channelsMapping) { m_channelsMapping = channelsMapping; }
+	[[nodiscard]] const ChannelsMapping& getChannelsMapping() const noexcept { return m_channelsMapping; }
+	void setChannelsMapping(const ChannelsMapping& channelsMapping) { m_channelsMapping = channelsMapping; }
 	void createSequentialChannelsMapping(size_t startChannel, size_t channelsCount) {
 		assert(channelsCount > 0);
 		assert(startChannel < channelsCount);
 		assert(channelsCount <= m_bufferChannelsCount);
-		if(m_channelsMapping.size() != channelsCount) {
-			m_channelsMapping.resize(channelsCount);
-		}
-		std::iota(m_channelsMapping.begin(), m_channelsMapping.end(), startChannel);
+		m_channelsMapping.createSequential(startChannel, channelsCount);
 	}
 
 
@@ -315,41 +361,43 @@ protected:
 	}
 
 	[[nodiscard]] inline CircularAudioBufferChannelView<AudioSampleType> getReadChannelView(size_t channel) const {
-		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_readSampleOffset.load()) % m_bufferSize);
+		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_readSampleOffset.load(std::memory_order_relaxed)) % m_bufferSize);
 	}
 
 	[[nodiscard]] inline CircularAudioBufferChannelView<AudioSampleType> getWriteChannelView(size_t channel) const {
-		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_writeSampleOffset.load()) % m_bufferSize);
+		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_writeSampleOffset.load(std::memory_order_relaxed)) % m_bufferSize);
 	}
 
 	[[nodiscard]] inline OffsettedReadCircularAudioBufferChannelView<AudioSampleType> getOffsettedChannelView(size_t channel) const {
-		return OffsettedReadCircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_readSampleOffset.load()) % m_bufferSize, (m_bufferStartOffset + m_writeSampleOffset.load()) % m_bufferSize);
+		return OffsettedReadCircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, m_singleBufferSize, (m_bufferStartOffset + m_readSampleOffset.load(std::memory_order_relaxed)) % m_bufferSize, (m_bufferStartOffset + m_writeSampleOffset.load(std::memory_order_relaxed)) % m_bufferSize);
 	}
 
 	[[nodiscard]] inline CircularAudioBufferChannelView<AudioSampleType> getRangedReadChannelView(size_t channel, size_t startOffset, size_t samplesCount) const {
 		assert(startOffset + samplesCount <= m_singleBufferSize);
-		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_readSampleOffset.load() + startOffset) % m_bufferSize);
+		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_readSampleOffset.load(std::memory_order_relaxed) + startOffset) % m_bufferSize);
 	}
 
 	[[nodiscard]] inline CircularAudioBufferChannelView<AudioSampleType> getRangedWriteChannelView(size_t channel, size_t startOffset, size_t samplesCount) const {
 		assert(startOffset + samplesCount <= m_singleBufferSize);
-		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_writeSampleOffset.load() + startOffset) % m_bufferSize);
+		return CircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_writeSampleOffset.load(std::memory_order_relaxed) + startOffset) % m_bufferSize);
 	}
 
 	[[nodiscard]] inline OffsettedReadCircularAudioBufferChannelView<AudioSampleType> getRangedOffsettedChannelView(size_t channel, size_t startOffset, size_t samplesCount) const {
 		assert(startOffset + samplesCount <= m_singleBufferSize);
-		return OffsettedReadCircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_readSampleOffset.load() + startOffset) % m_bufferSize, (m_bufferStartOffset + m_writeSampleOffset.load() + startOffset) % m_bufferSize);
+		return OffsettedReadCircularAudioBufferChannelView<AudioSampleType>(m_data[getMappedChannel(channel)], m_bufferSize, samplesCount, (m_bufferStartOffset + m_readSampleOffset.load(std::memory_order_relaxed) + startOffset) % m_bufferSize, (m_bufferStartOffset + m_writeSampleOffset.load(std::memory_order_relaxed) + startOffset) % m_bufferSize);
 	}
 
 	AudioSampleType** m_data;
 	size_t m_bufferSize;
 	size_t m_singleBufferSize;
 	size_t m_bufferChannelsCount;
-	std::vector<size_t> m_channelsMapping;
+	ChannelsMapping m_channelsMapping;
 	size_t m_bufferStartOffset;
 
-	std::atomic<size_t> m_readSampleOffset;
-	std::atomic<size_t> m_writeSampleOffset;
+	//The offsets are derived from the indexes of the subclasses, that are the ones used to synchronize the threads (so they are read relaxed).
+	//They are kept on different cache lines because they are written by the reader and the writer threads
+	alignas(cacheLineSize) std::atomic<size_t> m_readSampleOffset;
+	alignas(cacheLineSize) std::atomic<size_t> m_writeSampleOffset;
 
 };
 
@@ -10,24 +10,26 @@
 
 namespace abl {
 
-template <NumericType AudioSampleType>
-class CircularAudioBuffer : public CircularAudioBufferView<AudioSampleType>, public AudioBufferWithMemoryManagement<AudioSampleType> {
+template <NumericType AudioSampleType, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
+class CircularAudioBuffer : public AudioBufferWithMemoryManagement<AudioSampleType, Allocator>, public CircularAudioBufferView<AudioSampleType> {
 public:
+	using MemoryManagement = AudioBufferWithMemoryManagement<AudioSampleType, Allocator>;
 
-	explicit CircularAudioBuffer(size_t bufferSize, size_t singleBufferSize, size_t channelsCount = 2, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
-		: CircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize), channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
+
+	explicit CircularAudioBuffer(size_t bufferSize, size_t singleBufferSize, size_t channelsCount = 2, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), CircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize), channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
 	{
 		//assert(bufferSize > 0);
 		//assert(channelsCount > 0);
 	}
 
-	static CircularAudioBuffer createFor(size_t singleBuffersCount, size_t singleBufferSize, size_t channelsCount = 2, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0) {
-		return CircularAudioBuffer(singleBuffersCount * singleBufferSize, singleBufferSize, channelsCount, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex);
+	static CircularAudioBuffer createFor(size_t singleBuffersCount, size_t singleBufferSize, size_t channelsCount = 2, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0, const Allocator& allocator = Allocator()) {
+		return CircularAudioBuffer(singleBuffersCount * singleBufferSize, singleBufferSize, channelsCount, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex, allocator);
 	}
 
 	//Full buffer copy
-	explicit CircularAudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
-		: CircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
+	explicit CircularAudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), CircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
 	{
 		for(size_t channel = 0; channel < channelsCount; ++channel) {
 			std::copy(sourceData[channel], sourceData[channel] + bufferSize, BasicCircularAudioBufferView<AudioSampleType>::m_data[channel]);
@@ -47,8 +49,8 @@ public:
 //	}
 
 	//Full buffer copy
-	explicit CircularAudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, size_t singleBufferSize, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
-		: CircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
+	explicit CircularAudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, size_t singleBufferSize, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), CircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), singleBufferSize, bufferStartOffset, channelsMapping, startReadIndex, startWriteIndex)
 	{
 		if(!sourceBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < sourceBuffer.getChannelsCount(); ++channel) {
@@ -61,8 +63,8 @@ public:
 
 	//@todo create a constructor or factory method that create the buffer from a single buffer?
 
-	CircularAudioBuffer(const CircularAudioBuffer &otherBuffer) : CircularAudioBufferView<AudioSampleType>(
-			prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()),
+	CircularAudioBuffer(const CircularAudioBuffer &otherBuffer) : MemoryManagement(otherBuffer.m_allocator), CircularAudioBufferView<AudioSampleType>(
+			MemoryManagement::allocateSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()),
 			otherBuffer.m_bufferChannelsCount,
 			otherBuffer.m_bufferSize,
 			otherBuffer.m_singleBufferSize,
@@ -79,6 +81,10 @@ public:
 	}
 
 	CircularAudioBuffer& operator= (const CircularAudioBuffer &otherBuffer) {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize = otherBuffer.m_singleBufferSize;
@@ -88,8 +94,11 @@ public:
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset);
 		CircularAudioBufferView<AudioSampleType>::m_readIndex.store(otherBuffer.m_readIndex.load());
 		CircularAudioBufferView<AudioSampleType>::m_writeIndex.store(otherBuffer.m_writeIndex.load());
+		//Like the copy constructor, the copied buffer is not metered until a meter is set again
+		CircularAudioBufferView<AudioSampleType>::m_levelMeter = nullptr;
 
-		BasicCircularAudioBufferView<AudioSampleType>::m_data = prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty());
+		//The old data is released with the current allocator, that is kept
+		setInternalData(prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()));
 		if(!otherBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < otherBuffer.m_bufferChannelsCount; ++channel) {
 				std::copy(otherBuffer.m_data[channel], otherBuffer.m_data[channel] + otherBuffer.m_bufferSize, BasicCircularAudioBufferView<AudioSampleType>::m_data[channel]);
@@ -99,7 +108,7 @@ public:
 		return *this;
 	}
 
-	CircularAudioBuffer (CircularAudioBuffer&& otherBuffer) noexcept : CircularAudioBufferView<AudioSampleType>(
+	CircularAudioBuffer (CircularAudioBuffer&& otherBuffer) noexcept : MemoryManagement(otherBuffer.m_allocator), CircularAudioBufferView<AudioSampleType>(
 			otherBuffer.m_data,
 			otherBuffer.m_bufferChannelsCount,
 			otherBuffer.m_bufferSize,
@@ -109,6 +118,7 @@ public:
 			otherBuffer.m_readIndex,
 			otherBuffer.m_writeIndex
 	) {
+		CircularAudioBufferView<AudioSampleType>::m_levelMeter = otherBuffer.m_levelMeter;
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_singleBufferSize = 0;
@@ -119,19 +129,27 @@ public:
 		otherBuffer.m_writeSampleOffset = 0;
 		otherBuffer.m_readIndex = 0;
 		otherBuffer.m_writeIndex = 0;
+		otherBuffer.m_levelMeter = nullptr;
 	}
 
 	CircularAudioBuffer& operator= (CircularAudioBuffer&& otherBuffer) noexcept {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize = otherBuffer.m_singleBufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferStartOffset = otherBuffer.m_bufferStartOffset;
 		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(otherBuffer.m_readSampleOffset);
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset);
-		BasicCircularAudioBufferView<AudioSampleType>::m_data = otherBuffer.m_data;
+		//The old data is released with the current allocator, the moved data will be released with the allocator that created it
+		setInternalData(otherBuffer.m_data);
+		MemoryManagement::m_allocator = otherBuffer.m_allocator;
 		BasicCircularAudioBufferView<AudioSampleType>::m_channelsMapping = std::move(otherBuffer.m_channelsMapping);
 		CircularAudioBufferView<AudioSampleType>::m_readIndex.store(otherBuffer.m_readIndex.load());
 		CircularAudioBufferView<AudioSampleType>::m_writeIndex.store(otherBuffer.m_writeIndex.load());
+		CircularAudioBufferView<AudioSampleType>::m_levelMeter = otherBuffer.m_levelMeter;
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_singleBufferSize = 0;
@@ -142,6 +160,7 @@ public:
 		otherBuffer.m_writeSampleOffset = 0;
 		otherBuffer.m_readIndex = 0;
 		otherBuffer.m_writeIndex = 0;
+		otherBuffer.m_levelMeter = nullptr;
 		return *this;
 	}
 
@@ -154,7 +173,7 @@ public:
 			return;
 		}
 
-		AudioBufferWithMemoryManagement<AudioSampleType>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
+		AudioBufferWithMemoryManagement<AudioSampleType, Allocator>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
 		                                                           BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount,
 																   BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize,
 																   BasicCircularAudioBufferView<AudioSampleType>::m_data);
@@ -167,12 +186,12 @@ protected:
 	AudioSampleType** prepareAllocatedSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) override {
 		//@todo use preallocated space? (like string that have a basic space, and if you don't use more than that it already come with the object)
 
-		return allocateContiguous2DArray<AudioSampleType>(channelsCount, bufferSize, zeroData);
+		return MemoryManagement::allocateSpace(channelsCount, bufferSize, zeroData);
 	}
 
 	void setInternalData(AudioSampleType** newData, bool deleteOld = true) override {
 		if(deleteOld && BasicCircularAudioBufferView<AudioSampleType>::m_data) {
-			deallocateContiguous2DArray<AudioSampleType>(BasicCircularAudioBufferView<AudioSampleType>::m_data);
+			MemoryManagement::deallocateSpace(BasicCircularAudioBufferView<AudioSampleType>::m_data);
 		}
 		BasicCircularAudioBufferView<AudioSampleType>::m_data = newData;
 	}
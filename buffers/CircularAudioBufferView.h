@@ -5,6 +5,7 @@
 #define ABL_CIRCULARAUDIOBUFFERVIEW_H
 
 #include "BasicCircularAudioBufferView.h"
+#include "../analysis/AudioLevelMeter.h"
 
 namespace abl {
 
@@ -14,7 +15,7 @@ public:
 //	CircularAudioBufferView(const juce::AudioBuffer<AudioSampleType> &buffer, size_t singleBufferSize, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
 //			: BasicCircularAudioBufferView<AudioSampleType>(buffer, singleBufferSize, bufferStartOffset, channelsMapping), m_readIndex{startReadIndex}, m_writeIndex{startWriteIndex} {}
 
-	CircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
+	CircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startReadIndex = 0, size_t startWriteIndex = 0)
 			: BasicCircularAudioBufferView<AudioSampleType>(data, channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping), m_readIndex{startReadIndex}, m_writeIndex{startWriteIndex} {}
 
 	CircularAudioBufferView(const CircularAudioBufferView& otherBuffer)
@@ -29,8 +30,10 @@ public:
 	{
 		m_readIndex.store(otherBuffer.m_readIndex.load());
 		m_writeIndex.store(otherBuffer.m_writeIndex.load());
+		m_levelMeter = otherBuffer.m_levelMeter;
 		otherBuffer.m_readIndex = 0;
 		otherBuffer.m_writeIndex = 0;
+		otherBuffer.m_levelMeter = nullptr;
 	}
 
 	BasicCircularAudioBufferView<AudioSampleType> getRangedView(SamplesRange samplesRange) override {
@@ -47,23 +50,35 @@ public:
 		);
 	}
 
+	//The indexes are published with release stores and read with acquire loads, so the samples written before incrementWriteIndex() are visible
+	//to the thread that see the new write index (and the samples read before incrementReadIndex() are not overwritten before the new read index is visible).
+	//Used as single producer/single consumer ring buffer, only the writer thread can call incrementWriteIndex(), availableToWrite() and tryWrite(),
+	//and only the reader thread can call incrementReadIndex(), availableToRead() and tryRead()
 	void incrementReadIndex(std::optional<size_t> increment = {}) noexcept {
 		auto incrementValue = increment.has_value() ? increment.value() : BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize;
-		assert(m_readIndex + incrementValue <= m_writeIndex); //@todo bound the increment value to save from this case?
-		m_readIndex.store(m_readIndex.load() + incrementValue);
-		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(m_readIndex % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize);
+		auto readIndex = m_readIndex.load(std::memory_order_relaxed) + incrementValue;
+		assert(readIndex <= m_writeIndex.load(std::memory_order_acquire)); //@todo bound the increment value to save from this case?
+		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(readIndex % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize, std::memory_order_relaxed);
+		m_readIndex.store(readIndex, std::memory_order_release);
 	}
 
 	void incrementWriteIndex(std::optional<size_t> increment = {}) noexcept {
-		m_writeIndex.store(m_writeIndex.load() + (increment.has_value() ? increment.value() : BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize));
-		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(m_writeIndex % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize);
+		auto incrementValue = increment.has_value() ? increment.value() : BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize;
+		if(m_levelMeter != nullptr) {
+			meterWrittenSamples(incrementValue);
+		}
+		auto writeIndex = m_writeIndex.load(std::memory_order_relaxed) + incrementValue;
+		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(writeIndex % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize, std::memory_order_relaxed);
+		m_writeIndex.store(writeIndex, std::memory_order_release);
 	}
 
+	//Not thread safe: the reader and the writer must be stopped
 	void resetWriteIndexToReadIndexPosition() noexcept {
 		m_writeIndex.store(m_readIndex.load());
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.load());
 	}
 
+	//Not thread safe: the reader and the writer must be stopped
 	void resetIndexes() noexcept {
 		m_readIndex = 0;
 		m_writeIndex = 0;
@@ -71,18 +86,81 @@ public:
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset = 0;
 	}
 
-	size_t getReadIndex() const noexcept { return m_readIndex.load();}
-	size_t getWriteIndex() const noexcept { return m_writeIndex.load(); }
+	size_t getReadIndex() const noexcept { return m_readIndex.load(std::memory_order_acquire); }
+	size_t getWriteIndex() const noexcept { return m_writeIndex.load(std::memory_order_acquire); }
 
 	[[nodiscard]] bool isDataAvailable() const noexcept {
-		return m_writeIndex > m_readIndex;
+		return availableToRead() > 0;
+	}
+
+	[[nodiscard]] size_t availableToRead() const noexcept {
+		return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] size_t availableToWrite() const noexcept {
+		auto usedSamples = m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_acquire);
+		return usedSamples < BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize ? BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize - usedSamples : 0;
+	}
+
+	//Copy the block in the write area and increment the write index, only if there's enough free space (without overwriting samples not read yet)
+	bool tryWrite(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToWrite = samplesCount.has_value() ? samplesCount.value() : sourceBuffer.getBufferSize();
+		assert(samplesToWrite > 0 && samplesToWrite <= BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize);
+		if(availableToWrite() < samplesToWrite) {
+			return false;
+		}
+
+		BasicCircularAudioBufferView<AudioSampleType>::copyFrom(sourceBuffer, SamplesRange(0, static_cast<int>(samplesToWrite)));
+		incrementWriteIndex(samplesToWrite);
+		return true;
+	}
+
+	//Copy the samples of the read area in the block and increment the read index, only if enough samples have been written
+	bool tryRead(AudioBufferType<AudioSampleType> auto &destinationBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToRead = samplesCount.has_value() ? samplesCount.value() : destinationBuffer.getBufferSize();
+		assert(samplesToRead > 0 && samplesToRead <= BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize);
+		assert(destinationBuffer.getChannelsCount() <= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		if(availableToRead() < samplesToRead) {
+			return false;
+		}
+
+		for(size_t channel = 0; channel < destinationBuffer.getChannelsCount(); ++channel) {
+			destinationBuffer.copyIntoChannelFrom(BasicCircularAudioBufferView<AudioSampleType>::getRangedReadChannelView(channel, 0, samplesToRead), channel, SamplesRange(0, static_cast<int>(samplesToRead)));
+		}
+		incrementReadIndex(samplesToRead);
+		return true;
 	}
 
 	[[nodiscard]] size_t getBaseBufferSize() const noexcept { return BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize; }
 
+	//The samples published by incrementWriteIndex() are metered by the writer thread before moving the index, so the levels are always updated without rescanning the buffer.
+	//The meter must have at most the channels of the view and must outlive it (nullptr to stop metering).
+	//A meter is fed by a single writer, so the copies of the view start without one (it must be set again on the copy), while a move keep it
+	void setLevelMeter(AudioLevelMeter<AudioSampleType>* levelMeter) noexcept {
+		assert(levelMeter == nullptr || levelMeter->getChannelsCount() <= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		m_levelMeter = levelMeter;
+	}
+
+	[[nodiscard]] AudioLevelMeter<AudioSampleType>* getLevelMeter() const noexcept { return m_levelMeter; }
+
 protected:
-	std::atomic<size_t> m_readIndex;
-	std::atomic<size_t> m_writeIndex;
+	void meterWrittenSamples(size_t samplesCount) noexcept {
+		auto& bufferSize = BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize;
+		samplesCount = std::min(samplesCount, bufferSize);
+		auto writeOffset = (BasicCircularAudioBufferView<AudioSampleType>::m_bufferStartOffset + BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.load(std::memory_order_relaxed)) % bufferSize;
+		for(size_t channel = 0; channel < m_levelMeter->getChannelsCount(); ++channel) {
+			auto channelData = BasicCircularAudioBufferView<AudioSampleType>::m_data[BasicCircularAudioBufferView<AudioSampleType>::getMappedChannel(channel)];
+			CircularAudioBufferChannelView<AudioSampleType> writtenSamples{channelData, bufferSize, samplesCount, writeOffset};
+			forEachContiguousPart(writtenSamples.getReadSpans(), [&](const AudioSampleType* samples, size_t partSamplesCount, size_t) {
+				m_levelMeter->processChannelPart(channel, samples, partSamplesCount);
+			});
+		}
+		m_levelMeter->finishBlock(samplesCount);
+	}
+
+	alignas(cacheLineSize) std::atomic<size_t> m_readIndex;
+	alignas(cacheLineSize) std::atomic<size_t> m_writeIndex;
+	AudioLevelMeter<AudioSampleType>* m_levelMeter = nullptr;
 };
 
 } // engine::showmanager
@@ -9,19 +9,21 @@
 
 namespace abl {
 
-template <NumericType AudioSampleType>
-class DelayedCircularAudioBuffer : public DelayedCircularAudioBufferView<AudioSampleType>, public AudioBufferWithMemoryManagement<AudioSampleType> {
+template <NumericType AudioSampleType, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
+class DelayedCircularAudioBuffer : public AudioBufferWithMemoryManagement<AudioSampleType, Allocator>, public DelayedCircularAudioBufferView<AudioSampleType> {
 public:
-	explicit DelayedCircularAudioBuffer(size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t channelsCount = 2, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startIndex = 0)
-		: DelayedCircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize), channelsCount, bufferSize, singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
+	using MemoryManagement = AudioBufferWithMemoryManagement<AudioSampleType, Allocator>;
+
+	explicit DelayedCircularAudioBuffer(size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t channelsCount = 2, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), DelayedCircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize), channelsCount, bufferSize, singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
 	{
 		//assert(bufferSize > 0);
 		//assert(channelsCount > 0);
 	}
 
 	//Full buffer copy
-	explicit DelayedCircularAudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startIndex = 0)
-		: DelayedCircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
+	explicit DelayedCircularAudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), DelayedCircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
 	{
 		for(size_t channel = 0; channel < channelsCount; ++channel) {
 			std::copy(sourceData[channel], sourceData[channel] + bufferSize, BasicCircularAudioBufferView<AudioSampleType>::m_data[channel]);
@@ -41,8 +43,8 @@ public:
 //	}
 
 	//Full buffer copy
-	explicit DelayedCircularAudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startIndex = 0)
-		: DelayedCircularAudioBufferView<AudioSampleType>(prepareAllocatedSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
+	explicit DelayedCircularAudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startIndex = 0, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), DelayedCircularAudioBufferView<AudioSampleType>(MemoryManagement::allocateSpace(sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), sourceBuffer.isEmpty()), sourceBuffer.getChannelsCount(), sourceBuffer.getBufferSize(), singleBufferSize, delayInSamples, bufferStartOffset, channelsMapping, startIndex)
 	{
 		if(!sourceBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < sourceBuffer.getChannelsCount(); ++channel) {
@@ -55,8 +57,8 @@ public:
 
 	//@todo create a constructor or factory method that create the buffer from a single buffer?
 
-	DelayedCircularAudioBuffer(const DelayedCircularAudioBuffer &otherBuffer) : DelayedCircularAudioBufferView<AudioSampleType>(
-			prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()),
+	DelayedCircularAudioBuffer(const DelayedCircularAudioBuffer &otherBuffer) : MemoryManagement(otherBuffer.m_allocator), DelayedCircularAudioBufferView<AudioSampleType>(
+			MemoryManagement::allocateSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()),
 			otherBuffer.m_bufferChannelsCount,
 			otherBuffer.m_bufferSize,
 			otherBuffer.m_singleBufferSize,
@@ -65,6 +67,7 @@ public:
 			otherBuffer.m_channelsMapping,
 			otherBuffer.m_index
 	) {
+		DelayedCircularAudioBufferView<AudioSampleType>::copyDelayTransitionFrom(otherBuffer);
 		if(!otherBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < otherBuffer.getChannelsCount(); ++channel) {
 				std::copy(otherBuffer.m_data[channel], otherBuffer.m_data[channel] + otherBuffer.m_bufferSize, BasicCircularAudioBufferView<AudioSampleType>::m_data[channel]);
@@ -73,6 +76,10 @@ public:
 	}
 
 	DelayedCircularAudioBuffer& operator= (const DelayedCircularAudioBuffer &otherBuffer) {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize = otherBuffer.m_singleBufferSize;
@@ -82,8 +89,10 @@ public:
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset);
 		DelayedCircularAudioBufferView<AudioSampleType>::m_delayInSamples.store(otherBuffer.m_delayInSamples.load());
 		DelayedCircularAudioBufferView<AudioSampleType>::m_index.store(otherBuffer.m_index.load());
+		DelayedCircularAudioBufferView<AudioSampleType>::copyDelayTransitionFrom(otherBuffer);
 
-		BasicCircularAudioBufferView<AudioSampleType>::m_data = prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty());
+		//The old data is released with the current allocator, that is kept
+		setInternalData(prepareAllocatedSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.isEmpty()));
 		if(!otherBuffer.isEmpty()) {
 			for(size_t channel = 0; channel < otherBuffer.m_bufferChannelsCount; ++channel) {
 				std::copy(otherBuffer.m_data[channel], otherBuffer.m_data[channel] + otherBuffer.m_bufferSize, BasicCircularAudioBufferView<AudioSampleType>::m_data[channel]);
@@ -93,7 +102,7 @@ public:
 		return *this;
 	}
 
-	DelayedCircularAudioBuffer (DelayedCircularAudioBuffer&& otherBuffer) noexcept : DelayedCircularAudioBufferView<AudioSampleType>(
+	DelayedCircularAudioBuffer (DelayedCircularAudioBuffer&& otherBuffer) noexcept : MemoryManagement(otherBuffer.m_allocator), DelayedCircularAudioBufferView<AudioSampleType>(
 			otherBuffer.m_data,
 			otherBuffer.m_bufferChannelsCount,
 			otherBuffer.m_bufferSize,
@@ -103,6 +112,7 @@ public:
 			std::move(otherBuffer.m_channelsMapping),
 			otherBuffer.m_index
 	) {
+		DelayedCircularAudioBufferView<AudioSampleType>::copyDelayTransitionFrom(otherBuffer);
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_singleBufferSize = 0;
@@ -113,19 +123,29 @@ public:
 		otherBuffer.m_readSampleOffset = 0;
 		otherBuffer.m_writeSampleOffset = 0;
 		otherBuffer.m_index = 0;
+		otherBuffer.m_indexShift = 0;
+		otherBuffer.m_transitionSamplesCount = 0;
+		otherBuffer.m_hasPendingDelayChange = false;
 	}
 
 	DelayedCircularAudioBuffer& operator= (DelayedCircularAudioBuffer&& otherBuffer) noexcept {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize = otherBuffer.m_singleBufferSize;
 		BasicCircularAudioBufferView<AudioSampleType>::m_bufferStartOffset = otherBuffer.m_bufferStartOffset;
 		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(otherBuffer.m_readSampleOffset);
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset);
-		BasicCircularAudioBufferView<AudioSampleType>::m_data = otherBuffer.m_data;
+		//The old data is released with the current allocator, the moved data will be released with the allocator that created it
+		setInternalData(otherBuffer.m_data);
+		MemoryManagement::m_allocator = otherBuffer.m_allocator;
 		BasicCircularAudioBufferView<AudioSampleType>::m_channelsMapping = std::move(otherBuffer.m_channelsMapping);
 		DelayedCircularAudioBufferView<AudioSampleType>::m_delayInSamples.store(otherBuffer.m_delayInSamples.load());
 		DelayedCircularAudioBufferView<AudioSampleType>::m_index.store(otherBuffer.m_index.load());
+		DelayedCircularAudioBufferView<AudioSampleType>::copyDelayTransitionFrom(otherBuffer);
 		otherBuffer.m_data = nullptr;
 		otherBuffer.m_bufferSize = 0;
 		otherBuffer.m_singleBufferSize = 0;
@@ -136,6 +156,9 @@ public:
 		otherBuffer.m_readSampleOffset = 0;
 		otherBuffer.m_writeSampleOffset = 0;
 		otherBuffer.m_index = 0;
+		otherBuffer.m_indexShift = 0;
+		otherBuffer.m_transitionSamplesCount = 0;
+		otherBuffer.m_hasPendingDelayChange = false;
 		return *this;
 	}
 
@@ -148,7 +171,7 @@ public:
 			return;
 		}
 
-		AudioBufferWithMemoryManagement<AudioSampleType>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
+		AudioBufferWithMemoryManagement<AudioSampleType, Allocator>::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
 		                                                           BasicCircularAudioBufferView<AudioSampleType>::m_bufferChannelsCount,
 		                                                           BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize,
 		                                                           BasicCircularAudioBufferView<AudioSampleType>::m_data);
@@ -161,12 +184,12 @@ protected:
 	AudioSampleType** prepareAllocatedSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) override {
 		//@todo use preallocated space? (like string that have a basic space, and if you don't use more than that it already come with the object)
 
-		return allocateContiguous2DArray<AudioSampleType>(channelsCount, bufferSize, zeroData);
+		return MemoryManagement::allocateSpace(channelsCount, bufferSize, zeroData);
 	}
 
 	void setInternalData(AudioSampleType** newData, bool deleteOld = true) override {
 		if(deleteOld && BasicCircularAudioBufferView<AudioSampleType>::m_data) {
-			deallocateContiguous2DArray<AudioSampleType>(BasicCircularAudioBufferView<AudioSampleType>::m_data);
+			MemoryManagement::deallocateSpace(BasicCircularAudioBufferView<AudioSampleType>::m_data);
 		}
 		BasicCircularAudioBufferView<AudioSampleType>::m_data = newData;
 	}
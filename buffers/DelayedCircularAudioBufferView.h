@@ -4,10 +4,37 @@
 #ifndef ABL_DELAYEDCIRCULARAUDIOBUFFERVIEW_H
 #define ABL_DELAYEDCIRCULARAUDIOBUFFERVIEW_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <span>
+
 #include "BasicCircularAudioBufferView.h"
+#include "AudioBufferMixSource.h"
+#include "../kernels/AudioKernels.h"
 
 namespace abl {
 
+//Tap of the multi-tap reads: the samples delayed by delayInSamples (from the write area, like the interpolated reads) added with a constant gain,
+//or with a gain ramp from startGain to endGain over the read samples
+template <NumericType AudioSampleType>
+struct DelayTap {
+	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+
+	DelayTap(size_t tapDelayInSamples, GainType gain = GainType(1))
+			: delayInSamples{tapDelayInSamples}, startGain{gain}, endGain{gain} {}
+
+	DelayTap(size_t tapDelayInSamples, GainType rampStartGain, GainType rampEndGain)
+			: delayInSamples{tapDelayInSamples}, startGain{rampStartGain}, endGain{rampEndGain} {}
+
+	size_t delayInSamples;
+	GainType startGain;
+	GainType endGain;
+};
+
 template <NumericType AudioSampleType>
 class DelayedCircularAudioBufferView : public BasicCircularAudioBufferView<AudioSampleType> {
 public:
@@ -18,7 +45,7 @@ public:
 //		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset + m_delayInSamples);
 //	}
 
-	DelayedCircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const std::vector<size_t>& channelsMapping = {}, size_t startIndex = 0)
+	DelayedCircularAudioBufferView(AudioSampleType **data, size_t channelsCount, size_t bufferSize, size_t singleBufferSize, size_t delayInSamples, size_t bufferStartOffset = 0, const ChannelsMapping& channelsMapping = {}, size_t startIndex = 0)
 			: BasicCircularAudioBufferView<AudioSampleType>(data, channelsCount, bufferSize, singleBufferSize, bufferStartOffset, channelsMapping), m_index{startIndex}, m_delayInSamples{delayInSamples}
 	{
 		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(startIndex % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize);
@@ -30,6 +57,7 @@ public:
 	{
 		m_index.store(otherBuffer.m_index.load());
 		m_delayInSamples.store(otherBuffer.m_delayInSamples.load());
+		copyDelayTransitionFrom(otherBuffer);
 	}
 
 	DelayedCircularAudioBufferView(DelayedCircularAudioBufferView&& otherBuffer) noexcept
@@ -37,8 +65,12 @@ public:
 	{
 		m_index.store(otherBuffer.m_index.load());
 		m_delayInSamples.store(otherBuffer.m_delayInSamples.load());
+		copyDelayTransitionFrom(otherBuffer);
 		otherBuffer.m_index = 0;
 		otherBuffer.m_delayInSamples = 0;
+		otherBuffer.m_indexShift = 0;
+		otherBuffer.m_transitionSamplesCount = 0;
+		otherBuffer.m_hasPendingDelayChange = false;
 	}
 
 	BasicCircularAudioBufferView<AudioSampleType> getRangedView(SamplesRange samplesRange) override {
@@ -57,13 +89,24 @@ public:
 	}
 
 	void incrementIndex(std::optional<size_t> increment = {}) noexcept {
-		m_index.store(m_index.load() + (increment.has_value() ? increment.value() : BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize));
-		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(m_index % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize);
+		auto samplesCount = increment.has_value() ? increment.value() : BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize;
+		m_index.store(m_index.load() + samplesCount);
+		if(isDelayTransitionActive()) {
+			m_transitionPosition.store(std::min(m_transitionPosition.load() + samplesCount, m_transitionSamplesCount.load()));
+		}
+		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store((m_index + m_indexShift) % BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize);
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset + m_delayInSamples);
+		if(m_hasPendingDelayChange.load() && !isDelayTransitionActive()) {
+			m_hasPendingDelayChange.store(false);
+			startDelayTransition(m_pendingDelayInSamples.load(), m_pendingCrossfadeSamplesCount.load());
+		}
 	}
 
 	void resetIndex() noexcept {
 		m_index = 0;
+		m_indexShift = 0;
+		m_transitionSamplesCount = 0;
+		m_hasPendingDelayChange = false;
 		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(0);
 		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(m_delayInSamples);
 	}
@@ -71,17 +114,275 @@ public:
 	size_t getIndex() const noexcept { return m_index.load(); }
 
 	size_t getDelayInSamples() const noexcept { return m_delayInSamples.load(); }
+
+	//Move the delay at once: the reads jump to samples written at a different time, so it clicks on a playing signal (see the crossfaded version)
 	void setDelayInSamples(size_t delay) noexcept {
-		m_delayInSamples.store(delay);
-		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset + m_delayInSamples);
-		//@todo resample the difference?
+		m_transitionSamplesCount.store(0);
+		m_hasPendingDelayChange.store(false);
+		updateDelayInSamples(delay);
+	}
+
+	//Move the delay keeping the write position, so the samples keep being written contiguously and the read area move to the samples of the new delay
+	//(that are already in the buffer, without the gap left by moving the write position). readCrossfaded blend the samples of the old delay into the new ones
+	//with a linear crossfade of crossfadeSamplesCount samples, advanced by incrementIndex. A change during a transition is kept pending (replacing the
+	//previous pending one) and starts at the first incrementIndex after the end of the running transition, so every crossfade starts from a single delay
+	//and the output never jumps. Both the delays must be less than getBaseBufferSize() - getBufferSize(), and like the other index functions it must be
+	//called by the thread that reads the buffer, between the blocks
+	void setDelayInSamples(size_t delay, size_t crossfadeSamplesCount) noexcept {
+		if(isDelayTransitionActive()) {
+			m_pendingDelayInSamples.store(delay);
+			m_pendingCrossfadeSamplesCount.store(crossfadeSamplesCount);
+			m_hasPendingDelayChange.store(true);
+			return;
+		}
+
+		m_hasPendingDelayChange.store(false);
+		startDelayTransition(delay, crossfadeSamplesCount);
+	}
+
+	[[nodiscard]] bool isDelayTransitionActive() const noexcept { return m_transitionPosition.load() < m_transitionSamplesCount.load(); }
+	[[nodiscard]] bool hasPendingDelayChange() const noexcept { return m_hasPendingDelayChange.load(); }
+
+	//Copy the samples of the read area to destination, blending the ones of the old delay during a delay transition. The ramps are applied by the copy and add
+	//ramp kernels to the contiguous parts of the two read positions, so every part is read and written once while it's in the cache, without temporary buffers.
+	//Outside of the transitions it's a plain copy of the read area
+	void readCrossfaded(size_t channel, AudioSampleType* destination, const SamplesRange& samplesRange = {}) const noexcept {
+		using BaseView = BasicCircularAudioBufferView<AudioSampleType>;
+		using GainType = typename AudioKernels<AudioSampleType>::GainType;
+		assert(channel < BaseView::getChannelsCount());
+		auto samplesCount = samplesRange.getRealSamplesCount(BaseView::m_singleBufferSize);
+		assert(samplesRange.startSample + samplesCount <= BaseView::m_singleBufferSize);
+		const auto bufferSize = BaseView::m_bufferSize;
+		const AudioSampleType* data = BaseView::m_data[BaseView::getMappedChannel(channel)];
+		auto readPosition = (BaseView::m_bufferStartOffset + BaseView::m_readSampleOffset.load(std::memory_order_relaxed) + samplesRange.startSample) % bufferSize;
+		auto transitionSamplesCount = m_transitionSamplesCount.load();
+		auto transitionPosition = m_transitionPosition.load() + samplesRange.startSample;
+		//The old delay is read at its distance from the write position, that is delayInSamples - previousDelayInSamples samples from the read position
+		auto previousReadPosition = (readPosition + m_delayInSamples.load() + bufferSize - m_previousDelayInSamples.load() % bufferSize) % bufferSize;
+
+		for(size_t index = 0; index < samplesCount;) {
+			auto partSamplesCount = std::min(samplesCount - index, bufferSize - readPosition);
+			if(transitionPosition < transitionSamplesCount) {
+				partSamplesCount = std::min({partSamplesCount, bufferSize - previousReadPosition, transitionSamplesCount - transitionPosition});
+				auto gainIncrement = GainType(1) / static_cast<GainType>(transitionSamplesCount);
+				auto startGain = static_cast<GainType>(transitionPosition) * gainIncrement;
+				AudioKernels<AudioSampleType>::copyWithRamp(destination + index, data + readPosition, partSamplesCount, startGain, gainIncrement);
+				AudioKernels<AudioSampleType>::addWithRamp(destination + index, data + previousReadPosition, partSamplesCount, GainType(1) - startGain, -gainIncrement);
+				transitionPosition += partSamplesCount;
+			} else {
+				AudioKernels<AudioSampleType>::copy(destination + index, data + readPosition, partSamplesCount);
+			}
+			index += partSamplesCount;
+			readPosition = (readPosition + partSamplesCount) % bufferSize;
+			previousReadPosition = (previousReadPosition + partSamplesCount) % bufferSize;
+		}
+	}
+
+	void readCrossfaded(const AudioBufferView<AudioSampleType>& destination, const SamplesRange& samplesRange = {}) const noexcept {
+		assert(destination.getChannelsCount() >= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		assert(samplesRange.getRealSamplesCount(BasicCircularAudioBufferView<AudioSampleType>::m_singleBufferSize) <= destination.getBufferSize());
+		for(size_t channel = 0; channel < BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount(); ++channel) {
+			readCrossfaded(channel, destination.getChannelRawData(channel), samplesRange);
+		}
 	}
 
 	[[nodiscard]] size_t getBaseBufferSize() const noexcept { return BasicCircularAudioBufferView<AudioSampleType>::m_bufferSize; }
 
+	//Fractional delay reads, for the modulated delays (chorus, flanger, vibrato, doppler) and the smooth delay changes.
+	//delays[i] is the distance (in samples, with a fraction) of the read sample from the one written at the index startOffset + i of the write area,
+	//so a delay equal to getDelayInSamples read the same samples of the read area. The written samples must be at least the after margin of the
+	//interpolation (getInterpolationMargins) after the read position, and the delays can't be more than getBaseBufferSize() - getBufferSize() - the before margin.
+	//The samples are read from the buffer memory by the interpolation kernels, in blocks of interpolationBlockSize samples: only the rare blocks that cross
+	//the end of the buffer are copied on the stack first. No allocations, and it doesn't move the indexes
+	void readInterpolated(size_t channel, AudioSampleType* destination, std::span<const double> delays, InterpolationType interpolation, size_t startOffset = 0) const noexcept {
+		interpolateChannel(channel, destination, delays.size(), startOffset, interpolation, [delays](size_t index) { return delays[index]; });
+	}
+
+	//Delay ramped linearly from startDelay (at the first sample) to endDelay (after the last one), so consecutive blocks can continue the ramp
+	void readInterpolated(size_t channel, AudioSampleType* destination, size_t samplesCount, double startDelay, double endDelay, InterpolationType interpolation, size_t startOffset = 0) const noexcept {
+		auto delayIncrement = samplesCount > 0 ? (endDelay - startDelay) / static_cast<double>(samplesCount) : 0.0;
+		interpolateChannel(channel, destination, samplesCount, startOffset, interpolation, [startDelay, delayIncrement](size_t index) { return startDelay + static_cast<double>(index) * delayIncrement; });
+	}
+
+	//Read delays.size() samples of all the channels, with the same delays
+	void readInterpolated(const AudioBufferView<AudioSampleType>& destination, std::span<const double> delays, InterpolationType interpolation, size_t startOffset = 0) const noexcept {
+		assert(destination.getChannelsCount() >= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		assert(delays.size() <= destination.getBufferSize());
+		for(size_t channel = 0; channel < BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount(); ++channel) {
+			readInterpolated(channel, destination.getChannelRawData(channel), delays, interpolation, startOffset);
+		}
+	}
+
+	//Fill all the channels of destination with the ramped delay
+	void readInterpolated(const AudioBufferView<AudioSampleType>& destination, double startDelay, double endDelay, InterpolationType interpolation, size_t startOffset = 0) const noexcept {
+		assert(destination.getChannelsCount() >= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		for(size_t channel = 0; channel < BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount(); ++channel) {
+			readInterpolated(channel, destination.getChannelRawData(channel), destination.getBufferSize(), startDelay, endDelay, interpolation, startOffset);
+		}
+	}
+
+	//Multi-tap read: add all the taps to samplesCount samples of destination, reading every destination sample once. The block is split only where one of
+	//the taps cross the end of the buffer, and every part is mixed by the mix kernel with all the taps as sources (in groups of mixing::maxSourcesPerPass).
+	//The tap delays can go from 0 (the samples of the write area) to getBaseBufferSize() - samplesCount
+	void addTapsTo(size_t channel, AudioSampleType* destination, size_t samplesCount, std::span<const DelayTap<AudioSampleType>> taps, size_t startOffset = 0) const noexcept {
+		using BaseView = BasicCircularAudioBufferView<AudioSampleType>;
+		using GainType = typename DelayTap<AudioSampleType>::GainType;
+		assert(channel < BaseView::getChannelsCount());
+		const auto bufferSize = BaseView::m_bufferSize;
+		const AudioSampleType* data = BaseView::m_data[BaseView::getMappedChannel(channel)];
+		const auto writeStart = (BaseView::m_bufferStartOffset + BaseView::m_writeSampleOffset.load(std::memory_order_relaxed) + startOffset) % bufferSize;
+
+		std::array<kernels::KernelMixSource<AudioSampleType>, mixing::maxSourcesPerPass> kernelSources;
+		std::array<size_t, mixing::maxSourcesPerPass> tapsPositions;
+		std::array<size_t, mixing::maxSourcesPerPass + 1> partsEnds;
+		for(size_t firstTap = 0; firstTap < taps.size(); firstTap += mixing::maxSourcesPerPass) {
+			auto passTapsCount = std::min(mixing::maxSourcesPerPass, taps.size() - firstTap);
+			size_t partsCount = 0;
+			for(size_t tap = 0; tap < passTapsCount; ++tap) {
+				assert(taps[firstTap + tap].delayInSamples + samplesCount <= bufferSize);
+				tapsPositions[tap] = (writeStart + bufferSize - taps[firstTap + tap].delayInSamples % bufferSize) % bufferSize;
+				if(bufferSize - tapsPositions[tap] < samplesCount) {
+					partsEnds[partsCount++] = bufferSize - tapsPositions[tap];
+				}
+			}
+			partsEnds[partsCount++] = samplesCount;
+			std::sort(partsEnds.begin(), partsEnds.begin() + static_cast<std::ptrdiff_t>(partsCount));
+
+			size_t partStart = 0;
+			for(size_t part = 0; part < partsCount; ++part) {
+				if(partsEnds[part] == partStart) {
+					continue;
+				}
+				for(size_t tap = 0; tap < passTapsCount; ++tap) {
+					const auto& delayTap = taps[firstTap + tap];
+					GainType gainIncrement = delayTap.startGain == delayTap.endGain ? GainType(0) : (delayTap.endGain - delayTap.startGain) / static_cast<GainType>(samplesCount);
+					kernelSources[tap] = {data + (tapsPositions[tap] + partStart) % bufferSize, delayTap.startGain + static_cast<GainType>(partStart) * gainIncrement, gainIncrement};
+				}
+				AudioKernels<AudioSampleType>::mix(destination + partStart, kernelSources.data(), passTapsCount, partsEnds[part] - partStart);
+				partStart = partsEnds[part];
+			}
+		}
+	}
+
+	//Add the taps to all the channels of destination
+	void addTapsTo(const AudioBufferView<AudioSampleType>& destination, std::span<const DelayTap<AudioSampleType>> taps, size_t startOffset = 0) const noexcept {
+		assert(destination.getChannelsCount() >= BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount());
+		for(size_t channel = 0; channel < BasicCircularAudioBufferView<AudioSampleType>::getChannelsCount(); ++channel) {
+			addTapsTo(channel, destination.getChannelRawData(channel), destination.getBufferSize(), taps, startOffset);
+		}
+	}
+
+	void addTapsTo(const AudioBufferView<AudioSampleType>& destination, std::initializer_list<DelayTap<AudioSampleType>> taps, size_t startOffset = 0) const noexcept {
+		addTapsTo(destination, std::span(taps.begin(), taps.size()), startOffset);
+	}
+
+	static constexpr size_t interpolationBlockSize = 256;
+
 protected:
+	//Copy the index shift and the delay transition of another view (and its offsets, that depend on the shift)
+	void copyDelayTransitionFrom(const DelayedCircularAudioBufferView& otherBuffer) noexcept {
+		m_indexShift.store(otherBuffer.m_indexShift.load());
+		m_previousDelayInSamples.store(otherBuffer.m_previousDelayInSamples.load());
+		m_transitionSamplesCount.store(otherBuffer.m_transitionSamplesCount.load());
+		m_transitionPosition.store(otherBuffer.m_transitionPosition.load());
+		m_pendingDelayInSamples.store(otherBuffer.m_pendingDelayInSamples.load());
+		m_pendingCrossfadeSamplesCount.store(otherBuffer.m_pendingCrossfadeSamplesCount.load());
+		m_hasPendingDelayChange.store(otherBuffer.m_hasPendingDelayChange.load());
+		BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset.store(otherBuffer.m_readSampleOffset.load());
+		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(otherBuffer.m_writeSampleOffset.load());
+	}
+
+	//Move the read position to the new delay and start the crossfade from the current one
+	void startDelayTransition(size_t delay, size_t crossfadeSamplesCount) noexcept {
+		using BaseView = BasicCircularAudioBufferView<AudioSampleType>;
+		auto previousDelay = m_delayInSamples.load();
+		assert(delay < BaseView::m_bufferSize && previousDelay < BaseView::m_bufferSize);
+		if(delay == previousDelay) {
+			return;
+		}
+
+		auto readShift = previousDelay + BaseView::m_bufferSize - delay;
+		m_indexShift.store((m_indexShift.load() + readShift) % BaseView::m_bufferSize);
+		BaseView::m_readSampleOffset.store((BaseView::m_readSampleOffset.load() + readShift) % BaseView::m_bufferSize);
+		m_previousDelayInSamples.store(previousDelay);
+		m_transitionPosition.store(0);
+		m_transitionSamplesCount.store(crossfadeSamplesCount);
+		updateDelayInSamples(delay);
+	}
+
+	void updateDelayInSamples(size_t delay) noexcept {
+		m_delayInSamples.store(delay);
+		BasicCircularAudioBufferView<AudioSampleType>::m_writeSampleOffset.store(BasicCircularAudioBufferView<AudioSampleType>::m_readSampleOffset + m_delayInSamples);
+	}
+
+	//Longest window of samples copied on the stack for a block crossing the end of the buffer (the block samples, plus the change of the delay and the margins)
+	static constexpr size_t maxWrappedWindowSize = 2 * interpolationBlockSize;
+	static constexpr size_t maxInterpolationTaps = 16;
+
+	template<typename DelayFunction>
+	void interpolateChannel(size_t channel, AudioSampleType* destination, size_t samplesCount, size_t startOffset, InterpolationType interpolation, DelayFunction getDelay) const noexcept {
+		using BaseView = BasicCircularAudioBufferView<AudioSampleType>;
+		assert(channel < BaseView::getChannelsCount());
+		const auto bufferSize = static_cast<std::ptrdiff_t>(BaseView::m_bufferSize);
+		const auto margins = getInterpolationMargins(interpolation);
+		const AudioSampleType* data = BaseView::m_data[BaseView::getMappedChannel(channel)];
+		const auto writeStart = static_cast<std::ptrdiff_t>((BaseView::m_bufferStartOffset + BaseView::m_writeSampleOffset.load(std::memory_order_relaxed) + startOffset) % BaseView::m_bufferSize);
+
+		double positions[interpolationBlockSize];
+		for(size_t blockStart = 0; blockStart < samplesCount; blockStart += interpolationBlockSize) {
+			auto blockSamplesCount = std::min(interpolationBlockSize, samplesCount - blockStart);
+			//Positions relative to writeStart, and the window of samples they need with the margins
+			auto minPosition = std::numeric_limits<double>::max();
+			auto maxPosition = std::numeric_limits<double>::lowest();
+			for(size_t index = 0; index < blockSamplesCount; ++index) {
+				positions[index] = static_cast<double>(blockStart + index) - getDelay(blockStart + index);
+				minPosition = std::min(minPosition, positions[index]);
+				maxPosition = std::max(maxPosition, positions[index]);
+			}
+			auto windowStart = static_cast<std::ptrdiff_t>(std::floor(minPosition)) - static_cast<std::ptrdiff_t>(margins.before);
+			auto windowSize = static_cast<size_t>(static_cast<std::ptrdiff_t>(std::floor(maxPosition)) + static_cast<std::ptrdiff_t>(margins.after) + 1 - windowStart);
+			assert(windowSize <= BaseView::m_bufferSize);
+			for(size_t index = 0; index < blockSamplesCount; ++index) {
+				positions[index] -= static_cast<double>(windowStart);
+			}
+
+			auto windowOffset = static_cast<size_t>(((writeStart + windowStart) % bufferSize + bufferSize) % bufferSize);
+			if(windowOffset + windowSize <= BaseView::m_bufferSize) {
+				AudioKernels<AudioSampleType>::interpolate(destination + blockStart, data + windowOffset, positions, blockSamplesCount, interpolation);
+			} else if(windowSize <= maxWrappedWindowSize) {
+				AudioSampleType window[maxWrappedWindowSize];
+				auto firstPartSize = BaseView::m_bufferSize - windowOffset;
+				std::copy_n(data + windowOffset, firstPartSize, window);
+				std::copy_n(data, windowSize - firstPartSize, window + firstPartSize);
+				AudioKernels<AudioSampleType>::interpolate(destination + blockStart, window, positions, blockSamplesCount, interpolation);
+			} else {
+				//The delay changes too fast for a single window: every sample gets its own
+				AudioSampleType taps[maxInterpolationTaps];
+				auto tapsCount = margins.before + margins.after + 1;
+				for(size_t index = 0; index < blockSamplesCount; ++index) {
+					auto firstTap = static_cast<size_t>(positions[index]) - margins.before;
+					for(size_t tap = 0; tap < tapsCount; ++tap) {
+						taps[tap] = data[(windowOffset + firstTap + tap) % BaseView::m_bufferSize];
+					}
+					auto position = positions[index] - static_cast<double>(firstTap);
+					AudioKernels<AudioSampleType>::interpolate(destination + blockStart + index, taps, &position, 1, interpolation);
+				}
+			}
+		}
+	}
+
 	std::atomic<size_t> m_index;
 	std::atomic<size_t> m_delayInSamples;
+	//Distance of the read position from the index, moved by the crossfaded delay changes
+	std::atomic<size_t> m_indexShift{0};
+	//Delay transition of the crossfaded setDelayInSamples, finished when the position reach the samples count
+	std::atomic<size_t> m_previousDelayInSamples{0};
+	std::atomic<size_t> m_transitionSamplesCount{0};
+	std::atomic<size_t> m_transitionPosition{0};
+	//Crossfaded delay change requested during a transition, started when it ends
+	std::atomic<size_t> m_pendingDelayInSamples{0};
+	std::atomic<size_t> m_pendingCrossfadeSamplesCount{0};
+	std::atomic<bool> m_hasPendingDelayChange{false};
 };
 
 } // engine::showmanager
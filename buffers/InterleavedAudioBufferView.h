@@ -0,0 +1,323 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_INTERLEAVEDAUDIOBUFFERVIEW_H
+#define ABL_INTERLEAVEDAUDIOBUFFERVIEW_H
+
+#include <array>
+#include <numeric>
+
+#include "AudioBufferViewConcepts.h"
+#include "StridedAudioBufferChannelView.h"
+#include "../memory/ParentReferencingIterator.h"
+#include "../kernels/AudioKernels.h"
+#include "../kernels/InterleaveKernels.h"
+
+namespace abl {
+
+//View of interleaved samples (frame after frame, with the samples of all the channels in each frame), like the ones of the sound cards, codecs and network streams.
+//The channels are StridedAudioBufferChannelView. Copying from a buffer with contiguous channels (and to it, with AudioBufferView::copyFrom) use the interleave kernels
+template <NumericType AudioSampleType>
+class InterleavedAudioBufferView {
+public:
+	InterleavedAudioBufferView(AudioSampleType* data, size_t channelsCount, size_t bufferSize, const ChannelsMapping& channelsMapping = {}, size_t bufferStartOffset = 0)
+			: m_data(data),
+			  m_bufferSize(bufferSize),
+			  m_bufferChannelsCount(channelsCount),
+			  m_channelsMapping(channelsMapping),
+			  m_bufferStartOffset{bufferStartOffset} {}
+
+	InterleavedAudioBufferView(const InterleavedAudioBufferView& otherBuffer)
+			: m_data{otherBuffer.m_data},
+			  m_bufferSize {otherBuffer.m_bufferSize},
+			  m_bufferChannelsCount{otherBuffer.m_bufferChannelsCount},
+			  m_channelsMapping{otherBuffer.m_channelsMapping},
+			  m_bufferStartOffset{otherBuffer.m_bufferStartOffset}
+	{}
+
+	InterleavedAudioBufferView(InterleavedAudioBufferView&& otherBuffer) noexcept
+			: m_data{otherBuffer.m_data},
+			  m_bufferSize {otherBuffer.m_bufferSize},
+			  m_bufferChannelsCount{otherBuffer.m_bufferChannelsCount},
+			  m_channelsMapping{otherBuffer.m_channelsMapping},
+			  m_bufferStartOffset{otherBuffer.m_bufferStartOffset}
+	{
+		otherBuffer.m_data = nullptr;
+		otherBuffer.m_bufferSize = 0;
+		otherBuffer.m_bufferChannelsCount = 0;
+		otherBuffer.m_channelsMapping = {};
+		otherBuffer.m_bufferStartOffset = 0;
+	}
+
+	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+	using iterator = ParentReferencingIterator<InterleavedAudioBufferView, StridedAudioBufferChannelView<AudioSampleType>>;
+	iterator begin() { return iterator(0, *this); }
+	iterator end() { return iterator(getChannelsCount(), *this); }
+
+	bool isEmpty() const { return m_bufferChannelsCount < 1 || m_bufferSize < 1 || !m_data; }
+
+	//Return the pointer to the first sample of the frame, with the start offset already applied
+	[[nodiscard]] AudioSampleType* getInterleavedRawData(size_t startFrame = 0) const noexcept {
+		assert(startFrame <= m_bufferSize);
+		return m_data + (m_bufferStartOffset + startFrame) * m_bufferChannelsCount;
+	}
+
+	//Number of samples in every frame (the channels of the memory, not the mapped ones)
+	[[nodiscard]] size_t getFrameChannelsCount() const noexcept { return m_bufferChannelsCount; }
+
+	//True when the channels of the view are all the channels of the frames, in the same order (so the frames can be processed as a single block)
+	[[nodiscard]] bool hasSequentialChannels() const noexcept { return m_channelsMapping.empty(); }
+
+	StridedAudioBufferChannelView<AudioSampleType> operator[](size_t channel) {
+		return getChannelView(channel);
+	}
+
+	const StridedAudioBufferChannelView<AudioSampleType> operator[](size_t channel) const {
+		return getChannelView(channel);
+	}
+
+	StridedAudioBufferChannelView<AudioSampleType> getChannelView(size_t channel, SamplesRange samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+		return getTemporaryRangedChannelView(channel, samplesRange.startSample, samplesCount);
+	}
+
+	InterleavedAudioBufferView<AudioSampleType> getRangedView(SamplesRange samplesRange = {}) {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+		return InterleavedAudioBufferView(m_data, m_bufferChannelsCount, samplesCount, m_channelsMapping, m_bufferStartOffset + samplesRange.startSample);
+	}
+
+	AudioSampleType getSample(size_t channel, size_t index) const {
+		assert(channel < getChannelsCount());
+		assert(index < m_bufferSize);
+		return getInterleavedRawData(index)[getMappedChannel(channel)];
+	}
+
+	void setSample(size_t destinationChannel, size_t destinationIndex, const AudioSampleType sample) {
+		assert(destinationChannel < getChannelsCount());
+		assert(destinationIndex < m_bufferSize);
+		getInterleavedRawData(destinationIndex)[getMappedChannel(destinationChannel)] = sample;
+	}
+
+	void addSample(size_t destinationChannel, size_t destinationIndex, const AudioSampleType sample) {
+		assert(destinationChannel < getChannelsCount());
+		assert(destinationIndex < m_bufferSize);
+		getInterleavedRawData(destinationIndex)[getMappedChannel(destinationChannel)] += sample;
+	}
+
+	void copyFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		assert(destinationSamplesRange.startSample + samplesCount <= m_bufferSize);
+		assert(samplesCount <= sourceBuffer.getBufferSize());
+
+		if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+			if(hasSequentialChannels() && m_bufferChannelsCount <= ChannelsMapping::inlineMappedChannels) {
+				std::array<const AudioSampleType*, ChannelsMapping::inlineMappedChannels> sourceChannels;
+				for(size_t channel = 0; channel < m_bufferChannelsCount; ++channel) {
+					sourceChannels[channel] = sourceBuffer.getChannelRawData(channel);
+				}
+
+				auto destination = getInterleavedRawData(destinationSamplesRange.startSample);
+				InterleaveKernels<AudioSampleType>::interleave(destination, sourceChannels.data(), m_bufferChannelsCount, samplesCount);
+				AudioKernels<AudioSampleType>::applyGain(destination, samplesCount * m_bufferChannelsCount, gain);
+				return;
+			}
+		}
+
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount).copyFrom(sourceBuffer.getChannelView(destinationChannel, SamplesRange(0, samplesCount)), {}, gain);
+		}
+	}
+
+	void copyWithRampFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		if(startGain == endGain) {
+			copyFrom(sourceBuffer, destinationSamplesRange, startGain);
+			return;
+		}
+
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesCount > 0);
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount).copyWithRampFrom(sourceBuffer.getChannelView(destinationChannel, SamplesRange(0, samplesCount)), startGain, endGain);
+		}
+	}
+
+	void copyIntoChannelFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, size_t destinationChannel, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		assert(destinationChannel < getChannelsCount());
+		getTemporaryChannelView(destinationChannel).copyFrom(sourceBufferChannel, destinationSamplesRange, gain);
+	}
+
+	void copyIntoChannelWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, size_t destinationChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		assert(destinationChannel < getChannelsCount());
+		getTemporaryChannelView(destinationChannel).copyWithRampFrom(sourceBufferChannel, startGain, endGain, destinationSamplesRange);
+	}
+
+	void addFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount).addFrom(sourceBuffer.getChannelView(destinationChannel, SamplesRange(0, samplesCount)), {}, gain);
+		}
+	}
+
+	void addWithRampFrom(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		if(startGain == endGain) {
+			addFrom(sourceBuffer, destinationSamplesRange, startGain);
+			return;
+		}
+
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		auto samplesCount = destinationSamplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesCount > 0);
+		for(size_t destinationChannel = 0; destinationChannel < getChannelsCount(); ++destinationChannel) {
+			getTemporaryRangedChannelView(destinationChannel, destinationSamplesRange.startSample, samplesCount).addWithRampFrom(sourceBuffer.getChannelView(destinationChannel, SamplesRange(0, samplesCount)), startGain, endGain);
+		}
+	}
+
+	void addIntoChannelFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, size_t destinationChannel, const SamplesRange &destinationSamplesRange = {}, GainType gain = GainType(1)) {
+		assert(destinationChannel < getChannelsCount());
+		getTemporaryChannelView(destinationChannel).addFrom(sourceBufferChannel, destinationSamplesRange, gain);
+	}
+
+	void addIntoChannelWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, size_t destinationChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		assert(destinationChannel < getChannelsCount());
+		getTemporaryChannelView(destinationChannel).addWithRampFrom(sourceBufferChannel, startGain, endGain, destinationSamplesRange);
+	}
+
+	void applyGain(GainType gain, const SamplesRange &samplesRange = {}) {
+		if(hasSequentialChannels()) {
+			auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+			assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+			AudioKernels<AudioSampleType>::applyGain(getInterleavedRawData(samplesRange.startSample), samplesCount * m_bufferChannelsCount, gain);
+			return;
+		}
+
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			getTemporaryChannelView(channel).applyGain(gain, samplesRange);
+		}
+	}
+
+	void applyGainToChannel(GainType gain, size_t channel, const SamplesRange &samplesRange = {}) {
+		assert(channel < getChannelsCount());
+		getTemporaryChannelView(channel).applyGain(gain, samplesRange);
+	}
+
+	void applyGainRamp(GainType startGain, GainType endGain, const SamplesRange &samplesRange = {}) {
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			getTemporaryChannelView(channel).applyGainRamp(startGain, endGain, samplesRange);
+		}
+	}
+
+	void applyGainRampToChannel(GainType startGain, GainType endGain, size_t channel, const SamplesRange &samplesRange = {}) {
+		assert(channel < getChannelsCount());
+		getTemporaryChannelView(channel).applyGainRamp(startGain, endGain, samplesRange);
+	}
+
+	void clear(const SamplesRange &samplesRange = {}) {
+		if(hasSequentialChannels()) {
+			auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+			assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+			std::fill_n(getInterleavedRawData(samplesRange.startSample), samplesCount * m_bufferChannelsCount, AudioSampleType(0));
+			return;
+		}
+
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			getTemporaryChannelView(channel).clear(samplesRange);
+		}
+	}
+
+	void clearChannel(size_t channel, const SamplesRange &samplesRange = {}) {
+		assert(channel < getChannelsCount());
+		getTemporaryChannelView(channel).clear(samplesRange);
+	}
+
+	void reverse(const SamplesRange &samplesRange = {}) {
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			getTemporaryChannelView(channel).reverse(samplesRange);
+		}
+	}
+
+	void reverseChannel(size_t channel, const SamplesRange &samplesRange = {}) {
+		assert(channel < getChannelsCount());
+		getTemporaryChannelView(channel).reverse(samplesRange);
+	}
+
+	AudioSampleType getHigherPeak(const SamplesRange &samplesRange = {}) const {
+		AudioSampleType higherPeak = 0;
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			higherPeak = std::max(getTemporaryChannelView(channel).getHigherPeak(samplesRange), higherPeak);
+		}
+		return higherPeak;
+	}
+
+	AudioSampleType getHigherPeakForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		return getTemporaryChannelView(channel).getHigherPeak(samplesRange);
+	}
+
+	AudioSampleType getRMSLevelForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		return getTemporaryChannelView(channel).getRMSLevel(samplesRange);
+	}
+
+	//Statistics of the samples of all the channels together, analyzed channel after channel
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange &samplesRange = {}) const {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+			accumulator.process(getInterleavedRawData(samplesRange.startSample) + getMappedChannel(channel), samplesCount, m_bufferChannelsCount);
+		}
+		return accumulator.getStatistics();
+	}
+
+	AudioStatistics<AudioSampleType> getStatisticsForChannel(size_t channel, const SamplesRange &samplesRange = {}) const {
+		assert(channel < getChannelsCount());
+		return getTemporaryChannelView(channel).getStatistics(samplesRange);
+	}
+
+	[[nodiscard]] size_t getBufferSize() const noexcept { return m_bufferSize; }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return !m_channelsMapping.empty() ? m_channelsMapping.size() : m_bufferChannelsCount; }
+
+	[[nodiscard]] const ChannelsMapping& getChannelsMapping() const noexcept { return m_channelsMapping; }
+	void setChannelsMapping(const ChannelsMapping& channelsMapping) { m_channelsMapping = channelsMapping; }
+	void createSequentialChannelsMapping(size_t startChannel, size_t channelsCount) {
+		assert(channelsCount > 0);
+		assert(startChannel < channelsCount);
+		assert(channelsCount <= m_bufferChannelsCount);
+		m_channelsMapping.createSequential(startChannel, channelsCount);
+	}
+
+protected:
+	[[nodiscard]] inline size_t getMappedChannel(size_t channel) const noexcept {
+		if(!m_channelsMapping.empty()) {
+			assert(channel < m_channelsMapping.size());
+			return m_channelsMapping[channel];
+		}
+
+		return channel;
+	}
+
+	[[nodiscard]] inline StridedAudioBufferChannelView<AudioSampleType> getTemporaryChannelView(size_t channel) const {
+		return getTemporaryRangedChannelView(channel, 0, m_bufferSize);
+	}
+
+	[[nodiscard]] inline StridedAudioBufferChannelView<AudioSampleType> getTemporaryRangedChannelView(size_t channel, size_t startOffset, size_t samplesCount) const {
+		assert(startOffset + samplesCount <= m_bufferSize);
+		return StridedAudioBufferChannelView<AudioSampleType>(getInterleavedRawData(startOffset) + getMappedChannel(channel), samplesCount, m_bufferChannelsCount);
+	}
+
+	AudioSampleType* m_data;
+	size_t m_bufferSize = 0;
+	size_t m_bufferChannelsCount = 0;
+	ChannelsMapping m_channelsMapping;
+	size_t m_bufferStartOffset = 0;
+};
+
+} // abl
+
+#endif //ABL_INTERLEAVEDAUDIOBUFFERVIEW_H
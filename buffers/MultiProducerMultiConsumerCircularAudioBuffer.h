@@ -0,0 +1,226 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_MULTIPRODUCERMULTICONSUMERCIRCULARAUDIOBUFFER_H
+#define ABL_MULTIPRODUCERMULTICONSUMERCIRCULARAUDIOBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <cstdint>
+
+#include "CircularAudioBuffer.h"
+#include "../memory/CacheLineSize.h"
+
+namespace abl {
+
+struct MultiProducerMultiConsumerContentionCounters {
+	uint64_t writeRetries = 0; //a writer lost the race for a block and tried again
+	uint64_t readRetries = 0; //a reader lost the race for a block and tried again
+	uint64_t failedWrites = 0; //no free block when a writer asked for one
+	uint64_t failedReads = 0; //no written block when a reader asked for one
+};
+
+//Bounded queue of blocks of singleBufferSize samples, that can be written and read concurrently by more threads.
+//Every block has a sequence number (like in the Dmitry Vyukov bounded MPMC queue) that tells if it's free, being written/read, or ready to be read.
+//The write and read blocks are views over the memory of the circular buffer (zero-copy), the block is published (or freed) when the view is committed or destroyed.
+//The blocks are handed out in order, so a block that is never committed stalls the readers (or the writers) when they reach it
+template <NumericType AudioSampleType, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
+class MultiProducerMultiConsumerCircularAudioBuffer {
+public:
+	template <bool isWriteBlock>
+	class Block {
+	public:
+		Block(const Block&) = delete;
+		Block& operator= (const Block&) = delete;
+
+		Block(Block&& otherBlock) noexcept
+			: m_parentBuffer{otherBlock.m_parentBuffer}, m_position{otherBlock.m_position}, m_view{std::move(otherBlock.m_view)}
+		{
+			otherBlock.m_parentBuffer = nullptr;
+		}
+
+		Block& operator= (Block&&) = delete;
+
+		~Block() { commit(); }
+
+		AudioBufferView<AudioSampleType>& getView() noexcept { return m_view; }
+		const AudioBufferView<AudioSampleType>& getView() const noexcept { return m_view; }
+		AudioBufferView<AudioSampleType>* operator->() noexcept { return &m_view; }
+		const AudioBufferView<AudioSampleType>* operator->() const noexcept { return &m_view; }
+
+		//Publish the written block to the readers (or give back the read block to the writers). The view must not be used after this call
+		void commit() noexcept {
+			if(m_parentBuffer) {
+				if constexpr (isWriteBlock) {
+					m_parentBuffer->commitWriteBlock(m_position);
+				} else {
+					m_parentBuffer->commitReadBlock(m_position);
+				}
+				m_parentBuffer = nullptr;
+			}
+		}
+
+		[[nodiscard]] bool isCommitted() const noexcept { return m_parentBuffer == nullptr; }
+
+	private:
+		friend class MultiProducerMultiConsumerCircularAudioBuffer;
+
+		Block(MultiProducerMultiConsumerCircularAudioBuffer* parentBuffer, size_t position, AudioBufferView<AudioSampleType>&& view) noexcept
+			: m_parentBuffer{parentBuffer}, m_position{position}, m_view{std::move(view)} {}
+
+		MultiProducerMultiConsumerCircularAudioBuffer* m_parentBuffer;
+		size_t m_position;
+		AudioBufferView<AudioSampleType> m_view;
+	};
+
+	using WriteBlock = Block<true>;
+	using ReadBlock = Block<false>;
+	using GainType = typename CircularAudioBuffer<AudioSampleType, Allocator>::GainType;
+
+	explicit MultiProducerMultiConsumerCircularAudioBuffer(size_t blocksCount, size_t singleBufferSize, size_t channelsCount = 2, const Allocator& allocator = Allocator())
+		: m_buffer{blocksCount * singleBufferSize, singleBufferSize, channelsCount, 0, {}, 0, 0, allocator},
+		  m_blocksCount{blocksCount},
+		  m_blocksSequence{std::make_unique<BlockSequence[]>(blocksCount)}
+	{
+		assert(blocksCount > 0);
+		assert(singleBufferSize > 0);
+		for(size_t block = 0; block < blocksCount; ++block) {
+			m_blocksSequence[block].sequence.store(block, std::memory_order_relaxed);
+		}
+	}
+
+	MultiProducerMultiConsumerCircularAudioBuffer(const MultiProducerMultiConsumerCircularAudioBuffer&) = delete;
+	MultiProducerMultiConsumerCircularAudioBuffer& operator= (const MultiProducerMultiConsumerCircularAudioBuffer&) = delete;
+
+	//Reserve the next free block for writing. Return an empty optional if all the blocks are full (or being read)
+	[[nodiscard]] std::optional<WriteBlock> tryAcquireWriteBlock() {
+		auto position = acquirePosition(m_writePosition, 0, m_writeRetries, m_failedWrites);
+		if(!position.has_value()) {
+			return {};
+		}
+		return WriteBlock(this, position.value(), getBlockView(position.value()));
+	}
+
+	//Reserve the next written block for reading. Return an empty optional if no block has been written (or committed) yet
+	[[nodiscard]] std::optional<ReadBlock> tryAcquireReadBlock() {
+		auto position = acquirePosition(m_readPosition, 1, m_readRetries, m_failedReads);
+		if(!position.has_value()) {
+			return {};
+		}
+		return ReadBlock(this, position.value(), getBlockView(position.value()));
+	}
+
+	//Copy the source in a free block and publish it. If the source is shorter than a block, the remaining samples are cleared
+	bool tryWrite(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, GainType gain = 1) {
+		assert(sourceBuffer.getBufferSize() <= getSingleBufferSize());
+		auto block = tryAcquireWriteBlock();
+		if(!block.has_value()) {
+			return false;
+		}
+
+		auto& view = block->getView();
+		auto samplesCount = std::min(sourceBuffer.getBufferSize(), view.getBufferSize());
+		view.copyFrom(sourceBuffer, SamplesRange(0, static_cast<int>(samplesCount)), gain);
+		if(samplesCount < view.getBufferSize()) {
+			view.clear(SamplesRange(samplesCount));
+		}
+		return true;
+	}
+
+	//Copy the next written block in the destination and free it
+	bool tryRead(AudioBufferType<AudioSampleType> auto &destinationBuffer) {
+		assert(destinationBuffer.getChannelsCount() <= getChannelsCount());
+		auto block = tryAcquireReadBlock();
+		if(!block.has_value()) {
+			return false;
+		}
+
+		auto samplesCount = std::min(destinationBuffer.getBufferSize(), getSingleBufferSize());
+		destinationBuffer.copyFrom(block->getView(), SamplesRange(0, static_cast<int>(samplesCount)));
+		return true;
+	}
+
+	//Snapshot of the counters, incremented (with relaxed atomics) only when a thread doesn't get a block at the first try
+	[[nodiscard]] MultiProducerMultiConsumerContentionCounters getContentionCounters() const noexcept {
+		return {
+			m_writeRetries.load(std::memory_order_relaxed),
+			m_readRetries.load(std::memory_order_relaxed),
+			m_failedWrites.load(std::memory_order_relaxed),
+			m_failedReads.load(std::memory_order_relaxed)
+		};
+	}
+
+	void resetContentionCounters() noexcept {
+		m_writeRetries.store(0, std::memory_order_relaxed);
+		m_readRetries.store(0, std::memory_order_relaxed);
+		m_failedWrites.store(0, std::memory_order_relaxed);
+		m_failedReads.store(0, std::memory_order_relaxed);
+	}
+
+	//Approximated when other threads are writing or reading (the blocks acquired but not committed yet are counted)
+	[[nodiscard]] size_t getWrittenBlocksCount() const noexcept {
+		auto readPosition = m_readPosition.load(std::memory_order_acquire);
+		auto writePosition = m_writePosition.load(std::memory_order_acquire);
+		return writePosition > readPosition ? std::min(writePosition - readPosition, m_blocksCount) : 0;
+	}
+
+	[[nodiscard]] size_t getBlocksCount() const noexcept { return m_blocksCount; }
+	[[nodiscard]] size_t getSingleBufferSize() const noexcept { return m_buffer.getBufferSize(); }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return m_buffer.getChannelsCount(); }
+
+private:
+	struct alignas(cacheLineSize) BlockSequence {
+		std::atomic<size_t> sequence;
+	};
+
+	//A block at position is free for writing when his sequence is position, ready for reading when his sequence is position + 1
+	std::optional<size_t> acquirePosition(std::atomic<size_t>& sharedPosition, size_t sequenceOffset, std::atomic<uint64_t>& retries, std::atomic<uint64_t>& failures) noexcept {
+		auto position = sharedPosition.load(std::memory_order_relaxed);
+		while(true) {
+			auto sequence = m_blocksSequence[position % m_blocksCount].sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + sequenceOffset);
+			if(difference == 0) {
+				if(sharedPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					return position;
+				}
+				retries.fetch_add(1, std::memory_order_relaxed);
+			} else if(difference < 0) {
+				failures.fetch_add(1, std::memory_order_relaxed);
+				return {};
+			} else {
+				position = sharedPosition.load(std::memory_order_relaxed);
+				retries.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void commitWriteBlock(size_t position) noexcept {
+		m_blocksSequence[position % m_blocksCount].sequence.store(position + 1, std::memory_order_release);
+	}
+
+	void commitReadBlock(size_t position) noexcept {
+		m_blocksSequence[position % m_blocksCount].sequence.store(position + m_blocksCount, std::memory_order_release);
+	}
+
+	AudioBufferView<AudioSampleType> getBlockView(size_t position) const {
+		return m_buffer.getContiguousView((position % m_blocksCount) * m_buffer.getBufferSize(), m_buffer.getBufferSize());
+	}
+
+	//The circular buffer indexes aren't used, only his memory (divided in blocksCount blocks)
+	CircularAudioBuffer<AudioSampleType, Allocator> m_buffer;
+	const size_t m_blocksCount;
+	std::unique_ptr<BlockSequence[]> m_blocksSequence;
+
+	alignas(cacheLineSize) std::atomic<size_t> m_writePosition{0};
+	alignas(cacheLineSize) std::atomic<size_t> m_readPosition{0};
+
+	alignas(cacheLineSize) std::atomic<uint64_t> m_writeRetries{0};
+	std::atomic<uint64_t> m_failedWrites{0};
+	alignas(cacheLineSize) std::atomic<uint64_t> m_readRetries{0};
+	std::atomic<uint64_t> m_failedReads{0};
+};
+
+} // abl
+
+#endif //ABL_MULTIPRODUCERMULTICONSUMERCIRCULARAUDIOBUFFER_H
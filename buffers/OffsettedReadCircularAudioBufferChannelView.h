@@ -8,9 +8,9 @@
 #include <span>
 
 #include "AudioBufferChannelViewConcepts.h"
-#include "../memory/GenericPointerIterator.h"
-#include "../memory/CircularIterator.h"
-#include "../memory/VariantRandomAccessIteratorWrapper.h"
+#include "../analysis/AudioStatistics.h"
+#include "../memory/SegmentedIterator.h"
+#include "../kernels/AudioKernels.h"
 
 namespace abl {
 
@@ -62,13 +62,13 @@ public:
 	}
 
 	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
-	using iterator = CircularIterator<AudioSampleType>;
-	using const_iterator = const CircularIterator<AudioSampleType>;
-	using wrapperIterator = VariantRandomAccessIteratorWrapper<AudioSampleType, GenericPointerIterator<AudioSampleType>, CircularIterator<AudioSampleType>>;
-	wrapperIterator begin() const noexcept { return wrapperIterator(const_iterator(m_data, m_data + m_bufferSize, m_data + m_readStartOffset, 0)); }
-	wrapperIterator end() const noexcept { return wrapperIterator(const_iterator(m_data, m_data + m_bufferSize, m_data + m_lastReadSampleIndex + 1, m_singleBufferSize)); }
-	wrapperIterator writeBegin() const noexcept { return wrapperIterator(iterator(m_data, m_data + m_bufferSize, m_data + m_writeStartOffset, 0)); }
-	wrapperIterator writeEnd() const noexcept { return wrapperIterator(iterator(m_data, m_data + m_bufferSize, m_data + m_lastWriteSampleIndex + 1, m_singleBufferSize)); }
+	using iterator = SegmentedIterator<AudioSampleType>;
+	using const_iterator = const SegmentedIterator<AudioSampleType>;
+	using wrapperIterator = SegmentedIterator<AudioSampleType>;
+	wrapperIterator begin() const noexcept { return wrapperIterator(getReadSpans(), 0); }
+	wrapperIterator end() const noexcept { auto spans = getReadSpans(); return wrapperIterator(spans, spans.size()); }
+	wrapperIterator writeBegin() const noexcept { return wrapperIterator(getWriteSpans(), 0); }
+	wrapperIterator writeEnd() const noexcept { auto spans = getWriteSpans(); return wrapperIterator(spans, spans.size()); }
 
 	bool isEmpty() { return m_bufferSize < 1 || m_singleBufferSize < 1 || !m_data; }
 
@@ -97,8 +97,14 @@ public:
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		assert(destinationSamplesRange.startSample + samplesCount <= m_singleBufferSize);
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			setSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * gain);
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [gain](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t) {
+				AudioKernels<AudioSampleType>::copy(destination, source, partSamplesCount, gain);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				setSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * gain);
+			}
 		}
 	}
 
@@ -112,11 +118,15 @@ public:
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		assert(destinationSamplesRange.startSample + samplesCount <= m_singleBufferSize);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			setSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * currentGain);
-			currentGain += baseGainIncrement;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [startGain, baseGainIncrement](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+				AudioKernels<AudioSampleType>::copyWithRamp(destination, source, partSamplesCount, startGain + static_cast<GainType>(processedSamplesCount) * baseGainIncrement, baseGainIncrement);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				setSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+			}
 		}
 	}
 
@@ -125,14 +135,20 @@ public:
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		assert(destinationSamplesRange.startSample + samplesCount <= m_singleBufferSize);
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			addSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * gain);
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [gain](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t) {
+				AudioKernels<AudioSampleType>::add(destination, source, partSamplesCount, gain);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				addSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * gain);
+			}
 		}
 	}
 
 	void addWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange) {
 		if(startGain == endGain) {
-			copyFrom(sourceBufferChannel, destinationSamplesRange, startGain);
+			addFrom(sourceBufferChannel, destinationSamplesRange, startGain);
 			return;
 		}
 
@@ -140,20 +156,23 @@ public:
 		assert(samplesCount <= sourceBufferChannel.getBufferSize());
 		assert(destinationSamplesRange.startSample + samplesCount <= m_singleBufferSize);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
 
-		for(size_t index = 0; index < samplesCount; ++index) {
-			addSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * currentGain);
-			currentGain += baseGainIncrement;
+		if constexpr (AudioBufferChannelSpansReadableType<std::remove_cvref_t<decltype(sourceBufferChannel)>, AudioSampleType>) {
+			forEachContiguousPart(getWriteSpans(destinationSamplesRange), sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [startGain, baseGainIncrement](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+				AudioKernels<AudioSampleType>::addWithRamp(destination, source, partSamplesCount, startGain + static_cast<GainType>(processedSamplesCount) * baseGainIncrement, baseGainIncrement);
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				addSample(index + destinationSamplesRange.startSample, sourceBufferChannel.getSample(index) * (startGain + static_cast<GainType>(index) * baseGainIncrement));
+			}
 		}
 	}
 
 	void applyGain(GainType gain, const SamplesRange& samplesRange) noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
-		for(size_t index = 0; index < samplesCount; ++index) {
-			setSample(index + samplesRange.startSample, getSample(index + samplesRange.startSample) * gain);
-		}
+		assert(samplesRange.startSample + getSamplesCountFromRange(samplesRange) <= m_singleBufferSize);
+		forEachContiguousPart(getWriteSpans(samplesRange), getReadSpans(samplesRange), [gain](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t) {
+			AudioKernels<AudioSampleType>::copy(destination, source, partSamplesCount, gain);
+		});
 	}
 
 	void applyGainRamp(GainType startGain, GainType endGain, const SamplesRange& samplesRange) noexcept {
@@ -165,65 +184,49 @@ public:
 		auto samplesCount = getSamplesCountFromRange(samplesRange);
 		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
 		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
-		GainType currentGain = startGain;
-
-		for(size_t index = 0; index < samplesCount; ++index) {
-			setSample(index + samplesRange.startSample, getSample(index + samplesRange.startSample) * currentGain);
-			currentGain += baseGainIncrement;
-		}
+		forEachContiguousPart(getWriteSpans(samplesRange), getReadSpans(samplesRange), [startGain, baseGainIncrement](AudioSampleType* destination, AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+			AudioKernels<AudioSampleType>::copyWithRamp(destination, source, partSamplesCount, startGain + static_cast<GainType>(processedSamplesCount) * baseGainIncrement, baseGainIncrement);
+		});
 	}
 
 	void clear(const SamplesRange& samplesRange = SamplesRange::allSamples()) noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
-		for(size_t index = 0; index < samplesCount; ++index) {
-			setSample(index + samplesRange.startSample, 0);
-		}
+		assert(samplesRange.startSample + getSamplesCountFromRange(samplesRange) <= m_singleBufferSize);
+		forEachContiguousPart(getWriteSpans(samplesRange), [](AudioSampleType* data, size_t partSamplesCount, size_t) {
+			std::fill_n(data, partSamplesCount, AudioSampleType(0));
+		});
 	}
 
 	void clearContainerBuffer() noexcept {
-		for(size_t index = 0; index < m_bufferSize; ++index) {
-			m_data[index] = 0;
-		}
+		std::fill_n(m_data, m_bufferSize, AudioSampleType(0));
 	}
 
 	void reverse(const SamplesRange& samplesRange) noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
-		std::reverse(writeBegin() + samplesRange.startSample, writeBegin() + (samplesRange.startSample + samplesCount));
+		assert(samplesRange.startSample + getSamplesCountFromRange(samplesRange) <= m_singleBufferSize);
+		reverseCircularSpans(getWriteSpans(samplesRange));
 	}
 
-	AudioSampleType getHigherPeak(const SamplesRange& samplesRange) const noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
-		auto startSample = samplesRange.startSample + m_readStartOffset;
-		AudioSampleType higherElement = 0;
-		if(startSample > m_bufferSize) {
-			startSample -= m_bufferSize;
-		} else if(startSample + samplesCount > m_bufferSize) {
-			higherElement = *std::max_element(m_data + startSample, m_data + m_bufferSize, [](AudioSampleType a, AudioSampleType b) { return std::abs(a) < std::abs(b); });
-			samplesCount -= m_bufferSize - startSample;
-			startSample = 0;
-		}
+	//Peak, min/max, RMS, DC offset and crest factor of the range in a single pass of the SIMD kernels over its (at most two) contiguous parts
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange& samplesRange) const noexcept {
+		assert(samplesRange.startSample + getSamplesCountFromRange(samplesRange) <= m_singleBufferSize);
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		accumulator.process(getReadSpans(samplesRange));
+		return accumulator.getStatistics();
+	}
 
-		return std::max(higherElement, *std::max_element(m_data + startSample, m_data + startSample + samplesCount, [](AudioSampleType a, AudioSampleType b) { return std::abs(a) < std::abs(b); }));
+	AudioSampleType getHigherPeak(const SamplesRange& samplesRange) const noexcept {
+		return getStatistics(samplesRange).peak;
 	}
 
 	AudioSampleType getRMSLevel(const SamplesRange& samplesRange) const noexcept {
-		auto samplesCount = getSamplesCountFromRange(samplesRange);
-		assert(samplesRange.startSample + samplesCount <= m_singleBufferSize);
-		auto startSample = samplesRange.startSample + m_readStartOffset;
-		auto remainingSamplesCount = samplesCount;
-		AudioSampleType accumulator = 0;
-		if(startSample > m_bufferSize) {
-			startSample -= m_bufferSize;
-		} else if(startSample + samplesCount > m_bufferSize) {
-			accumulator = std::accumulate(m_data + startSample, m_data + m_bufferSize, AudioSampleType(0));
-			remainingSamplesCount -= m_bufferSize - startSample;
-			startSample = 0;
-		}
+		return static_cast<AudioSampleType>(getStatistics(samplesRange).rms);
+	}
+
+	[[nodiscard]] CircularSpans<AudioSampleType> getReadSpans(const SamplesRange& samplesRange = {}) const noexcept {
+		return CircularSpans<AudioSampleType>(m_data, m_bufferSize, m_readStartOffset + samplesRange.startSample, getSamplesCountFromRange(samplesRange));
+	}
 
-		return std::accumulate(m_data + startSample, m_data + startSample + remainingSamplesCount, accumulator) / samplesCount;
+	[[nodiscard]] CircularSpans<AudioSampleType> getWriteSpans(const SamplesRange& samplesRange = {}) const noexcept {
+		return CircularSpans<AudioSampleType>(m_data, m_bufferSize, m_writeStartOffset + samplesRange.startSample, getSamplesCountFromRange(samplesRange));
 	}
 
 	[[nodiscard]] size_t getBufferSize() const noexcept { return m_singleBufferSize; }
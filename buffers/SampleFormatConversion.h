@@ -0,0 +1,82 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SAMPLEFORMATCONVERSION_H
+#define ABL_SAMPLEFORMATCONVERSION_H
+
+#include <algorithm>
+
+#include "AudioBufferView.h"
+#include "../kernels/SampleFormatKernels.h"
+
+namespace abl {
+
+struct SampleFormatConversionOptions {
+	//Bits used by the integral samples (for example 24 for the 24 bits samples stored in int32), 0 to use all the bits of the type
+	size_t sourceSignificantBits = 0;
+	size_t destinationSignificantBits = 0;
+	//Dither added when the destination samples are integral, nullptr to only round them
+	TpdfDither* dither = nullptr;
+};
+
+namespace sampleFormat {
+
+template<NumericType SampleType>
+size_t getSignificantBits(size_t significantBits) noexcept {
+	if constexpr (std::is_integral_v<SampleType>) {
+		assert(significantBits <= sizeof(SampleType) * 8);
+		return significantBits != 0 ? significantBits : sizeof(SampleType) * 8;
+	} else {
+		return 0;
+	}
+}
+
+//Convert a single channel. The integral to integral conversions pass through blocks of double samples on the stack, that are exact for all the integral types up to 32 bits
+template<NumericType DestinationSampleType, NumericType SourceSampleType>
+void convertChannel(DestinationSampleType* destination, const SourceSampleType* source, size_t samplesCount, size_t sourceBits, size_t destinationBits, TpdfDither* dither) noexcept {
+	if constexpr (std::is_floating_point_v<DestinationSampleType> && std::is_floating_point_v<SourceSampleType>) {
+		std::copy_n(source, samplesCount, destination);
+	} else if constexpr (std::is_floating_point_v<DestinationSampleType>) {
+		SampleFormatKernels<DestinationSampleType, SourceSampleType>::toFloating(destination, source, samplesCount, sourceBits);
+	} else if constexpr (std::is_floating_point_v<SourceSampleType>) {
+		SampleFormatKernels<SourceSampleType, DestinationSampleType>::toIntegral(destination, source, samplesCount, destinationBits, dither);
+	} else {
+		constexpr size_t blockSize = 256;
+		double block[blockSize];
+		for(size_t startSample = 0; startSample < samplesCount; startSample += blockSize) {
+			auto blockSamplesCount = std::min(blockSize, samplesCount - startSample);
+			SampleFormatKernels<double, SourceSampleType>::toFloating(block, source + startSample, blockSamplesCount, sourceBits);
+			SampleFormatKernels<double, DestinationSampleType>::toIntegral(destination + startSample, block, blockSamplesCount, destinationBits, destinationBits < sourceBits ? dither : nullptr);
+		}
+	}
+}
+
+} // sampleFormat
+
+//Copy the samples of the source buffer in the destination buffer converting their format, with the integral samples normalized to [-1, 1) of their full scale.
+//The floating samples converted to integral are rounded to the nearest value (after adding the dither, when given) and clipped to the full scale
+template<NumericType DestinationSampleType, NumericType SourceSampleType>
+void convertSampleFormat(AudioBufferView<DestinationSampleType>& destinationBuffer, const AudioBufferView<SourceSampleType>& sourceBuffer, const SamplesRange& destinationSamplesRange = {}, const SampleFormatConversionOptions& options = {}) {
+	assert(sourceBuffer.getChannelsCount() >= destinationBuffer.getChannelsCount());
+	auto samplesCount = destinationSamplesRange.getRealSamplesCount(destinationBuffer.getBufferSize());
+	assert(destinationSamplesRange.startSample + samplesCount <= destinationBuffer.getBufferSize());
+	assert(samplesCount <= sourceBuffer.getBufferSize());
+
+	auto sourceBits = sampleFormat::getSignificantBits<SourceSampleType>(options.sourceSignificantBits);
+	auto destinationBits = sampleFormat::getSignificantBits<DestinationSampleType>(options.destinationSignificantBits);
+	for(size_t channel = 0; channel < destinationBuffer.getChannelsCount(); ++channel) {
+		auto destination = destinationBuffer.getChannelRawData(channel, destinationSamplesRange.startSample);
+		auto source = sourceBuffer.getChannelRawData(channel);
+		if constexpr (std::is_same_v<DestinationSampleType, SourceSampleType>) {
+			if(sourceBits == destinationBits) {
+				AudioKernels<DestinationSampleType>::copy(destination, source, samplesCount);
+				continue;
+			}
+		}
+		sampleFormat::convertChannel(destination, source, samplesCount, sourceBits, destinationBits, options.dither);
+	}
+}
+
+} // abl
+
+#endif //ABL_SAMPLEFORMATCONVERSION_H
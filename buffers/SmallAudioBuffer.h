@@ -0,0 +1,221 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SMALLAUDIOBUFFER_H
+#define ABL_SMALLAUDIOBUFFER_H
+
+#include "AudioBufferView.h"
+#include "AudioBufferWithMemoryManagement.h"
+
+namespace abl {
+
+//Owning buffer that keep up to maxChannels x maxSamples samples inside the object itself (like the small string optimization),
+//so the scratch buffers created in the audio callback don't touch the heap.
+//Only when it's created or resized bigger than that the space is allocated with the allocator.
+template <NumericType AudioSampleType, size_t maxChannels, size_t maxSamples, Contiguous2DArrayAllocatorType<AudioSampleType> Allocator = DefaultContiguous2DArrayAllocator>
+class SmallAudioBuffer : public AudioBufferWithMemoryManagement<AudioSampleType, Allocator>, public AudioBufferView<AudioSampleType> {
+public:
+	using MemoryManagement = AudioBufferWithMemoryManagement<AudioSampleType, Allocator>;
+
+	static_assert(maxChannels > 0 && maxSamples > 0);
+
+	explicit SmallAudioBuffer(size_t bufferSize, size_t channelsCount = 2, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), AudioBufferView<AudioSampleType>(fitsInlineStorage(channelsCount, bufferSize) ? m_inlineData : MemoryManagement::allocateSpace(channelsCount, bufferSize), channelsCount, bufferSize, channelsMapping)
+	{
+		prepareInlineStorage();
+		if(isUsingInlineStorage()) {
+			clearInlineStorage(0, channelsCount, 0, bufferSize);
+		}
+	}
+
+	explicit SmallAudioBuffer(AudioSampleType **sourceData, size_t channelsCount, size_t bufferSize, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: MemoryManagement(allocator), AudioBufferView<AudioSampleType>(fitsInlineStorage(channelsCount, bufferSize) ? m_inlineData : MemoryManagement::allocateSpace(channelsCount, bufferSize, false), channelsCount, bufferSize, channelsMapping)
+	{
+		prepareInlineStorage();
+		copyData(sourceData, channelsCount, bufferSize);
+	}
+
+	explicit SmallAudioBuffer(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, const ChannelsMapping& channelsMapping = {}, const Allocator& allocator = Allocator())
+		: SmallAudioBuffer(sourceBuffer.getBufferSize(), sourceBuffer.getChannelsCount(), channelsMapping, allocator)
+	{
+		if(!sourceBuffer.isEmpty()) {
+			for(size_t channel = 0; channel < sourceBuffer.getChannelsCount(); ++channel) {
+				for(size_t i = 0; i < sourceBuffer.getBufferSize(); ++i) {
+					AudioBufferView<AudioSampleType>::m_data[channel][i] = sourceBuffer.getSample(channel, i);
+				}
+			}
+		}
+	}
+
+	SmallAudioBuffer(const SmallAudioBuffer &otherBuffer)
+		: MemoryManagement(otherBuffer.m_allocator), AudioBufferView<AudioSampleType>(fitsInlineStorage(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize) ? m_inlineData : MemoryManagement::allocateSpace(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, false), otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.m_channelsMapping)
+	{
+		prepareInlineStorage();
+		copyData(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize);
+	}
+
+	SmallAudioBuffer& operator= (const SmallAudioBuffer &otherBuffer) {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
+		resize(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, false, false);
+		copyData(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize);
+		AudioBufferView<AudioSampleType>::m_channelsMapping = otherBuffer.m_channelsMapping;
+		return *this;
+	}
+
+	//The inline samples can't be stolen, so they are copied. The allocated ones are moved as in AudioBuffer
+	SmallAudioBuffer(SmallAudioBuffer&& otherBuffer) noexcept
+		: MemoryManagement(otherBuffer.m_allocator), AudioBufferView<AudioSampleType>(otherBuffer.isUsingInlineStorage() ? m_inlineData : otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, otherBuffer.m_channelsMapping)
+	{
+		prepareInlineStorage();
+		if(otherBuffer.isUsingInlineStorage()) {
+			copyData(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize);
+		}
+		otherBuffer.m_data = otherBuffer.m_inlineData;
+		otherBuffer.m_bufferSize = 0;
+		otherBuffer.m_bufferChannelsCount = 0;
+		otherBuffer.m_channelsMapping = {};
+	}
+
+	SmallAudioBuffer& operator= (SmallAudioBuffer&& otherBuffer) noexcept {
+		if(this == &otherBuffer) {
+			return *this;
+		}
+
+		if(otherBuffer.isUsingInlineStorage()) {
+			resize(otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize, false, false);
+			copyData(otherBuffer.m_data, otherBuffer.m_bufferChannelsCount, otherBuffer.m_bufferSize);
+		} else {
+			//The old data is released with the current allocator, the moved data will be released with the allocator that created it
+			AudioBufferView<AudioSampleType>::m_bufferChannelsCount = otherBuffer.m_bufferChannelsCount;
+			AudioBufferView<AudioSampleType>::m_bufferSize = otherBuffer.m_bufferSize;
+			setInternalData(otherBuffer.m_data);
+			MemoryManagement::m_allocator = otherBuffer.m_allocator;
+		}
+
+		AudioBufferView<AudioSampleType>::m_channelsMapping = std::move(otherBuffer.m_channelsMapping);
+		otherBuffer.m_data = otherBuffer.m_inlineData;
+		otherBuffer.m_bufferSize = 0;
+		otherBuffer.m_bufferChannelsCount = 0;
+		otherBuffer.m_channelsMapping = {};
+		return *this;
+	}
+
+	virtual ~SmallAudioBuffer() {
+		setInternalData(nullptr);
+	};
+
+	//Inside the inline storage the channels never move, so resizing only clear the samples as requested.
+	//Going out of the inline storage (or back into it) copy the content like a reallocation
+	void resize(size_t channelsCount, size_t bufferSize, bool keepExistingContent = false, bool clearExtraSpace = true, bool avoidReallocating = false) override {
+		auto currentChannelsCount = AudioBufferView<AudioSampleType>::m_bufferChannelsCount;
+		auto currentBufferSize = AudioBufferView<AudioSampleType>::m_bufferSize;
+		if(channelsCount == currentChannelsCount && bufferSize == currentBufferSize) {
+			return;
+		}
+
+		if(fitsInlineStorage(channelsCount, bufferSize)) {
+			if(isUsingInlineStorage()) {
+				if(!keepExistingContent) {
+					clearInlineStorage(0, channelsCount, 0, bufferSize);
+				} else if(clearExtraSpace) {
+					clearInlineStorage(0, std::min(channelsCount, currentChannelsCount), currentBufferSize, bufferSize);
+					clearInlineStorage(currentChannelsCount, channelsCount, 0, bufferSize);
+				}
+			} else {
+				if(keepExistingContent) {
+					auto copiedChannelsCount = std::min(channelsCount, currentChannelsCount);
+					auto copiedSamplesCount = std::min(bufferSize, currentBufferSize);
+					for(size_t channel = 0; channel < copiedChannelsCount; ++channel) {
+						std::copy(AudioBufferView<AudioSampleType>::m_data[channel], AudioBufferView<AudioSampleType>::m_data[channel] + copiedSamplesCount, m_inlineData[channel]);
+					}
+					if(clearExtraSpace) {
+						clearInlineStorage(0, copiedChannelsCount, copiedSamplesCount, bufferSize);
+						clearInlineStorage(copiedChannelsCount, channelsCount, 0, bufferSize);
+					}
+				} else {
+					clearInlineStorage(0, channelsCount, 0, bufferSize);
+				}
+				setInternalData(m_inlineData);
+			}
+		} else if(isUsingInlineStorage()) {
+			auto newData = MemoryManagement::allocateSpace(channelsCount, bufferSize, !keepExistingContent || clearExtraSpace);
+			if(keepExistingContent) {
+				for(size_t channel = 0; channel < std::min(channelsCount, currentChannelsCount); ++channel) {
+					std::copy(m_inlineData[channel], m_inlineData[channel] + std::min(bufferSize, currentBufferSize), newData[channel]);
+				}
+			}
+			setInternalData(newData);
+		} else {
+			MemoryManagement::doResize(channelsCount, bufferSize, keepExistingContent, clearExtraSpace, avoidReallocating,
+									   currentChannelsCount, currentBufferSize, AudioBufferView<AudioSampleType>::m_data);
+		}
+
+		AudioBufferView<AudioSampleType>::m_bufferChannelsCount = channelsCount;
+		AudioBufferView<AudioSampleType>::m_bufferSize = bufferSize;
+	}
+
+	[[nodiscard]] bool isUsingInlineStorage() const noexcept { return AudioBufferView<AudioSampleType>::m_data == m_inlineData; }
+
+	[[nodiscard]] static constexpr size_t getMaxInlineChannelsCount() noexcept { return maxChannels; }
+	[[nodiscard]] static constexpr size_t getMaxInlineBufferSize() noexcept { return maxSamples; }
+
+protected:
+	AudioSampleType** prepareAllocatedSpace(size_t channelsCount, size_t bufferSize, bool zeroData = true) override {
+		if(fitsInlineStorage(channelsCount, bufferSize)) {
+			if(zeroData) {
+				clearInlineStorage(0, channelsCount, 0, bufferSize);
+			}
+			return m_inlineData;
+		}
+
+		return MemoryManagement::allocateSpace(channelsCount, bufferSize, zeroData);
+	}
+
+	void setInternalData(AudioSampleType** newData, bool deleteOld = true) override {
+		if(deleteOld && AudioBufferView<AudioSampleType>::m_data && !isUsingInlineStorage()) {
+			MemoryManagement::deallocateSpace(AudioBufferView<AudioSampleType>::m_data);
+		}
+		//The empty buffers point to the inline storage, so there's never a null data to check
+		AudioBufferView<AudioSampleType>::m_data = newData ? newData : m_inlineData;
+	}
+
+private:
+	//The inline channels use the same rows padding of the default allocator, to keep them aligned and out of the 4K aliasing
+	static constexpr size_t inlineRowStride = DefaultContiguous2DArrayAllocator::getRowStride<AudioSampleType>(maxSamples);
+
+	static constexpr bool fitsInlineStorage(size_t channelsCount, size_t bufferSize) noexcept {
+		return channelsCount <= maxChannels && bufferSize <= maxSamples;
+	}
+
+	void prepareInlineStorage() noexcept {
+		for(size_t channel = 0; channel < maxChannels; ++channel) {
+			m_inlineData[channel] = m_inlineSamples + channel * inlineRowStride;
+		}
+	}
+
+	void clearInlineStorage(size_t startChannel, size_t endChannel, size_t startSample, size_t endSample) noexcept {
+		for(size_t channel = startChannel; channel < endChannel; ++channel) {
+			std::fill(m_inlineData[channel] + startSample, m_inlineData[channel] + std::max(startSample, endSample), AudioSampleType(0));
+		}
+	}
+
+	void copyData(AudioSampleType* const* sourceData, size_t channelsCount, size_t bufferSize) {
+		if(channelsCount < 1 || bufferSize < 1) {
+			return;
+		}
+
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			std::copy(sourceData[channel], sourceData[channel] + bufferSize, AudioBufferView<AudioSampleType>::m_data[channel]);
+		}
+	}
+
+	alignas(64) AudioSampleType m_inlineSamples[maxChannels * inlineRowStride];
+	AudioSampleType* m_inlineData[maxChannels];
+};
+
+} // abl
+
+#endif //ABL_SMALLAUDIOBUFFER_H
@@ -0,0 +1,198 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_STRIDEDAUDIOBUFFERCHANNELVIEW_H
+#define ABL_STRIDEDAUDIOBUFFERCHANNELVIEW_H
+
+#include <cmath>
+#include <numeric>
+
+#include "AudioBufferChannelViewConcepts.h"
+#include "../analysis/AudioStatistics.h"
+#include "../memory/StridedIterator.h"
+
+namespace abl {
+
+//View of a channel inside interleaved frames: the sample at index is at data[index * stride]
+template <NumericType AudioSampleType>
+class StridedAudioBufferChannelView {
+public:
+	StridedAudioBufferChannelView(AudioSampleType* data, size_t bufferSize, size_t stride) : m_data(data), m_bufferSize(bufferSize), m_stride(stride) {}
+
+	StridedAudioBufferChannelView(const StridedAudioBufferChannelView& otherBuffer)
+			: m_data{otherBuffer.m_data},
+			  m_bufferSize {otherBuffer.m_bufferSize},
+			  m_stride{otherBuffer.m_stride}
+	{}
+
+	StridedAudioBufferChannelView(StridedAudioBufferChannelView&& otherBuffer) noexcept
+			: m_data{otherBuffer.m_data},
+			  m_bufferSize {otherBuffer.m_bufferSize},
+			  m_stride{otherBuffer.m_stride}
+	{
+		otherBuffer.m_data = nullptr;
+		otherBuffer.m_bufferSize = 0;
+	}
+
+	using GainType = typename std::conditional<std::is_integral_v<AudioSampleType>, double, AudioSampleType>::type;
+	using iterator = StridedIterator<AudioSampleType>;
+	iterator begin() const noexcept { return iterator(m_data, std::ptrdiff_t(m_stride)); }
+	iterator end() const noexcept { return iterator(m_data + m_bufferSize * m_stride, std::ptrdiff_t(m_stride)); }
+
+	bool isEmpty() { return m_bufferSize < 1 || !m_data; }
+
+	AudioSampleType& operator[](size_t index) noexcept {
+		assert(index < m_bufferSize);
+		return m_data[index * m_stride];
+	}
+
+	AudioSampleType operator[](size_t index) const noexcept {
+		assert(index < m_bufferSize);
+		return m_data[index * m_stride];
+	}
+
+	AudioSampleType getSample(size_t index) const noexcept {
+		assert(index < m_bufferSize);
+		return m_data[index * m_stride];
+	}
+
+	void setSample(size_t index, AudioSampleType sample) noexcept {
+		assert(index < m_bufferSize);
+		m_data[index * m_stride] = sample;
+	}
+
+	void addSample(size_t index, AudioSampleType sample) noexcept {
+		assert(index < m_bufferSize);
+		m_data[index * m_stride] += sample;
+	}
+
+	void copyFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, const SamplesRange &destinationSamplesRange = {}, GainType gain = AudioSampleType(1)) {
+		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
+		assert(samplesCount <= sourceBufferChannel.getBufferSize());
+		forEachSourceSample(sourceBufferChannel, destinationSamplesRange.startSample, samplesCount, [gain](AudioSampleType& destination, AudioSampleType source, size_t) {
+			destination = source * gain;
+		});
+	}
+
+	void copyWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		if(startGain == endGain) {
+			copyFrom(sourceBufferChannel, destinationSamplesRange, startGain);
+			return;
+		}
+
+		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
+		assert(samplesCount <= sourceBufferChannel.getBufferSize());
+		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
+		forEachSourceSample(sourceBufferChannel, destinationSamplesRange.startSample, samplesCount, [startGain, baseGainIncrement](AudioSampleType& destination, AudioSampleType source, size_t index) {
+			destination = source * (startGain + static_cast<GainType>(index) * baseGainIncrement);
+		});
+	}
+
+	void addFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, const SamplesRange &destinationSamplesRange = {}, GainType gain = AudioSampleType(1)) {
+		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
+		assert(samplesCount <= sourceBufferChannel.getBufferSize());
+		forEachSourceSample(sourceBufferChannel, destinationSamplesRange.startSample, samplesCount, [gain](AudioSampleType& destination, AudioSampleType source, size_t) {
+			destination += source * gain;
+		});
+	}
+
+	void addWithRampFrom(const AudioBufferChannelReadableType<AudioSampleType> auto &sourceBufferChannel, GainType startGain, GainType endGain, const SamplesRange &destinationSamplesRange = {}) {
+		if(startGain == endGain) {
+			addFrom(sourceBufferChannel, destinationSamplesRange, startGain);
+			return;
+		}
+
+		auto samplesCount = getSamplesCountFromRange(destinationSamplesRange);
+		assert(samplesCount <= sourceBufferChannel.getBufferSize());
+		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
+		forEachSourceSample(sourceBufferChannel, destinationSamplesRange.startSample, samplesCount, [startGain, baseGainIncrement](AudioSampleType& destination, AudioSampleType source, size_t index) {
+			destination += source * (startGain + static_cast<GainType>(index) * baseGainIncrement);
+		});
+	}
+
+	void applyGain(GainType gain, const SamplesRange& samplesRange = {}) noexcept {
+		auto samplesCount = getSamplesCountFromRange(samplesRange);
+		auto data = m_data + samplesRange.startSample * m_stride;
+		for(size_t index = 0; index < samplesCount; ++index) {
+			data[index * m_stride] *= gain;
+		}
+	}
+
+	void applyGainRamp(GainType startGain, GainType endGain, const SamplesRange& samplesRange = {}) noexcept {
+		if(startGain == endGain) {
+			applyGain(startGain, samplesRange);
+			return;
+		}
+
+		auto samplesCount = getSamplesCountFromRange(samplesRange);
+		GainType baseGainIncrement = (endGain - startGain) / static_cast<GainType>(samplesCount);
+		auto data = m_data + samplesRange.startSample * m_stride;
+		for(size_t index = 0; index < samplesCount; ++index) {
+			data[index * m_stride] *= startGain + static_cast<GainType>(index) * baseGainIncrement;
+		}
+	}
+
+	void clear(const SamplesRange& samplesRange = {}) noexcept {
+		auto samplesCount = getSamplesCountFromRange(samplesRange);
+		auto data = m_data + samplesRange.startSample * m_stride;
+		for(size_t index = 0; index < samplesCount; ++index) {
+			data[index * m_stride] = AudioSampleType(0);
+		}
+	}
+
+	void reverse(const SamplesRange& samplesRange = {}) noexcept {
+		auto first = begin() + std::ptrdiff_t(samplesRange.startSample);
+		std::reverse(first, first + std::ptrdiff_t(getSamplesCountFromRange(samplesRange)));
+	}
+
+	//Peak, min/max, RMS, DC offset and crest factor of the range, with the samples gathered in blocks for the SIMD kernels
+	AudioStatistics<AudioSampleType> getStatistics(const SamplesRange& samplesRange = {}) const noexcept {
+		AudioStatisticsAccumulator<AudioSampleType> accumulator;
+		accumulator.process(m_data + samplesRange.startSample * m_stride, getSamplesCountFromRange(samplesRange), m_stride);
+		return accumulator.getStatistics();
+	}
+
+	AudioSampleType getHigherPeak(const SamplesRange& samplesRange = {}) const noexcept {
+		return getStatistics(samplesRange).peak;
+	}
+
+	AudioSampleType getRMSLevel(const SamplesRange& samplesRange = {}) const noexcept {
+		return static_cast<AudioSampleType>(getStatistics(samplesRange).rms);
+	}
+
+	[[nodiscard]] size_t getBufferSize() const noexcept { return m_bufferSize; }
+	[[nodiscard]] size_t getStride() const noexcept { return m_stride; }
+
+protected:
+	[[nodiscard]] size_t getSamplesCountFromRange(const SamplesRange& samplesRange) const {
+		auto samplesCount = samplesRange.getRealSamplesCount(m_bufferSize);
+		assert(samplesCount > 0);
+		assert(samplesRange.startSample + samplesCount <= m_bufferSize);
+		return samplesCount;
+	}
+
+	//Call function(destinationSample, sourceSample, index) for the samples of the range, reading the contiguous sources directly from their spans
+	template<typename SourceType, typename Function>
+	void forEachSourceSample(const SourceType& sourceBufferChannel, size_t startSample, size_t samplesCount, Function&& function) {
+		auto destination = m_data + startSample * m_stride;
+		if constexpr (AudioBufferChannelSpansReadableType<SourceType, AudioSampleType>) {
+			forEachContiguousPart(sourceBufferChannel.getReadSpans(SamplesRange(0, samplesCount)), [this, destination, &function](AudioSampleType* source, size_t partSamplesCount, size_t processedSamplesCount) {
+				for(size_t index = 0; index < partSamplesCount; ++index) {
+					function(destination[(processedSamplesCount + index) * m_stride], source[index], processedSamplesCount + index);
+				}
+			});
+		} else {
+			for(size_t index = 0; index < samplesCount; ++index) {
+				function(destination[index * m_stride], sourceBufferChannel.getSample(index), index);
+			}
+		}
+	}
+
+	AudioSampleType* m_data;
+	size_t m_bufferSize;
+	size_t m_stride;
+};
+
+} // abl
+
+#endif //ABL_STRIDEDAUDIOBUFFERCHANNELVIEW_H
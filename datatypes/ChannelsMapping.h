@@ -0,0 +1,181 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_CHANNELSMAPPING_H
+#define ABL_CHANNELSMAPPING_H
+
+#include <assert.h>
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace abl {
+
+//Channels mapping of the multi channels views. Up to inlineMappedChannels channels with indexes up to UINT16_MAX are
+//stored inside the object, so copying the views and creating the ranged ones never allocate. Bigger mappings (or
+//with bigger channels indexes) are stored in an immutable shared array: copying them only increment the reference
+//count, while changing a shared mapping copy it first. Can be created implicitly from a std::vector or an initializer list
+class ChannelsMapping {
+public:
+	static constexpr size_t inlineMappedChannels = 64;
+
+	class const_iterator {
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = size_t;
+
+		const_iterator() noexcept = default;
+		const_iterator(const ChannelsMapping* channelsMapping, size_t index) noexcept : m_channelsMapping(channelsMapping), m_index(index) {}
+
+		[[nodiscard]] size_t operator*() const noexcept { return (*m_channelsMapping)[m_index]; }
+		[[nodiscard]] size_t operator[](difference_type offset) const noexcept { return (*m_channelsMapping)[m_index + offset]; }
+
+		const_iterator& operator++() noexcept { ++m_index; return *this; }
+		const_iterator operator++(int) noexcept { auto iterator = *this; ++m_index; return iterator; }
+		const_iterator& operator--() noexcept { --m_index; return *this; }
+		const_iterator operator--(int) noexcept { auto iterator = *this; --m_index; return iterator; }
+		const_iterator& operator+=(difference_type offset) noexcept { m_index += offset; return *this; }
+		const_iterator& operator-=(difference_type offset) noexcept { m_index -= offset; return *this; }
+
+		[[nodiscard]] friend const_iterator operator+(const_iterator iterator, difference_type offset) noexcept { return iterator += offset; }
+		[[nodiscard]] friend const_iterator operator+(difference_type offset, const_iterator iterator) noexcept { return iterator += offset; }
+		[[nodiscard]] friend const_iterator operator-(const_iterator iterator, difference_type offset) noexcept { return iterator -= offset; }
+		[[nodiscard]] friend difference_type operator-(const const_iterator& first, const const_iterator& second) noexcept {
+			return static_cast<difference_type>(first.m_index) - static_cast<difference_type>(second.m_index);
+		}
+
+		[[nodiscard]] friend bool operator==(const const_iterator& first, const const_iterator& second) noexcept { return first.m_index == second.m_index; }
+		[[nodiscard]] friend auto operator<=>(const const_iterator& first, const const_iterator& second) noexcept { return first.m_index <=> second.m_index; }
+
+	private:
+		const ChannelsMapping* m_channelsMapping = nullptr;
+		size_t m_index = 0;
+	};
+
+	using value_type = size_t;
+	using iterator = const_iterator;
+
+	ChannelsMapping() noexcept = default;
+	ChannelsMapping(const ChannelsMapping&) noexcept = default;
+	ChannelsMapping& operator=(const ChannelsMapping&) noexcept = default;
+
+	ChannelsMapping(ChannelsMapping&& otherMapping) noexcept
+		: m_size(otherMapping.m_size), m_sharedChannels(std::move(otherMapping.m_sharedChannels)) {
+		std::copy(otherMapping.m_inlineChannels, otherMapping.m_inlineChannels + inlineMappedChannels, m_inlineChannels);
+		otherMapping.m_size = 0;
+	}
+
+	ChannelsMapping& operator=(ChannelsMapping&& otherMapping) noexcept {
+		if(this != &otherMapping) {
+			std::copy(otherMapping.m_inlineChannels, otherMapping.m_inlineChannels + inlineMappedChannels, m_inlineChannels);
+			m_size = otherMapping.m_size;
+			m_sharedChannels = std::move(otherMapping.m_sharedChannels);
+			otherMapping.m_size = 0;
+		}
+
+		return *this;
+	}
+
+	ChannelsMapping(std::initializer_list<size_t> channels) {
+		assign(channels.begin(), channels.end());
+	}
+
+	ChannelsMapping(const std::vector<size_t>& channels) {
+		assign(channels.begin(), channels.end());
+	}
+
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+	[[nodiscard]] size_t size() const noexcept { return m_size; }
+	[[nodiscard]] bool isInline() const noexcept { return !m_sharedChannels; }
+
+	[[nodiscard]] size_t operator[](size_t index) const noexcept {
+		assert(index < m_size);
+		return m_sharedChannels ? m_sharedChannels[index] : m_inlineChannels[index];
+	}
+
+	[[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+	[[nodiscard]] const_iterator end() const noexcept { return {this, m_size}; }
+
+	//The new channels (when growing) are mapped to 0. Growing over inlineMappedChannels move the mapping to the shared storage
+	void resize(size_t size) {
+		if(m_sharedChannels || size > inlineMappedChannels) {
+			moveToSharedChannels(size);
+		} else {
+			std::fill(m_inlineChannels + std::min(m_size, size), m_inlineChannels + size, uint16_t(0));
+		}
+
+		m_size = size;
+	}
+
+	void setChannel(size_t index, size_t channel) {
+		assert(index < m_size);
+		if(!m_sharedChannels && channel > UINT16_MAX) {
+			moveToSharedChannels(m_size);
+		} else if(m_sharedChannels && m_sharedChannels.use_count() > 1) {
+			moveToSharedChannels(m_size);
+		}
+
+		if(m_sharedChannels) {
+			m_sharedChannels[index] = channel;
+		} else {
+			m_inlineChannels[index] = static_cast<uint16_t>(channel);
+		}
+	}
+
+	void createSequential(size_t startChannel, size_t channelsCount) {
+		resize(channelsCount);
+		for(size_t index = 0; index < channelsCount; ++index) {
+			setChannel(index, startChannel + index);
+		}
+	}
+
+	[[nodiscard]] std::vector<size_t> toVector() const { return std::vector<size_t>(begin(), end()); }
+
+	friend bool operator== (const ChannelsMapping& first, const ChannelsMapping& second) noexcept {
+		return std::equal(first.begin(), first.end(), second.begin(), second.end());
+	}
+
+private:
+	template<typename Iterator>
+	void assign(Iterator first, Iterator last) {
+		auto size = static_cast<size_t>(last - first);
+		if(size > inlineMappedChannels || std::any_of(first, last, [](size_t channel) { return channel > UINT16_MAX; })) {
+			m_sharedChannels = std::make_shared<size_t[]>(size);
+			std::copy(first, last, m_sharedChannels.get());
+			m_size = size;
+			return;
+		}
+
+		resize(size);
+		for(size_t index = 0; first != last; ++first, ++index) {
+			m_inlineChannels[index] = static_cast<uint16_t>(*first);
+		}
+	}
+
+	//Copy the current channels in a new shared array (not shared yet by any other mapping) of the given size
+	void moveToSharedChannels(size_t size) {
+		auto sharedChannels = std::make_shared<size_t[]>(size);
+		auto copiedChannels = std::min(m_size, size);
+		for(size_t index = 0; index < copiedChannels; ++index) {
+			sharedChannels[index] = (*this)[index];
+		}
+
+		m_sharedChannels = std::move(sharedChannels);
+	}
+
+	uint16_t m_inlineChannels[inlineMappedChannels]{};
+	size_t m_size = 0;
+	std::shared_ptr<size_t[]> m_sharedChannels;
+};
+
+} // abl
+
+#endif //ABL_CHANNELSMAPPING_H
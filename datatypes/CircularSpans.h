@@ -0,0 +1,102 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_CIRCULARSPANS_H
+#define ABL_CIRCULARSPANS_H
+
+#include <assert.h>
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace abl {
+
+//A range of samples in a circular memory area, split in the (at most) two contiguous parts before and after the end of the memory area
+template <typename SampleType>
+struct CircularSpans {
+	std::span<SampleType> first;
+	std::span<SampleType> second;
+
+	CircularSpans() = default;
+	CircularSpans(std::span<SampleType> firstSpan, std::span<SampleType> secondSpan = {}) : first{firstSpan}, second{secondSpan} {}
+
+	//startIndex can go past the end of the container (up to two times his size), like an offset summed to a sample index
+	CircularSpans(SampleType* data, size_t containerSize, size_t startIndex, size_t samplesCount) {
+		assert(samplesCount <= containerSize);
+		if(startIndex >= containerSize) {
+			startIndex -= containerSize;
+		}
+		assert(startIndex < containerSize || samplesCount == 0);
+
+		auto firstSamplesCount = std::min(samplesCount, containerSize - startIndex);
+		first = std::span<SampleType>(data + startIndex, firstSamplesCount);
+		second = std::span<SampleType>(data, samplesCount - firstSamplesCount);
+	}
+
+	[[nodiscard]] size_t size() const noexcept { return first.size() + second.size(); }
+	[[nodiscard]] bool empty() const noexcept { return first.empty() && second.empty(); }
+	[[nodiscard]] bool isSplit() const noexcept { return !second.empty(); }
+
+	//Return the pointer to the sample at index and the number of contiguous samples that follow it
+	[[nodiscard]] std::pair<SampleType*, size_t> getContiguousPart(size_t index) const noexcept {
+		assert(index < size());
+		if(index < first.size()) {
+			return {first.data() + index, first.size() - index};
+		}
+		return {second.data() + (index - first.size()), second.size() - (index - first.size())};
+	}
+};
+
+//Call function(data, samplesCount, processedSamplesCount) for each contiguous part of the spans
+template <typename SampleType, typename Function>
+void forEachContiguousPart(const CircularSpans<SampleType>& spans, Function&& function) {
+	if(!spans.first.empty()) {
+		function(spans.first.data(), spans.first.size(), size_t(0));
+	}
+	if(!spans.second.empty()) {
+		function(spans.second.data(), spans.second.size(), spans.first.size());
+	}
+}
+
+//Call function(destination, source, samplesCount, processedSamplesCount) for each part contiguous in both the spans (at most three),
+//processing all the samples of the destination spans
+template <typename DestinationSampleType, typename SourceSampleType, typename Function>
+void forEachContiguousPart(const CircularSpans<DestinationSampleType>& destinationSpans, const CircularSpans<SourceSampleType>& sourceSpans, Function&& function) {
+	assert(sourceSpans.size() >= destinationSpans.size());
+	const auto samplesCount = destinationSpans.size();
+	size_t processedSamplesCount = 0;
+	while(processedSamplesCount < samplesCount) {
+		auto [destination, destinationContiguousSamples] = destinationSpans.getContiguousPart(processedSamplesCount);
+		auto [source, sourceContiguousSamples] = sourceSpans.getContiguousPart(processedSamplesCount);
+		auto partSamplesCount = std::min({destinationContiguousSamples, sourceContiguousSamples, samplesCount - processedSamplesCount});
+		function(destination, source, partSamplesCount, processedSamplesCount);
+		processedSamplesCount += partSamplesCount;
+	}
+}
+
+//Reverse the samples order of the spans, swapping contiguous blocks from the two ends
+template <typename SampleType>
+void reverseCircularSpans(const CircularSpans<SampleType>& spans) {
+	if(!spans.isSplit()) {
+		std::reverse(spans.first.begin(), spans.first.end());
+		return;
+	}
+
+	size_t frontIndex = 0;
+	size_t backIndex = spans.size();
+	while(frontIndex + 1 < backIndex) {
+		auto [front, frontContiguousSamples] = spans.getContiguousPart(frontIndex);
+		auto backEnd = spans.getContiguousPart(backIndex - 1).first;
+		auto backContiguousSamplesBefore = backIndex - 1 < spans.first.size() ? backIndex : backIndex - spans.first.size();
+		auto swapsCount = std::min({frontContiguousSamples, backContiguousSamplesBefore, (backIndex - frontIndex) / 2});
+		for(size_t index = 0; index < swapsCount; ++index) {
+			std::swap(front[index], backEnd[-static_cast<std::ptrdiff_t>(index)]);
+		}
+		frontIndex += swapsCount;
+		backIndex -= swapsCount;
+	}
+}
+
+} // abl
+
+#endif //ABL_CIRCULARSPANS_H
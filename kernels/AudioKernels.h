@@ -0,0 +1,185 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOKERNELS_H
+#define ABL_AUDIOKERNELS_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "SimdInstructionSet.h"
+#include "ScalarKernels.h"
+#include "X86SimdTraits.h"
+#include "NeonSimdTraits.h"
+
+#if defined(ABL_SIMD_X86)
+	#define ABL_KERNELS_NAMESPACE sse2
+	#define ABL_KERNELS_TRAITS Sse2Traits
+	#define ABL_KERNELS_TARGET ABL_TARGET_SSE2
+	#include "VectorKernels.h"
+	#undef ABL_KERNELS_NAMESPACE
+	#undef ABL_KERNELS_TRAITS
+	#undef ABL_KERNELS_TARGET
+
+	#define ABL_KERNELS_NAMESPACE avx2
+	#define ABL_KERNELS_TRAITS Avx2Traits
+	#define ABL_KERNELS_TARGET ABL_TARGET_AVX2
+	#include "VectorKernels.h"
+	#undef ABL_KERNELS_NAMESPACE
+	#undef ABL_KERNELS_TRAITS
+	#undef ABL_KERNELS_TARGET
+
+	#define ABL_KERNELS_NAMESPACE avx512
+	#define ABL_KERNELS_TRAITS Avx512Traits
+	#define ABL_KERNELS_TARGET ABL_TARGET_AVX512
+	#include "VectorKernels.h"
+	#undef ABL_KERNELS_NAMESPACE
+	#undef ABL_KERNELS_TRAITS
+	#undef ABL_KERNELS_TARGET
+#elif defined(ABL_SIMD_NEON)
+	#define ABL_KERNELS_NAMESPACE neon
+	#define ABL_KERNELS_TRAITS NeonTraits
+	#define ABL_KERNELS_TARGET ABL_TARGET_NEON
+	#include "VectorKernels.h"
+	#undef ABL_KERNELS_NAMESPACE
+	#undef ABL_KERNELS_TRAITS
+	#undef ABL_KERNELS_TARGET
+#endif
+
+namespace abl {
+
+template<typename SampleType>
+concept SimdSampleType = std::is_same_v<SampleType, float> || std::is_same_v<SampleType, double> || std::is_same_v<SampleType, int16_t> || std::is_same_v<SampleType, int32_t>;
+
+template<typename SampleType>
+struct AudioKernelsTable {
+	using GainType = kernels::KernelGainType<SampleType>;
+
+	void (*applyGain)(SampleType*, size_t, GainType) noexcept;
+	void (*applyGainRamp)(SampleType*, size_t, GainType, GainType) noexcept;
+	void (*copy)(SampleType*, const SampleType*, size_t, GainType) noexcept;
+	void (*copyWithRamp)(SampleType*, const SampleType*, size_t, GainType, GainType) noexcept;
+	void (*add)(SampleType*, const SampleType*, size_t, GainType) noexcept;
+	void (*addWithRamp)(SampleType*, const SampleType*, size_t, GainType, GainType) noexcept;
+	void (*copyWithWindow)(SampleType*, const SampleType*, const GainType*, size_t) noexcept;
+	void (*addWithWindow)(SampleType*, const SampleType*, const GainType*, size_t) noexcept;
+	void (*mix)(SampleType*, const kernels::KernelMixSource<SampleType>*, size_t, size_t) noexcept;
+	kernels::KernelAnalysis<SampleType> (*analyze)(const SampleType*, size_t) noexcept;
+	void (*interpolate)(SampleType*, const SampleType*, const double*, size_t, InterpolationType) noexcept;
+};
+
+#define ABL_KERNELS_TABLE_FOR(kernelsNamespace) AudioKernelsTable<SampleType>{ \
+		&kernelsNamespace::applyGain<SampleType>, \
+		&kernelsNamespace::applyGainRamp<SampleType>, \
+		&kernelsNamespace::copy<SampleType>, \
+		&kernelsNamespace::copyWithRamp<SampleType>, \
+		&kernelsNamespace::add<SampleType>, \
+		&kernelsNamespace::addWithRamp<SampleType>, \
+		&kernelsNamespace::copyWithWindow<SampleType>, \
+		&kernelsNamespace::addWithWindow<SampleType>, \
+		&kernelsNamespace::mix<SampleType>, \
+		&kernelsNamespace::analyze<SampleType>, \
+		&kernelsNamespace::interpolate<SampleType> \
+	}
+
+//Gain, ramp, window, mix, analysis and interpolation kernels for contiguous samples, dispatched at runtime to the best instruction set supported by the cpu.
+//The constant gain kernels give the same results of the scalar loops (the integral samples saturate to the range of the type), the ramps compute the gain of each sample as startGain + index * gainIncrement
+template<typename SampleType>
+class AudioKernels {
+public:
+	using GainType = kernels::KernelGainType<SampleType>;
+
+	//A sample multiplied by 1 keeps his value (it's not true for 64 bit integers, that lose precision when converted to double)
+	static constexpr bool unityGainIsLossless = std::is_floating_point_v<SampleType> || sizeof(SampleType) <= sizeof(int32_t);
+
+	static void applyGain(SampleType* data, size_t samplesCount, GainType gain) noexcept {
+		if(gain == GainType(1) && unityGainIsLossless) {
+			return;
+		}
+		getTable().applyGain(data, samplesCount, gain);
+	}
+
+	static void applyGainRamp(SampleType* data, size_t samplesCount, GainType startGain, GainType gainIncrement) noexcept {
+		getTable().applyGainRamp(data, samplesCount, startGain, gainIncrement);
+	}
+
+	static void copy(SampleType* destination, const SampleType* source, size_t samplesCount, GainType gain = GainType(1)) noexcept {
+		if(gain == GainType(1) && unityGainIsLossless) {
+			std::memmove(destination, source, samplesCount * sizeof(SampleType));
+			return;
+		}
+		getTable().copy(destination, source, samplesCount, gain);
+	}
+
+	static void copyWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, GainType startGain, GainType gainIncrement) noexcept {
+		getTable().copyWithRamp(destination, source, samplesCount, startGain, gainIncrement);
+	}
+
+	static void add(SampleType* destination, const SampleType* source, size_t samplesCount, GainType gain = GainType(1)) noexcept {
+		getTable().add(destination, source, samplesCount, gain);
+	}
+
+	static void addWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, GainType startGain, GainType gainIncrement) noexcept {
+		getTable().addWithRamp(destination, source, samplesCount, startGain, gainIncrement);
+	}
+
+	//Multiply every sample by its coefficient of the window (like the frames of a STFT)
+	static void copyWithWindow(SampleType* destination, const SampleType* source, const GainType* window, size_t samplesCount) noexcept {
+		getTable().copyWithWindow(destination, source, window, samplesCount);
+	}
+
+	static void addWithWindow(SampleType* destination, const SampleType* source, const GainType* window, size_t samplesCount) noexcept {
+		getTable().addWithWindow(destination, source, window, samplesCount);
+	}
+
+	//Add all the sources to the destination in a single pass, instead of an add pass over the destination for every source
+	static void mix(SampleType* destination, const kernels::KernelMixSource<SampleType>* sources, size_t sourcesCount, size_t samplesCount) noexcept {
+		getTable().mix(destination, sources, sourcesCount, samplesCount);
+	}
+
+	//Minimum, maximum, sum and sum of squares of a block of at least one sample. The sums are in the lanes type, so the blocks must be
+	//short enough for its precision: AudioStatisticsAccumulator split the samples in blocks and add them in wider accumulators
+	static kernels::KernelAnalysis<SampleType> analyze(const SampleType* data, size_t samplesCount) noexcept {
+		assert(samplesCount > 0);
+		return getTable().analyze(data, samplesCount);
+	}
+
+	//Interpolate the samples at fractional positions relative to source: the margins of the interpolation (getInterpolationMargins) around the integer
+	//part of every position must be readable. The positions can have any order, the fraction is rounded to the precision of the lanes type
+	static void interpolate(SampleType* destination, const SampleType* source, const double* positions, size_t samplesCount, InterpolationType interpolation) noexcept {
+		getTable().interpolate(destination, source, positions, samplesCount, interpolation);
+	}
+
+	static const AudioKernelsTable<SampleType>& getTable() noexcept {
+		static const AudioKernelsTable<SampleType> table = getTableFor(getBestSimdInstructionSet());
+		return table;
+	}
+
+	//Return the kernels of a specific instruction set (the scalar ones if it's not supported by the cpu or for the sample type)
+	static AudioKernelsTable<SampleType> getTableFor(SimdInstructionSet instructionSet) noexcept {
+		if constexpr (SimdSampleType<SampleType>) {
+			if(isSimdInstructionSetSupported(instructionSet)) {
+				switch(instructionSet) {
+#if defined(ABL_SIMD_X86)
+					case SimdInstructionSet::Sse2: return ABL_KERNELS_TABLE_FOR(kernels::sse2);
+					case SimdInstructionSet::Avx2: return ABL_KERNELS_TABLE_FOR(kernels::avx2);
+					case SimdInstructionSet::Avx512: return ABL_KERNELS_TABLE_FOR(kernels::avx512);
+#elif defined(ABL_SIMD_NEON)
+					case SimdInstructionSet::Neon: return ABL_KERNELS_TABLE_FOR(kernels::neon);
+#endif
+					default: break;
+				}
+			}
+		}
+
+		return ABL_KERNELS_TABLE_FOR(kernels::scalar);
+	}
+};
+
+#undef ABL_KERNELS_TABLE_FOR
+
+} // abl
+
+#endif //ABL_AUDIOKERNELS_H
@@ -0,0 +1,360 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_INTERLEAVEKERNELS_H
+#define ABL_INTERLEAVEKERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "SimdInstructionSet.h"
+
+namespace abl::kernels {
+
+//The interleave kernels only move the samples, so the vector versions work on the bits of any 4 bytes (as float lanes) or 8 bytes (as double lanes) sample type
+template<typename SampleType>
+concept ShuffleableSampleType = std::is_trivially_copyable_v<SampleType> && (sizeof(SampleType) == 4 || sizeof(SampleType) == 8);
+
+namespace scalar {
+
+template<typename SampleType>
+void interleave(SampleType* destination, const SampleType* const* sources, size_t channelsCount, size_t framesCount) noexcept {
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		const SampleType* source = sources[channel];
+		for(size_t frame = 0; frame < framesCount; ++frame) {
+			destination[frame * channelsCount + channel] = source[frame];
+		}
+	}
+}
+
+template<typename SampleType>
+void deinterleave(SampleType* const* destinations, const SampleType* source, size_t channelsCount, size_t framesCount) noexcept {
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		SampleType* destination = destinations[channel];
+		for(size_t frame = 0; frame < framesCount; ++frame) {
+			destination[frame] = source[frame * channelsCount + channel];
+		}
+	}
+}
+
+//With the channels count known at compile time the inner loop is unrolled, and every frame is written (or read) at once
+template<size_t ChannelsCount, typename SampleType>
+void interleave(SampleType* destination, const SampleType* const* sources, size_t startFrame, size_t framesCount) noexcept {
+	const SampleType* channels[ChannelsCount];
+	std::copy_n(sources, ChannelsCount, channels);
+	for(size_t frame = startFrame; frame < framesCount; ++frame) {
+		for(size_t channel = 0; channel < ChannelsCount; ++channel) {
+			destination[frame * ChannelsCount + channel] = channels[channel][frame];
+		}
+	}
+}
+
+template<size_t ChannelsCount, typename SampleType>
+void deinterleave(SampleType* const* destinations, const SampleType* source, size_t startFrame, size_t framesCount) noexcept {
+	SampleType* channels[ChannelsCount];
+	std::copy_n(destinations, ChannelsCount, channels);
+	for(size_t frame = startFrame; frame < framesCount; ++frame) {
+		for(size_t channel = 0; channel < ChannelsCount; ++channel) {
+			channels[channel][frame] = source[frame * ChannelsCount + channel];
+		}
+	}
+}
+
+template<size_t ChannelsCount, typename SampleType>
+void interleaveFixed(SampleType* destination, const SampleType* const* sources, size_t framesCount) noexcept {
+	interleave<ChannelsCount>(destination, sources, 0, framesCount);
+}
+
+template<size_t ChannelsCount, typename SampleType>
+void deinterleaveFixed(SampleType* const* destinations, const SampleType* source, size_t framesCount) noexcept {
+	deinterleave<ChannelsCount>(destinations, source, 0, framesCount);
+}
+
+} // scalar
+
+#if defined(ABL_SIMD_X86)
+
+//Shuffles are limited by the memory bandwidth, so the 128 bits versions are used for every x86 instruction set
+namespace sse2 {
+
+//Transpose blocks of 4 frames x 4 channels (float lanes) or 2 frames x 2 channels (double lanes)
+template<size_t ChannelsCount, typename SampleType>
+ABL_TARGET_SSE2 void interleaveFixed(SampleType* destination, const SampleType* const* sources, size_t framesCount) noexcept {
+	size_t frame = 0;
+	if constexpr (sizeof(SampleType) == 4) {
+		auto destinationLanes = reinterpret_cast<float*>(destination);
+		const float* channels[ChannelsCount];
+		for(size_t channel = 0; channel < ChannelsCount; ++channel) {
+			channels[channel] = reinterpret_cast<const float*>(sources[channel]);
+		}
+
+		for(; frame + 4 <= framesCount; frame += 4) {
+			auto frames = destinationLanes + frame * ChannelsCount;
+			if constexpr (ChannelsCount == 2) {
+				auto left = _mm_loadu_ps(channels[0] + frame);
+				auto right = _mm_loadu_ps(channels[1] + frame);
+				_mm_storeu_ps(frames, _mm_unpacklo_ps(left, right));
+				_mm_storeu_ps(frames + 4, _mm_unpackhi_ps(left, right));
+			} else {
+				//Channels 0-3 (and 4-7) of the 4 frames, transposed in 4 vectors of a frame each
+				for(size_t firstChannel = 0; firstChannel + 4 <= ChannelsCount; firstChannel += 4) {
+					auto row0 = _mm_loadu_ps(channels[firstChannel] + frame);
+					auto row1 = _mm_loadu_ps(channels[firstChannel + 1] + frame);
+					auto row2 = _mm_loadu_ps(channels[firstChannel + 2] + frame);
+					auto row3 = _mm_loadu_ps(channels[firstChannel + 3] + frame);
+					_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+					_mm_storeu_ps(frames + firstChannel, row0);
+					_mm_storeu_ps(frames + ChannelsCount + firstChannel, row1);
+					_mm_storeu_ps(frames + 2 * ChannelsCount + firstChannel, row2);
+					_mm_storeu_ps(frames + 3 * ChannelsCount + firstChannel, row3);
+				}
+
+				if constexpr (ChannelsCount == 6) {
+					auto channel4 = _mm_loadu_ps(channels[4] + frame);
+					auto channel5 = _mm_loadu_ps(channels[5] + frame);
+					auto firstPairs = _mm_unpacklo_ps(channel4, channel5);
+					auto secondPairs = _mm_unpackhi_ps(channel4, channel5);
+					_mm_storel_pi(reinterpret_cast<__m64*>(frames + 4), firstPairs);
+					_mm_storeh_pi(reinterpret_cast<__m64*>(frames + 6 + 4), firstPairs);
+					_mm_storel_pi(reinterpret_cast<__m64*>(frames + 12 + 4), secondPairs);
+					_mm_storeh_pi(reinterpret_cast<__m64*>(frames + 18 + 4), secondPairs);
+				}
+			}
+		}
+	} else {
+		auto destinationLanes = reinterpret_cast<double*>(destination);
+		for(; frame + 2 <= framesCount; frame += 2) {
+			auto frames = destinationLanes + frame * ChannelsCount;
+			for(size_t channel = 0; channel < ChannelsCount; channel += 2) {
+				auto firstChannel = _mm_loadu_pd(reinterpret_cast<const double*>(sources[channel]) + frame);
+				auto secondChannel = _mm_loadu_pd(reinterpret_cast<const double*>(sources[channel + 1]) + frame);
+				_mm_storeu_pd(frames + channel, _mm_unpacklo_pd(firstChannel, secondChannel));
+				_mm_storeu_pd(frames + ChannelsCount + channel, _mm_unpackhi_pd(firstChannel, secondChannel));
+			}
+		}
+	}
+
+	scalar::interleave<ChannelsCount>(destination, sources, frame, framesCount);
+}
+
+template<size_t ChannelsCount, typename SampleType>
+ABL_TARGET_SSE2 void deinterleaveFixed(SampleType* const* destinations, const SampleType* source, size_t framesCount) noexcept {
+	size_t frame = 0;
+	if constexpr (sizeof(SampleType) == 4) {
+		auto sourceLanes = reinterpret_cast<const float*>(source);
+		float* channels[ChannelsCount];
+		for(size_t channel = 0; channel < ChannelsCount; ++channel) {
+			channels[channel] = reinterpret_cast<float*>(destinations[channel]);
+		}
+
+		for(; frame + 4 <= framesCount; frame += 4) {
+			auto frames = sourceLanes + frame * ChannelsCount;
+			if constexpr (ChannelsCount == 2) {
+				auto firstFrames = _mm_loadu_ps(frames);
+				auto secondFrames = _mm_loadu_ps(frames + 4);
+				_mm_storeu_ps(channels[0] + frame, _mm_shuffle_ps(firstFrames, secondFrames, _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(channels[1] + frame, _mm_shuffle_ps(firstFrames, secondFrames, _MM_SHUFFLE(3, 1, 3, 1)));
+			} else {
+				for(size_t firstChannel = 0; firstChannel + 4 <= ChannelsCount; firstChannel += 4) {
+					auto row0 = _mm_loadu_ps(frames + firstChannel);
+					auto row1 = _mm_loadu_ps(frames + ChannelsCount + firstChannel);
+					auto row2 = _mm_loadu_ps(frames + 2 * ChannelsCount + firstChannel);
+					auto row3 = _mm_loadu_ps(frames + 3 * ChannelsCount + firstChannel);
+					_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+					_mm_storeu_ps(channels[firstChannel] + frame, row0);
+					_mm_storeu_ps(channels[firstChannel + 1] + frame, row1);
+					_mm_storeu_ps(channels[firstChannel + 2] + frame, row2);
+					_mm_storeu_ps(channels[firstChannel + 3] + frame, row3);
+				}
+
+				if constexpr (ChannelsCount == 6) {
+					auto firstPairs = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(frames + 4)), reinterpret_cast<const __m64*>(frames + 6 + 4));
+					auto secondPairs = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(frames + 12 + 4)), reinterpret_cast<const __m64*>(frames + 18 + 4));
+					_mm_storeu_ps(channels[4] + frame, _mm_shuffle_ps(firstPairs, secondPairs, _MM_SHUFFLE(2, 0, 2, 0)));
+					_mm_storeu_ps(channels[5] + frame, _mm_shuffle_ps(firstPairs, secondPairs, _MM_SHUFFLE(3, 1, 3, 1)));
+				}
+			}
+		}
+	} else {
+		auto sourceLanes = reinterpret_cast<const double*>(source);
+		for(; frame + 2 <= framesCount; frame += 2) {
+			auto frames = sourceLanes + frame * ChannelsCount;
+			for(size_t channel = 0; channel < ChannelsCount; channel += 2) {
+				auto firstFrame = _mm_loadu_pd(frames + channel);
+				auto secondFrame = _mm_loadu_pd(frames + ChannelsCount + channel);
+				_mm_storeu_pd(reinterpret_cast<double*>(destinations[channel]) + frame, _mm_unpacklo_pd(firstFrame, secondFrame));
+				_mm_storeu_pd(reinterpret_cast<double*>(destinations[channel + 1]) + frame, _mm_unpackhi_pd(firstFrame, secondFrame));
+			}
+		}
+	}
+
+	scalar::deinterleave<ChannelsCount>(destinations, source, frame, framesCount);
+}
+
+} // sse2
+
+#elif defined(ABL_SIMD_NEON)
+
+//The structured loads and stores of NEON interleave up to 4 vectors, so they're used for the stereo and 4 channels frames
+namespace neon {
+
+template<size_t ChannelsCount, typename SampleType>
+void interleaveFixed(SampleType* destination, const SampleType* const* sources, size_t framesCount) noexcept {
+	size_t frame = 0;
+	if constexpr (ChannelsCount == 2 || ChannelsCount == 4) {
+		if constexpr (sizeof(SampleType) == 4) {
+			auto destinationLanes = reinterpret_cast<uint32_t*>(destination);
+			for(; frame + 4 <= framesCount; frame += 4) {
+				if constexpr (ChannelsCount == 2) {
+					vst2q_u32(destinationLanes + frame * 2, (uint32x4x2_t{{vld1q_u32(reinterpret_cast<const uint32_t*>(sources[0]) + frame), vld1q_u32(reinterpret_cast<const uint32_t*>(sources[1]) + frame)}}));
+				} else {
+					vst4q_u32(destinationLanes + frame * 4, (uint32x4x4_t{{vld1q_u32(reinterpret_cast<const uint32_t*>(sources[0]) + frame), vld1q_u32(reinterpret_cast<const uint32_t*>(sources[1]) + frame),
+					                                                       vld1q_u32(reinterpret_cast<const uint32_t*>(sources[2]) + frame), vld1q_u32(reinterpret_cast<const uint32_t*>(sources[3]) + frame)}}));
+				}
+			}
+		} else {
+			auto destinationLanes = reinterpret_cast<uint64_t*>(destination);
+			for(; frame + 2 <= framesCount; frame += 2) {
+				if constexpr (ChannelsCount == 2) {
+					vst2q_u64(destinationLanes + frame * 2, (uint64x2x2_t{{vld1q_u64(reinterpret_cast<const uint64_t*>(sources[0]) + frame), vld1q_u64(reinterpret_cast<const uint64_t*>(sources[1]) + frame)}}));
+				} else {
+					vst4q_u64(destinationLanes + frame * 4, (uint64x2x4_t{{vld1q_u64(reinterpret_cast<const uint64_t*>(sources[0]) + frame), vld1q_u64(reinterpret_cast<const uint64_t*>(sources[1]) + frame),
+					                                                       vld1q_u64(reinterpret_cast<const uint64_t*>(sources[2]) + frame), vld1q_u64(reinterpret_cast<const uint64_t*>(sources[3]) + frame)}}));
+				}
+			}
+		}
+	}
+
+	scalar::interleave<ChannelsCount>(destination, sources, frame, framesCount);
+}
+
+template<size_t ChannelsCount, typename SampleType>
+void deinterleaveFixed(SampleType* const* destinations, const SampleType* source, size_t framesCount) noexcept {
+	size_t frame = 0;
+	if constexpr (ChannelsCount == 2 || ChannelsCount == 4) {
+		if constexpr (sizeof(SampleType) == 4) {
+			auto sourceLanes = reinterpret_cast<const uint32_t*>(source);
+			for(; frame + 4 <= framesCount; frame += 4) {
+				if constexpr (ChannelsCount == 2) {
+					auto channels = vld2q_u32(sourceLanes + frame * 2);
+					vst1q_u32(reinterpret_cast<uint32_t*>(destinations[0]) + frame, channels.val[0]);
+					vst1q_u32(reinterpret_cast<uint32_t*>(destinations[1]) + frame, channels.val[1]);
+				} else {
+					auto channels = vld4q_u32(sourceLanes + frame * 4);
+					for(size_t channel = 0; channel < 4; ++channel) {
+						vst1q_u32(reinterpret_cast<uint32_t*>(destinations[channel]) + frame, channels.val[channel]);
+					}
+				}
+			}
+		} else {
+			auto sourceLanes = reinterpret_cast<const uint64_t*>(source);
+			for(; frame + 2 <= framesCount; frame += 2) {
+				if constexpr (ChannelsCount == 2) {
+					auto channels = vld2q_u64(sourceLanes + frame * 2);
+					vst1q_u64(reinterpret_cast<uint64_t*>(destinations[0]) + frame, channels.val[0]);
+					vst1q_u64(reinterpret_cast<uint64_t*>(destinations[1]) + frame, channels.val[1]);
+				} else {
+					auto channels = vld4q_u64(sourceLanes + frame * 4);
+					for(size_t channel = 0; channel < 4; ++channel) {
+						vst1q_u64(reinterpret_cast<uint64_t*>(destinations[channel]) + frame, channels.val[channel]);
+					}
+				}
+			}
+		}
+	}
+
+	scalar::deinterleave<ChannelsCount>(destinations, source, frame, framesCount);
+}
+
+} // neon
+
+#endif
+
+} // abl::kernels
+
+namespace abl {
+
+template<typename SampleType>
+struct InterleaveKernelsTable {
+	void (*interleave2)(SampleType*, const SampleType* const*, size_t) noexcept;
+	void (*interleave4)(SampleType*, const SampleType* const*, size_t) noexcept;
+	void (*interleave6)(SampleType*, const SampleType* const*, size_t) noexcept;
+	void (*interleave8)(SampleType*, const SampleType* const*, size_t) noexcept;
+	void (*deinterleave2)(SampleType* const*, const SampleType*, size_t) noexcept;
+	void (*deinterleave4)(SampleType* const*, const SampleType*, size_t) noexcept;
+	void (*deinterleave6)(SampleType* const*, const SampleType*, size_t) noexcept;
+	void (*deinterleave8)(SampleType* const*, const SampleType*, size_t) noexcept;
+};
+
+#define ABL_INTERLEAVE_KERNELS_TABLE_FOR(kernelsNamespace) InterleaveKernelsTable<SampleType>{ \
+		&kernelsNamespace::interleaveFixed<2, SampleType>, \
+		&kernelsNamespace::interleaveFixed<4, SampleType>, \
+		&kernelsNamespace::interleaveFixed<6, SampleType>, \
+		&kernelsNamespace::interleaveFixed<8, SampleType>, \
+		&kernelsNamespace::deinterleaveFixed<2, SampleType>, \
+		&kernelsNamespace::deinterleaveFixed<4, SampleType>, \
+		&kernelsNamespace::deinterleaveFixed<6, SampleType>, \
+		&kernelsNamespace::deinterleaveFixed<8, SampleType> \
+	}
+
+//Conversion between planar channels and interleaved frames (frame after frame, with the samples of all the channels in each frame).
+//Stereo, 4, 6 and 8 channels use shuffle kernels dispatched at runtime like the AudioKernels, the other channels counts a generic loop
+template<typename SampleType>
+class InterleaveKernels {
+public:
+	static void interleave(SampleType* destination, const SampleType* const* sources, size_t channelsCount, size_t framesCount) noexcept {
+		switch(channelsCount) {
+			case 1: std::memmove(destination, sources[0], framesCount * sizeof(SampleType)); break;
+			case 2: getTable().interleave2(destination, sources, framesCount); break;
+			case 4: getTable().interleave4(destination, sources, framesCount); break;
+			case 6: getTable().interleave6(destination, sources, framesCount); break;
+			case 8: getTable().interleave8(destination, sources, framesCount); break;
+			default: kernels::scalar::interleave(destination, sources, channelsCount, framesCount); break;
+		}
+	}
+
+	static void deinterleave(SampleType* const* destinations, const SampleType* source, size_t channelsCount, size_t framesCount) noexcept {
+		switch(channelsCount) {
+			case 1: std::memmove(destinations[0], source, framesCount * sizeof(SampleType)); break;
+			case 2: getTable().deinterleave2(destinations, source, framesCount); break;
+			case 4: getTable().deinterleave4(destinations, source, framesCount); break;
+			case 6: getTable().deinterleave6(destinations, source, framesCount); break;
+			case 8: getTable().deinterleave8(destinations, source, framesCount); break;
+			default: kernels::scalar::deinterleave(destinations, source, channelsCount, framesCount); break;
+		}
+	}
+
+	static const InterleaveKernelsTable<SampleType>& getTable() noexcept {
+		static const InterleaveKernelsTable<SampleType> table = getTableFor(getBestSimdInstructionSet());
+		return table;
+	}
+
+	//Return the kernels of a specific instruction set (the scalar ones if it's not supported by the cpu or for the sample type)
+	static InterleaveKernelsTable<SampleType> getTableFor(SimdInstructionSet instructionSet) noexcept {
+		if constexpr (kernels::ShuffleableSampleType<SampleType>) {
+			if(isSimdInstructionSetSupported(instructionSet)) {
+				switch(instructionSet) {
+#if defined(ABL_SIMD_X86)
+					case SimdInstructionSet::Sse2:
+					case SimdInstructionSet::Avx2:
+					case SimdInstructionSet::Avx512: return ABL_INTERLEAVE_KERNELS_TABLE_FOR(kernels::sse2);
+#elif defined(ABL_SIMD_NEON)
+					case SimdInstructionSet::Neon: return ABL_INTERLEAVE_KERNELS_TABLE_FOR(kernels::neon);
+#endif
+					default: break;
+				}
+			}
+		}
+
+		return ABL_INTERLEAVE_KERNELS_TABLE_FOR(kernels::scalar);
+	}
+};
+
+#undef ABL_INTERLEAVE_KERNELS_TABLE_FOR
+
+} // abl
+
+#endif //ABL_INTERLEAVEKERNELS_H
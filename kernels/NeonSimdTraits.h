@@ -0,0 +1,80 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_NEONSIMDTRAITS_H
+#define ABL_NEONSIMDTRAITS_H
+
+#include "SimdInstructionSet.h"
+
+#if defined(ABL_SIMD_NEON)
+
+#include <cstdint>
+#include <limits>
+
+namespace abl::kernels {
+
+//Integral samples are processed as double lanes to obtain the same truncation of the scalar code (sample * double gain),
+//saturated to the range of the sample type before the conversion as the scalar toSample
+
+template<typename SampleType> struct NeonTraits;
+
+template<>
+struct NeonTraits<float> {
+	using Vector = float32x4_t;
+	using ComputeType = float;
+	static constexpr size_t width = 4;
+	static Vector load(const float* source) noexcept { return vld1q_f32(source); }
+	static void store(float* destination, Vector value) noexcept { vst1q_f32(destination, value); }
+	static Vector broadcast(ComputeType value) noexcept { return vdupq_n_f32(value); }
+	static Vector lanesIndexes() noexcept { static const float indexes[] = {0, 1, 2, 3}; return vld1q_f32(indexes); }
+	static Vector mul(Vector a, Vector b) noexcept { return vmulq_f32(a, b); }
+	static Vector add(Vector a, Vector b) noexcept { return vaddq_f32(a, b); }
+	static Vector sub(Vector a, Vector b) noexcept { return vsubq_f32(a, b); }
+	static Vector min(Vector a, Vector b) noexcept { return vminq_f32(a, b); }
+	static Vector max(Vector a, Vector b) noexcept { return vmaxq_f32(a, b); }
+};
+
+template<>
+struct NeonTraits<double> {
+	using Vector = float64x2_t;
+	using ComputeType = double;
+	static constexpr size_t width = 2;
+	static Vector load(const double* source) noexcept { return vld1q_f64(source); }
+	static void store(double* destination, Vector value) noexcept { vst1q_f64(destination, value); }
+	static Vector broadcast(ComputeType value) noexcept { return vdupq_n_f64(value); }
+	static Vector lanesIndexes() noexcept { static const double indexes[] = {0, 1}; return vld1q_f64(indexes); }
+	static Vector mul(Vector a, Vector b) noexcept { return vmulq_f64(a, b); }
+	static Vector add(Vector a, Vector b) noexcept { return vaddq_f64(a, b); }
+	static Vector sub(Vector a, Vector b) noexcept { return vsubq_f64(a, b); }
+	static Vector min(Vector a, Vector b) noexcept { return vminq_f64(a, b); }
+	static Vector max(Vector a, Vector b) noexcept { return vmaxq_f64(a, b); }
+	template<typename IntegralType>
+	static Vector saturate(Vector value) noexcept {
+		return min(max(value, broadcast(std::numeric_limits<IntegralType>::lowest())), broadcast(std::numeric_limits<IntegralType>::max()));
+	}
+};
+
+template<>
+struct NeonTraits<int32_t> : NeonTraits<double> {
+	static Vector load(const int32_t* source) noexcept { return vcvtq_f64_s64(vmovl_s32(vld1_s32(source))); }
+	static void store(int32_t* destination, Vector value) noexcept { vst1_s32(destination, vmovn_s64(vcvtq_s64_f64(saturate<int32_t>(value)))); }
+};
+
+template<>
+struct NeonTraits<int16_t> : NeonTraits<double> {
+	static Vector load(const int16_t* source) noexcept {
+		int16_t samples[4] = {source[0], source[1], 0, 0};
+		return vcvtq_f64_s64(vmovl_s32(vget_low_s32(vmovl_s16(vld1_s16(samples)))));
+	}
+	static void store(int16_t* destination, Vector value) noexcept {
+		auto samples = vqmovn_s32(vcombine_s32(vqmovn_s64(vcvtq_s64_f64(saturate<int16_t>(value))), vdup_n_s32(0)));
+		destination[0] = vget_lane_s16(samples, 0);
+		destination[1] = vget_lane_s16(samples, 1);
+	}
+};
+
+} // abl::kernels
+
+#endif
+
+#endif //ABL_NEONSIMDTRAITS_H
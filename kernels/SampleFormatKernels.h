@@ -0,0 +1,438 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SAMPLEFORMATKERNELS_H
+#define ABL_SAMPLEFORMATKERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "SimdInstructionSet.h"
+
+namespace abl {
+
+//Packed 24 bits little endian sample, like the ones of the WAV files and of many sound cards
+struct PackedInt24 {
+	uint8_t bytes[3];
+};
+
+//Triangular (TPDF) dither of +-1 LSB for the conversions to integral samples, made by the difference of the two 16 bits halves of a random number.
+//The random numbers come from 16 xorshift32 generators used in turn, sample after sample, so the scalar and the vector kernels add the same noise
+//(and the vector kernels update more independent generators at once)
+class TpdfDither {
+public:
+	static constexpr size_t generatorsCount = 16;
+
+	explicit TpdfDither(uint32_t seed = 0x9E3779B9u) noexcept { reset(seed); }
+
+	void reset(uint32_t seed) noexcept {
+		for(auto& state : m_states) {
+			seed = seed * 1664525u + 1013904223u;
+			state = seed != 0 ? seed : 1u;
+		}
+	}
+
+	[[nodiscard]] uint32_t* getStates() noexcept { return m_states.data(); }
+
+private:
+	alignas(64) std::array<uint32_t, generatorsCount> m_states;
+};
+
+} // abl
+
+namespace abl::kernels {
+
+//The vector kernels convert the float samples from and to int16 and int32, the other types use only the scalar ones
+template<typename FloatType, typename IntType>
+concept SimdConversionTypes = std::is_same_v<FloatType, float> && (std::is_same_v<IntType, int16_t> || std::is_same_v<IntType, int32_t>);
+
+namespace scalar {
+
+inline uint32_t nextDitherRandom(uint32_t& state) noexcept {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+//Difference of two uniform values in [0, 1), in steps of 2^-16 (so the result is exact in float)
+inline float nextTpdfDither(uint32_t& state) noexcept {
+	auto random = nextDitherRandom(state);
+	return static_cast<float>(static_cast<int32_t>(random >> 16) - static_cast<int32_t>(random & 0xFFFFu)) * (1.0f / 65536.0f);
+}
+
+template<typename FloatType, typename IntType>
+void toFloating(FloatType* destination, const IntType* source, size_t samplesCount, FloatType scale) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = static_cast<FloatType>(source[index]) * scale;
+	}
+}
+
+//The clipping is written like the max/min of the vector kernels, so the NaN samples become the minimum value
+template<typename FloatType, typename IntType>
+void toIntegral(IntType* destination, const FloatType* source, size_t samplesCount, FloatType scale, FloatType minValue, FloatType maxValue, uint32_t* ditherStates) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		FloatType value = source[index] * scale;
+		if(ditherStates) {
+			value += static_cast<FloatType>(nextTpdfDither(ditherStates[index % TpdfDither::generatorsCount]));
+		}
+		value = value > minValue ? value : minValue;
+		value = value < maxValue ? value : maxValue;
+		destination[index] = static_cast<IntType>(std::nearbyint(value));
+	}
+}
+
+} // scalar
+
+#if defined(ABL_SIMD_X86)
+
+namespace sse2 {
+
+ABL_TARGET_SSE2 inline __m128i nextDitherRandom(__m128i& states) noexcept {
+	states = _mm_xor_si128(states, _mm_slli_epi32(states, 13));
+	states = _mm_xor_si128(states, _mm_srli_epi32(states, 17));
+	states = _mm_xor_si128(states, _mm_slli_epi32(states, 5));
+	return states;
+}
+
+ABL_TARGET_SSE2 inline __m128 nextTpdfDither(__m128i& states) noexcept {
+	auto random = nextDitherRandom(states);
+	auto difference = _mm_sub_epi32(_mm_srli_epi32(random, 16), _mm_and_si128(random, _mm_set1_epi32(0xFFFF)));
+	return _mm_mul_ps(_mm_cvtepi32_ps(difference), _mm_set1_ps(1.0f / 65536.0f));
+}
+
+template<typename IntType>
+ABL_TARGET_SSE2 inline __m128 loadAsFloat(const IntType* source) noexcept {
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		auto samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+		return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+	} else {
+		return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+	}
+}
+
+template<typename IntType>
+ABL_TARGET_SSE2 inline void storeFromFloat(IntType* destination, __m128 value) noexcept {
+	auto samples = _mm_cvtps_epi32(value);
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_packs_epi32(samples, samples));
+	} else {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), samples);
+	}
+}
+
+template<typename FloatType, typename IntType>
+ABL_TARGET_SSE2 void toFloating(FloatType* destination, const IntType* source, size_t samplesCount, FloatType scale) noexcept {
+	auto scaleVector = _mm_set1_ps(scale);
+	size_t index = 0;
+	for(; index + 4 <= samplesCount; index += 4) {
+		_mm_storeu_ps(destination + index, _mm_mul_ps(loadAsFloat(source + index), scaleVector));
+	}
+	scalar::toFloating(destination + index, source + index, samplesCount - index, scale);
+}
+
+//A sample for every dither generator in every iteration, so every lane use always the same generator
+template<typename FloatType, typename IntType>
+ABL_TARGET_SSE2 void toIntegral(IntType* destination, const FloatType* source, size_t samplesCount, FloatType scale, FloatType minValue, FloatType maxValue, uint32_t* ditherStates) noexcept {
+	auto scaleVector = _mm_set1_ps(scale);
+	auto minVector = _mm_set1_ps(minValue);
+	auto maxVector = _mm_set1_ps(maxValue);
+	size_t index = 0;
+	if(ditherStates) {
+		constexpr size_t statesCount = TpdfDither::generatorsCount / 4;
+		__m128i states[statesCount];
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			states[vector] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ditherStates + vector * 4));
+		}
+		for(; index + TpdfDither::generatorsCount <= samplesCount; index += TpdfDither::generatorsCount) {
+			for(size_t vector = 0; vector < statesCount; ++vector) {
+				auto value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(source + index + vector * 4), scaleVector), nextTpdfDither(states[vector]));
+				storeFromFloat(destination + index + vector * 4, _mm_min_ps(_mm_max_ps(value, minVector), maxVector));
+			}
+		}
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(ditherStates + vector * 4), states[vector]);
+		}
+	} else {
+		for(; index + 4 <= samplesCount; index += 4) {
+			auto value = _mm_mul_ps(_mm_loadu_ps(source + index), scaleVector);
+			storeFromFloat(destination + index, _mm_min_ps(_mm_max_ps(value, minVector), maxVector));
+		}
+	}
+	scalar::toIntegral(destination + index, source + index, samplesCount - index, scale, minValue, maxValue, ditherStates);
+}
+
+} // sse2
+
+namespace avx2 {
+
+ABL_TARGET_AVX2 inline __m256i nextDitherRandom(__m256i& states) noexcept {
+	states = _mm256_xor_si256(states, _mm256_slli_epi32(states, 13));
+	states = _mm256_xor_si256(states, _mm256_srli_epi32(states, 17));
+	states = _mm256_xor_si256(states, _mm256_slli_epi32(states, 5));
+	return states;
+}
+
+ABL_TARGET_AVX2 inline __m256 nextTpdfDither(__m256i& states) noexcept {
+	auto random = nextDitherRandom(states);
+	auto difference = _mm256_sub_epi32(_mm256_srli_epi32(random, 16), _mm256_and_si256(random, _mm256_set1_epi32(0xFFFF)));
+	return _mm256_mul_ps(_mm256_cvtepi32_ps(difference), _mm256_set1_ps(1.0f / 65536.0f));
+}
+
+template<typename IntType>
+ABL_TARGET_AVX2 inline __m256 loadAsFloat(const IntType* source) noexcept {
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))));
+	} else {
+		return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+	}
+}
+
+template<typename IntType>
+ABL_TARGET_AVX2 inline void storeFromFloat(IntType* destination, __m256 value) noexcept {
+	auto samples = _mm256_cvtps_epi32(value);
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		auto packedSamples = _mm_packs_epi32(_mm256_castsi256_si128(samples), _mm256_extracti128_si256(samples, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packedSamples);
+	} else {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), samples);
+	}
+}
+
+template<typename FloatType, typename IntType>
+ABL_TARGET_AVX2 void toFloating(FloatType* destination, const IntType* source, size_t samplesCount, FloatType scale) noexcept {
+	auto scaleVector = _mm256_set1_ps(scale);
+	size_t index = 0;
+	for(; index + 8 <= samplesCount; index += 8) {
+		_mm256_storeu_ps(destination + index, _mm256_mul_ps(loadAsFloat(source + index), scaleVector));
+	}
+	scalar::toFloating(destination + index, source + index, samplesCount - index, scale);
+}
+
+template<typename FloatType, typename IntType>
+ABL_TARGET_AVX2 void toIntegral(IntType* destination, const FloatType* source, size_t samplesCount, FloatType scale, FloatType minValue, FloatType maxValue, uint32_t* ditherStates) noexcept {
+	auto scaleVector = _mm256_set1_ps(scale);
+	auto minVector = _mm256_set1_ps(minValue);
+	auto maxVector = _mm256_set1_ps(maxValue);
+	size_t index = 0;
+	if(ditherStates) {
+		constexpr size_t statesCount = TpdfDither::generatorsCount / 8;
+		__m256i states[statesCount];
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			states[vector] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ditherStates + vector * 8));
+		}
+		for(; index + TpdfDither::generatorsCount <= samplesCount; index += TpdfDither::generatorsCount) {
+			for(size_t vector = 0; vector < statesCount; ++vector) {
+				auto value = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(source + index + vector * 8), scaleVector), nextTpdfDither(states[vector]));
+				storeFromFloat(destination + index + vector * 8, _mm256_min_ps(_mm256_max_ps(value, minVector), maxVector));
+			}
+		}
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(ditherStates + vector * 8), states[vector]);
+		}
+	} else {
+		for(; index + 8 <= samplesCount; index += 8) {
+			auto value = _mm256_mul_ps(_mm256_loadu_ps(source + index), scaleVector);
+			storeFromFloat(destination + index, _mm256_min_ps(_mm256_max_ps(value, minVector), maxVector));
+		}
+	}
+	scalar::toIntegral(destination + index, source + index, samplesCount - index, scale, minValue, maxValue, ditherStates);
+}
+
+} // avx2
+
+#elif defined(ABL_SIMD_NEON)
+
+namespace neon {
+
+inline uint32x4_t nextDitherRandom(uint32x4_t& states) noexcept {
+	states = veorq_u32(states, vshlq_n_u32(states, 13));
+	states = veorq_u32(states, vshrq_n_u32(states, 17));
+	states = veorq_u32(states, vshlq_n_u32(states, 5));
+	return states;
+}
+
+inline float32x4_t nextTpdfDither(uint32x4_t& states) noexcept {
+	auto random = nextDitherRandom(states);
+	auto difference = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(random, 16)), vreinterpretq_s32_u32(vandq_u32(random, vdupq_n_u32(0xFFFFu))));
+	return vmulq_f32(vcvtq_f32_s32(difference), vdupq_n_f32(1.0f / 65536.0f));
+}
+
+template<typename IntType>
+inline float32x4_t loadAsFloat(const IntType* source) noexcept {
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		return vcvtq_f32_s32(vmovl_s16(vld1_s16(source)));
+	} else {
+		return vcvtq_f32_s32(vld1q_s32(source));
+	}
+}
+
+//vcvtnq round to the nearest even like std::nearbyint, and maxnm/minnm turn the NaN samples into the minimum value like the scalar clipping
+template<typename IntType>
+inline void storeFromFloat(IntType* destination, float32x4_t value, float32x4_t minVector, float32x4_t maxVector) noexcept {
+	auto samples = vcvtnq_s32_f32(vminnmq_f32(vmaxnmq_f32(value, minVector), maxVector));
+	if constexpr (std::is_same_v<IntType, int16_t>) {
+		vst1_s16(destination, vqmovn_s32(samples));
+	} else {
+		vst1q_s32(destination, samples);
+	}
+}
+
+template<typename FloatType, typename IntType>
+void toFloating(FloatType* destination, const IntType* source, size_t samplesCount, FloatType scale) noexcept {
+	auto scaleVector = vdupq_n_f32(scale);
+	size_t index = 0;
+	for(; index + 4 <= samplesCount; index += 4) {
+		vst1q_f32(destination + index, vmulq_f32(loadAsFloat(source + index), scaleVector));
+	}
+	scalar::toFloating(destination + index, source + index, samplesCount - index, scale);
+}
+
+template<typename FloatType, typename IntType>
+void toIntegral(IntType* destination, const FloatType* source, size_t samplesCount, FloatType scale, FloatType minValue, FloatType maxValue, uint32_t* ditherStates) noexcept {
+	auto scaleVector = vdupq_n_f32(scale);
+	auto minVector = vdupq_n_f32(minValue);
+	auto maxVector = vdupq_n_f32(maxValue);
+	size_t index = 0;
+	if(ditherStates) {
+		constexpr size_t statesCount = TpdfDither::generatorsCount / 4;
+		uint32x4_t states[statesCount];
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			states[vector] = vld1q_u32(ditherStates + vector * 4);
+		}
+		for(; index + TpdfDither::generatorsCount <= samplesCount; index += TpdfDither::generatorsCount) {
+			for(size_t vector = 0; vector < statesCount; ++vector) {
+				auto value = vaddq_f32(vmulq_f32(vld1q_f32(source + index + vector * 4), scaleVector), nextTpdfDither(states[vector]));
+				storeFromFloat(destination + index + vector * 4, value, minVector, maxVector);
+			}
+		}
+		for(size_t vector = 0; vector < statesCount; ++vector) {
+			vst1q_u32(ditherStates + vector * 4, states[vector]);
+		}
+	} else {
+		for(; index + 4 <= samplesCount; index += 4) {
+			storeFromFloat(destination + index, vmulq_f32(vld1q_f32(source + index), scaleVector), minVector, maxVector);
+		}
+	}
+	scalar::toIntegral(destination + index, source + index, samplesCount - index, scale, minValue, maxValue, ditherStates);
+}
+
+} // neon
+
+#endif
+
+} // abl::kernels
+
+namespace abl {
+
+template<typename FloatType, typename IntType>
+struct SampleFormatKernelsTable {
+	void (*toFloating)(FloatType* destination, const IntType* source, size_t samplesCount, FloatType scale) noexcept;
+	void (*toIntegral)(IntType* destination, const FloatType* source, size_t samplesCount, FloatType scale, FloatType minValue, FloatType maxValue, uint32_t* ditherStates) noexcept;
+};
+
+#define ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR(kernelsNamespace) SampleFormatKernelsTable<FloatType, IntType>{ \
+		&kernelsNamespace::toFloating<FloatType, IntType>, \
+		&kernelsNamespace::toIntegral<FloatType, IntType> \
+	}
+
+//Conversion between integral and floating samples. The integral samples with significantBits bits (for example 24 for the 24 bits samples
+//stored in int32) are normalized to [-1, 1), and the floating samples are converted back rounding to the nearest value and clipping to the full scale
+template<typename FloatType, typename IntType>
+class SampleFormatKernels {
+	static_assert(std::is_floating_point_v<FloatType>);
+	static_assert(std::is_integral_v<IntType> && std::is_signed_v<IntType>);
+
+public:
+	static constexpr size_t maxSignificantBits = sizeof(IntType) * 8;
+	static constexpr size_t packedInt24BlockSize = 256;
+
+	static void toFloating(FloatType* destination, const IntType* source, size_t samplesCount, size_t significantBits = maxSignificantBits) noexcept {
+		assert(significantBits > 1 && significantBits <= maxSignificantBits);
+		getTable().toFloating(destination, source, samplesCount, FloatType(1) / getFullScale(significantBits));
+	}
+
+	//The dither is added only when given, and its generators continue between the calls
+	static void toIntegral(IntType* destination, const FloatType* source, size_t samplesCount, size_t significantBits = maxSignificantBits, TpdfDither* dither = nullptr) noexcept {
+		assert(significantBits > 1 && significantBits <= maxSignificantBits);
+		auto fullScale = getFullScale(significantBits);
+		getTable().toIntegral(destination, source, samplesCount, fullScale, -fullScale, getMaxValue(significantBits), dither ? dither->getStates() : nullptr);
+	}
+
+	//The packed samples are unpacked (or packed) in blocks on the stack, converted with the 24 bits int32 kernels
+	static void fromPackedInt24(FloatType* destination, const PackedInt24* source, size_t samplesCount) noexcept requires std::is_same_v<IntType, int32_t> {
+		int32_t block[packedInt24BlockSize];
+		for(size_t startSample = 0; startSample < samplesCount; startSample += packedInt24BlockSize) {
+			auto blockSamplesCount = std::min(packedInt24BlockSize, samplesCount - startSample);
+			for(size_t index = 0; index < blockSamplesCount; ++index) {
+				const auto& bytes = source[startSample + index].bytes;
+				block[index] = static_cast<int32_t>(uint32_t(bytes[0]) << 8 | uint32_t(bytes[1]) << 16 | uint32_t(bytes[2]) << 24) >> 8;
+			}
+			toFloating(destination + startSample, block, blockSamplesCount, 24);
+		}
+	}
+
+	static void toPackedInt24(PackedInt24* destination, const FloatType* source, size_t samplesCount, TpdfDither* dither = nullptr) noexcept requires std::is_same_v<IntType, int32_t> {
+		int32_t block[packedInt24BlockSize];
+		for(size_t startSample = 0; startSample < samplesCount; startSample += packedInt24BlockSize) {
+			auto blockSamplesCount = std::min(packedInt24BlockSize, samplesCount - startSample);
+			toIntegral(block, source + startSample, blockSamplesCount, 24, dither);
+			for(size_t index = 0; index < blockSamplesCount; ++index) {
+				auto sample = static_cast<uint32_t>(block[index]);
+				destination[startSample + index] = PackedInt24{{uint8_t(sample), uint8_t(sample >> 8), uint8_t(sample >> 16)}};
+			}
+		}
+	}
+
+	static const SampleFormatKernelsTable<FloatType, IntType>& getTable() noexcept {
+		static const SampleFormatKernelsTable<FloatType, IntType> table = getTableFor(getBestSimdInstructionSet());
+		return table;
+	}
+
+	//Return the kernels of a specific instruction set (the scalar ones if it's not supported by the cpu or for the samples types).
+	//The conversions are limited by the memory bandwidth, so AVX-512 use the AVX2 kernels
+	static SampleFormatKernelsTable<FloatType, IntType> getTableFor(SimdInstructionSet instructionSet) noexcept {
+		if constexpr (kernels::SimdConversionTypes<FloatType, IntType>) {
+			if(isSimdInstructionSetSupported(instructionSet)) {
+				switch(instructionSet) {
+#if defined(ABL_SIMD_X86)
+					case SimdInstructionSet::Sse2: return ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR(kernels::sse2);
+					case SimdInstructionSet::Avx2:
+					case SimdInstructionSet::Avx512: return ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR(kernels::avx2);
+#elif defined(ABL_SIMD_NEON)
+					case SimdInstructionSet::Neon: return ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR(kernels::neon);
+#endif
+					default: break;
+				}
+			}
+		}
+
+		return ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR(kernels::scalar);
+	}
+
+private:
+	static FloatType getFullScale(size_t significantBits) noexcept {
+		return std::ldexp(FloatType(1), int(significantBits) - 1);
+	}
+
+	//The biggest floating value that round to a valid sample (2^31 - 1 isn't representable as float)
+	static FloatType getMaxValue(size_t significantBits) noexcept {
+		auto maxSample = (int64_t(1) << (significantBits - 1)) - 1;
+		auto maxValue = static_cast<FloatType>(maxSample);
+		if(static_cast<long double>(maxValue) > static_cast<long double>(maxSample)) {
+			maxValue = std::nextafter(maxValue, FloatType(0));
+		}
+		return maxValue;
+	}
+};
+
+#undef ABL_SAMPLE_FORMAT_KERNELS_TABLE_FOR
+
+} // abl
+
+#endif //ABL_SAMPLEFORMATKERNELS_H
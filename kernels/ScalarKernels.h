@@ -0,0 +1,281 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SCALARKERNELS_H
+#define ABL_SCALARKERNELS_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace abl {
+
+//Interpolation of the samples between the stored ones, for the fractional delays
+enum class InterpolationType {
+	//2 points, the cheapest, with a low pass effect that depends on the fraction
+	Linear,
+	//4 points Catmull-Rom cubic Hermite spline
+	Hermite,
+	//4 points third order Lagrange polynomial
+	Lagrange,
+	//16 points Blackman windowed sinc, the flatter response up to near the Nyquist frequency
+	WindowedSinc
+};
+
+//Samples needed before and after the integer part of the position by an interpolation
+struct InterpolationMargins {
+	size_t before;
+	size_t after;
+};
+
+constexpr InterpolationMargins getInterpolationMargins(InterpolationType interpolation) noexcept {
+	switch(interpolation) {
+		case InterpolationType::Linear: return {0, 1};
+		case InterpolationType::Hermite:
+		case InterpolationType::Lagrange: return {1, 2};
+		case InterpolationType::WindowedSinc: return {7, 8};
+	}
+	return {0, 0};
+}
+
+} // abl
+
+namespace abl::kernels {
+
+template<typename SampleType>
+using KernelGainType = typename std::conditional<std::is_integral_v<SampleType>, double, SampleType>::type;
+
+//Sample of a value computed in the gain type. The integral samples saturate to the range of the type (as the vector stores do)
+//and are truncated toward zero, instead of the undefined behaviour of the out of range conversions
+template<typename SampleType>
+SampleType toSample(KernelGainType<SampleType> value) noexcept {
+	if constexpr (std::is_integral_v<SampleType>) {
+		constexpr auto lowest = static_cast<double>(std::numeric_limits<SampleType>::lowest());
+		//The max + 1 power of two is exact also for the 64 bit types, whose max is rounded when converted to double
+		constexpr auto upperLimit = static_cast<double>(std::numeric_limits<SampleType>::max()) + 1.0;
+		if(!(value > lowest)) {
+			return std::numeric_limits<SampleType>::lowest();
+		}
+		return value < upperLimit ? static_cast<SampleType>(value) : std::numeric_limits<SampleType>::max();
+	} else {
+		return value;
+	}
+}
+
+//Source of the mix kernel, added with the gain startGain + index * gainIncrement (0 for a constant gain)
+template<typename SampleType>
+struct KernelMixSource {
+	const SampleType* data;
+	KernelGainType<SampleType> startGain;
+	KernelGainType<SampleType> gainIncrement;
+};
+
+//Minimum, maximum, sum and sum of squares of a block of samples, computed in the lanes type of the kernels (double for the integral samples).
+//The callers keep the blocks short and add the sums of the blocks in wider accumulators (see AudioStatisticsAccumulator)
+template<typename SampleType>
+struct KernelAnalysis {
+	KernelGainType<SampleType> min;
+	KernelGainType<SampleType> max;
+	KernelGainType<SampleType> sum;
+	KernelGainType<SampleType> squaresSum;
+};
+
+//Coefficients of the windowed sinc interpolation for phasesCount + 1 fractions between 0 and 1 (both included), so the coefficients of any
+//fraction are interpolated between two rows. Every row is normalized to unity gain at DC
+template<typename ComputeType>
+struct WindowedSincTable {
+	static constexpr size_t tapsCount = 16;
+	static constexpr size_t phasesCount = 256;
+
+	alignas(64) ComputeType coefficients[(phasesCount + 1) * tapsCount];
+
+	static const WindowedSincTable& get() noexcept {
+		static const WindowedSincTable table;
+		return table;
+	}
+
+	//Row of the phase before the fraction (the next row follows it), and the fraction between the two rows
+	const ComputeType* getRow(ComputeType fraction, ComputeType& phaseFraction) const noexcept {
+		auto phasePosition = fraction * static_cast<ComputeType>(phasesCount);
+		auto phase = static_cast<size_t>(phasePosition);
+		phase = phase < phasesCount ? phase : phasesCount - 1;
+		phaseFraction = phasePosition - static_cast<ComputeType>(phase);
+		return coefficients + phase * tapsCount;
+	}
+
+private:
+	WindowedSincTable() noexcept {
+		constexpr double halfLength = tapsCount / 2;
+		for(size_t phase = 0; phase <= phasesCount; ++phase) {
+			auto fraction = static_cast<double>(phase) / phasesCount;
+			double rowCoefficients[tapsCount];
+			double rowSum = 0;
+			for(size_t tap = 0; tap < tapsCount; ++tap) {
+				//Distance of the tap from the position, the taps go from 7 samples before the integer part to 8 after
+				auto distance = static_cast<double>(tap) - (halfLength - 1) - fraction;
+				auto sinc = distance == 0 ? 1.0 : std::sin(std::numbers::pi * distance) / (std::numbers::pi * distance);
+				auto window = std::abs(distance) >= halfLength ? 0.0 : 0.42 + 0.5 * std::cos(std::numbers::pi * distance / halfLength) + 0.08 * std::cos(2 * std::numbers::pi * distance / halfLength);
+				rowCoefficients[tap] = sinc * window;
+				rowSum += rowCoefficients[tap];
+			}
+			for(size_t tap = 0; tap < tapsCount; ++tap) {
+				coefficients[phase * tapsCount + tap] = static_cast<ComputeType>(rowCoefficients[tap] / rowSum);
+			}
+		}
+	}
+};
+
+namespace scalar {
+
+//The ramp gain is computed as startGain + index * gainIncrement (and not accumulated sample by sample) so every implementation produce the same values
+
+template<typename SampleType>
+void applyGain(SampleType* data, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		data[index] = toSample<SampleType>(data[index] * gain);
+	}
+}
+
+template<typename SampleType>
+void applyGainRamp(SampleType* data, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		data[index] = toSample<SampleType>(data[index] * (startGain + static_cast<KernelGainType<SampleType>>(index) * gainIncrement));
+	}
+}
+
+template<typename SampleType>
+void copy(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * gain);
+	}
+}
+
+template<typename SampleType>
+void copyWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * (startGain + static_cast<KernelGainType<SampleType>>(index) * gainIncrement));
+	}
+}
+
+template<typename SampleType>
+void add(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * gain);
+	}
+}
+
+template<typename SampleType>
+void addWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * (startGain + static_cast<KernelGainType<SampleType>>(index) * gainIncrement));
+	}
+}
+
+//The window has a coefficient for every sample, in the gain type (double for the integral samples)
+template<typename SampleType>
+void copyWithWindow(SampleType* destination, const SampleType* source, const KernelGainType<SampleType>* window, size_t samplesCount) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * window[index]);
+	}
+}
+
+template<typename SampleType>
+void addWithWindow(SampleType* destination, const SampleType* source, const KernelGainType<SampleType>* window, size_t samplesCount) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * window[index]);
+	}
+}
+
+//Every destination sample is read and written once, accumulating all the sources (for the integral samples in double, truncated only at the end)
+template<typename SampleType>
+void mix(SampleType* destination, const KernelMixSource<SampleType>* sources, size_t sourcesCount, size_t samplesCount) noexcept {
+	using GainType = KernelGainType<SampleType>;
+	for(size_t index = 0; index < samplesCount; ++index) {
+		GainType sample = destination[index];
+		for(size_t source = 0; source < sourcesCount; ++source) {
+			sample += sources[source].data[index] * (sources[source].startGain + static_cast<GainType>(index) * sources[source].gainIncrement);
+		}
+		destination[index] = toSample<SampleType>(sample);
+	}
+}
+
+//The block must contain at least one sample
+template<typename SampleType>
+KernelAnalysis<SampleType> analyze(const SampleType* data, size_t samplesCount) noexcept {
+	using ComputeType = KernelGainType<SampleType>;
+	KernelAnalysis<SampleType> analysis{static_cast<ComputeType>(data[0]), static_cast<ComputeType>(data[0]), ComputeType(0), ComputeType(0)};
+	for(size_t index = 0; index < samplesCount; ++index) {
+		auto sample = static_cast<ComputeType>(data[index]);
+		analysis.min = sample < analysis.min ? sample : analysis.min;
+		analysis.max = sample > analysis.max ? sample : analysis.max;
+		analysis.sum += sample;
+		analysis.squaresSum += sample * sample;
+	}
+	return analysis;
+}
+
+//Value at position (from source, with the margins of the interpolation available around it) of the samples interpolated with the fraction of the position.
+//The vector kernels use it for their tails, so the formulas must be kept in sync with them
+template<typename SampleType>
+KernelGainType<SampleType> interpolateSample(const SampleType* source, double position, InterpolationType interpolation) noexcept {
+	using ComputeType = KernelGainType<SampleType>;
+	auto integerPosition = static_cast<size_t>(position);
+	auto fraction = static_cast<ComputeType>(position - static_cast<double>(integerPosition));
+	auto samples = source + integerPosition;
+	switch(interpolation) {
+		case InterpolationType::Linear: {
+			auto first = static_cast<ComputeType>(samples[0]);
+			return first + fraction * (static_cast<ComputeType>(samples[1]) - first);
+		}
+		case InterpolationType::Hermite: {
+			auto previous = static_cast<ComputeType>(samples[-1]);
+			auto first = static_cast<ComputeType>(samples[0]);
+			auto second = static_cast<ComputeType>(samples[1]);
+			auto next = static_cast<ComputeType>(samples[2]);
+			auto c1 = ComputeType(0.5) * (second - previous);
+			auto c2 = previous - ComputeType(2.5) * first + ComputeType(2) * second - ComputeType(0.5) * next;
+			auto c3 = ComputeType(0.5) * (next - previous) + ComputeType(1.5) * (first - second);
+			return ((c3 * fraction + c2) * fraction + c1) * fraction + first;
+		}
+		case InterpolationType::Lagrange: {
+			auto fractionPlusOne = fraction + ComputeType(1);
+			auto fractionMinusOne = fraction - ComputeType(1);
+			auto fractionMinusTwo = fraction - ComputeType(2);
+			auto previousWeight = fraction * fractionMinusOne * fractionMinusTwo * ComputeType(-1.0 / 6.0);
+			auto firstWeight = fractionPlusOne * fractionMinusOne * fractionMinusTwo * ComputeType(0.5);
+			auto secondWeight = fractionPlusOne * fraction * fractionMinusTwo * ComputeType(-0.5);
+			auto nextWeight = fractionPlusOne * fraction * fractionMinusOne * ComputeType(1.0 / 6.0);
+			return previousWeight * static_cast<ComputeType>(samples[-1]) + firstWeight * static_cast<ComputeType>(samples[0])
+				+ secondWeight * static_cast<ComputeType>(samples[1]) + nextWeight * static_cast<ComputeType>(samples[2]);
+		}
+		case InterpolationType::WindowedSinc: {
+			using Table = WindowedSincTable<ComputeType>;
+			ComputeType phaseFraction;
+			auto firstRow = Table::get().getRow(fraction, phaseFraction);
+			auto secondRow = firstRow + Table::tapsCount;
+			auto taps = samples - (Table::tapsCount / 2 - 1);
+			ComputeType value = 0;
+			for(size_t tap = 0; tap < Table::tapsCount; ++tap) {
+				value += (firstRow[tap] + phaseFraction * (secondRow[tap] - firstRow[tap])) * static_cast<ComputeType>(taps[tap]);
+			}
+			return value;
+		}
+	}
+	return 0;
+}
+
+//Interpolate the samples at the given positions, relative to source (that must have the margins of the interpolation around all of them)
+template<typename SampleType>
+void interpolate(SampleType* destination, const SampleType* source, const double* positions, size_t samplesCount, InterpolationType interpolation) noexcept {
+	for(size_t index = 0; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(interpolateSample(source, positions[index], interpolation));
+	}
+}
+
+} // scalar
+
+} // abl::kernels
+
+#endif //ABL_SCALARKERNELS_H
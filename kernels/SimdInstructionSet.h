@@ -0,0 +1,111 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SIMDINSTRUCTIONSET_H
+#define ABL_SIMDINSTRUCTIONSET_H
+
+#include <initializer_list>
+
+#if !defined(ABL_DISABLE_SIMD)
+	#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		#define ABL_SIMD_X86 1
+	#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_NEON) || defined(_M_ARM64))
+		#define ABL_SIMD_NEON 1
+	#endif
+#endif
+
+#if defined(ABL_SIMD_X86)
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define ABL_TARGET_SSE2
+		#define ABL_TARGET_AVX2
+		#define ABL_TARGET_AVX512
+	#else
+		#include <cpuid.h>
+		#define ABL_TARGET_SSE2 __attribute__((target("sse2")))
+		#define ABL_TARGET_AVX2 __attribute__((target("avx2")))
+		#define ABL_TARGET_AVX512 __attribute__((target("avx512f,avx2"), optimize("fp-contract=off")))
+	#endif
+	#include <immintrin.h>
+#elif defined(ABL_SIMD_NEON)
+	#include <arm_neon.h>
+	#define ABL_TARGET_NEON
+#endif
+
+namespace abl {
+
+enum class SimdInstructionSet {
+	Scalar,
+	Sse2,
+	Avx2,
+	Avx512,
+	Neon
+};
+
+struct CpuFeatures {
+	bool sse2 = false;
+	bool avx2 = false;
+	bool avx512f = false;
+	bool neon = false;
+
+	static const CpuFeatures& get() noexcept {
+		static const CpuFeatures cpuFeatures = detect();
+		return cpuFeatures;
+	}
+
+private:
+	static CpuFeatures detect() noexcept {
+		CpuFeatures cpuFeatures;
+#if defined(ABL_SIMD_X86)
+	#if defined(_MSC_VER) && !defined(__clang__)
+		int registers[4];
+		__cpuid(registers, 0);
+		auto maxLeaf = registers[0];
+		__cpuid(registers, 1);
+		cpuFeatures.sse2 = (registers[3] & (1 << 26)) != 0;
+		bool osSavesAvxState = (registers[2] & (1 << 27)) != 0 && (registers[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+		if(maxLeaf >= 7 && osSavesAvxState) {
+			__cpuidex(registers, 7, 0);
+			cpuFeatures.avx2 = (registers[1] & (1 << 5)) != 0;
+			cpuFeatures.avx512f = (registers[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6;
+		}
+	#else
+		__builtin_cpu_init();
+		cpuFeatures.sse2 = __builtin_cpu_supports("sse2");
+		cpuFeatures.avx2 = __builtin_cpu_supports("avx2");
+		cpuFeatures.avx512f = __builtin_cpu_supports("avx512f") && cpuFeatures.avx2;
+	#endif
+#elif defined(ABL_SIMD_NEON)
+		cpuFeatures.neon = true;
+#endif
+		return cpuFeatures;
+	}
+};
+
+[[nodiscard]] inline bool isSimdInstructionSetSupported(SimdInstructionSet instructionSet) noexcept {
+	const auto& cpuFeatures = CpuFeatures::get();
+	switch(instructionSet) {
+		case SimdInstructionSet::Scalar: return true;
+		case SimdInstructionSet::Sse2: return cpuFeatures.sse2;
+		case SimdInstructionSet::Avx2: return cpuFeatures.avx2;
+		case SimdInstructionSet::Avx512: return cpuFeatures.avx512f;
+		case SimdInstructionSet::Neon: return cpuFeatures.neon;
+	}
+	return false;
+}
+
+[[nodiscard]] inline SimdInstructionSet getBestSimdInstructionSet() noexcept {
+	static const SimdInstructionSet bestInstructionSet = [] {
+		for(auto instructionSet : {SimdInstructionSet::Avx512, SimdInstructionSet::Avx2, SimdInstructionSet::Sse2, SimdInstructionSet::Neon}) {
+			if(isSimdInstructionSetSupported(instructionSet)) {
+				return instructionSet;
+			}
+		}
+		return SimdInstructionSet::Scalar;
+	}();
+	return bestInstructionSet;
+}
+
+} // abl
+
+#endif //ABL_SIMDINSTRUCTIONSET_H
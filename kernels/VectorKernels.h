@@ -0,0 +1,356 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+//No include guard: this file is included once for every instruction set by AudioKernels.h, with
+//ABL_KERNELS_NAMESPACE, ABL_KERNELS_TRAITS and ABL_KERNELS_TARGET defined, to generate the same kernels for each of them
+
+#if !defined(ABL_KERNELS_NAMESPACE) || !defined(ABL_KERNELS_TRAITS) || !defined(ABL_KERNELS_TARGET)
+#error "VectorKernels.h must be included by AudioKernels.h"
+#endif
+
+namespace abl::kernels::ABL_KERNELS_NAMESPACE {
+
+template<typename SampleType>
+using Traits = ABL_KERNELS_TRAITS<SampleType>;
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void applyGain(SampleType* data, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	using T = Traits<SampleType>;
+	const auto gainVector = T::broadcast(gain);
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		T::store(data + index, T::mul(T::load(data + index), gainVector));
+	}
+	for(; index < samplesCount; ++index) {
+		data[index] = toSample<SampleType>(data[index] * gain);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void applyGainRamp(SampleType* data, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	using T = Traits<SampleType>;
+	using GainType = KernelGainType<SampleType>;
+	const auto startGainVector = T::broadcast(startGain);
+	const auto gainIncrementVector = T::broadcast(gainIncrement);
+	const auto lanesIndexes = T::lanesIndexes();
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		auto gainVector = T::add(startGainVector, T::mul(T::add(T::broadcast(static_cast<GainType>(index)), lanesIndexes), gainIncrementVector));
+		T::store(data + index, T::mul(T::load(data + index), gainVector));
+	}
+	for(; index < samplesCount; ++index) {
+		data[index] = toSample<SampleType>(data[index] * (startGain + static_cast<GainType>(index) * gainIncrement));
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void copy(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	using T = Traits<SampleType>;
+	const auto gainVector = T::broadcast(gain);
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		T::store(destination + index, T::mul(T::load(source + index), gainVector));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * gain);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void copyWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	using T = Traits<SampleType>;
+	using GainType = KernelGainType<SampleType>;
+	const auto startGainVector = T::broadcast(startGain);
+	const auto gainIncrementVector = T::broadcast(gainIncrement);
+	const auto lanesIndexes = T::lanesIndexes();
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		auto gainVector = T::add(startGainVector, T::mul(T::add(T::broadcast(static_cast<GainType>(index)), lanesIndexes), gainIncrementVector));
+		T::store(destination + index, T::mul(T::load(source + index), gainVector));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * (startGain + static_cast<GainType>(index) * gainIncrement));
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void add(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> gain) noexcept {
+	using T = Traits<SampleType>;
+	const auto gainVector = T::broadcast(gain);
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		T::store(destination + index, T::add(T::load(destination + index), T::mul(T::load(source + index), gainVector)));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * gain);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void addWithRamp(SampleType* destination, const SampleType* source, size_t samplesCount, KernelGainType<SampleType> startGain, KernelGainType<SampleType> gainIncrement) noexcept {
+	using T = Traits<SampleType>;
+	using GainType = KernelGainType<SampleType>;
+	const auto startGainVector = T::broadcast(startGain);
+	const auto gainIncrementVector = T::broadcast(gainIncrement);
+	const auto lanesIndexes = T::lanesIndexes();
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		auto gainVector = T::add(startGainVector, T::mul(T::add(T::broadcast(static_cast<GainType>(index)), lanesIndexes), gainIncrementVector));
+		T::store(destination + index, T::add(T::load(destination + index), T::mul(T::load(source + index), gainVector)));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * (startGain + static_cast<GainType>(index) * gainIncrement));
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void copyWithWindow(SampleType* destination, const SampleType* source, const KernelGainType<SampleType>* window, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using WindowTraits = Traits<KernelGainType<SampleType>>;
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		T::store(destination + index, T::mul(T::load(source + index), WindowTraits::load(window + index)));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(source[index] * window[index]);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void addWithWindow(SampleType* destination, const SampleType* source, const KernelGainType<SampleType>* window, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using WindowTraits = Traits<KernelGainType<SampleType>>;
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		T::store(destination + index, T::add(T::load(destination + index), T::mul(T::load(source + index), WindowTraits::load(window + index))));
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(destination[index] + source[index] * window[index]);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void mix(SampleType* destination, const KernelMixSource<SampleType>* sources, size_t sourcesCount, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using GainType = KernelGainType<SampleType>;
+	const auto lanesIndexes = T::lanesIndexes();
+	const auto widthIndexes = T::broadcast(static_cast<GainType>(T::width));
+	size_t index = 0;
+	//Four vectors for every pass over the sources, to not chain all the adds on a single register
+	for(; index + 4 * T::width <= samplesCount; index += 4 * T::width) {
+		auto firstSample = T::load(destination + index);
+		auto secondSample = T::load(destination + index + T::width);
+		auto thirdSample = T::load(destination + index + 2 * T::width);
+		auto fourthSample = T::load(destination + index + 3 * T::width);
+		const auto firstIndexes = T::add(T::broadcast(static_cast<GainType>(index)), lanesIndexes);
+		const auto secondIndexes = T::add(firstIndexes, widthIndexes);
+		const auto thirdIndexes = T::add(secondIndexes, widthIndexes);
+		const auto fourthIndexes = T::add(thirdIndexes, widthIndexes);
+		for(size_t source = 0; source < sourcesCount; ++source) {
+			const auto& mixSource = sources[source];
+			const auto data = mixSource.data + index;
+			const auto startGain = T::broadcast(mixSource.startGain);
+			if(mixSource.gainIncrement == GainType(0)) {
+				firstSample = T::add(firstSample, T::mul(T::load(data), startGain));
+				secondSample = T::add(secondSample, T::mul(T::load(data + T::width), startGain));
+				thirdSample = T::add(thirdSample, T::mul(T::load(data + 2 * T::width), startGain));
+				fourthSample = T::add(fourthSample, T::mul(T::load(data + 3 * T::width), startGain));
+			} else {
+				const auto gainIncrement = T::broadcast(mixSource.gainIncrement);
+				firstSample = T::add(firstSample, T::mul(T::load(data), T::add(startGain, T::mul(firstIndexes, gainIncrement))));
+				secondSample = T::add(secondSample, T::mul(T::load(data + T::width), T::add(startGain, T::mul(secondIndexes, gainIncrement))));
+				thirdSample = T::add(thirdSample, T::mul(T::load(data + 2 * T::width), T::add(startGain, T::mul(thirdIndexes, gainIncrement))));
+				fourthSample = T::add(fourthSample, T::mul(T::load(data + 3 * T::width), T::add(startGain, T::mul(fourthIndexes, gainIncrement))));
+			}
+		}
+		T::store(destination + index, firstSample);
+		T::store(destination + index + T::width, secondSample);
+		T::store(destination + index + 2 * T::width, thirdSample);
+		T::store(destination + index + 3 * T::width, fourthSample);
+	}
+	for(; index + T::width <= samplesCount; index += T::width) {
+		auto sample = T::load(destination + index);
+		const auto indexes = T::add(T::broadcast(static_cast<GainType>(index)), lanesIndexes);
+		for(size_t source = 0; source < sourcesCount; ++source) {
+			const auto& mixSource = sources[source];
+			auto gainVector = mixSource.gainIncrement == GainType(0) ? T::broadcast(mixSource.startGain) : T::add(T::broadcast(mixSource.startGain), T::mul(indexes, T::broadcast(mixSource.gainIncrement)));
+			sample = T::add(sample, T::mul(T::load(mixSource.data + index), gainVector));
+		}
+		T::store(destination + index, sample);
+	}
+	for(; index < samplesCount; ++index) {
+		GainType sample = destination[index];
+		for(size_t source = 0; source < sourcesCount; ++source) {
+			sample += sources[source].data[index] * (sources[source].startGain + static_cast<GainType>(index) * sources[source].gainIncrement);
+		}
+		destination[index] = toSample<SampleType>(sample);
+	}
+}
+
+//Four accumulators of every kind, so the adds of consecutive vectors don't wait each other, reduced in pairs at the end
+template<typename SampleType>
+ABL_KERNELS_TARGET KernelAnalysis<SampleType> analyze(const SampleType* data, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using ComputeTraits = Traits<KernelGainType<SampleType>>;
+	using ComputeType = KernelGainType<SampleType>;
+	KernelAnalysis<SampleType> analysis{static_cast<ComputeType>(data[0]), static_cast<ComputeType>(data[0]), ComputeType(0), ComputeType(0)};
+	size_t index = 0;
+	if(samplesCount >= 4 * T::width) {
+		auto minVector = T::load(data);
+		auto maxVector = minVector;
+		auto firstSum = T::broadcast(ComputeType(0));
+		auto secondSum = firstSum;
+		auto thirdSum = firstSum;
+		auto fourthSum = firstSum;
+		auto firstSquaresSum = firstSum;
+		auto secondSquaresSum = firstSum;
+		auto thirdSquaresSum = firstSum;
+		auto fourthSquaresSum = firstSum;
+		for(; index + 4 * T::width <= samplesCount; index += 4 * T::width) {
+			auto firstSample = T::load(data + index);
+			auto secondSample = T::load(data + index + T::width);
+			auto thirdSample = T::load(data + index + 2 * T::width);
+			auto fourthSample = T::load(data + index + 3 * T::width);
+			minVector = T::min(minVector, T::min(T::min(firstSample, secondSample), T::min(thirdSample, fourthSample)));
+			maxVector = T::max(maxVector, T::max(T::max(firstSample, secondSample), T::max(thirdSample, fourthSample)));
+			firstSum = T::add(firstSum, firstSample);
+			secondSum = T::add(secondSum, secondSample);
+			thirdSum = T::add(thirdSum, thirdSample);
+			fourthSum = T::add(fourthSum, fourthSample);
+			firstSquaresSum = T::add(firstSquaresSum, T::mul(firstSample, firstSample));
+			secondSquaresSum = T::add(secondSquaresSum, T::mul(secondSample, secondSample));
+			thirdSquaresSum = T::add(thirdSquaresSum, T::mul(thirdSample, thirdSample));
+			fourthSquaresSum = T::add(fourthSquaresSum, T::mul(fourthSample, fourthSample));
+		}
+
+		ComputeType minLanes[T::width];
+		ComputeType maxLanes[T::width];
+		ComputeType sumLanes[T::width];
+		ComputeType squaresSumLanes[T::width];
+		ComputeTraits::store(minLanes, minVector);
+		ComputeTraits::store(maxLanes, maxVector);
+		ComputeTraits::store(sumLanes, T::add(T::add(firstSum, secondSum), T::add(thirdSum, fourthSum)));
+		ComputeTraits::store(squaresSumLanes, T::add(T::add(firstSquaresSum, secondSquaresSum), T::add(thirdSquaresSum, fourthSquaresSum)));
+		for(size_t lane = 0; lane < T::width; ++lane) {
+			analysis.min = minLanes[lane] < analysis.min ? minLanes[lane] : analysis.min;
+			analysis.max = maxLanes[lane] > analysis.max ? maxLanes[lane] : analysis.max;
+			analysis.sum += sumLanes[lane];
+			analysis.squaresSum += squaresSumLanes[lane];
+		}
+	}
+	for(; index < samplesCount; ++index) {
+		auto sample = static_cast<ComputeType>(data[index]);
+		analysis.min = sample < analysis.min ? sample : analysis.min;
+		analysis.max = sample > analysis.max ? sample : analysis.max;
+		analysis.sum += sample;
+		analysis.squaresSum += sample * sample;
+	}
+	return analysis;
+}
+
+template<typename SampleType, InterpolationType interpolation>
+ABL_KERNELS_TARGET void interpolatePolynomial(SampleType* destination, const SampleType* source, const double* positions, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using ComputeType = KernelGainType<SampleType>;
+	using ComputeTraits = Traits<ComputeType>;
+	size_t index = 0;
+	for(; index + T::width <= samplesCount; index += T::width) {
+		//The taps of the lanes are not contiguous, so they're gathered on the stack and the coefficients are computed in the vectors
+		ComputeType fractionLanes[T::width];
+		ComputeType previousLanes[T::width];
+		ComputeType firstLanes[T::width];
+		ComputeType secondLanes[T::width];
+		ComputeType nextLanes[T::width];
+		for(size_t lane = 0; lane < T::width; ++lane) {
+			auto integerPosition = static_cast<size_t>(positions[index + lane]);
+			auto samples = source + integerPosition;
+			fractionLanes[lane] = static_cast<ComputeType>(positions[index + lane] - static_cast<double>(integerPosition));
+			firstLanes[lane] = static_cast<ComputeType>(samples[0]);
+			secondLanes[lane] = static_cast<ComputeType>(samples[1]);
+			if constexpr (interpolation != InterpolationType::Linear) {
+				previousLanes[lane] = static_cast<ComputeType>(samples[-1]);
+				nextLanes[lane] = static_cast<ComputeType>(samples[2]);
+			}
+		}
+
+		auto fraction = ComputeTraits::load(fractionLanes);
+		auto first = ComputeTraits::load(firstLanes);
+		auto second = ComputeTraits::load(secondLanes);
+		typename ComputeTraits::Vector value;
+		if constexpr (interpolation == InterpolationType::Linear) {
+			value = ComputeTraits::add(first, ComputeTraits::mul(fraction, ComputeTraits::sub(second, first)));
+		} else if constexpr (interpolation == InterpolationType::Hermite) {
+			auto previous = ComputeTraits::load(previousLanes);
+			auto next = ComputeTraits::load(nextLanes);
+			auto half = ComputeTraits::broadcast(ComputeType(0.5));
+			auto c1 = ComputeTraits::mul(half, ComputeTraits::sub(second, previous));
+			auto c2 = ComputeTraits::sub(ComputeTraits::add(ComputeTraits::sub(previous, ComputeTraits::mul(ComputeTraits::broadcast(ComputeType(2.5)), first)),
+				ComputeTraits::mul(ComputeTraits::broadcast(ComputeType(2)), second)), ComputeTraits::mul(half, next));
+			auto c3 = ComputeTraits::add(ComputeTraits::mul(half, ComputeTraits::sub(next, previous)), ComputeTraits::mul(ComputeTraits::broadcast(ComputeType(1.5)), ComputeTraits::sub(first, second)));
+			value = ComputeTraits::add(ComputeTraits::mul(ComputeTraits::add(ComputeTraits::mul(ComputeTraits::add(ComputeTraits::mul(c3, fraction), c2), fraction), c1), fraction), first);
+		} else {
+			auto previous = ComputeTraits::load(previousLanes);
+			auto next = ComputeTraits::load(nextLanes);
+			auto one = ComputeTraits::broadcast(ComputeType(1));
+			auto fractionPlusOne = ComputeTraits::add(fraction, one);
+			auto fractionMinusOne = ComputeTraits::sub(fraction, one);
+			auto fractionMinusTwo = ComputeTraits::sub(fraction, ComputeTraits::broadcast(ComputeType(2)));
+			auto previousWeight = ComputeTraits::mul(ComputeTraits::mul(ComputeTraits::mul(fraction, fractionMinusOne), fractionMinusTwo), ComputeTraits::broadcast(ComputeType(-1.0 / 6.0)));
+			auto firstWeight = ComputeTraits::mul(ComputeTraits::mul(ComputeTraits::mul(fractionPlusOne, fractionMinusOne), fractionMinusTwo), ComputeTraits::broadcast(ComputeType(0.5)));
+			auto secondWeight = ComputeTraits::mul(ComputeTraits::mul(ComputeTraits::mul(fractionPlusOne, fraction), fractionMinusTwo), ComputeTraits::broadcast(ComputeType(-0.5)));
+			auto nextWeight = ComputeTraits::mul(ComputeTraits::mul(ComputeTraits::mul(fractionPlusOne, fraction), fractionMinusOne), ComputeTraits::broadcast(ComputeType(1.0 / 6.0)));
+			value = ComputeTraits::add(ComputeTraits::add(ComputeTraits::add(ComputeTraits::mul(previousWeight, previous), ComputeTraits::mul(firstWeight, first)),
+				ComputeTraits::mul(secondWeight, second)), ComputeTraits::mul(nextWeight, next));
+		}
+		T::store(destination + index, value);
+	}
+	for(; index < samplesCount; ++index) {
+		destination[index] = toSample<SampleType>(scalar::interpolateSample(source, positions[index], interpolation));
+	}
+}
+
+//The taps of a sample are contiguous, so the windowed sinc is vectorized over the taps of every sample
+template<typename SampleType>
+ABL_KERNELS_TARGET void interpolateWindowedSinc(SampleType* destination, const SampleType* source, const double* positions, size_t samplesCount) noexcept {
+	using T = Traits<SampleType>;
+	using ComputeType = KernelGainType<SampleType>;
+	using ComputeTraits = Traits<ComputeType>;
+	using Table = WindowedSincTable<ComputeType>;
+	static_assert(Table::tapsCount % T::width == 0);
+	const auto& table = Table::get();
+	for(size_t index = 0; index < samplesCount; ++index) {
+		auto integerPosition = static_cast<size_t>(positions[index]);
+		auto fraction = static_cast<ComputeType>(positions[index] - static_cast<double>(integerPosition));
+		ComputeType phaseFraction;
+		auto firstRow = table.getRow(fraction, phaseFraction);
+		auto secondRow = firstRow + Table::tapsCount;
+		auto taps = source + integerPosition - (Table::tapsCount / 2 - 1);
+		auto phaseFractionVector = ComputeTraits::broadcast(phaseFraction);
+		auto sum = ComputeTraits::broadcast(ComputeType(0));
+		for(size_t tap = 0; tap < Table::tapsCount; tap += T::width) {
+			auto firstCoefficients = ComputeTraits::load(firstRow + tap);
+			auto coefficients = ComputeTraits::add(firstCoefficients, ComputeTraits::mul(phaseFractionVector, ComputeTraits::sub(ComputeTraits::load(secondRow + tap), firstCoefficients)));
+			sum = ComputeTraits::add(sum, ComputeTraits::mul(coefficients, T::load(taps + tap)));
+		}
+
+		ComputeType sumLanes[T::width];
+		ComputeTraits::store(sumLanes, sum);
+		ComputeType value = 0;
+		for(size_t lane = 0; lane < T::width; ++lane) {
+			value += sumLanes[lane];
+		}
+		destination[index] = toSample<SampleType>(value);
+	}
+}
+
+template<typename SampleType>
+ABL_KERNELS_TARGET void interpolate(SampleType* destination, const SampleType* source, const double* positions, size_t samplesCount, InterpolationType interpolation) noexcept {
+	switch(interpolation) {
+		case InterpolationType::Linear: interpolatePolynomial<SampleType, InterpolationType::Linear>(destination, source, positions, samplesCount); break;
+		case InterpolationType::Hermite: interpolatePolynomial<SampleType, InterpolationType::Hermite>(destination, source, positions, samplesCount); break;
+		case InterpolationType::Lagrange: interpolatePolynomial<SampleType, InterpolationType::Lagrange>(destination, source, positions, samplesCount); break;
+		case InterpolationType::WindowedSinc: interpolateWindowedSinc(destination, source, positions, samplesCount); break;
+	}
+}
+
+} // abl::kernels::ABL_KERNELS_NAMESPACE
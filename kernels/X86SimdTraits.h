@@ -0,0 +1,187 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_X86SIMDTRAITS_H
+#define ABL_X86SIMDTRAITS_H
+
+#include "SimdInstructionSet.h"
+
+#if defined(ABL_SIMD_X86)
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace abl::kernels {
+
+//Integral samples are processed as double lanes to obtain the same truncation of the scalar code (sample * double gain),
+//saturated to the range of the sample type before the conversion as the scalar toSample
+
+template<typename SampleType> struct Sse2Traits;
+template<typename SampleType> struct Avx2Traits;
+template<typename SampleType> struct Avx512Traits;
+
+template<>
+struct Sse2Traits<float> {
+	using Vector = __m128;
+	using ComputeType = float;
+	static constexpr size_t width = 4;
+	ABL_TARGET_SSE2 static Vector load(const float* source) noexcept { return _mm_loadu_ps(source); }
+	ABL_TARGET_SSE2 static void store(float* destination, Vector value) noexcept { _mm_storeu_ps(destination, value); }
+	ABL_TARGET_SSE2 static Vector broadcast(ComputeType value) noexcept { return _mm_set1_ps(value); }
+	ABL_TARGET_SSE2 static Vector lanesIndexes() noexcept { return _mm_setr_ps(0, 1, 2, 3); }
+	ABL_TARGET_SSE2 static Vector mul(Vector a, Vector b) noexcept { return _mm_mul_ps(a, b); }
+	ABL_TARGET_SSE2 static Vector add(Vector a, Vector b) noexcept { return _mm_add_ps(a, b); }
+	ABL_TARGET_SSE2 static Vector sub(Vector a, Vector b) noexcept { return _mm_sub_ps(a, b); }
+	ABL_TARGET_SSE2 static Vector min(Vector a, Vector b) noexcept { return _mm_min_ps(a, b); }
+	ABL_TARGET_SSE2 static Vector max(Vector a, Vector b) noexcept { return _mm_max_ps(a, b); }
+};
+
+template<>
+struct Sse2Traits<double> {
+	using Vector = __m128d;
+	using ComputeType = double;
+	static constexpr size_t width = 2;
+	ABL_TARGET_SSE2 static Vector load(const double* source) noexcept { return _mm_loadu_pd(source); }
+	ABL_TARGET_SSE2 static void store(double* destination, Vector value) noexcept { _mm_storeu_pd(destination, value); }
+	ABL_TARGET_SSE2 static Vector broadcast(ComputeType value) noexcept { return _mm_set1_pd(value); }
+	ABL_TARGET_SSE2 static Vector lanesIndexes() noexcept { return _mm_setr_pd(0, 1); }
+	ABL_TARGET_SSE2 static Vector mul(Vector a, Vector b) noexcept { return _mm_mul_pd(a, b); }
+	ABL_TARGET_SSE2 static Vector add(Vector a, Vector b) noexcept { return _mm_add_pd(a, b); }
+	ABL_TARGET_SSE2 static Vector sub(Vector a, Vector b) noexcept { return _mm_sub_pd(a, b); }
+	ABL_TARGET_SSE2 static Vector min(Vector a, Vector b) noexcept { return _mm_min_pd(a, b); }
+	ABL_TARGET_SSE2 static Vector max(Vector a, Vector b) noexcept { return _mm_max_pd(a, b); }
+	template<typename IntegralType>
+	ABL_TARGET_SSE2 static Vector saturate(Vector value) noexcept {
+		return min(max(value, broadcast(std::numeric_limits<IntegralType>::lowest())), broadcast(std::numeric_limits<IntegralType>::max()));
+	}
+};
+
+template<>
+struct Sse2Traits<int32_t> : Sse2Traits<double> {
+	ABL_TARGET_SSE2 static Vector load(const int32_t* source) noexcept { return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source))); }
+	ABL_TARGET_SSE2 static void store(int32_t* destination, Vector value) noexcept { _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_cvttpd_epi32(saturate<int32_t>(value))); }
+};
+
+template<>
+struct Sse2Traits<int16_t> : Sse2Traits<double> {
+	ABL_TARGET_SSE2 static Vector load(const int16_t* source) noexcept {
+		int32_t packedSamples;
+		std::memcpy(&packedSamples, source, sizeof(packedSamples));
+		auto samples = _mm_cvtsi32_si128(packedSamples);
+		return _mm_cvtepi32_pd(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+	}
+	ABL_TARGET_SSE2 static void store(int16_t* destination, Vector value) noexcept {
+		auto samples = _mm_cvttpd_epi32(saturate<int16_t>(value));
+		int32_t packedSamples = _mm_cvtsi128_si32(_mm_packs_epi32(samples, samples));
+		std::memcpy(destination, &packedSamples, sizeof(packedSamples));
+	}
+};
+
+template<>
+struct Avx2Traits<float> {
+	using Vector = __m256;
+	using ComputeType = float;
+	static constexpr size_t width = 8;
+	ABL_TARGET_AVX2 static Vector load(const float* source) noexcept { return _mm256_loadu_ps(source); }
+	ABL_TARGET_AVX2 static void store(float* destination, Vector value) noexcept { _mm256_storeu_ps(destination, value); }
+	ABL_TARGET_AVX2 static Vector broadcast(ComputeType value) noexcept { return _mm256_set1_ps(value); }
+	ABL_TARGET_AVX2 static Vector lanesIndexes() noexcept { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+	ABL_TARGET_AVX2 static Vector mul(Vector a, Vector b) noexcept { return _mm256_mul_ps(a, b); }
+	ABL_TARGET_AVX2 static Vector add(Vector a, Vector b) noexcept { return _mm256_add_ps(a, b); }
+	ABL_TARGET_AVX2 static Vector sub(Vector a, Vector b) noexcept { return _mm256_sub_ps(a, b); }
+	ABL_TARGET_AVX2 static Vector min(Vector a, Vector b) noexcept { return _mm256_min_ps(a, b); }
+	ABL_TARGET_AVX2 static Vector max(Vector a, Vector b) noexcept { return _mm256_max_ps(a, b); }
+};
+
+template<>
+struct Avx2Traits<double> {
+	using Vector = __m256d;
+	using ComputeType = double;
+	static constexpr size_t width = 4;
+	ABL_TARGET_AVX2 static Vector load(const double* source) noexcept { return _mm256_loadu_pd(source); }
+	ABL_TARGET_AVX2 static void store(double* destination, Vector value) noexcept { _mm256_storeu_pd(destination, value); }
+	ABL_TARGET_AVX2 static Vector broadcast(ComputeType value) noexcept { return _mm256_set1_pd(value); }
+	ABL_TARGET_AVX2 static Vector lanesIndexes() noexcept { return _mm256_setr_pd(0, 1, 2, 3); }
+	ABL_TARGET_AVX2 static Vector mul(Vector a, Vector b) noexcept { return _mm256_mul_pd(a, b); }
+	ABL_TARGET_AVX2 static Vector add(Vector a, Vector b) noexcept { return _mm256_add_pd(a, b); }
+	ABL_TARGET_AVX2 static Vector sub(Vector a, Vector b) noexcept { return _mm256_sub_pd(a, b); }
+	ABL_TARGET_AVX2 static Vector min(Vector a, Vector b) noexcept { return _mm256_min_pd(a, b); }
+	ABL_TARGET_AVX2 static Vector max(Vector a, Vector b) noexcept { return _mm256_max_pd(a, b); }
+	template<typename IntegralType>
+	ABL_TARGET_AVX2 static Vector saturate(Vector value) noexcept {
+		return min(max(value, broadcast(std::numeric_limits<IntegralType>::lowest())), broadcast(std::numeric_limits<IntegralType>::max()));
+	}
+};
+
+template<>
+struct Avx2Traits<int32_t> : Avx2Traits<double> {
+	ABL_TARGET_AVX2 static Vector load(const int32_t* source) noexcept { return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))); }
+	ABL_TARGET_AVX2 static void store(int32_t* destination, Vector value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm256_cvttpd_epi32(saturate<int32_t>(value))); }
+};
+
+template<>
+struct Avx2Traits<int16_t> : Avx2Traits<double> {
+	ABL_TARGET_AVX2 static Vector load(const int16_t* source) noexcept { return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)))); }
+	ABL_TARGET_AVX2 static void store(int16_t* destination, Vector value) noexcept {
+		auto samples = _mm256_cvttpd_epi32(saturate<int16_t>(value));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_packs_epi32(samples, samples));
+	}
+};
+
+template<>
+struct Avx512Traits<float> {
+	using Vector = __m512;
+	using ComputeType = float;
+	static constexpr size_t width = 16;
+	ABL_TARGET_AVX512 static Vector load(const float* source) noexcept { return _mm512_loadu_ps(source); }
+	ABL_TARGET_AVX512 static void store(float* destination, Vector value) noexcept { _mm512_storeu_ps(destination, value); }
+	ABL_TARGET_AVX512 static Vector broadcast(ComputeType value) noexcept { return _mm512_set1_ps(value); }
+	ABL_TARGET_AVX512 static Vector lanesIndexes() noexcept { return _mm512_setr_ps(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15); }
+	ABL_TARGET_AVX512 static Vector mul(Vector a, Vector b) noexcept { return _mm512_mul_ps(a, b); }
+	ABL_TARGET_AVX512 static Vector add(Vector a, Vector b) noexcept { return _mm512_add_ps(a, b); }
+	ABL_TARGET_AVX512 static Vector sub(Vector a, Vector b) noexcept { return _mm512_sub_ps(a, b); }
+	ABL_TARGET_AVX512 static Vector min(Vector a, Vector b) noexcept { return _mm512_min_ps(a, b); }
+	ABL_TARGET_AVX512 static Vector max(Vector a, Vector b) noexcept { return _mm512_max_ps(a, b); }
+};
+
+template<>
+struct Avx512Traits<double> {
+	using Vector = __m512d;
+	using ComputeType = double;
+	static constexpr size_t width = 8;
+	ABL_TARGET_AVX512 static Vector load(const double* source) noexcept { return _mm512_loadu_pd(source); }
+	ABL_TARGET_AVX512 static void store(double* destination, Vector value) noexcept { _mm512_storeu_pd(destination, value); }
+	ABL_TARGET_AVX512 static Vector broadcast(ComputeType value) noexcept { return _mm512_set1_pd(value); }
+	ABL_TARGET_AVX512 static Vector lanesIndexes() noexcept { return _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7); }
+	ABL_TARGET_AVX512 static Vector mul(Vector a, Vector b) noexcept { return _mm512_mul_pd(a, b); }
+	ABL_TARGET_AVX512 static Vector add(Vector a, Vector b) noexcept { return _mm512_add_pd(a, b); }
+	ABL_TARGET_AVX512 static Vector sub(Vector a, Vector b) noexcept { return _mm512_sub_pd(a, b); }
+	ABL_TARGET_AVX512 static Vector min(Vector a, Vector b) noexcept { return _mm512_min_pd(a, b); }
+	ABL_TARGET_AVX512 static Vector max(Vector a, Vector b) noexcept { return _mm512_max_pd(a, b); }
+	template<typename IntegralType>
+	ABL_TARGET_AVX512 static Vector saturate(Vector value) noexcept {
+		return min(max(value, broadcast(std::numeric_limits<IntegralType>::lowest())), broadcast(std::numeric_limits<IntegralType>::max()));
+	}
+};
+
+template<>
+struct Avx512Traits<int32_t> : Avx512Traits<double> {
+	ABL_TARGET_AVX512 static Vector load(const int32_t* source) noexcept { return _mm512_maskz_cvtepi32_pd(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))); }
+	ABL_TARGET_AVX512 static void store(int32_t* destination, Vector value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), _mm512_maskz_cvttpd_epi32(0xFF, saturate<int32_t>(value))); }
+};
+
+template<>
+struct Avx512Traits<int16_t> : Avx512Traits<double> {
+	ABL_TARGET_AVX512 static Vector load(const int16_t* source) noexcept { return _mm512_maskz_cvtepi32_pd(0xFF, _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)))); }
+	ABL_TARGET_AVX512 static void store(int16_t* destination, Vector value) noexcept {
+		auto samples = _mm512_maskz_cvttpd_epi32(0xFF, saturate<int16_t>(value));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packs_epi32(_mm256_castsi256_si128(samples), _mm256_extracti128_si256(samples, 1)));
+	}
+};
+
+} // abl::kernels
+
+#endif
+
+#endif //ABL_X86SIMDTRAITS_H
@@ -5,6 +5,16 @@
 #define AUDIOBUFFERS_2DARRAYALLOCATOR_H
 
 #include <memory>
+#include <new>
+#include <cstdlib>
+#include <cassert>
+#include <concepts>
+#include <algorithm>
+#include <memory_resource>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 namespace abl {
 
@@ -67,6 +77,205 @@ void deallocateContiguous2DArray(T** array) {
 	}
 }
 
+//Allocation policies used by the buffers that manage their memory. The rows (channels) are stored in a single memory area,
+//getRowStride() return the distance (in samples) between the start of two rows allocated for rowSize samples.
+//The policies can have a state (like the memory resource used), the buffers keep a copy of it
+template<typename Allocator, typename T>
+concept Contiguous2DArrayAllocatorType = std::copyable<Allocator> && requires(Allocator allocator, size_t rows, size_t rowSize, bool zeroData, T** array)
+{
+	{ allocator.template allocate<T>(rows, rowSize, zeroData) } -> std::same_as<T**>;
+	{ allocator.template deallocate<T>(array) };
+	{ allocator.template getRowStride<T>(rowSize) } -> std::same_as<size_t>;
+};
+
+//Rows allocated with new[], one after the other without padding
+struct NewContiguous2DArrayAllocator {
+	template<typename T>
+	static T** allocate(size_t rows, size_t rowSize, bool zeroData = true) { return allocateContiguous2DArray<T>(rows, rowSize, zeroData); }
+
+	template<typename T>
+	static void deallocate(T** array) { deallocateContiguous2DArray<T>(array); }
+
+	template<typename T>
+	static size_t getRowStride(size_t rowSize) noexcept { return rowSize; }
+};
+
+//Every row start at a multiple of rowAlignment bytes (64 = cache line and AVX-512 register size).
+//If avoidCacheAliasing is true and the rows stride is a multiple of 4KB, a padding of rowAlignment bytes is added to every row,
+//so the same sample of different channels doesn't map to the same cache set (and the loads of a channel aren't falsely
+//dependent from the stores of the previous one).
+//When the samples area is at least hugePagesMinimumSize bytes (0 = never), it's aligned to 2MB and on linux marked for
+//transparent huge pages with madvise, reducing the TLB misses on very big buffers
+template<size_t rowAlignment = 64, bool avoidCacheAliasing = true, size_t hugePagesMinimumSize = 0>
+struct AlignedContiguous2DArrayAllocator {
+	static_assert(rowAlignment > 0 && (rowAlignment & (rowAlignment - 1)) == 0, "The row alignment must be a power of two");
+	static_assert(rowAlignment >= alignof(void*), "The row alignment must be at least the pointer alignment");
+
+	static constexpr size_t hugePageSize = 2 * 1024 * 1024;
+	static constexpr size_t cacheAliasingSize = 4096;
+
+	template<typename T>
+	static constexpr size_t getRowStride(size_t rowSize) noexcept {
+		static_assert(rowAlignment % sizeof(T) == 0, "The row alignment must be a multiple of the sample size");
+		auto rowStrideBytes = roundUp(rowSize * sizeof(T), rowAlignment);
+		if(avoidCacheAliasing && rowStrideBytes > 0 && rowStrideBytes % cacheAliasingSize == 0) {
+			rowStrideBytes += rowAlignment;
+		}
+		return rowStrideBytes / sizeof(T);
+	}
+
+	template<typename T>
+	static T** allocate(size_t rows, size_t rowSize, bool zeroData = true) {
+		if(rows < 1) {
+			return nullptr;
+		}
+		auto array = new T*[rows];
+
+		if(rowSize > 0) {
+			auto rowStride = getRowStride<T>(rowSize);
+			auto samplesBytes = rows * rowStride * sizeof(T);
+			auto useHugePages = hugePagesMinimumSize > 0 && samplesBytes >= hugePagesMinimumSize;
+			auto alignment = useHugePages ? std::max(hugePageSize, rowAlignment) : rowAlignment;
+			if(useHugePages) {
+				samplesBytes = roundUp(samplesBytes, hugePageSize);
+			}
+
+			auto samples = static_cast<T*>(allocateAlignedMemory(samplesBytes, alignment));
+			if(!samples) {
+				delete[] array;
+				throw std::bad_alloc();
+			}
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+			if(useHugePages) {
+				madvise(samples, samplesBytes, MADV_HUGEPAGE); //only an hint, the normal pages are used if it fails
+			}
+#endif
+			if(zeroData) {
+				std::fill_n(samples, rows * rowStride, T(0));
+			}
+
+			for(size_t row = 0; row < rows; ++row) {
+				array[row] = samples + row * rowStride;
+			}
+		} else {
+			for(size_t row = 0; row < rows; ++row) {
+				array[row] = nullptr;
+			}
+		}
+
+		return array;
+	}
+
+	template<typename T>
+	static void deallocate(T** array) {
+		if(array) {
+			freeAlignedMemory(array[0]);
+			delete[] array;
+		}
+	}
+
+private:
+	static constexpr size_t roundUp(size_t value, size_t multiple) noexcept {
+		return (value + multiple - 1) / multiple * multiple;
+	}
+
+	static void* allocateAlignedMemory(size_t bytes, size_t alignment) noexcept {
+#if defined(_WIN32)
+		return _aligned_malloc(bytes, alignment);
+#else
+		void* memory = nullptr;
+		return posix_memalign(&memory, alignment, bytes) == 0 ? memory : nullptr;
+#endif
+	}
+
+	static void freeAlignedMemory(void* memory) noexcept {
+#if defined(_WIN32)
+		_aligned_free(memory);
+#else
+		free(memory);
+#endif
+	}
+};
+
+using DefaultContiguous2DArrayAllocator = AlignedContiguous2DArrayAllocator<>;
+
+//Aligned allocation that use the transparent huge pages for the buffers bigger than hugePagesMinimumSize bytes
+template<size_t hugePagesMinimumSize = 4 * 1024 * 1024>
+using HugePagesContiguous2DArrayAllocator = AlignedContiguous2DArrayAllocator<64, true, hugePagesMinimumSize>;
+
+//Allocate the rows from a std::pmr::memory_resource (like MonotonicArenaResource or LockFreePoolResource), with the same
+//alignment and padding of AlignedContiguous2DArrayAllocator. The rows pointers and the samples are allocated in a single block
+//(of getAllocationSize() bytes), so a buffer cost a single allocation from the resource
+template<size_t rowAlignment = 64, bool avoidCacheAliasing = true>
+class MemoryResourceContiguous2DArrayAllocator {
+public:
+	MemoryResourceContiguous2DArrayAllocator(std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource()) noexcept
+		: m_memoryResource{memoryResource}
+	{
+		assert(memoryResource);
+	}
+
+	template<typename T>
+	static size_t getRowStride(size_t rowSize) noexcept {
+		return AlignedContiguous2DArrayAllocator<rowAlignment, avoidCacheAliasing>::template getRowStride<T>(rowSize);
+	}
+
+	template<typename T>
+	static size_t getAllocationSize(size_t rows, size_t rowSize) noexcept {
+		return getHeaderSize<T>(rows) + rows * getRowStride<T>(rowSize) * sizeof(T);
+	}
+
+	template<typename T>
+	T** allocate(size_t rows, size_t rowSize, bool zeroData = true) {
+		if(rows < 1) {
+			return nullptr;
+		}
+
+		//The block start with his size (needed to deallocate it), followed by the rows pointers and the rows
+		auto allocationSize = getAllocationSize<T>(rows, rowSize);
+		auto block = static_cast<std::byte*>(m_memoryResource->allocate(allocationSize, rowAlignment));
+		*reinterpret_cast<size_t*>(block) = allocationSize;
+		auto array = reinterpret_cast<T**>(block + sizeof(size_t));
+
+		if(rowSize > 0) {
+			auto rowStride = getRowStride<T>(rowSize);
+			auto samples = reinterpret_cast<T*>(block + getHeaderSize<T>(rows));
+			if(zeroData) {
+				std::fill_n(samples, rows * rowStride, T(0));
+			}
+			for(size_t row = 0; row < rows; ++row) {
+				array[row] = samples + row * rowStride;
+			}
+		} else {
+			for(size_t row = 0; row < rows; ++row) {
+				array[row] = nullptr;
+			}
+		}
+
+		return array;
+	}
+
+	template<typename T>
+	void deallocate(T** array) {
+		if(array) {
+			auto block = reinterpret_cast<std::byte*>(array) - sizeof(size_t);
+			m_memoryResource->deallocate(block, *reinterpret_cast<size_t*>(block), rowAlignment);
+		}
+	}
+
+	[[nodiscard]] std::pmr::memory_resource* getMemoryResource() const noexcept { return m_memoryResource; }
+
+private:
+	static_assert(rowAlignment >= alignof(size_t) && rowAlignment >= alignof(void*), "The row alignment must be at least the size_t and pointer alignment");
+
+	template<typename T>
+	static size_t getHeaderSize(size_t rows) noexcept {
+		return (sizeof(size_t) + rows * sizeof(T*) + rowAlignment - 1) / rowAlignment * rowAlignment;
+	}
+
+	std::pmr::memory_resource* m_memoryResource;
+};
+
 }
 
 #endif //AUDIOBUFFERS_2DARRAYALLOCATOR_H
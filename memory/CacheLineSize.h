@@ -0,0 +1,21 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_CACHELINESIZE_H
+#define ABL_CACHELINESIZE_H
+
+#include <cstddef>
+
+namespace abl {
+
+//Used to keep the atomics written by different threads on different cache lines (to avoid false sharing).
+//std::hardware_destructive_interference_size isn't used because his value can change with the compiler flags
+#if defined(__APPLE__) && defined(__aarch64__)
+inline constexpr size_t cacheLineSize = 128;
+#else
+inline constexpr size_t cacheLineSize = 64;
+#endif
+
+} // abl
+
+#endif //ABL_CACHELINESIZE_H
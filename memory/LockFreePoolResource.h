@@ -0,0 +1,117 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_LOCKFREEPOOLRESOURCE_H
+#define ABL_LOCKFREEPOOLRESOURCE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "CacheLineSize.h"
+
+namespace abl {
+
+//Memory resource that give out blocks of a fixed size, preallocated at construction (from the upstream resource).
+//The free blocks are kept in a lock-free stack (with a counter against the ABA problem), so the blocks can be allocated
+//and deallocated from any thread without locks and without touching the global heap.
+//The requests bigger than the block size (or when all the blocks are used) are forwarded to the fallback resource
+//(by default the null resource, that throw std::bad_alloc)
+class LockFreePoolResource : public std::pmr::memory_resource {
+public:
+	LockFreePoolResource(size_t blockSize, size_t blocksCount, size_t blockAlignment = 64, std::pmr::memory_resource* upstreamResource = std::pmr::get_default_resource(), std::pmr::memory_resource* fallbackResource = std::pmr::null_memory_resource())
+		: m_upstreamResource{upstreamResource},
+		  m_fallbackResource{fallbackResource},
+		  m_blockAlignment{blockAlignment},
+		  m_blockSize{(blockSize + blockAlignment - 1) / blockAlignment * blockAlignment},
+		  m_blocksCount{blocksCount},
+		  m_data{static_cast<std::byte*>(upstreamResource->allocate(m_blockSize * blocksCount, blockAlignment))},
+		  m_nextFreeBlocks{std::make_unique<std::atomic<uint32_t>[]>(blocksCount)}
+	{
+		assert(blocksCount > 0 && blocksCount < noBlock);
+		assert(blockAlignment > 0 && (blockAlignment & (blockAlignment - 1)) == 0);
+		for(size_t block = 0; block < blocksCount; ++block) {
+			m_nextFreeBlocks[block].store(block + 1 < blocksCount ? static_cast<uint32_t>(block + 1) : noBlock, std::memory_order_relaxed);
+		}
+		m_freeBlocksHead.store(createHead(0, 0), std::memory_order_release);
+	}
+
+	LockFreePoolResource(const LockFreePoolResource&) = delete;
+	LockFreePoolResource& operator= (const LockFreePoolResource&) = delete;
+
+	~LockFreePoolResource() override {
+		m_upstreamResource->deallocate(m_data, m_blockSize * m_blocksCount, m_blockAlignment);
+	}
+
+	[[nodiscard]] size_t getBlockSize() const noexcept { return m_blockSize; }
+	[[nodiscard]] size_t getBlocksCount() const noexcept { return m_blocksCount; }
+
+	//Approximated when other threads are allocating or deallocating
+	[[nodiscard]] size_t getUsedBlocksCount() const noexcept { return m_usedBlocksCount.load(std::memory_order_relaxed); }
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		if(bytes > m_blockSize || alignment > m_blockAlignment) {
+			return m_fallbackResource->allocate(bytes, alignment);
+		}
+
+		auto head = m_freeBlocksHead.load(std::memory_order_acquire);
+		while(true) {
+			auto block = getHeadBlock(head);
+			if(block == noBlock) {
+				return m_fallbackResource->allocate(bytes, alignment);
+			}
+
+			auto nextBlock = m_nextFreeBlocks[block].load(std::memory_order_relaxed);
+			if(m_freeBlocksHead.compare_exchange_weak(head, createHead(nextBlock, getHeadCounter(head) + 1), std::memory_order_acquire, std::memory_order_acquire)) {
+				m_usedBlocksCount.fetch_add(1, std::memory_order_relaxed);
+				return m_data + block * m_blockSize;
+			}
+		}
+	}
+
+	void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+		auto address = static_cast<std::byte*>(memory);
+		if(address < m_data || address >= m_data + m_blockSize * m_blocksCount) {
+			m_fallbackResource->deallocate(memory, bytes, alignment);
+			return;
+		}
+
+		auto block = static_cast<uint32_t>((address - m_data) / m_blockSize);
+		auto head = m_freeBlocksHead.load(std::memory_order_relaxed);
+		do {
+			m_nextFreeBlocks[block].store(getHeadBlock(head), std::memory_order_relaxed);
+		} while(!m_freeBlocksHead.compare_exchange_weak(head, createHead(block, getHeadCounter(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+		m_usedBlocksCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& otherResource) const noexcept override {
+		return this == &otherResource;
+	}
+
+private:
+	static constexpr uint32_t noBlock = UINT32_MAX;
+
+	//The head of the free blocks stack keep the block index in the lower 32 bits and a counter, incremented at every change, in the upper ones
+	static constexpr uint64_t createHead(uint32_t block, uint64_t counter) noexcept { return (counter << 32) | block; }
+	static constexpr uint32_t getHeadBlock(uint64_t head) noexcept { return static_cast<uint32_t>(head); }
+	static constexpr uint64_t getHeadCounter(uint64_t head) noexcept { return head >> 32; }
+
+	std::pmr::memory_resource* m_upstreamResource;
+	std::pmr::memory_resource* m_fallbackResource;
+	size_t m_blockAlignment;
+	size_t m_blockSize;
+	size_t m_blocksCount;
+	std::byte* m_data;
+	std::unique_ptr<std::atomic<uint32_t>[]> m_nextFreeBlocks;
+
+	alignas(cacheLineSize) std::atomic<uint64_t> m_freeBlocksHead;
+	alignas(cacheLineSize) std::atomic<size_t> m_usedBlocksCount{0};
+};
+
+} // abl
+
+#endif //ABL_LOCKFREEPOOLRESOURCE_H
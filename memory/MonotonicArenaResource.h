@@ -0,0 +1,84 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_MONOTONICARENARESOURCE_H
+#define ABL_MONOTONICARENARESOURCE_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace abl {
+
+//Memory resource that give out consecutive parts of a memory area allocated once at construction (from the upstream resource).
+//The deallocation does nothing, all the memory is given back with reset() (for example at the start of every audio callback,
+//after the scratch buffers of the previous one have been destroyed).
+//When the area is full the request is forwarded to the fallback resource (by default the null resource, that throw std::bad_alloc).
+//Not thread safe: every thread should use his own arena
+class MonotonicArenaResource : public std::pmr::memory_resource {
+public:
+	explicit MonotonicArenaResource(size_t capacity, std::pmr::memory_resource* upstreamResource = std::pmr::get_default_resource(), std::pmr::memory_resource* fallbackResource = std::pmr::null_memory_resource())
+		: m_upstreamResource{upstreamResource},
+		  m_fallbackResource{fallbackResource},
+		  m_capacity{capacity},
+		  m_data{static_cast<std::byte*>(upstreamResource->allocate(capacity, maxAlignment))}
+	{
+		assert(fallbackResource);
+	}
+
+	MonotonicArenaResource(const MonotonicArenaResource&) = delete;
+	MonotonicArenaResource& operator= (const MonotonicArenaResource&) = delete;
+
+	~MonotonicArenaResource() override {
+		m_upstreamResource->deallocate(m_data, m_capacity, maxAlignment);
+	}
+
+	//All the memory given out before is considered free again
+	void reset() noexcept { m_usedBytes = 0; }
+
+	[[nodiscard]] size_t getCapacity() const noexcept { return m_capacity; }
+	[[nodiscard]] size_t getUsedBytes() const noexcept { return m_usedBytes; }
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		auto address = reinterpret_cast<std::uintptr_t>(m_data) + m_usedBytes;
+		auto padding = (alignment - address % alignment) % alignment;
+		if(alignment > maxAlignment || m_usedBytes + padding + bytes > m_capacity) {
+			return m_fallbackResource->allocate(bytes, alignment);
+		}
+
+		auto memory = m_data + m_usedBytes + padding;
+		m_usedBytes += padding + bytes;
+		return memory;
+	}
+
+	void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+		if(!isInArena(memory)) {
+			m_fallbackResource->deallocate(memory, bytes, alignment);
+		}
+	}
+
+	[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& otherResource) const noexcept override {
+		return this == &otherResource;
+	}
+
+private:
+	//The area is aligned to the biggest alignment used by the buffers allocators, bigger alignments go to the fallback resource
+	static constexpr size_t maxAlignment = 64;
+
+	[[nodiscard]] bool isInArena(const void* memory) const noexcept {
+		auto address = static_cast<const std::byte*>(memory);
+		return address >= m_data && address < m_data + m_capacity;
+	}
+
+	std::pmr::memory_resource* m_upstreamResource;
+	std::pmr::memory_resource* m_fallbackResource;
+	size_t m_capacity;
+	std::byte* m_data;
+	size_t m_usedBytes = 0;
+};
+
+} // abl
+
+#endif //ABL_MONOTONICARENARESOURCE_H
@@ -0,0 +1,178 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SEGMENTEDITERATOR_H
+#define ABL_SEGMENTEDITERATOR_H
+
+#include "../datatypes/CircularSpans.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace abl {
+
+//Random access iterator on the (at most two) contiguous segments of a CircularSpans.
+//The same type is used for the normal and the circular channel views, so there's no variant to visit on every operation,
+//and the increment is a pointer increment plus the check for the segment change
+template <typename T>
+class SegmentedIterator {
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_cv_t<T>;
+	using reference = T&;
+	using pointer = T*;
+	using difference_type = std::ptrdiff_t;
+
+	SegmentedIterator() : m_firstSegment{nullptr}, m_firstSegmentSize{0}, m_secondSegment{nullptr}, m_size{0}, m_index{0}, m_current{nullptr} {}
+	SegmentedIterator(const CircularSpans<T>& spans, size_t index) : m_firstSegment{spans.first.data()}, m_firstSegmentSize{spans.first.size()}, m_secondSegment{spans.second.data()}, m_size{spans.size()}, m_index{index}, m_current{getPointer(index)} {}
+	SegmentedIterator(const SegmentedIterator& otherIterator) = default;
+	SegmentedIterator& operator=(const SegmentedIterator& otherIterator) = default;
+
+	inline T& operator*() const { return *m_current; }
+	inline T* operator->() const { return m_current; }
+	inline T& operator[](difference_type difference) const { return *getPointer(m_index + difference); }
+
+	inline SegmentedIterator& operator++() { increment(); return *this; }
+	inline SegmentedIterator& operator--() { decrement(); return *this; }
+	inline SegmentedIterator operator++(int) { SegmentedIterator tmp(*this); increment(); return tmp; }
+	inline SegmentedIterator operator--(int) { SegmentedIterator tmp(*this); decrement(); return tmp; }
+
+	inline SegmentedIterator operator+(difference_type difference) const { SegmentedIterator tmp(*this); tmp.advanceBy(difference); return tmp; }
+	inline SegmentedIterator operator-(difference_type difference) const { SegmentedIterator tmp(*this); tmp.advanceBy(-difference); return tmp; }
+	inline difference_type operator-(const SegmentedIterator& otherIterator) const { return difference_type(m_index) - difference_type(otherIterator.m_index); }
+	inline SegmentedIterator& operator+=(difference_type difference) { advanceBy(difference); return *this; }
+	inline SegmentedIterator& operator-=(difference_type difference) { advanceBy(-difference); return *this; }
+	friend inline SegmentedIterator operator+(difference_type difference, const SegmentedIterator& otherIterator) { SegmentedIterator tmp(otherIterator); tmp.advanceBy(difference); return tmp; }
+
+	inline bool operator==(const SegmentedIterator& otherIterator) const { return m_index == otherIterator.m_index; }
+	inline bool operator!=(const SegmentedIterator& otherIterator) const { return m_index != otherIterator.m_index; }
+	inline auto operator<=>(const SegmentedIterator& otherIterator) const { return m_index <=> otherIterator.m_index; }
+
+	//Number of samples, starting from the current one, that are contiguous in memory (until the end of the current segment)
+	[[nodiscard]] inline size_t getContiguousSamplesCount() const { return m_index < m_firstSegmentSize ? m_firstSegmentSize - m_index : m_size - m_index; }
+
+private:
+	inline T* getPointer(size_t index) const {
+		return index < m_firstSegmentSize ? m_firstSegment + index : m_secondSegment + (index - m_firstSegmentSize);
+	}
+
+	void increment() {
+		if(++m_index == m_firstSegmentSize) {
+			m_current = m_secondSegment;
+		} else {
+			++m_current;
+		}
+	}
+
+	void decrement() {
+		if(m_index-- == m_firstSegmentSize) {
+			m_current = m_firstSegment + m_index;
+		} else {
+			--m_current;
+		}
+	}
+
+	void advanceBy(difference_type difference) {
+		m_index += difference;
+		m_current = getPointer(m_index);
+	}
+
+	T* m_firstSegment;
+	size_t m_firstSegmentSize;
+	T* m_secondSegment;
+	size_t m_size;
+	size_t m_index;
+	T* m_current;
+};
+
+//Call function(data, samplesCount) for each contiguous part between first and last (at most two)
+template <typename T, typename Function>
+void forEachSegment(SegmentedIterator<T> first, const SegmentedIterator<T>& last, Function&& function) {
+	assert(first <= last);
+	while(first != last) {
+		auto samplesCount = std::min(first.getContiguousSamplesCount(), size_t(last - first));
+		function(&*first, samplesCount);
+		first += std::ptrdiff_t(samplesCount);
+	}
+}
+
+template <typename T>
+concept SegmentedRange = requires(T& range) {
+	{ range.begin() } -> std::same_as<SegmentedIterator<std::remove_reference_t<decltype(*range.begin())>>>;
+	{ range.end() } -> std::same_as<SegmentedIterator<std::remove_reference_t<decltype(*range.begin())>>>;
+};
+
+//Segmented versions of the std::ranges algorithms, with the same results: the outer loop is on the segments and the inner loop on raw pointers
+namespace ranges {
+
+template <typename T, typename Function>
+std::ranges::for_each_result<SegmentedIterator<T>, Function> for_each(SegmentedIterator<T> first, SegmentedIterator<T> last, Function function) {
+	forEachSegment(first, last, [&function](T* data, size_t samplesCount) {
+		for(size_t i = 0; i < samplesCount; ++i) {
+			std::invoke(function, data[i]);
+		}
+	});
+	return {std::move(last), std::move(function)};
+}
+
+template <SegmentedRange Range, typename Function>
+auto for_each(Range&& range, Function function) { return ranges::for_each(range.begin(), range.end(), std::move(function)); }
+
+template <typename T, typename ValueType>
+SegmentedIterator<T> fill(SegmentedIterator<T> first, SegmentedIterator<T> last, const ValueType& value) {
+	forEachSegment(first, last, [&value](T* data, size_t samplesCount) {
+		std::fill_n(data, samplesCount, value);
+	});
+	return last;
+}
+
+template <SegmentedRange Range, typename ValueType>
+auto fill(Range&& range, const ValueType& value) { return ranges::fill(range.begin(), range.end(), value); }
+
+template <typename T, std::weakly_incrementable OutputIterator>
+std::ranges::copy_result<SegmentedIterator<T>, OutputIterator> copy(SegmentedIterator<T> first, SegmentedIterator<T> last, OutputIterator result) {
+	if constexpr (std::is_same_v<OutputIterator, SegmentedIterator<std::remove_const_t<T>>>) {
+		//Both sides are segmented, copy the parts contiguous in both (at most three)
+		forEachSegment(first, last, [&result](T* data, size_t samplesCount) {
+			while(samplesCount > 0) {
+				auto partSamplesCount = std::min(samplesCount, result.getContiguousSamplesCount());
+				std::copy_n(data, partSamplesCount, &*result);
+				result += std::iter_difference_t<OutputIterator>(partSamplesCount);
+				data += partSamplesCount;
+				samplesCount -= partSamplesCount;
+			}
+		});
+	} else {
+		forEachSegment(first, last, [&result](T* data, size_t samplesCount) {
+			result = std::copy_n(data, samplesCount, std::move(result));
+		});
+	}
+	return {std::move(last), std::move(result)};
+}
+
+template <SegmentedRange Range, std::weakly_incrementable OutputIterator>
+auto copy(Range&& range, OutputIterator result) { return ranges::copy(range.begin(), range.end(), std::move(result)); }
+
+template <typename T, std::weakly_incrementable OutputIterator, typename Function>
+std::ranges::unary_transform_result<SegmentedIterator<T>, OutputIterator> transform(SegmentedIterator<T> first, SegmentedIterator<T> last, OutputIterator result, Function function) {
+	forEachSegment(first, last, [&result, &function](T* data, size_t samplesCount) {
+		for(size_t i = 0; i < samplesCount; ++i, ++result) {
+			*result = std::invoke(function, data[i]);
+		}
+	});
+	return {std::move(last), std::move(result)};
+}
+
+template <SegmentedRange Range, std::weakly_incrementable OutputIterator, typename Function>
+auto transform(Range&& range, OutputIterator result, Function function) { return ranges::transform(range.begin(), range.end(), std::move(result), std::move(function)); }
+
+} // ranges
+
+} // abl
+
+#endif //ABL_SEGMENTEDITERATOR_H
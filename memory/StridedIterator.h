@@ -0,0 +1,53 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_STRIDEDITERATOR_H
+#define ABL_STRIDEDITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+namespace abl {
+
+//Iterator on the samples of a channel inside interleaved frames, that move by stride samples at every step
+template <typename T>
+class StridedIterator {
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = T;
+	using reference = T&;
+	using pointer = T*;
+	using difference_type = std::ptrdiff_t;
+
+	StridedIterator() : m_current{nullptr}, m_stride{1} {}
+	StridedIterator(T* current, difference_type stride) : m_current{current}, m_stride{stride} {}
+	StridedIterator(const StridedIterator &otherIterator) : m_current{otherIterator.m_current}, m_stride{otherIterator.m_stride} {}
+	StridedIterator& operator=(const StridedIterator& otherIterator) = default;
+	inline T& operator*() const { return *m_current; }
+	inline T* operator->() const { return m_current; }
+	inline T& operator[](difference_type difference) const { return m_current[difference * m_stride]; }
+
+	inline StridedIterator& operator++() { m_current += m_stride;  return *this; }
+	inline StridedIterator& operator--() { m_current -= m_stride;  return *this; }
+	inline StridedIterator operator++(int) { StridedIterator tmp(*this); m_current += m_stride;  return tmp; }
+	inline StridedIterator operator--(int) { StridedIterator tmp(*this); m_current -= m_stride;  return tmp; }
+
+	inline StridedIterator operator+(difference_type difference) const { return StridedIterator(m_current + difference * m_stride, m_stride); }
+	inline StridedIterator operator-(difference_type difference) const { return StridedIterator(m_current - difference * m_stride, m_stride); }
+	inline difference_type operator-(const StridedIterator& otherIterator) const { return difference_type(m_current - otherIterator.m_current) / m_stride; }
+	inline StridedIterator& operator+=(difference_type difference) { m_current += difference * m_stride;  return *this;}
+	inline StridedIterator& operator-=(difference_type difference) { m_current -= difference * m_stride;  return *this;}
+	friend inline StridedIterator operator+(difference_type difference, const StridedIterator& iterator) { return iterator + difference; }
+
+	inline bool operator==(const StridedIterator& otherIterator) const { return m_current == otherIterator.m_current; }
+	inline bool operator!=(const StridedIterator& otherIterator) const { return m_current != otherIterator.m_current; }
+	inline auto operator<=>(const StridedIterator& otherIterator) const { return m_current <=> otherIterator.m_current; }
+
+private:
+	T* m_current;
+	difference_type m_stride;
+};
+
+} // abl
+
+#endif //ABL_STRIDEDITERATOR_H
@@ -0,0 +1,137 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOJOBGRAPH_H
+#define ABL_AUDIOJOBGRAPH_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "../buffers/AudioBufferView.h"
+
+namespace abl {
+
+//Memory read or written by a job: a samples range of every channel of a view.
+//Use a view with a channels mapping (or a ranged view) to declare only a group of channels
+class AudioJobAccess {
+public:
+	template<NumericType AudioSampleType>
+	static AudioJobAccess reading(const AudioBufferView<AudioSampleType>& buffer, const SamplesRange& samplesRange = {}) {
+		return AudioJobAccess{buffer, samplesRange, false};
+	}
+
+	template<NumericType AudioSampleType>
+	static AudioJobAccess writing(const AudioBufferView<AudioSampleType>& buffer, const SamplesRange& samplesRange = {}) {
+		return AudioJobAccess{buffer, samplesRange, true};
+	}
+
+	//Two accesses conflict when they touch the same memory and at least one of them write it
+	[[nodiscard]] bool conflictsWith(const AudioJobAccess& otherAccess) const noexcept {
+		if(!m_isWrite && !otherAccess.m_isWrite) {
+			return false;
+		}
+
+		for(const auto& memoryRange : m_memoryRanges) {
+			for(const auto& otherMemoryRange : otherAccess.m_memoryRanges) {
+				if(memoryRange.begin < otherMemoryRange.end && otherMemoryRange.begin < memoryRange.end) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	[[nodiscard]] bool isWrite() const noexcept { return m_isWrite; }
+
+private:
+	struct MemoryRange {
+		uintptr_t begin;
+		uintptr_t end;
+	};
+
+	template<NumericType AudioSampleType>
+	AudioJobAccess(const AudioBufferView<AudioSampleType>& buffer, const SamplesRange& samplesRange, bool isWrite) : m_isWrite{isWrite} {
+		auto samplesCount = samplesRange.getRealSamplesCount(buffer.getBufferSize());
+		assert(samplesRange.startSample + samplesCount <= buffer.getBufferSize());
+		m_memoryRanges.reserve(buffer.getChannelsCount());
+		for(size_t channel = 0; channel < buffer.getChannelsCount(); ++channel) {
+			auto begin = reinterpret_cast<uintptr_t>(buffer.getChannelRawData(channel, samplesRange.startSample));
+			m_memoryRanges.push_back({begin, begin + samplesCount * sizeof(AudioSampleType)});
+		}
+	}
+
+	std::vector<MemoryRange> m_memoryRanges;
+	bool m_isWrite;
+};
+
+//Jobs with the buffers memory they read and write, built outside of the audio callback and executed every block by an AudioJobSystem.
+//A job depends on all the jobs added before it that access the same memory (with at least one of the two writing it), so the jobs that work on
+//different buffers or different channels groups run in parallel, while the others keep the order in which they were added
+class AudioJobGraph {
+public:
+	using JobFunction = std::function<void()>;
+
+	//Add a job and return its index
+	size_t addJob(JobFunction function, std::initializer_list<AudioJobAccess> accesses = {}) {
+		auto jobIndex = m_jobs.size();
+		assert(jobIndex < std::numeric_limits<uint32_t>::max());
+		auto& job = m_jobs.emplace_back(Job{std::move(function), std::vector<AudioJobAccess>(accesses), {}, 0});
+		for(size_t previousJobIndex = 0; previousJobIndex < jobIndex; ++previousJobIndex) {
+			if(accessesConflict(m_jobs[previousJobIndex].accesses, job.accesses)) {
+				addDependency(previousJobIndex, jobIndex);
+			}
+		}
+		return jobIndex;
+	}
+
+	//Make secondJob wait the end of firstJob, for the dependencies that aren't declared with the accesses
+	void addDependency(size_t firstJob, size_t secondJob) {
+		assert(firstJob < secondJob);
+		assert(secondJob < m_jobs.size());
+		auto& successors = m_jobs[firstJob].successors;
+		if(std::find(successors.begin(), successors.end(), uint32_t(secondJob)) == successors.end()) {
+			successors.push_back(uint32_t(secondJob));
+			++m_jobs[secondJob].dependenciesCount;
+		}
+	}
+
+	void clear() { m_jobs.clear(); }
+
+	[[nodiscard]] size_t getJobsCount() const noexcept { return m_jobs.size(); }
+	[[nodiscard]] const std::vector<uint32_t>& getSuccessors(size_t job) const noexcept { return m_jobs[job].successors; }
+	[[nodiscard]] uint32_t getDependenciesCount(size_t job) const noexcept { return m_jobs[job].dependenciesCount; }
+
+	void runJob(size_t job) const { m_jobs[job].function(); }
+
+	//Run all the jobs on the calling thread, in the order they were added (that respect all the dependencies)
+	void runSerially() const {
+		for(const auto& job : m_jobs) {
+			job.function();
+		}
+	}
+
+private:
+	struct Job {
+		JobFunction function;
+		std::vector<AudioJobAccess> accesses;
+		std::vector<uint32_t> successors;
+		uint32_t dependenciesCount;
+	};
+
+	static bool accessesConflict(const std::vector<AudioJobAccess>& firstAccesses, const std::vector<AudioJobAccess>& secondAccesses) noexcept {
+		return std::any_of(firstAccesses.begin(), firstAccesses.end(), [&](const AudioJobAccess& firstAccess) {
+			return std::any_of(secondAccesses.begin(), secondAccesses.end(), [&](const AudioJobAccess& secondAccess) { return firstAccess.conflictsWith(secondAccess); });
+		});
+	}
+
+	std::vector<Job> m_jobs;
+};
+
+} // abl
+
+#endif //ABL_AUDIOJOBGRAPH_H
@@ -0,0 +1,189 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_AUDIOJOBSYSTEM_H
+#define ABL_AUDIOJOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "AudioJobGraph.h"
+#include "SpinWait.h"
+#include "WorkStealingDeque.h"
+#include "../memory/CacheLineSize.h"
+
+namespace abl {
+
+//Execute an AudioJobGraph on the calling thread (usually the audio thread) and on worker threads created in the constructor.
+//The dependencies counters and a WorkStealingDeque for every thread are allocated in the constructor for up to maxJobsCount jobs, so run never allocate or lock:
+//the jobs without dependencies are split between the deques, every thread pop the jobs of its deque and steal the ones of the others when it's empty,
+//and a job that complete push its successors that became ready on the deque of its thread. The idle threads spin for a while before sleeping on a futex.
+//A run called while another one is executing (from another thread or from inside a job) execute the graph serially on the calling thread
+class AudioJobSystem {
+public:
+	explicit AudioJobSystem(size_t maxJobsCount, size_t threadsCount = std::max(std::thread::hardware_concurrency(), 1u) - 1)
+			: m_maxJobsCount{maxJobsCount},
+			  m_pendingDependencies{std::make_unique<std::atomic<uint32_t>[]>(maxJobsCount)},
+			  m_participants{std::make_unique<Participant[]>(threadsCount + 1)} {
+		for(size_t participant = 0; participant < threadsCount + 1; ++participant) {
+			m_participants[participant].deque = std::make_unique<WorkStealingDeque>(maxJobsCount);
+		}
+		m_workers.reserve(threadsCount);
+		for(size_t worker = 0; worker < threadsCount; ++worker) {
+			m_workers.emplace_back([this, worker]() { workerLoop(worker + 1); });
+		}
+	}
+
+	AudioJobSystem(const AudioJobSystem&) = delete;
+	AudioJobSystem& operator=(const AudioJobSystem&) = delete;
+
+	~AudioJobSystem() {
+		m_state.store((getGeneration(m_state.load(std::memory_order_relaxed)) + 1) << participantsBits | stopParticipants, std::memory_order_release);
+		m_state.notify_all();
+		for(auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	//Run all the jobs of the graph respecting their dependencies, returning when all of them are completed
+	void run(const AudioJobGraph& graph) noexcept {
+		auto jobsCount = graph.getJobsCount();
+		assert(jobsCount <= m_maxJobsCount);
+		if(jobsCount == 0) {
+			return;
+		}
+
+		if(jobsCount == 1 || m_workers.empty() || m_busy.exchange(true, std::memory_order_acquire)) {
+			graph.runSerially();
+			return;
+		}
+
+		size_t participantsCount = std::min(m_workers.size() + 1, jobsCount);
+		for(size_t participant = 0; participant < participantsCount; ++participant) {
+			m_participants[participant].deque->reset();
+		}
+		size_t nextParticipant = 0;
+		for(size_t job = 0; job < jobsCount; ++job) {
+			auto dependenciesCount = graph.getDependenciesCount(job);
+			m_pendingDependencies[job].store(dependenciesCount, std::memory_order_relaxed);
+			if(dependenciesCount == 0) {
+				m_participants[nextParticipant].deque->push(uint32_t(job));
+				nextParticipant = (nextParticipant + 1) % participantsCount;
+			}
+		}
+		m_graph = &graph;
+		m_participantsCount = participantsCount;
+		m_remainingJobs.store(jobsCount, std::memory_order_relaxed);
+		m_runningWorkers.store(participantsCount - 1, std::memory_order_relaxed);
+
+		auto generation = getGeneration(m_state.load(std::memory_order_relaxed)) + 1;
+		m_state.store(generation << participantsBits | participantsCount, std::memory_order_release);
+		m_state.notify_all();
+
+		runJobs(0);
+
+		auto runningWorkers = m_runningWorkers.load(std::memory_order_acquire);
+		while(runningWorkers != 0) {
+			runningWorkers = parallelism::spinThenWait(m_runningWorkers, runningWorkers);
+		}
+
+		m_busy.store(false, std::memory_order_release);
+	}
+
+	[[nodiscard]] size_t getConcurrency() const noexcept { return m_workers.size() + 1; }
+	[[nodiscard]] size_t getMaxJobsCount() const noexcept { return m_maxJobsCount; }
+
+private:
+	//The generation and the participants count are stored in the same atomic, as in WorkStealingThreadPool
+	static constexpr uint64_t participantsBits = 16;
+	static constexpr uint64_t participantsMask = (uint64_t(1) << participantsBits) - 1;
+	static constexpr uint64_t stopParticipants = participantsMask;
+
+	static constexpr uint64_t getGeneration(uint64_t state) noexcept { return state >> participantsBits; }
+
+	struct alignas(cacheLineSize) Participant {
+		std::unique_ptr<WorkStealingDeque> deque;
+	};
+
+	void workerLoop(size_t participant) noexcept {
+		uint64_t lastState = 0;
+		while(true) {
+			lastState = parallelism::spinThenWait(m_state, lastState);
+			auto participantsCount = lastState & participantsMask;
+			if(participantsCount == stopParticipants) {
+				return;
+			}
+
+			if(participant < participantsCount) {
+				runJobs(participant);
+				if(m_runningWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					m_runningWorkers.notify_one();
+				}
+			}
+		}
+	}
+
+	std::optional<uint32_t> findJob(size_t participant) noexcept {
+		if(auto job = m_participants[participant].deque->pop()) {
+			return job;
+		}
+
+		for(size_t offset = 1; offset < m_participantsCount; ++offset) {
+			if(auto job = m_participants[(participant + offset) % m_participantsCount].deque->steal()) {
+				return job;
+			}
+		}
+		return std::nullopt;
+	}
+
+	void runJobs(size_t participant) noexcept {
+		while(m_remainingJobs.load(std::memory_order_acquire) != 0) {
+			//The epoch is read before looking for a job, so a job pushed after the search change it and wake up the wait
+			auto readyEpoch = m_readyEpoch.load(std::memory_order_acquire);
+			if(auto job = findJob(participant)) {
+				executeJob(*job, participant);
+			} else if(m_remainingJobs.load(std::memory_order_acquire) != 0) {
+				parallelism::spinThenWait(m_readyEpoch, readyEpoch);
+			}
+		}
+	}
+
+	void executeJob(uint32_t job, size_t participant) noexcept {
+		m_graph->runJob(job);
+
+		bool pushedJobs = false;
+		for(auto successor : m_graph->getSuccessors(job)) {
+			if(m_pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				m_participants[participant].deque->push(successor);
+				pushedJobs = true;
+			}
+		}
+
+		bool lastJob = m_remainingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		if(pushedJobs || lastJob) {
+			m_readyEpoch.fetch_add(1, std::memory_order_release);
+			m_readyEpoch.notify_all();
+		}
+	}
+
+	size_t m_maxJobsCount;
+	std::unique_ptr<std::atomic<uint32_t>[]> m_pendingDependencies;
+	std::unique_ptr<Participant[]> m_participants;
+	std::vector<std::thread> m_workers;
+	const AudioJobGraph* m_graph = nullptr;
+	size_t m_participantsCount = 0;
+	alignas(cacheLineSize) std::atomic<uint64_t> m_state{0};
+	alignas(cacheLineSize) std::atomic<uint32_t> m_readyEpoch{0};
+	alignas(cacheLineSize) std::atomic<size_t> m_remainingJobs{0};
+	alignas(cacheLineSize) std::atomic<size_t> m_runningWorkers{0};
+	std::atomic<bool> m_busy{false};
+};
+
+} // abl
+
+#endif //ABL_AUDIOJOBSYSTEM_H
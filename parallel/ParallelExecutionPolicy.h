@@ -0,0 +1,103 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_PARALLELEXECUTIONPOLICY_H
+#define ABL_PARALLELEXECUTIONPOLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "TaskExecutor.h"
+
+namespace abl {
+
+//Passed as the first parameter of the buffers operations to split their channels and samples between the threads of the executor.
+//When the operation touch less than two times minimumSamplesPerTask samples (or the executor has a single thread) it runs inline on the calling thread,
+//so the small blocks of an audio callback never pay the scheduling of the tasks.
+//The executor is taken by reference, so a braced SamplesRange is never mistaken for a policy
+struct ParallelExecutionPolicy {
+	explicit ParallelExecutionPolicy(TaskExecutor& taskExecutor, size_t minimumSamplesPerTaskCount = 16384) noexcept
+			: executor{&taskExecutor}, minimumSamplesPerTask{minimumSamplesPerTaskCount} {}
+
+	TaskExecutor* executor;
+	size_t minimumSamplesPerTask;
+};
+
+namespace parallelism {
+
+//Tasks created for every thread of the executor, so a thread that finish early can steal the work of a slower one
+inline constexpr size_t tasksPerThread = 4;
+//The sample blocks of a channel are multiple of this, to keep them aligned to the cache lines and the SIMD widths
+inline constexpr size_t blockSamplesGranularity = 64;
+
+inline bool shouldRunInParallel(const ParallelExecutionPolicy& policy, size_t channelsCount, size_t samplesCount) noexcept {
+	return policy.executor->getConcurrency() > 1 && channelsCount * samplesCount >= 2 * std::max(policy.minimumSamplesPerTask, size_t(1));
+}
+
+//Split of the channels and samples of an operation between the tasks: a group of channels for every task when there are enough channels,
+//otherwise every channel is split in blocks of samples (and every task has a single channel)
+struct ChannelsPartition {
+	ChannelsPartition(const ParallelExecutionPolicy& policy, size_t channelsCount, size_t samplesCount, size_t maxTasksCount = size_t(-1)) noexcept
+			: m_channelsCount{channelsCount},
+			  m_samplesCount{samplesCount} {
+		auto minimumSamplesPerTask = std::max(policy.minimumSamplesPerTask, size_t(1));
+		auto concurrency = policy.executor->getConcurrency();
+		auto targetTasksCount = std::clamp(concurrency * tasksPerThread, size_t(1), maxTasksCount);
+		if(channelsCount >= targetTasksCount || samplesCount < 2 * minimumSamplesPerTask) {
+			auto minimumChannelsPerTask = (minimumSamplesPerTask + samplesCount - 1) / std::max(samplesCount, size_t(1));
+			m_channelsPerTask = std::max((channelsCount + targetTasksCount - 1) / targetTasksCount, minimumChannelsPerTask);
+			m_blockSamplesCount = samplesCount;
+			m_tasksCount = (channelsCount + m_channelsPerTask - 1) / m_channelsPerTask;
+		} else {
+			auto blocksPerChannel = std::min((targetTasksCount + channelsCount - 1) / channelsCount, samplesCount / minimumSamplesPerTask);
+			blocksPerChannel = std::max(std::min(blocksPerChannel, maxTasksCount / channelsCount), size_t(1));
+			m_blockSamplesCount = (samplesCount + blocksPerChannel - 1) / blocksPerChannel;
+			m_blockSamplesCount = (m_blockSamplesCount + blockSamplesGranularity - 1) / blockSamplesGranularity * blockSamplesGranularity;
+			m_blocksPerChannel = (samplesCount + m_blockSamplesCount - 1) / m_blockSamplesCount;
+			m_tasksCount = channelsCount * m_blocksPerChannel;
+		}
+	}
+
+	[[nodiscard]] size_t getTasksCount() const noexcept { return m_tasksCount; }
+	[[nodiscard]] size_t getBlocksPerChannel() const noexcept { return m_blocksPerChannel; }
+
+	//Call function(channel, startSample, samplesCount) for every channel block of the task, with startSample relative to the start of the operation range
+	template<typename Function>
+	void forEachBlockOfTask(size_t taskIndex, Function&& function) const {
+		if(m_blocksPerChannel > 1) {
+			auto channel = taskIndex / m_blocksPerChannel;
+			auto startSample = (taskIndex % m_blocksPerChannel) * m_blockSamplesCount;
+			function(channel, startSample, std::min(m_blockSamplesCount, m_samplesCount - startSample));
+			return;
+		}
+
+		auto endChannel = std::min((taskIndex + 1) * m_channelsPerTask, m_channelsCount);
+		for(auto channel = taskIndex * m_channelsPerTask; channel < endChannel; ++channel) {
+			function(channel, size_t(0), m_samplesCount);
+		}
+	}
+
+private:
+	size_t m_channelsCount;
+	size_t m_samplesCount;
+	size_t m_channelsPerTask = 1;
+	size_t m_blocksPerChannel = 1;
+	size_t m_blockSamplesCount = 0;
+	size_t m_tasksCount = 0;
+};
+
+//Run function(channel, startSample, samplesCount) on all the channel blocks of the operation with the executor of the policy.
+//The caller has to check shouldRunInParallel before, and use the serial version of the operation when it's false
+template<typename Function>
+void forEachChannelBlock(const ParallelExecutionPolicy& policy, size_t channelsCount, size_t samplesCount, Function&& function) {
+	ChannelsPartition partition{policy, channelsCount, samplesCount};
+	policy.executor->parallelFor(partition.getTasksCount(), [&](size_t taskIndex) {
+		partition.forEachBlockOfTask(taskIndex, function);
+	});
+}
+
+} // parallelism
+
+} // abl
+
+#endif //ABL_PARALLELEXECUTIONPOLICY_H
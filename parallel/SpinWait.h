@@ -0,0 +1,49 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_SPINWAIT_H
+#define ABL_SPINWAIT_H
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace abl::parallelism {
+
+//Spins done before sleeping, long enough to catch the work given in the same audio block without paying the wake up of the kernel
+inline constexpr size_t spinsBeforeWait = 4096;
+
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	_mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+	__asm__ __volatile__("yield");
+#endif
+}
+
+//Wait until the atomic isn't oldValue anymore, spinning for a while before sleeping on it (with a futex on Linux).
+//The writer must call notify_all (or notify_one) after changing the value
+template<typename ValueType>
+ValueType spinThenWait(const std::atomic<ValueType>& atomic, ValueType oldValue, std::memory_order order = std::memory_order_acquire) noexcept {
+	for(size_t spin = 0; spin < spinsBeforeWait; ++spin) {
+		auto value = atomic.load(order);
+		if(value != oldValue) {
+			return value;
+		}
+		cpuRelax();
+	}
+
+	auto value = atomic.load(order);
+	while(value == oldValue) {
+		atomic.wait(oldValue, order);
+		value = atomic.load(order);
+	}
+	return value;
+}
+
+} // abl::parallelism
+
+#endif //ABL_SPINWAIT_H
@@ -0,0 +1,44 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_TASKEXECUTOR_H
+#define ABL_TASKEXECUTOR_H
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace abl {
+
+//Non owning reference to a callable that take the task index, so passing a task never allocate (unlike std::function).
+//The referenced callable must live until the call that received it returns
+class TaskReference {
+public:
+	template<typename Function>
+	requires (!std::is_same_v<std::remove_cvref_t<Function>, TaskReference> && std::invocable<std::remove_reference_t<Function>&, size_t>)
+	TaskReference(Function&& function) noexcept
+			: m_function{const_cast<void*>(static_cast<const void*>(std::addressof(function)))},
+			  m_call{[](void* function, size_t taskIndex) { (*static_cast<std::remove_reference_t<Function>*>(function))(taskIndex); }} {}
+
+	void operator()(size_t taskIndex) const { m_call(m_function, taskIndex); }
+
+private:
+	void* m_function;
+	void (*m_call)(void*, size_t);
+};
+
+//Executor of the parallel operations of the buffers
+class TaskExecutor {
+public:
+	virtual ~TaskExecutor() = default;
+
+	//Call the task for every index in [0, tasksCount) and return when all of them are done. The calling thread execute tasks too
+	virtual void parallelFor(size_t tasksCount, TaskReference task) noexcept = 0;
+	//Number of threads that can execute the tasks at the same time, including the calling thread
+	[[nodiscard]] virtual size_t getConcurrency() const noexcept = 0;
+};
+
+} // abl
+
+#endif //ABL_TASKEXECUTOR_H
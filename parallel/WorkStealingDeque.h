@@ -0,0 +1,92 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_WORKSTEALINGDEQUE_H
+#define ABL_WORKSTEALINGDEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "../memory/CacheLineSize.h"
+
+namespace abl {
+
+//Chase-Lev deque of job indexes (in the C11 version of Lê, Pop, Cohen and Zappa Nardelli) with a fixed capacity allocated in the constructor.
+//Only the owner thread can push and pop from the bottom, the others threads steal from the top. It never grows, so the owner must never push more than capacity items between two resets
+class WorkStealingDeque {
+public:
+	explicit WorkStealingDeque(size_t minimumCapacity = 1024)
+			: m_capacity{std::bit_ceil(std::max(minimumCapacity, size_t(2)))},
+			  m_items{std::make_unique<std::atomic<uint32_t>[]>(m_capacity)} {}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	//Empty the deque. Can be called only when no other thread is using it
+	void reset() noexcept {
+		m_top.store(0, std::memory_order_relaxed);
+		m_bottom.store(0, std::memory_order_relaxed);
+	}
+
+	void push(uint32_t item) noexcept {
+		auto bottom = m_bottom.load(std::memory_order_relaxed);
+		[[maybe_unused]] auto top = m_top.load(std::memory_order_acquire);
+		assert(bottom - top < static_cast<int64_t>(m_capacity));
+		m_items[static_cast<size_t>(bottom) & (m_capacity - 1)].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	std::optional<uint32_t> pop() noexcept {
+		auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto top = m_top.load(std::memory_order_relaxed);
+		if(top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		std::optional<uint32_t> item = m_items[static_cast<size_t>(bottom) & (m_capacity - 1)].load(std::memory_order_relaxed);
+		if(top == bottom) {
+			//Last item, race with the thieves
+			if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				item = std::nullopt;
+			}
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	std::optional<uint32_t> steal() noexcept {
+		auto top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto bottom = m_bottom.load(std::memory_order_acquire);
+		if(top >= bottom) {
+			return std::nullopt;
+		}
+
+		auto item = m_items[static_cast<size_t>(top) & (m_capacity - 1)].load(std::memory_order_relaxed);
+		if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return std::nullopt;
+		}
+		return item;
+	}
+
+	[[nodiscard]] size_t getCapacity() const noexcept { return m_capacity; }
+
+private:
+	size_t m_capacity;
+	std::unique_ptr<std::atomic<uint32_t>[]> m_items;
+	alignas(cacheLineSize) std::atomic<int64_t> m_top{0};
+	alignas(cacheLineSize) std::atomic<int64_t> m_bottom{0};
+};
+
+} // abl
+
+#endif //ABL_WORKSTEALINGDEQUE_H
@@ -0,0 +1,134 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_WORKSTEALINGTHREADPOOL_H
+#define ABL_WORKSTEALINGTHREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TaskExecutor.h"
+#include "SpinWait.h"
+#include "../memory/CacheLineSize.h"
+
+namespace abl {
+
+//TaskExecutor with threads created once in the constructor.
+//Every parallelFor split the tasks in a range for every participating thread (the caller included): each thread take the tasks from the front of its range and,
+//when it's over, steal the remaining tasks from the ranges of the others threads. The tasks are claimed with an atomic increment, so there are no locks or allocations in parallelFor.
+//A parallelFor called while another one is running (from another thread or from inside a task) execute its tasks on the calling thread
+class WorkStealingThreadPool final : public TaskExecutor {
+public:
+	explicit WorkStealingThreadPool(size_t threadsCount = std::max(std::thread::hardware_concurrency(), 1u) - 1)
+			: m_ranges{std::make_unique<TasksRange[]>(threadsCount + 1)} {
+		m_workers.reserve(threadsCount);
+		for(size_t worker = 0; worker < threadsCount; ++worker) {
+			m_workers.emplace_back([this, worker]() { workerLoop(worker + 1); });
+		}
+	}
+
+	WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+	WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+	~WorkStealingThreadPool() override {
+		m_state.store((getGeneration(m_state.load(std::memory_order_relaxed)) + 1) << participantsBits | stopParticipants, std::memory_order_release);
+		m_state.notify_all();
+		for(auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	void parallelFor(size_t tasksCount, TaskReference task) noexcept override {
+		if(tasksCount == 0) {
+			return;
+		}
+
+		if(tasksCount == 1 || m_workers.empty() || m_busy.exchange(true, std::memory_order_acquire)) {
+			for(size_t taskIndex = 0; taskIndex < tasksCount; ++taskIndex) {
+				task(taskIndex);
+			}
+			return;
+		}
+
+		size_t participantsCount = std::min(m_workers.size() + 1, tasksCount);
+		for(size_t participant = 0; participant < participantsCount; ++participant) {
+			m_ranges[participant].nextTask.store(tasksCount * participant / participantsCount, std::memory_order_relaxed);
+			m_ranges[participant].endTask = tasksCount * (participant + 1) / participantsCount;
+		}
+		m_task = &task;
+		m_participantsCount = participantsCount;
+		m_runningWorkers.store(participantsCount - 1, std::memory_order_relaxed);
+
+		auto generation = getGeneration(m_state.load(std::memory_order_relaxed)) + 1;
+		m_state.store(generation << participantsBits | participantsCount, std::memory_order_release);
+		m_state.notify_all();
+
+		runTasks(0);
+
+		auto runningWorkers = m_runningWorkers.load(std::memory_order_acquire);
+		while(runningWorkers != 0) {
+			runningWorkers = parallelism::spinThenWait(m_runningWorkers, runningWorkers);
+		}
+
+		m_busy.store(false, std::memory_order_release);
+	}
+
+	[[nodiscard]] size_t getConcurrency() const noexcept override { return m_workers.size() + 1; }
+
+private:
+	//The generation and the participants count are stored in the same atomic, so a worker that wake up late never mix the participants of a call with the generation of another one
+	static constexpr uint64_t participantsBits = 16;
+	static constexpr uint64_t participantsMask = (uint64_t(1) << participantsBits) - 1;
+	static constexpr uint64_t stopParticipants = participantsMask;
+
+	static constexpr uint64_t getGeneration(uint64_t state) noexcept { return state >> participantsBits; }
+
+	struct alignas(cacheLineSize) TasksRange {
+		std::atomic<size_t> nextTask{0};
+		size_t endTask = 0;
+	};
+
+	void workerLoop(size_t participant) noexcept {
+		uint64_t lastState = 0;
+		while(true) {
+			lastState = parallelism::spinThenWait(m_state, lastState);
+			auto participantsCount = lastState & participantsMask;
+			if(participantsCount == stopParticipants) {
+				return;
+			}
+
+			if(participant < participantsCount) {
+				runTasks(participant);
+				if(m_runningWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					m_runningWorkers.notify_one();
+				}
+			}
+		}
+	}
+
+	void runTasks(size_t participant) noexcept {
+		const auto& task = *m_task;
+		for(size_t rangeOffset = 0; rangeOffset < m_participantsCount; ++rangeOffset) {
+			auto& range = m_ranges[(participant + rangeOffset) % m_participantsCount];
+			for(auto taskIndex = range.nextTask.fetch_add(1, std::memory_order_relaxed); taskIndex < range.endTask; taskIndex = range.nextTask.fetch_add(1, std::memory_order_relaxed)) {
+				task(taskIndex);
+			}
+		}
+	}
+
+	std::vector<std::thread> m_workers;
+	std::unique_ptr<TasksRange[]> m_ranges;
+	const TaskReference* m_task = nullptr;
+	size_t m_participantsCount = 0;
+	alignas(cacheLineSize) std::atomic<uint64_t> m_state{0};
+	alignas(cacheLineSize) std::atomic<size_t> m_runningWorkers{0};
+	std::atomic<bool> m_busy{false};
+};
+
+} // abl
+
+#endif //ABL_WORKSTEALINGTHREADPOOL_H
@@ -0,0 +1,245 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_FRAMINGAUDIOPROCESSOR_H
+#define ABL_FRAMINGAUDIOPROCESSOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/AudioBufferView.h"
+#include "../buffers/AudioBufferViewConcepts.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../kernels/AudioKernels.h"
+
+namespace abl {
+
+enum class FramingMode {
+	//The processed frames are multiplied by the synthesis window and added to the output where they overlap (STFT processing)
+	OverlapAdd,
+	//Only the last hopSize samples of every processed frame are output, the others are discarded (FFT convolution)
+	OverlapSave
+};
+
+struct FramingOptions {
+	FramingMode mode = FramingMode::OverlapAdd;
+	//frameSize coefficients applied to the input samples of every frame. When empty, the periodic square root Hann window in OverlapAdd mode
+	//(rectangular when the frames don't overlap) and rectangular in OverlapSave mode
+	std::vector<double> analysisWindow;
+	//frameSize coefficients applied to the processed frames before the overlap-add, with the same default of the analysis window.
+	//It's normalized so the overlap-add of frames not modified by the frame function gives back the input. Not used in OverlapSave mode
+	std::vector<double> synthesisWindow;
+};
+
+//Framing engine for the STFT processing and the FFT convolution: the pushed samples are written in an input CircularAudioBuffer and every hopSize
+//samples the last frameSize samples are multiplied by the analysis window, passed to the frame function and written in an output CircularAudioBuffer
+//(overlap-added with the synthesis window or overlap-saved), from where they can be pulled in parts of any size.
+//The windowing reads the frames directly from the memory of the input ring (in two parts when they cross its end) and the overlap-add accumulates
+//directly in the memory of the output ring, with the SIMD window kernels. The only copy is the windowed frame, that the frame function process in place.
+//The input starts with frameSize - 1 samples of silence, so after a push at least all the samples pushed until then are available to pull:
+//the latency is frameSize - 1 samples in OverlapAdd mode and hopSize - 1 in OverlapSave mode.
+//The rings and the frame are allocated in the constructor for pushes of maxPushSize samples, then push and pull never allocate.
+//Not thread safe: push and pull must be called by the same thread, and the frame function is called inside push
+template <NumericType AudioSampleType>
+class FramingAudioProcessor {
+public:
+	using GainType = kernels::KernelGainType<AudioSampleType>;
+	using FrameFunction = std::function<void(AudioBufferView<AudioSampleType>&)>;
+
+	FramingAudioProcessor(size_t channelsCount, size_t frameSize, size_t hopSize, size_t maxPushSize, FrameFunction frameFunction, const FramingOptions& options = {})
+			: m_frameSize{frameSize},
+			  m_hopSize{hopSize},
+			  m_mode{options.mode},
+			  m_input{frameSize - 1 + std::max(maxPushSize, size_t(1)), hopSize, channelsCount},
+			  m_output{frameSize - 1 + std::max(maxPushSize, size_t(1)), hopSize, channelsCount},
+			  m_frame{frameSize, channelsCount},
+			  m_frameFunction{std::move(frameFunction)} {
+		assert(hopSize > 0 && hopSize <= frameSize);
+		assert(options.analysisWindow.empty() || options.analysisWindow.size() == frameSize);
+		assert(options.synthesisWindow.empty() || options.synthesisWindow.size() == frameSize);
+		auto defaultWindow = m_mode == FramingMode::OverlapAdd && hopSize < frameSize ? getPeriodicSquareRootHannWindow(frameSize) : std::vector<double>{};
+		auto& analysisWindow = options.analysisWindow.empty() ? defaultWindow : options.analysisWindow;
+		m_analysisWindow.assign(analysisWindow.begin(), analysisWindow.end());
+		if(m_mode == FramingMode::OverlapAdd) {
+			auto& synthesisWindow = options.synthesisWindow.empty() ? defaultWindow : options.synthesisWindow;
+			m_synthesisWindow = getNormalizedSynthesisWindow(analysisWindow, synthesisWindow);
+		}
+		reset();
+	}
+
+	//Copy the samples in the input ring and process all the frames they complete. Return false without pushing anything if there's not enough space
+	//(when less samples than the pushed ones have been pulled, or a push is bigger than maxPushSize)
+	bool push(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToPush = samplesCount.has_value() ? samplesCount.value() : sourceBuffer.getBufferSize();
+		assert(samplesToPush <= sourceBuffer.getBufferSize());
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		//The frames never write the output beyond the input write index
+		if(m_input.availableToWrite() < samplesToPush || m_input.getWriteIndex() + samplesToPush - m_output.getReadIndex() > getRingSize()) {
+			return false;
+		}
+
+		forEachRingPart(m_input.getWriteIndex(), samplesToPush, [&](size_t ringPosition, size_t sourceOffset, size_t partSamplesCount) {
+			auto destination = m_input.getContiguousView(ringPosition, partSamplesCount);
+			for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+				if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+					AudioKernels<AudioSampleType>::copy(destination.getChannelRawData(channel), sourceBuffer.getChannelRawData(channel, sourceOffset), partSamplesCount);
+				} else {
+					auto destinationData = destination.getChannelRawData(channel);
+					for(size_t index = 0; index < partSamplesCount; ++index) {
+						destinationData[index] = sourceBuffer.getSample(channel, sourceOffset + index);
+					}
+				}
+			}
+		});
+		m_input.incrementWriteIndex(samplesToPush);
+
+		//The read index of the input ring is the start of the next frame
+		while(m_input.availableToRead() >= m_frameSize) {
+			processFrame(m_input.getReadIndex());
+			m_input.incrementReadIndex(m_hopSize);
+		}
+		return true;
+	}
+
+	//Copy the processed samples in destination (samplesCount or all its samples). Return false without pulling anything if not enough samples have been processed
+	bool pull(const AudioBufferView<AudioSampleType>& destinationBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToPull = samplesCount.has_value() ? samplesCount.value() : destinationBuffer.getBufferSize();
+		assert(samplesToPull <= destinationBuffer.getBufferSize());
+		assert(destinationBuffer.getChannelsCount() <= getChannelsCount());
+		if(availableToPull() < samplesToPull) {
+			return false;
+		}
+
+		forEachRingPart(m_output.getReadIndex(), samplesToPull, [&](size_t ringPosition, size_t destinationOffset, size_t partSamplesCount) {
+			auto source = m_output.getContiguousView(ringPosition, partSamplesCount);
+			for(size_t channel = 0; channel < destinationBuffer.getChannelsCount(); ++channel) {
+				AudioKernels<AudioSampleType>::copy(destinationBuffer.getChannelRawData(channel, destinationOffset), source.getChannelRawData(channel), partSamplesCount);
+			}
+		});
+		m_output.incrementReadIndex(samplesToPull);
+		return true;
+	}
+
+	//Drop all the samples and start again with the latency silence
+	void reset() noexcept {
+		m_input.resetIndexes();
+		m_output.resetIndexes();
+		m_input.getContiguousView(0, getRingSize()).clear();
+		m_output.getContiguousView(0, getRingSize()).clear();
+		m_input.incrementWriteIndex(m_frameSize - 1);
+		//The output of the first frame starts after the discarded part
+		if(m_mode == FramingMode::OverlapSave) {
+			m_output.incrementWriteIndex(m_frameSize - m_hopSize);
+			m_output.incrementReadIndex(m_frameSize - m_hopSize);
+		}
+	}
+
+	[[nodiscard]] size_t availableToPull() const noexcept { return m_output.availableToRead(); }
+	[[nodiscard]] size_t getLatency() const noexcept { return m_mode == FramingMode::OverlapAdd ? m_frameSize - 1 : m_hopSize - 1; }
+	[[nodiscard]] size_t getFrameSize() const noexcept { return m_frameSize; }
+	[[nodiscard]] size_t getHopSize() const noexcept { return m_hopSize; }
+	[[nodiscard]] FramingMode getMode() const noexcept { return m_mode; }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return m_frame.getChannelsCount(); }
+	[[nodiscard]] size_t getRingSize() const noexcept { return m_input.getBaseBufferSize(); }
+	//Analysis and (normalized) synthesis windows, empty when rectangular
+	[[nodiscard]] const std::vector<GainType>& getAnalysisWindow() const noexcept { return m_analysisWindow; }
+	[[nodiscard]] const std::vector<GainType>& getSynthesisWindow() const noexcept { return m_synthesisWindow; }
+
+	static std::vector<double> getPeriodicSquareRootHannWindow(size_t size) {
+		std::vector<double> window(size);
+		for(size_t index = 0; index < size; ++index) {
+			window[index] = std::sqrt(0.5 - 0.5 * std::cos(2 * std::numbers::pi * static_cast<double>(index) / static_cast<double>(size)));
+		}
+		return window;
+	}
+
+private:
+	//Call function(ringPosition, offset, partSamplesCount) for the one or two contiguous parts of samplesCount samples starting at the ring index
+	template<typename PartFunction>
+	void forEachRingPart(size_t startIndex, size_t samplesCount, PartFunction&& function) const {
+		auto ringPosition = startIndex % getRingSize();
+		for(size_t offset = 0; offset < samplesCount;) {
+			auto partSamplesCount = std::min(samplesCount - offset, getRingSize() - ringPosition);
+			function(ringPosition, offset, partSamplesCount);
+			offset += partSamplesCount;
+			ringPosition = 0;
+		}
+	}
+
+	void processFrame(size_t frameStartIndex) {
+		forEachRingPart(frameStartIndex, m_frameSize, [&](size_t ringPosition, size_t frameOffset, size_t partSamplesCount) {
+			auto source = m_input.getContiguousView(ringPosition, partSamplesCount);
+			for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+				if(m_analysisWindow.empty()) {
+					AudioKernels<AudioSampleType>::copy(m_frame.getChannelRawData(channel, frameOffset), source.getChannelRawData(channel), partSamplesCount);
+				} else {
+					AudioKernels<AudioSampleType>::copyWithWindow(m_frame.getChannelRawData(channel, frameOffset), source.getChannelRawData(channel), m_analysisWindow.data() + frameOffset, partSamplesCount);
+				}
+			}
+		});
+
+		m_frameFunction(m_frame);
+
+		auto newSamplesStart = frameStartIndex + m_frameSize - m_hopSize;
+		if(m_mode == FramingMode::OverlapAdd) {
+			//The last hop of the frame is the first to reach this part of the ring since it was pulled
+			forEachRingPart(newSamplesStart, m_hopSize, [&](size_t ringPosition, size_t, size_t partSamplesCount) {
+				m_output.getContiguousView(ringPosition, partSamplesCount).clear();
+			});
+			forEachRingPart(frameStartIndex, m_frameSize, [&](size_t ringPosition, size_t frameOffset, size_t partSamplesCount) {
+				auto destination = m_output.getContiguousView(ringPosition, partSamplesCount);
+				for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+					AudioKernels<AudioSampleType>::addWithWindow(destination.getChannelRawData(channel), m_frame.getChannelRawData(channel, frameOffset), m_synthesisWindow.data() + frameOffset, partSamplesCount);
+				}
+			});
+		} else {
+			forEachRingPart(newSamplesStart, m_hopSize, [&](size_t ringPosition, size_t hopOffset, size_t partSamplesCount) {
+				auto destination = m_output.getContiguousView(ringPosition, partSamplesCount);
+				for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+					AudioKernels<AudioSampleType>::copy(destination.getChannelRawData(channel), m_frame.getChannelRawData(channel, m_frameSize - m_hopSize + hopOffset), partSamplesCount);
+				}
+			});
+		}
+		//All the frames overlapping the hop before the new samples have been added
+		m_output.incrementWriteIndex(m_hopSize);
+	}
+
+	//Every output sample is the sum of the products of the windows at the positions with the same remainder modulo hopSize,
+	//so the synthesis window is divided by those sums (the positions where they're zero can't be reconstructed and are left as they are)
+	std::vector<GainType> getNormalizedSynthesisWindow(const std::vector<double>& analysisWindow, const std::vector<double>& synthesisWindow) const {
+		auto getCoefficient = [](const std::vector<double>& window, size_t index) { return window.empty() ? 1.0 : window[index]; };
+		std::vector<double> overlapSums(m_hopSize, 0.0);
+		for(size_t index = 0; index < m_frameSize; ++index) {
+			overlapSums[index % m_hopSize] += getCoefficient(analysisWindow, index) * getCoefficient(synthesisWindow, index);
+		}
+
+		std::vector<GainType> normalizedWindow(m_frameSize);
+		for(size_t index = 0; index < m_frameSize; ++index) {
+			auto overlapSum = overlapSums[index % m_hopSize];
+			auto coefficient = getCoefficient(synthesisWindow, index);
+			normalizedWindow[index] = static_cast<GainType>(std::abs(overlapSum) > 1e-9 ? coefficient / overlapSum : coefficient);
+		}
+		return normalizedWindow;
+	}
+
+	size_t m_frameSize;
+	size_t m_hopSize;
+	FramingMode m_mode;
+	CircularAudioBuffer<AudioSampleType> m_input;
+	CircularAudioBuffer<AudioSampleType> m_output;
+	AudioBuffer<AudioSampleType> m_frame;
+	FrameFunction m_frameFunction;
+	std::vector<GainType> m_analysisWindow;
+	std::vector<GainType> m_synthesisWindow;
+};
+
+} // abl
+
+#endif //ABL_FRAMINGAUDIOPROCESSOR_H
@@ -0,0 +1,131 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef ABL_REBLOCKINGAUDIOPROCESSOR_H
+#define ABL_REBLOCKINGAUDIOPROCESSOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+#include "../buffers/AudioBufferView.h"
+#include "../buffers/AudioBufferViewConcepts.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../kernels/AudioKernels.h"
+
+namespace abl {
+
+//Adapter between the blocks of any size of a host callback and a processing that works on blocks of a fixed size.
+//The pushed samples are written in a CircularAudioBuffer with a size multiple of blockSize, so every complete block is contiguous in its memory:
+//the block function process it in place (through a view of the ring memory, without copies) and the processed samples can then be pulled in parts of any size.
+//The output is delayed by getLatency() = blockSize - 1 samples of silence (passed through the block function like the other samples), the minimum latency
+//that let a pull of the same samples count follow every push: after a push, at least all the samples pushed until then are available to pull.
+//The ring is allocated in the constructor to hold the latency and a push of maxPushSize samples, then push and pull never allocate.
+//Not thread safe: push and pull must be called by the same thread (usually the audio callback), and the block function is called inside push
+template <NumericType AudioSampleType>
+class ReblockingAudioProcessor {
+public:
+	using BlockFunction = std::function<void(AudioBufferView<AudioSampleType>&)>;
+
+	ReblockingAudioProcessor(size_t channelsCount, size_t blockSize, size_t maxPushSize, BlockFunction blockFunction)
+			: m_blockSize{blockSize},
+			  m_buffer{getRingSize(blockSize, maxPushSize), blockSize, channelsCount},
+			  m_blockFunction{std::move(blockFunction)} {
+		assert(blockSize > 0);
+		m_buffer.incrementWriteIndex(getLatency());
+	}
+
+	//Copy the samples in the ring and process all the blocks they complete. Return false without pushing anything if there's not enough space
+	//(when less samples than the pushed ones have been pulled, or a push is bigger than maxPushSize)
+	bool push(const AudioBufferReadableType<AudioSampleType> auto &sourceBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToPush = samplesCount.has_value() ? samplesCount.value() : sourceBuffer.getBufferSize();
+		assert(samplesToPush <= sourceBuffer.getBufferSize());
+		assert(sourceBuffer.getChannelsCount() >= getChannelsCount());
+		if(m_buffer.availableToWrite() < samplesToPush) {
+			return false;
+		}
+
+		auto writePosition = m_buffer.getWriteIndex() % getRingSize();
+		for(size_t pushedSamples = 0; pushedSamples < samplesToPush;) {
+			auto partSamplesCount = std::min(samplesToPush - pushedSamples, getRingSize() - writePosition);
+			auto destination = m_buffer.getContiguousView(writePosition, partSamplesCount);
+			for(size_t channel = 0; channel < getChannelsCount(); ++channel) {
+				if constexpr (ContiguousAudioBufferReadableType<std::remove_cvref_t<decltype(sourceBuffer)>, AudioSampleType>) {
+					AudioKernels<AudioSampleType>::copy(destination.getChannelRawData(channel), sourceBuffer.getChannelRawData(channel, pushedSamples), partSamplesCount);
+				} else {
+					auto destinationData = destination.getChannelRawData(channel);
+					for(size_t index = 0; index < partSamplesCount; ++index) {
+						destinationData[index] = sourceBuffer.getSample(channel, pushedSamples + index);
+					}
+				}
+			}
+			pushedSamples += partSamplesCount;
+			writePosition = (writePosition + partSamplesCount) % getRingSize();
+		}
+		m_buffer.incrementWriteIndex(samplesToPush);
+
+		//The processed index is always a multiple of the block size, like the ring size, so the blocks never cross the end of the ring
+		while(m_buffer.getWriteIndex() - m_processedIndex >= m_blockSize) {
+			auto block = m_buffer.getContiguousView(m_processedIndex % getRingSize(), m_blockSize);
+			m_blockFunction(block);
+			m_processedIndex += m_blockSize;
+		}
+		return true;
+	}
+
+	//Copy the processed samples in destination (samplesCount or all its samples). Return false without pulling anything if not enough samples have been processed
+	bool pull(const AudioBufferView<AudioSampleType>& destinationBuffer, std::optional<size_t> samplesCount = {}) {
+		auto samplesToPull = samplesCount.has_value() ? samplesCount.value() : destinationBuffer.getBufferSize();
+		assert(samplesToPull <= destinationBuffer.getBufferSize());
+		assert(destinationBuffer.getChannelsCount() <= getChannelsCount());
+		if(availableToPull() < samplesToPull) {
+			return false;
+		}
+
+		auto readPosition = m_buffer.getReadIndex() % getRingSize();
+		for(size_t pulledSamples = 0; pulledSamples < samplesToPull;) {
+			auto partSamplesCount = std::min(samplesToPull - pulledSamples, getRingSize() - readPosition);
+			auto source = m_buffer.getContiguousView(readPosition, partSamplesCount);
+			for(size_t channel = 0; channel < destinationBuffer.getChannelsCount(); ++channel) {
+				AudioKernels<AudioSampleType>::copy(destinationBuffer.getChannelRawData(channel, pulledSamples), source.getChannelRawData(channel), partSamplesCount);
+			}
+			pulledSamples += partSamplesCount;
+			readPosition = (readPosition + partSamplesCount) % getRingSize();
+		}
+		m_buffer.incrementReadIndex(samplesToPull);
+		return true;
+	}
+
+	//Drop all the samples and start again with the latency silence
+	void reset() noexcept {
+		m_buffer.resetIndexes();
+		m_processedIndex = 0;
+		m_buffer.clear();
+		m_buffer.incrementWriteIndex(getLatency());
+	}
+
+	[[nodiscard]] size_t availableToPull() const noexcept { return m_processedIndex - m_buffer.getReadIndex(); }
+	//Samples pushed and waiting for the completion of their block
+	[[nodiscard]] size_t getPendingSamplesCount() const noexcept { return m_buffer.getWriteIndex() - m_processedIndex; }
+	[[nodiscard]] size_t getLatency() const noexcept { return m_blockSize - 1; }
+	[[nodiscard]] size_t getBlockSize() const noexcept { return m_blockSize; }
+	[[nodiscard]] size_t getChannelsCount() const noexcept { return m_buffer.getChannelsCount(); }
+	[[nodiscard]] size_t getRingSize() const noexcept { return m_buffer.getBaseBufferSize(); }
+
+private:
+	static size_t getRingSize(size_t blockSize, size_t maxPushSize) noexcept {
+		auto samplesCount = blockSize - 1 + std::max(maxPushSize, size_t(1));
+		return (samplesCount + blockSize - 1) / blockSize * blockSize;
+	}
+
+	size_t m_blockSize;
+	CircularAudioBuffer<AudioSampleType> m_buffer;
+	BlockFunction m_blockFunction;
+	size_t m_processedIndex = 0;
+};
+
+} // abl
+
+#endif //ABL_REBLOCKINGAUDIOPROCESSOR_H
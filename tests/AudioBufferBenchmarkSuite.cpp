@@ -0,0 +1,347 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/DelayedCircularAudioBuffer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+//Full matrix of the buffers operations, for every sample type, channels count and block size.
+//The test cases are hidden (they take some minutes), run them with: AudioBufferBenchmark "[AudioBufferBenchmarkSuite]"
+//(optionally with --benchmark-samples to make them faster, or with the xml/junit reporter to save and compare the results).
+//At the end of every test case the throughput of every benchmark is printed in samples/s and bytes/s.
+//applyGain alternate a gain and its inverse, while the gain ramp refill the buffer first (a ramp can't be undone by
+//another ramp), so repeating them never decay the samples to denormals and slow down the following iterations
+
+namespace {
+
+struct BenchmarkWork {
+	size_t samplesCount;
+	size_t bytesCount;
+};
+
+std::map<std::string, BenchmarkWork>& getBenchmarksWork() {
+	static std::map<std::string, BenchmarkWork> benchmarksWork;
+	return benchmarksWork;
+}
+
+//touchedBuffers is the number of samples streams read or written by the operation (for example copy read one and write one)
+template<typename T>
+std::string registerBenchmark(const std::string& bufferName, const std::string& operationName, size_t channelsCount, size_t blockSize, size_t touchedBuffers) {
+	auto name = bufferName + " " + operationName + " " + std::to_string(channelsCount) + "ch x " + std::to_string(blockSize);
+	getBenchmarksWork()[name] = {channelsCount * blockSize, channelsCount * blockSize * sizeof(T) * touchedBuffers};
+	return name;
+}
+
+class BenchmarkThroughputListener : public Catch::EventListenerBase {
+public:
+	using Catch::EventListenerBase::EventListenerBase;
+
+	void benchmarkEnded(Catch::BenchmarkStats const& stats) override {
+		auto work = getBenchmarksWork().find(stats.info.name);
+		if(work != getBenchmarksWork().end()) {
+			m_results.emplace_back(stats.info.name, work->second, std::chrono::duration<double>(stats.mean.point).count());
+		}
+	}
+
+	void testCaseEnded(Catch::TestCaseStats const&) override {
+		if(m_results.empty()) {
+			return;
+		}
+
+		std::printf("\n%-72s %16s %16s\n", "benchmark", "Msamples/s", "MB/s");
+		for(auto& [name, work, seconds] : m_results) {
+			std::printf("%-72s %16.1f %16.1f\n", name.c_str(), work.samplesCount / seconds / 1e6, work.bytesCount / seconds / 1e6);
+		}
+		std::printf("\n");
+		m_results.clear();
+	}
+
+private:
+	std::vector<std::tuple<std::string, BenchmarkWork, double>> m_results;
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkThroughputListener)
+
+template<typename T>
+T** createRawData(size_t channelsCount, size_t bufferSize) {
+	auto data = new T*[channelsCount];
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		data[channel] = new T[bufferSize];
+		for(size_t i = 0; i < bufferSize; ++i) {
+			data[channel][i] = std::is_floating_point_v<T> ? T((i % 100) + 1) / T(100) : T((i % 100) + 1);
+		}
+	}
+	return data;
+}
+
+template<typename T>
+void deleteRawData(T** data, size_t channelsCount) {
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		delete[] data[channel];
+	}
+	delete[] data;
+}
+
+template<typename T, typename BufferType>
+void benchmarkBufferOperations(const std::string& bufferName, BufferType& buffer, const abl::AudioBuffer<T>& sourceBuffer) {
+	using GainType = typename abl::AudioBuffer<T>::GainType;
+	auto channelsCount = buffer.getChannelsCount();
+	auto blockSize = buffer.getBufferSize();
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "copyFrom", channelsCount, blockSize, 2)) {
+		buffer.copyFrom(sourceBuffer);
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "copyFrom with gain", channelsCount, blockSize, 2)) {
+		buffer.copyFrom(sourceBuffer, {}, GainType(0.5));
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "addFrom", channelsCount, blockSize, 3)) {
+		buffer.addFrom(sourceBuffer);
+	};
+
+	auto gain = GainType(0.5);
+	BENCHMARK(registerBenchmark<T>(bufferName, "applyGain", channelsCount, blockSize, 2)) {
+		gain = GainType(1) / gain;
+		buffer.applyGain(gain);
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "copyFrom + applyGainRamp", channelsCount, blockSize, 4)) {
+		buffer.copyFrom(sourceBuffer);
+		buffer.applyGainRamp(GainType(0.5), GainType(1));
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "clear", channelsCount, blockSize, 1)) {
+		buffer.clear();
+	};
+
+	buffer.copyFrom(sourceBuffer);
+	BENCHMARK(registerBenchmark<T>(bufferName, "reverse", channelsCount, blockSize, 2)) {
+		buffer.reverse();
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "getHigherPeak", channelsCount, blockSize, 1)) {
+		return buffer.getHigherPeak();
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "getRMSLevel", channelsCount, blockSize, 1)) {
+		T rmsSum = 0;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			rmsSum += buffer.getRMSLevelForChannel(channel);
+		}
+		return rmsSum;
+	};
+}
+
+//The same operations done channel by channel, through the variant returned by the buffers operator[]
+template<typename T, typename BufferType>
+void benchmarkChannelWrapperOperations(const std::string& bufferName, BufferType& buffer, const abl::AudioBuffer<T>& sourceBuffer) {
+	using GainType = typename abl::AudioBuffer<T>::GainType;
+	auto channelsCount = buffer.getChannelsCount();
+	auto blockSize = buffer.getBufferSize();
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "copyFrom", channelsCount, blockSize, 2)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].copyFrom(sourceBuffer[channel]);
+		}
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "addFrom", channelsCount, blockSize, 3)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].addFrom(sourceBuffer[channel]);
+		}
+	};
+
+	auto gain = GainType(0.5);
+	BENCHMARK(registerBenchmark<T>(bufferName, "applyGain", channelsCount, blockSize, 2)) {
+		gain = GainType(1) / gain;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].applyGain(gain);
+		}
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "copyFrom + applyGainRamp", channelsCount, blockSize, 4)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].copyFrom(sourceBuffer[channel]);
+			buffer[channel].applyGainRamp(GainType(0.5), GainType(1));
+		}
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "clear", channelsCount, blockSize, 1)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].clear();
+		}
+	};
+
+	buffer.copyFrom(sourceBuffer);
+	BENCHMARK(registerBenchmark<T>(bufferName, "reverse", channelsCount, blockSize, 2)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			buffer[channel].reverse();
+		}
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "getHigherPeak", channelsCount, blockSize, 1)) {
+		T higherPeak = 0;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			higherPeak = std::max(higherPeak, buffer[channel].getHigherPeak());
+		}
+		return higherPeak;
+	};
+
+	BENCHMARK(registerBenchmark<T>(bufferName, "getRMSLevel", channelsCount, blockSize, 1)) {
+		T rmsSum = 0;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			rmsSum += buffer[channel].getRMSLevel();
+		}
+		return rmsSum;
+	};
+}
+
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferBenchmarkSuite] Raw pointers baseline", "[.AudioBufferBenchmarkSuite]", float, double, int) {
+	auto channelsCount = GENERATE(as<size_t>{}, 1, 2, 8, 64);
+	auto blockSize = GENERATE(as<size_t>{}, 32, 512, 8192);
+	const std::string bufferName = "raw pointers";
+	using GainType = typename abl::AudioBuffer<TestType>::GainType;
+
+	auto data = createRawData<TestType>(channelsCount, blockSize);
+	auto sourceData = createRawData<TestType>(channelsCount, blockSize);
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "copyFrom", channelsCount, blockSize, 2)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			std::copy(sourceData[channel], sourceData[channel] + blockSize, data[channel]);
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "copyFrom with gain", channelsCount, blockSize, 2)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t i = 0; i < blockSize; ++i) {
+				data[channel][i] = sourceData[channel][i] * GainType(0.5);
+			}
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "addFrom", channelsCount, blockSize, 3)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t i = 0; i < blockSize; ++i) {
+				data[channel][i] += sourceData[channel][i];
+			}
+		}
+	};
+
+	auto gain = GainType(0.5);
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "applyGain", channelsCount, blockSize, 2)) {
+		gain = GainType(1) / gain;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t i = 0; i < blockSize; ++i) {
+				data[channel][i] *= gain;
+			}
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "copyFrom + applyGainRamp", channelsCount, blockSize, 4)) {
+		auto gainIncrement = GainType(0.5) / GainType(blockSize);
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			std::copy(sourceData[channel], sourceData[channel] + blockSize, data[channel]);
+			for(size_t i = 0; i < blockSize; ++i) {
+				data[channel][i] *= GainType(0.5) + gainIncrement * GainType(i);
+			}
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "clear", channelsCount, blockSize, 1)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			std::fill(data[channel], data[channel] + blockSize, TestType(0));
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "reverse", channelsCount, blockSize, 2)) {
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			std::reverse(data[channel], data[channel] + blockSize);
+		}
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "getHigherPeak", channelsCount, blockSize, 1)) {
+		TestType higherPeak = 0;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t i = 0; i < blockSize; ++i) {
+				higherPeak = std::max(higherPeak, TestType(std::abs(sourceData[channel][i])));
+			}
+		}
+		return higherPeak;
+	};
+
+	BENCHMARK(registerBenchmark<TestType>(bufferName, "getRMSLevel", channelsCount, blockSize, 1)) {
+		TestType rmsSum = 0;
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			double squaresSum = 0;
+			for(size_t i = 0; i < blockSize; ++i) {
+				squaresSum += double(sourceData[channel][i]) * sourceData[channel][i];
+			}
+			rmsSum += TestType(std::sqrt(squaresSum / blockSize));
+		}
+		return rmsSum;
+	};
+
+	deleteRawData(data, channelsCount);
+	deleteRawData(sourceData, channelsCount);
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferBenchmarkSuite] AudioBuffer operations", "[.AudioBufferBenchmarkSuite]", float, double, int) {
+	auto channelsCount = GENERATE(as<size_t>{}, 1, 2, 8, 64);
+	auto blockSize = GENERATE(as<size_t>{}, 32, 512, 8192);
+
+	auto sourceData = createRawData<TestType>(channelsCount, blockSize);
+	abl::AudioBuffer<TestType> sourceBuffer{sourceData, channelsCount, blockSize};
+	abl::AudioBuffer<TestType> audioBuffer{blockSize, channelsCount};
+	benchmarkBufferOperations<TestType>("AudioBuffer", audioBuffer, sourceBuffer);
+	deleteRawData(sourceData, channelsCount);
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferBenchmarkSuite] CircularAudioBuffer operations", "[.AudioBufferBenchmarkSuite]", float, double, int) {
+	auto channelsCount = GENERATE(as<size_t>{}, 1, 2, 8, 64);
+	auto blockSize = GENERATE(as<size_t>{}, 32, 512, 8192);
+
+	auto sourceData = createRawData<TestType>(channelsCount, blockSize);
+	abl::AudioBuffer<TestType> sourceBuffer{sourceData, channelsCount, blockSize};
+	//The single buffer start in the middle of the last block, so every operation work on the two wrapped parts
+	abl::CircularAudioBuffer<TestType> circularBuffer{blockSize * 4, blockSize, channelsCount, blockSize * 4 - blockSize / 2};
+	benchmarkBufferOperations<TestType>("CircularAudioBuffer", circularBuffer, sourceBuffer);
+	deleteRawData(sourceData, channelsCount);
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferBenchmarkSuite] DelayedCircularAudioBuffer operations", "[.AudioBufferBenchmarkSuite]", float, double, int) {
+	auto channelsCount = GENERATE(as<size_t>{}, 1, 2, 8, 64);
+	auto blockSize = GENERATE(as<size_t>{}, 32, 512, 8192);
+
+	auto sourceData = createRawData<TestType>(channelsCount, blockSize);
+	abl::AudioBuffer<TestType> sourceBuffer{sourceData, channelsCount, blockSize};
+	abl::DelayedCircularAudioBuffer<TestType> delayedBuffer{blockSize * 4, blockSize, blockSize, channelsCount, blockSize * 4 - blockSize / 2};
+	benchmarkBufferOperations<TestType>("DelayedCircularAudioBuffer", delayedBuffer, sourceBuffer);
+	deleteRawData(sourceData, channelsCount);
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferBenchmarkSuite] AudioBufferChannelViewWrapper operations", "[.AudioBufferBenchmarkSuite]", float, double, int) {
+	auto channelsCount = GENERATE(as<size_t>{}, 1, 2, 8, 64);
+	auto blockSize = GENERATE(as<size_t>{}, 32, 512, 8192);
+
+	auto sourceData = createRawData<TestType>(channelsCount, blockSize);
+	abl::AudioBuffer<TestType> sourceBuffer{sourceData, channelsCount, blockSize};
+	abl::AudioBuffer<TestType> audioBuffer{blockSize, channelsCount};
+	abl::CircularAudioBuffer<TestType> circularBuffer{blockSize * 4, blockSize, channelsCount, blockSize * 4 - blockSize / 2};
+	benchmarkChannelWrapperOperations<TestType>("AudioBufferChannelViewWrapper(AudioBuffer)", audioBuffer, sourceBuffer);
+	benchmarkChannelWrapperOperations<TestType>("AudioBufferChannelViewWrapper(CircularAudioBuffer)", circularBuffer, sourceBuffer);
+	deleteRawData(sourceData, channelsCount);
+}
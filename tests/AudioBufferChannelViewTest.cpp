@@ -2,6 +2,7 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/AudioBufferChannelView.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -301,8 +302,8 @@ TEMPLATE_TEST_CASE("[AudioBufferChannelView] View report correct rms level", "[A
 	const size_t bufferSize = 8;
 	auto wrapper = AudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize);
 
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(4.5));
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 3)) == 5);
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(std::sqrt(204.0 / 8)));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 3)) == TestType(std::sqrt(77.0 / 3)));
 }
 
 TEMPLATE_TEST_CASE("[AudioBufferChannelView] View report correct buffer size", "[AudioBufferChannelView]", int, double) {
@@ -0,0 +1,87 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/AudioBufferChannelViewWrapper.h"
+#include <numeric>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEMPLATE_TEST_CASE("[AudioBufferChannelViewWrapper] Resolved view give access to the wrapped view", "[AudioBufferChannelViewWrapper]", int, double) {
+	std::vector<TestType> data(16);
+	std::iota(data.begin(), data.end(), 1);
+
+	abl::AudioBufferChannelViewWrapper<TestType> normalWrapper{abl::AudioBufferChannelView<TestType>{data.data(), 16}};
+	abl::AudioBufferChannelViewWrapper<TestType> circularWrapper{abl::CircularAudioBufferChannelView<TestType>{data.data(), 16, 8, 12}};
+
+	auto sum = normalWrapper.withResolvedView([](auto& channelView) {
+		TestType sum = 0;
+		for(size_t i = 0; i < channelView.getBufferSize(); ++i) {
+			sum += channelView[i];
+		}
+		return sum;
+	});
+	REQUIRE(sum == TestType(136));
+
+	circularWrapper.withResolvedView([](auto& channelView) {
+		REQUIRE(std::is_same_v<std::remove_cvref_t<decltype(channelView)>, abl::CircularAudioBufferChannelView<TestType>>);
+		for(size_t i = 0; i < channelView.getBufferSize(); ++i) {
+			channelView[i] *= 2;
+		}
+	});
+	REQUIRE(data[11] == TestType(12));
+	REQUIRE(data[12] == TestType(26));
+	REQUIRE(data[15] == TestType(32));
+	REQUIRE(data[0] == TestType(2));
+	REQUIRE(data[3] == TestType(8));
+	REQUIRE(data[4] == TestType(5));
+
+	const auto& constWrapper = circularWrapper;
+	REQUIRE(constWrapper.withResolvedView([](const auto& channelView) { return channelView.getSample(4); }) == TestType(2));
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferChannelViewWrapper] Contiguous parts cover the wrapped samples in order", "[AudioBufferChannelViewWrapper]", int, double) {
+	std::vector<TestType> data(16);
+	std::iota(data.begin(), data.end(), 0);
+
+	abl::AudioBufferChannelViewWrapper<TestType> normalWrapper{abl::AudioBufferChannelView<TestType>{data.data(), 16}};
+	abl::AudioBufferChannelViewWrapper<TestType> circularWrapper{abl::CircularAudioBufferChannelView<TestType>{data.data(), 16, 8, 12}};
+	abl::AudioBufferChannelViewWrapper<TestType> offsettedWrapper{abl::OffsettedReadCircularAudioBufferChannelView<TestType>{data.data(), 16, 8, 14, 4}};
+
+	std::vector<TestType> visitedSamples;
+	size_t partsCount = 0;
+	auto collectSamples = [&](TestType* part, size_t samplesCount, size_t processedSamplesCount) {
+		REQUIRE(processedSamplesCount == visitedSamples.size());
+		visitedSamples.insert(visitedSamples.end(), part, part + samplesCount);
+		++partsCount;
+	};
+
+	normalWrapper.visitContiguous(collectSamples, {2, 4});
+	REQUIRE(partsCount == 1);
+	REQUIRE(visitedSamples == std::vector<TestType>{2, 3, 4, 5});
+
+	visitedSamples.clear();
+	partsCount = 0;
+	circularWrapper.visitContiguous(collectSamples);
+	REQUIRE(partsCount == 2);
+	REQUIRE(visitedSamples == std::vector<TestType>{12, 13, 14, 15, 0, 1, 2, 3});
+
+	visitedSamples.clear();
+	partsCount = 0;
+	offsettedWrapper.visitContiguous(collectSamples);
+	REQUIRE(partsCount == 2);
+	REQUIRE(visitedSamples == std::vector<TestType>{14, 15, 0, 1, 2, 3, 4, 5});
+
+	visitedSamples.clear();
+	partsCount = 0;
+	offsettedWrapper.visitContiguousForWrite(collectSamples);
+	REQUIRE(partsCount == 1);
+	REQUIRE(visitedSamples == std::vector<TestType>{4, 5, 6, 7, 8, 9, 10, 11});
+
+	//The wrapper expose the spans, so it's copied by contiguous parts
+	REQUIRE(abl::AudioBufferChannelSpansReadableType<abl::AudioBufferChannelViewWrapper<TestType>, TestType>);
+	std::vector<TestType> destinationData(8);
+	abl::AudioBufferChannelView<TestType> destinationView{destinationData.data(), 8};
+	destinationView.copyFrom(circularWrapper);
+	REQUIRE(destinationData == std::vector<TestType>{12, 13, 14, 15, 0, 1, 2, 3});
+}
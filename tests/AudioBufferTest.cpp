@@ -2,6 +2,7 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/AudioBuffer.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -981,10 +982,10 @@ TEMPLATE_TEST_CASE("[AudioBuffer] View report correct rms level for channels", "
 	const size_t bufferSize = 8;
 	auto wrapper = AudioBufferWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize);
 
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(4.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(12.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(5.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(13.5));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(std::sqrt(204.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(std::sqrt(1292.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(std::sqrt(126.0 / 4)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(std::sqrt((13.0 * 13.0 + 14.0 * 14.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[AudioBuffer] View report correct buffer size and channel count", "[AudioBuffer]", int, double) {
@@ -3,6 +3,8 @@
 
 #include "../buffers/AudioBufferView.h"
 #include "../buffers/AudioBufferChannelView.h"
+#include "../buffers/AudioBuffer.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -451,6 +453,32 @@ TEMPLATE_TEST_CASE("[AudioBufferView] Channel buffer data can be added from anot
 	}
 }
 
+TEMPLATE_TEST_CASE("[AudioBufferView] Buffer data can be copied and added from a mapped and ranged buffer", "[AudioBufferView]", int, double) {
+	size_t channels = 2;
+	size_t bufferSize = 8;
+	auto wrapper = AudioBufferViewWrapper<TestType>::createWithFixedValue(channels, bufferSize, 3);
+	auto wrapperCopy = AudioBufferViewWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, {1, 0});
+	auto rangedSourceView = wrapperCopy.audioBufferView.getRangedView(abl::SamplesRange(4, 4));
+
+	REQUIRE(rangedSourceView.getChannelRawData(0) == wrapperCopy.data[1] + 4);
+	REQUIRE(rangedSourceView.getChannelRawData(1, 2) == wrapperCopy.data[0] + 6);
+
+	wrapper.audioBufferView.copyFrom(rangedSourceView, abl::SamplesRange(2, 4));
+	for (size_t channel = 0; channel < channels; ++channel) {
+		for (size_t i = 0; i < bufferSize; ++i) {
+			REQUIRE(wrapper.audioBufferView.getSample(channel, i) == (i >= 2 && i < 6 ? i + 3 + (1 - channel) * bufferSize : 3));
+		}
+	}
+
+	wrapper.audioBufferView.addWithRampFrom(rangedSourceView, 0.5, 0.5, abl::SamplesRange(2, 4));
+	for (size_t channel = 0; channel < channels; ++channel) {
+		for (size_t i = 0; i < bufferSize; ++i) {
+			auto sourceSample = TestType(i + 3 + (1 - channel) * bufferSize);
+			REQUIRE(wrapper.audioBufferView.getSample(channel, i) == (i >= 2 && i < 6 ? sourceSample + TestType(sourceSample * 0.5) : 3));
+		}
+	}
+}
+
 TEMPLATE_TEST_CASE("[AudioBufferView] Buffer data is scaled with applyGain()", "[AudioBufferView]", int, double) {
 	size_t channels = 2;
 	size_t bufferSize = 8;
@@ -726,10 +754,10 @@ TEMPLATE_TEST_CASE("[AudioBufferView] View report correct rms level for channels
 	size_t bufferSize = 8;
 	auto wrapper = AudioBufferViewWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize);
 
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(4.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(12.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(5.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(13.5));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(std::sqrt(204.0 / 8)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(std::sqrt(1292.0 / 8)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(std::sqrt(126.0 / 4)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(std::sqrt((13.0 * 13.0 + 14.0 * 14.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[AudioBufferView] View report correct buffer size and channel count", "[AudioBufferView]", int, double) {
@@ -784,4 +812,47 @@ TEMPLATE_TEST_CASE("[AudioBufferView] Channels are mapped correctly", "[AudioBuf
 }
 
 
-//test channel out-of-bound assert?
\ No newline at end of file
+TEMPLATE_TEST_CASE("[AudioBufferView] mixFrom give the same result of an addFrom for every source", "[AudioBufferView]", int, double) {
+	const size_t channels = 2;
+	const size_t bufferSize = 37;
+	std::vector<abl::AudioBuffer<TestType>> sources;
+	for(size_t source = 0; source < 20; ++source) {
+		auto& sourceBuffer = sources.emplace_back(bufferSize, channels);
+		for(size_t channel = 0; channel < channels; ++channel) {
+			for(size_t index = 0; index < bufferSize; ++index) {
+				sourceBuffer.setSample(channel, index, TestType(source * 64 + channel * 32 + index));
+			}
+		}
+	}
+
+	//More sources than the ones mixed in a single pass, with constant gains and ramps
+	std::vector<abl::AudioBufferMixSource<TestType>> mixSources;
+	auto expectedWrapper = AudioBufferViewWrapper<TestType>::createWithFixedValue(channels, bufferSize, TestType(4));
+	for(size_t source = 0; source < sources.size(); ++source) {
+		if(source % 2 == 0) {
+			mixSources.emplace_back(sources[source], 0.5);
+			expectedWrapper.audioBufferView.addFrom(sources[source], abl::SamplesRange(2, 32), 0.5);
+		} else {
+			mixSources.emplace_back(sources[source], 0, 1);
+			expectedWrapper.audioBufferView.addWithRampFrom(sources[source], 0, 1, abl::SamplesRange(2, 32));
+		}
+	}
+
+	auto resultWrapper = AudioBufferViewWrapper<TestType>::createWithFixedValue(channels, bufferSize, TestType(4));
+	resultWrapper.audioBufferView.mixFrom(mixSources, abl::SamplesRange(2, 32));
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < bufferSize; ++index) {
+			//The integral samples are truncated once at the end of the mix, instead of after every source
+			auto tolerance = std::is_integral_v<TestType> ? double(sources.size()) : 1e-9;
+			REQUIRE(std::abs(double(resultWrapper.audioBufferView.getSample(channel, index)) - double(expectedWrapper.audioBufferView.getSample(channel, index))) <= tolerance);
+		}
+	}
+	REQUIRE(resultWrapper.audioBufferView.getSample(0, 1) == TestType(4));
+	REQUIRE(resultWrapper.audioBufferView.getSample(1, 34) == TestType(4));
+
+	resultWrapper.audioBufferView.clear();
+	resultWrapper.audioBufferView.mixFrom({{sources[0], 1}, {sources[1], 2}});
+	REQUIRE(resultWrapper.audioBufferView.getSample(1, 3) == TestType(32 + 3 + (64 + 32 + 3) * 2));
+}
+
+//test channel out-of-bound assert?
@@ -0,0 +1,172 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../parallel/AudioJobSystem.h"
+#include "../buffers/AudioBuffer.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[WorkStealingDeque] Owner pop the last pushed item and thieves steal the first one", "[WorkStealingDeque]") {
+	abl::WorkStealingDeque deque{3};
+	REQUIRE(deque.getCapacity() == 4);
+	REQUIRE_FALSE(deque.pop().has_value());
+	REQUIRE_FALSE(deque.steal().has_value());
+
+	deque.push(1);
+	deque.push(2);
+	deque.push(3);
+	REQUIRE(deque.pop() == 3u);
+	REQUIRE(deque.steal() == 1u);
+	REQUIRE(deque.pop() == 2u);
+	REQUIRE_FALSE(deque.pop().has_value());
+
+	deque.push(4);
+	deque.reset();
+	REQUIRE_FALSE(deque.steal().has_value());
+}
+
+TEST_CASE("[WorkStealingDeque] Every item is taken once with concurrent thieves", "[WorkStealingDeque]") {
+	const uint32_t itemsCount = 100000;
+	abl::WorkStealingDeque deque{itemsCount};
+	std::vector<std::atomic<int>> takenItems(itemsCount);
+	std::atomic<bool> ownerDone{false};
+
+	std::vector<std::thread> thieves;
+	for(size_t thief = 0; thief < 3; ++thief) {
+		thieves.emplace_back([&]() {
+			while(!ownerDone.load()) {
+				if(auto item = deque.steal()) {
+					takenItems[*item].fetch_add(1);
+				}
+			}
+		});
+	}
+
+	for(uint32_t item = 0; item < itemsCount; ++item) {
+		deque.push(item);
+		if(item % 3 == 0) {
+			if(auto poppedItem = deque.pop()) {
+				takenItems[*poppedItem].fetch_add(1);
+			}
+		}
+	}
+	while(auto item = deque.pop()) {
+		takenItems[*item].fetch_add(1);
+	}
+	ownerDone = true;
+	for(auto& thief : thieves) {
+		thief.join();
+	}
+
+	for(auto& takenItem : takenItems) {
+		REQUIRE(takenItem.load() == 1);
+	}
+}
+
+TEST_CASE("[AudioJobGraph] Dependencies are created from the conflicting accesses", "[AudioJobGraph]") {
+	abl::AudioBuffer<float> firstBuffer{64, 4};
+	abl::AudioBuffer<float> secondBuffer{64, 4};
+	abl::AudioBufferView<float> firstChannels = firstBuffer;
+	firstChannels.createSequentialChannelsMapping(0, 2);
+	abl::AudioBufferView<float> lastChannels = firstBuffer;
+	lastChannels.setChannelsMapping({2, 3});
+
+	abl::AudioJobGraph graph;
+	auto writeFirstChannels = graph.addJob([]() {}, {abl::AudioJobAccess::writing(firstChannels)});
+	auto writeLastChannels = graph.addJob([]() {}, {abl::AudioJobAccess::writing(lastChannels)});
+	auto readFirstBuffer = graph.addJob([]() {}, {abl::AudioJobAccess::reading(firstBuffer)});
+	auto readFirstBufferAgain = graph.addJob([]() {}, {abl::AudioJobAccess::reading(firstBuffer), abl::AudioJobAccess::writing(secondBuffer, abl::SamplesRange(0, 32))});
+	auto writeSecondBufferEnd = graph.addJob([]() {}, {abl::AudioJobAccess::writing(secondBuffer, abl::SamplesRange(32, 32))});
+	auto writeSecondBuffer = graph.addJob([]() {}, {abl::AudioJobAccess::writing(secondBuffer)});
+
+	REQUIRE(graph.getJobsCount() == 6);
+	REQUIRE(graph.getDependenciesCount(writeFirstChannels) == 0);
+	REQUIRE(graph.getDependenciesCount(writeLastChannels) == 0);
+	REQUIRE(graph.getDependenciesCount(readFirstBuffer) == 2);
+	REQUIRE(graph.getDependenciesCount(readFirstBufferAgain) == 2);
+	REQUIRE(graph.getDependenciesCount(writeSecondBufferEnd) == 0);
+	REQUIRE(graph.getDependenciesCount(writeSecondBuffer) == 2);
+	REQUIRE(graph.getSuccessors(writeFirstChannels) == std::vector<uint32_t>{uint32_t(readFirstBuffer), uint32_t(readFirstBufferAgain)});
+
+	graph.addDependency(writeFirstChannels, writeSecondBufferEnd);
+	graph.addDependency(writeFirstChannels, writeSecondBufferEnd);
+	REQUIRE(graph.getDependenciesCount(writeSecondBufferEnd) == 1);
+}
+
+TEST_CASE("[AudioJobSystem] Jobs run in parallel respecting the dependencies", "[AudioJobSystem]") {
+	const size_t channels = 16;
+	const size_t bufferSize = 256;
+	abl::AudioBuffer<double> buffer{bufferSize, channels};
+	abl::AudioBuffer<double> sumBuffer{bufferSize, 1};
+	std::vector<abl::AudioBufferView<double>> channelViews;
+	for(size_t channel = 0; channel < channels; ++channel) {
+		auto& channelView = channelViews.emplace_back(buffer);
+		channelView.setChannelsMapping({channel});
+	}
+
+	abl::AudioJobGraph graph;
+	for(size_t channel = 0; channel < channels; ++channel) {
+		graph.addJob([&, channel]() { channelViews[channel].clear(); }, {abl::AudioJobAccess::writing(channelViews[channel])});
+		//The order of these two jobs matter: (0 + channel) * 2 + 1
+		graph.addJob([&, channel]() {
+			for(size_t index = 0; index < bufferSize; ++index) {
+				channelViews[channel].addSample(0, index, double(channel));
+			}
+		}, {abl::AudioJobAccess::writing(channelViews[channel])});
+		graph.addJob([&, channel]() {
+			channelViews[channel].applyGain(2.0);
+			for(size_t index = 0; index < bufferSize; ++index) {
+				channelViews[channel].addSample(0, index, 1.0);
+			}
+		}, {abl::AudioJobAccess::writing(channelViews[channel])});
+	}
+	graph.addJob([&]() {
+		sumBuffer.clear();
+		for(size_t channel = 0; channel < channels; ++channel) {
+			sumBuffer.addIntoChannelFrom(buffer[channel], 0);
+		}
+	}, {abl::AudioJobAccess::reading(buffer), abl::AudioJobAccess::writing(sumBuffer)});
+
+	abl::AudioJobSystem jobSystem{graph.getJobsCount(), 3};
+	REQUIRE(jobSystem.getConcurrency() == 4);
+	double expectedSum = 0;
+	for(size_t channel = 0; channel < channels; ++channel) {
+		expectedSum += double(channel) * 2 + 1;
+	}
+
+	for(size_t run = 0; run < 200; ++run) {
+		buffer.clear();
+		jobSystem.run(graph);
+		for(size_t channel = 0; channel < channels; ++channel) {
+			REQUIRE(buffer.getSample(channel, run % bufferSize) == double(channel) * 2 + 1);
+		}
+		REQUIRE(sumBuffer.getSample(0, run % bufferSize) == expectedSum);
+	}
+}
+
+TEST_CASE("[AudioJobSystem] Every job run once and nested runs are serial", "[AudioJobSystem]") {
+	abl::AudioJobSystem jobSystem{1000, 2};
+	std::vector<std::atomic<int>> executions(1000);
+	abl::AudioJobGraph nestedGraph;
+	std::atomic<int> nestedExecutions{0};
+	nestedGraph.addJob([&]() { nestedExecutions.fetch_add(1); });
+	nestedGraph.addJob([&]() { nestedExecutions.fetch_add(1); });
+
+	abl::AudioJobGraph graph;
+	for(size_t job = 0; job < executions.size(); ++job) {
+		graph.addJob([&, job]() {
+			executions[job].fetch_add(1);
+			if(job % 100 == 0) {
+				jobSystem.run(nestedGraph);
+			}
+		});
+	}
+
+	jobSystem.run(graph);
+	for(auto& execution : executions) {
+		REQUIRE(execution.load() == 1);
+	}
+	REQUIRE(nestedExecutions.load() == 20);
+}
@@ -0,0 +1,284 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../kernels/AudioKernels.h"
+#include "../buffers/AudioBufferChannelView.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+const std::vector<abl::SimdInstructionSet> instructionSets{abl::SimdInstructionSet::Sse2, abl::SimdInstructionSet::Avx2, abl::SimdInstructionSet::Avx512, abl::SimdInstructionSet::Neon};
+
+template<typename T>
+std::vector<T> createRandomSamples(size_t size, unsigned int seed) {
+	std::mt19937 generator{seed};
+	std::vector<T> samples(size);
+	if constexpr (std::is_floating_point_v<T>) {
+		std::uniform_real_distribution<T> distribution{-1, 1};
+		std::generate(samples.begin(), samples.end(), [&]() { return distribution(generator); });
+	} else {
+		std::uniform_int_distribution<int> distribution{-10000, 10000};
+		std::generate(samples.begin(), samples.end(), [&]() { return static_cast<T>(distribution(generator)); });
+	}
+	return samples;
+}
+
+//Every size up to 67 to cover all the vector widths with their scalar tails
+TEMPLATE_TEST_CASE("[AudioKernels] All the instruction sets give the same results of the scalar kernels", "[AudioKernels]", float, double, int16_t, int32_t) {
+	using GainType = typename abl::AudioKernels<TestType>::GainType;
+	const auto scalarTable = abl::AudioKernels<TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::AudioKernels<TestType>::getTableFor(instructionSet);
+		for(size_t size = 0; size < 68; ++size) {
+			auto source = createRandomSamples<TestType>(size, size);
+			auto destination = createRandomSamples<TestType>(size, size + 100);
+			GainType gain = GainType(0.75);
+			GainType startGain = GainType(0.25);
+			GainType gainIncrement = GainType(1) / GainType(64);
+
+			auto expected = destination;
+			auto result = destination;
+			scalarTable.applyGain(expected.data(), size, gain);
+			table.applyGain(result.data(), size, gain);
+			REQUIRE(result == expected);
+
+			scalarTable.applyGainRamp(expected.data(), size, startGain, gainIncrement);
+			table.applyGainRamp(result.data(), size, startGain, gainIncrement);
+			REQUIRE(result == expected);
+
+			scalarTable.add(expected.data(), source.data(), size, gain);
+			table.add(result.data(), source.data(), size, gain);
+			REQUIRE(result == expected);
+
+			scalarTable.addWithRamp(expected.data(), source.data(), size, startGain, gainIncrement);
+			table.addWithRamp(result.data(), source.data(), size, startGain, gainIncrement);
+			REQUIRE(result == expected);
+
+			scalarTable.copy(expected.data(), source.data(), size, gain);
+			table.copy(result.data(), source.data(), size, gain);
+			REQUIRE(result == expected);
+
+			scalarTable.copyWithRamp(expected.data(), source.data(), size, startGain, gainIncrement);
+			table.copyWithRamp(result.data(), source.data(), size, startGain, gainIncrement);
+			REQUIRE(result == expected);
+
+			auto window = createRandomSamples<GainType>(size, size + 200);
+			scalarTable.addWithWindow(expected.data(), source.data(), window.data(), size);
+			table.addWithWindow(result.data(), source.data(), window.data(), size);
+			REQUIRE(result == expected);
+
+			scalarTable.copyWithWindow(expected.data(), source.data(), window.data(), size);
+			table.copyWithWindow(result.data(), source.data(), window.data(), size);
+			REQUIRE(result == expected);
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[AudioKernels] Mix kernel give the same results of the scalar kernel on all the instruction sets", "[AudioKernels]", float, double, int16_t, int32_t) {
+	using GainType = typename abl::AudioKernels<TestType>::GainType;
+	const auto scalarTable = abl::AudioKernels<TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::AudioKernels<TestType>::getTableFor(instructionSet);
+		for(size_t size = 0; size < 68; ++size) {
+			auto firstSource = createRandomSamples<TestType>(size, size + 1);
+			auto secondSource = createRandomSamples<TestType>(size, size + 2);
+			auto thirdSource = createRandomSamples<TestType>(size, size + 3);
+			auto destination = createRandomSamples<TestType>(size, size + 100);
+			const std::vector<abl::kernels::KernelMixSource<TestType>> sources{
+				{firstSource.data(), GainType(0.5), GainType(0)},
+				{secondSource.data(), GainType(0.25), GainType(1) / GainType(64)},
+				{thirdSource.data(), GainType(1), GainType(-1) / GainType(128)}
+			};
+
+			auto expected = destination;
+			auto result = destination;
+			scalarTable.mix(expected.data(), sources.data(), sources.size(), size);
+			table.mix(result.data(), sources.data(), sources.size(), size);
+			REQUIRE(result == expected);
+		}
+	}
+}
+
+//The vector kernels add the samples in a different order, so only the min and max are exactly the same of the scalar kernel
+TEMPLATE_TEST_CASE("[AudioKernels] Analyze kernel give the same results of the scalar kernel on all the instruction sets", "[AudioKernels]", float, double, int16_t, int32_t) {
+	const auto scalarTable = abl::AudioKernels<TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::AudioKernels<TestType>::getTableFor(instructionSet);
+		for(size_t size = 1; size < 200; ++size) {
+			auto samples = createRandomSamples<TestType>(size, size);
+			auto expected = scalarTable.analyze(samples.data(), size);
+			auto result = table.analyze(samples.data(), size);
+			REQUIRE(result.min == expected.min);
+			REQUIRE(result.max == expected.max);
+			REQUIRE(std::abs(double(result.sum) - double(expected.sum)) <= 1e-4 * std::max(double(expected.squaresSum), 1.0));
+			REQUIRE(std::abs(double(result.squaresSum) - double(expected.squaresSum)) <= 1e-5 * double(expected.squaresSum));
+		}
+	}
+}
+
+//The windowed sinc is summed in a different order, and the integral samples can be truncated to the next integer
+TEMPLATE_TEST_CASE("[AudioKernels] Interpolate kernel give the same results of the scalar kernel on all the instruction sets", "[AudioKernels]", float, double, int16_t, int32_t) {
+	const auto scalarTable = abl::AudioKernels<TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+	const double tolerance = std::is_integral_v<TestType> ? 1.0 : 1e-5;
+	auto source = createRandomSamples<TestType>(300, 1);
+	std::mt19937 generator{2};
+	std::uniform_real_distribution<double> distribution{8, 280};
+	std::vector<double> positions(67);
+	std::generate(positions.begin(), positions.end(), [&]() { return distribution(generator); });
+	positions[0] = 10;
+
+	for(auto interpolation : {abl::InterpolationType::Linear, abl::InterpolationType::Hermite, abl::InterpolationType::Lagrange, abl::InterpolationType::WindowedSinc}) {
+		std::vector<TestType> expected(positions.size());
+		scalarTable.interpolate(expected.data(), source.data(), positions.data(), positions.size(), interpolation);
+		REQUIRE(std::abs(double(expected[0]) - double(source[10])) <= tolerance);
+		for(auto instructionSet : instructionSets) {
+			const auto table = abl::AudioKernels<TestType>::getTableFor(instructionSet);
+			for(size_t size = 1; size <= positions.size(); size += 11) {
+				std::vector<TestType> result(size);
+				table.interpolate(result.data(), source.data(), positions.data(), size, interpolation);
+				for(size_t index = 0; index < size; ++index) {
+					REQUIRE(std::abs(double(result[index]) - double(expected[index])) <= tolerance);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("[AudioKernels] Interpolations reproduce the polynomials of their order", "[AudioKernels]") {
+	std::vector<double> source(64);
+	for(size_t index = 0; index < source.size(); ++index) {
+		auto x = static_cast<double>(index) / 8;
+		source[index] = x * x * x - 2 * x + 1;
+	}
+	std::vector<double> positions{1, 1.25, 17.5, 30.125, 60.999};
+	std::vector<double> result(positions.size());
+	abl::AudioKernels<double>::interpolate(result.data(), source.data(), positions.data(), positions.size(), abl::InterpolationType::Lagrange);
+	for(size_t index = 0; index < positions.size(); ++index) {
+		auto x = positions[index] / 8;
+		REQUIRE(std::abs(result[index] - (x * x * x - 2 * x + 1)) < 1e-9);
+	}
+
+	//Hermite and linear are exact on a line
+	for(size_t index = 0; index < source.size(); ++index) {
+		source[index] = 3 * static_cast<double>(index) - 20;
+	}
+	for(auto interpolation : {abl::InterpolationType::Linear, abl::InterpolationType::Hermite}) {
+		abl::AudioKernels<double>::interpolate(result.data(), source.data(), positions.data(), positions.size(), interpolation);
+		for(size_t index = 0; index < positions.size(); ++index) {
+			REQUIRE(std::abs(result[index] - (3 * positions[index] - 20)) < 1e-9);
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[AudioKernels] Unity gain leaves the samples untouched", "[AudioKernels]", float, double, int16_t, int32_t) {
+	auto source = createRandomSamples<TestType>(37, 1);
+	auto destination = createRandomSamples<TestType>(37, 2);
+
+	auto result = source;
+	abl::AudioKernels<TestType>::applyGain(result.data(), result.size(), 1);
+	REQUIRE(result == source);
+
+	abl::AudioKernels<TestType>::copy(destination.data(), source.data(), source.size());
+	REQUIRE(destination == source);
+}
+
+//Full scale samples with gains that push them out of the range of the type: every kernel saturate like the scalar ones
+TEMPLATE_TEST_CASE("[AudioKernels] Integral samples saturate on overflow on all the instruction sets", "[AudioKernels]", int16_t, int32_t) {
+	using Limits = std::numeric_limits<TestType>;
+	const auto scalarTable = abl::AudioKernels<TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+
+	std::vector<TestType> source(67);
+	std::vector<TestType> destination(67);
+	std::vector<double> window(67);
+	for(size_t index = 0; index < source.size(); ++index) {
+		source[index] = index % 2 == 0 ? Limits::max() : Limits::lowest();
+		destination[index] = index % 3 == 0 ? Limits::lowest() : Limits::max() - TestType(index);
+		window[index] = 1.5 + static_cast<double>(index);
+	}
+
+	std::vector<TestType> saturated{Limits::max()};
+	scalarTable.applyGain(saturated.data(), saturated.size(), 4);
+	REQUIRE(saturated[0] == Limits::max());
+	saturated[0] = Limits::max();
+	scalarTable.applyGain(saturated.data(), saturated.size(), -4);
+	REQUIRE(saturated[0] == Limits::lowest());
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::AudioKernels<TestType>::getTableFor(instructionSet);
+		for(size_t size : {size_t(1), size_t(7), size_t(16), size_t(33), size_t(67)}) {
+			for(double gain : {3.0, -2.5, 1e12}) {
+				auto expected = destination;
+				auto result = destination;
+				scalarTable.applyGain(expected.data(), size, gain);
+				table.applyGain(result.data(), size, gain);
+				REQUIRE(result == expected);
+
+				expected = destination;
+				result = destination;
+				scalarTable.applyGainRamp(expected.data(), size, gain, gain / 8);
+				table.applyGainRamp(result.data(), size, gain, gain / 8);
+				REQUIRE(result == expected);
+
+				scalarTable.add(expected.data(), source.data(), size, gain);
+				table.add(result.data(), source.data(), size, gain);
+				REQUIRE(result == expected);
+
+				scalarTable.addWithRamp(expected.data(), source.data(), size, gain, gain / 8);
+				table.addWithRamp(result.data(), source.data(), size, gain, gain / 8);
+				REQUIRE(result == expected);
+
+				scalarTable.copy(expected.data(), source.data(), size, gain);
+				table.copy(result.data(), source.data(), size, gain);
+				REQUIRE(result == expected);
+
+				scalarTable.copyWithRamp(expected.data(), source.data(), size, gain, gain / 8);
+				table.copyWithRamp(result.data(), source.data(), size, gain, gain / 8);
+				REQUIRE(result == expected);
+
+				scalarTable.addWithWindow(expected.data(), source.data(), window.data(), size);
+				table.addWithWindow(result.data(), source.data(), window.data(), size);
+				REQUIRE(result == expected);
+
+				scalarTable.copyWithWindow(expected.data(), source.data(), window.data(), size);
+				table.copyWithWindow(result.data(), source.data(), window.data(), size);
+				REQUIRE(result == expected);
+
+				const std::vector<abl::kernels::KernelMixSource<TestType>> sources{{source.data(), gain, 0}, {source.data(), gain, gain / 8}};
+				scalarTable.mix(expected.data(), sources.data(), sources.size(), size);
+				table.mix(result.data(), sources.data(), sources.size(), size);
+				REQUIRE(result == expected);
+			}
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[AudioKernels] Channel view operations between contiguous views use the kernels", "[AudioKernels]", int, double) {
+	const size_t bufferSize = 37;
+	std::vector<TestType> sourceData(bufferSize, TestType(8));
+	std::vector<TestType> destinationData(bufferSize, TestType(2));
+	abl::AudioBufferChannelView<TestType> sourceView{sourceData.data(), bufferSize};
+	abl::AudioBufferChannelView<TestType> destinationView{destinationData.data(), bufferSize};
+
+	destinationView.addFrom(sourceView, {1, 35}, 0.5);
+	REQUIRE(destinationView.getSample(0) == TestType(2));
+	for(size_t index = 1; index < 36; ++index) {
+		REQUIRE(destinationView.getSample(index) == TestType(6));
+	}
+	REQUIRE(destinationView.getSample(36) == TestType(2));
+
+	destinationView.copyWithRampFrom(sourceView, 0, 1, {0, 32});
+	for(size_t index = 0; index < 32; ++index) {
+		REQUIRE(destinationView.getSample(index) == TestType(index / 4.0));
+	}
+
+	destinationView.addWithRampFrom(sourceView, 0.25, 0.25, {0, 4});
+	for(size_t index = 0; index < 4; ++index) {
+		REQUIRE(destinationView.getSample(index) == TestType(index / 4.0) + TestType(2));
+	}
+}
@@ -0,0 +1,177 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../analysis/AudioLevelMeter.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template<typename T>
+abl::AudioBuffer<T> createSquareWave(size_t bufferSize, size_t channels, T amplitude) {
+	abl::AudioBuffer<T> buffer{bufferSize, channels};
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < bufferSize; ++index) {
+			buffer.setSample(channel, index, index % 2 == 0 ? amplitude : T(-amplitude * T(channel + 1)));
+		}
+	}
+	return buffer;
+}
+
+TEMPLATE_TEST_CASE("[AudioLevelMeter] RMS and peak of the processed blocks", "[AudioLevelMeter]", int16_t, int, float, double) {
+	const TestType amplitude = std::is_integral_v<TestType> ? TestType(16000) : TestType(0.25);
+	auto buffer = createSquareWave<TestType>(1024, 2, amplitude);
+	abl::AudioLevelMeter<TestType> meter{2, {.rmsWindowSize = 512}};
+	REQUIRE(meter.getLevels(0).rms == 0);
+
+	meter.process(buffer);
+	REQUIRE(meter.getProcessedSamplesCount() == 1024);
+	auto levels = meter.getLevels(0);
+	REQUIRE(levels.peak == amplitude);
+	REQUIRE(levels.heldPeak == amplitude);
+	REQUIRE(levels.maxPeak == amplitude);
+	REQUIRE(std::abs(levels.rms - double(amplitude)) < 1e-3);
+
+	//Half of the samples at amplitude and half at two times amplitude
+	auto secondChannelLevels = meter.getLevels(1);
+	REQUIRE(secondChannelLevels.peak == 2 * amplitude);
+	REQUIRE(std::abs(secondChannelLevels.rms - std::sqrt((1.0 + 4.0) / 2.0) * double(amplitude)) < 1e-2);
+}
+
+TEST_CASE("[AudioLevelMeter] Blocks of any size give the same levels", "[AudioLevelMeter]") {
+	abl::AudioBuffer<double> buffer{4000, 1};
+	for(size_t index = 0; index < buffer.getBufferSize(); ++index) {
+		buffer.setSample(0, index, std::sin(double(index) * 0.01) * (double(index) / 4000.0));
+	}
+
+	abl::AudioLevelMeter<double> singleBlockMeter{1, {.rmsWindowSize = 1000}};
+	abl::AudioLevelMeter<double> smallBlocksMeter{1, {.rmsWindowSize = 1000}};
+	singleBlockMeter.process(buffer);
+	for(size_t startSample = 0; startSample < buffer.getBufferSize(); startSample += 100) {
+		smallBlocksMeter.process(buffer, abl::SamplesRange(startSample, 100));
+	}
+	REQUIRE(std::abs(singleBlockMeter.getRMSLevel(0) - smallBlocksMeter.getRMSLevel(0)) < 1e-12);
+	REQUIRE(singleBlockMeter.getLevels(0).maxPeak == smallBlocksMeter.getLevels(0).maxPeak);
+
+	//The window hold the last 4 chunks (1024 samples) completed, the chunk at the end of the buffer isn't completed yet
+	double squaresSum = 0;
+	for(size_t index = 3840 - 1024; index < 3840; ++index) {
+		squaresSum += buffer.getSample(0, index) * buffer.getSample(0, index);
+	}
+	REQUIRE(std::abs(singleBlockMeter.getRMSLevel(0) - std::sqrt(squaresSum / 1024)) < 1e-12);
+}
+
+TEST_CASE("[AudioLevelMeter] Held peak decay after the hold time and max peak reset", "[AudioLevelMeter]") {
+	abl::AudioLevelMeter<float> meter{1, {.peakHoldSamples = 200, .peakDecayPerSample = 0.99}};
+	abl::AudioBuffer<float> buffer{100, 1};
+	buffer.clear();
+	buffer.setSample(0, 10, -0.8f);
+	meter.process(buffer);
+	REQUIRE(meter.getLevels(0).heldPeak == 0.8f);
+
+	buffer.clear();
+	meter.process(buffer);
+	meter.process(buffer);
+	REQUIRE(meter.getLevels(0).peak == 0.0f);
+	REQUIRE(meter.getLevels(0).heldPeak == 0.8f);
+
+	meter.process(buffer);
+	REQUIRE(std::abs(meter.getLevels(0).heldPeak - 0.8f * std::pow(0.99f, 100.0f)) < 1e-5f);
+	REQUIRE(meter.getLevels(0).maxPeak == 0.8f);
+
+	meter.resetMaxPeaks();
+	buffer.setSample(0, 0, 0.1f);
+	meter.process(buffer);
+	REQUIRE(meter.getLevels(0).maxPeak == 0.1f);
+}
+
+TEMPLATE_TEST_CASE("[AudioLevelMeter] Circular buffer meter the samples published by incrementWriteIndex", "[AudioLevelMeter]", int, float) {
+	const size_t singleBufferSize = 96;
+	abl::CircularAudioBuffer<TestType> circularBuffer{4 * singleBufferSize, singleBufferSize, 2, 3 * singleBufferSize + 40};
+	abl::AudioLevelMeter<TestType> meter{2, {.rmsWindowSize = 256}};
+	abl::AudioLevelMeter<TestType> expectedMeter{2, {.rmsWindowSize = 256}};
+	circularBuffer.setLevelMeter(&meter);
+	REQUIRE(circularBuffer.getLevelMeter() == &meter);
+
+	abl::AudioBuffer<TestType> block{singleBufferSize, 2};
+	for(size_t blockIndex = 0; blockIndex < 10; ++blockIndex) {
+		for(size_t index = 0; index < singleBufferSize; ++index) {
+			block.setSample(0, index, TestType((blockIndex * singleBufferSize + index) % 50));
+			block.setSample(1, index, TestType(-int(blockIndex)));
+		}
+		REQUIRE(circularBuffer.tryWrite(block));
+		expectedMeter.process(block);
+		abl::AudioBuffer<TestType> readBlock{singleBufferSize, 2};
+		REQUIRE(circularBuffer.tryRead(readBlock));
+
+		for(size_t channel = 0; channel < 2; ++channel) {
+			REQUIRE(meter.getLevels(channel).rms == expectedMeter.getLevels(channel).rms);
+			REQUIRE(meter.getLevels(channel).peak == expectedMeter.getLevels(channel).peak);
+			REQUIRE(meter.getLevels(channel).heldPeak == expectedMeter.getLevels(channel).heldPeak);
+		}
+	}
+	REQUIRE(meter.getProcessedSamplesCount() == 10 * singleBufferSize);
+
+	circularBuffer.setLevelMeter(nullptr);
+	circularBuffer.incrementWriteIndex();
+	REQUIRE(meter.getProcessedSamplesCount() == 10 * singleBufferSize);
+}
+
+TEST_CASE("[AudioLevelMeter] Copies of a metered circular buffer start without the meter", "[AudioLevelMeter]") {
+	abl::CircularAudioBuffer<float> circularBuffer{256, 64, 2};
+	abl::AudioLevelMeter<float> meter{2};
+	circularBuffer.setLevelMeter(&meter);
+
+	abl::CircularAudioBufferView<float> viewCopy{circularBuffer};
+	REQUIRE(viewCopy.getLevelMeter() == nullptr);
+	viewCopy.incrementWriteIndex();
+	REQUIRE(meter.getProcessedSamplesCount() == 0);
+
+	abl::CircularAudioBuffer<float> bufferCopy{circularBuffer};
+	REQUIRE(bufferCopy.getLevelMeter() == nullptr);
+	abl::CircularAudioBuffer<float> assignedBuffer{256, 64, 2};
+	assignedBuffer.setLevelMeter(&meter);
+	assignedBuffer = bufferCopy;
+	REQUIRE(assignedBuffer.getLevelMeter() == nullptr);
+
+	abl::CircularAudioBuffer<float> movedBuffer{std::move(circularBuffer)};
+	REQUIRE(movedBuffer.getLevelMeter() == &meter);
+	REQUIRE(circularBuffer.getLevelMeter() == nullptr);
+	movedBuffer.incrementWriteIndex();
+	REQUIRE(meter.getProcessedSamplesCount() == 64);
+
+	bufferCopy = std::move(movedBuffer);
+	REQUIRE(bufferCopy.getLevelMeter() == &meter);
+	REQUIRE(movedBuffer.getLevelMeter() == nullptr);
+}
+
+TEST_CASE("[AudioLevelMeter] Levels are read while the blocks are written", "[AudioLevelMeter]") {
+	abl::AudioLevelMeter<float> meter{8};
+	abl::AudioBuffer<float> block{128, 8};
+	for(size_t channel = 0; channel < 8; ++channel) {
+		for(size_t index = 0; index < 128; ++index) {
+			block.setSample(channel, index, index % 2 == 0 ? 0.5f : -0.5f);
+		}
+	}
+
+	std::atomic<bool> writing{true};
+	bool levelsInRange = true;
+	std::thread reader([&]() {
+		while(writing.load()) {
+			for(size_t channel = 0; channel < 8; ++channel) {
+				auto levels = meter.getLevels(channel);
+				levelsInRange = levelsInRange && levels.rms <= 0.5f + 1e-6f && levels.heldPeak <= 0.5f;
+			}
+		}
+	});
+	for(size_t blockIndex = 0; blockIndex < 2000; ++blockIndex) {
+		meter.process(block);
+	}
+	writing = false;
+	reader.join();
+	REQUIRE(levelsInRange);
+	REQUIRE(std::abs(meter.getRMSLevel(7) - 0.5f) < 1e-6f);
+}
@@ -0,0 +1,146 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../analysis/AudioStatistics.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/InterleavedAudioBufferView.h"
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEMPLATE_TEST_CASE("[AudioStatistics] Statistics of a sine with a DC offset", "[AudioStatistics]", int16_t, int, float, double) {
+	const double amplitude = std::is_integral_v<TestType> ? 10000 : 0.5;
+	const double dcOffset = amplitude / 10;
+	const size_t bufferSize = 48000;
+	abl::AudioBuffer<TestType> buffer{bufferSize, 1};
+	for(size_t index = 0; index < bufferSize; ++index) {
+		buffer.setSample(0, index, static_cast<TestType>(dcOffset + amplitude * std::sin(2 * std::numbers::pi * double(index) / 480)));
+	}
+
+	auto statistics = buffer[0].getStatistics();
+	auto expectedRMS = std::sqrt(amplitude * amplitude / 2 + dcOffset * dcOffset);
+	REQUIRE(statistics.samplesCount == bufferSize);
+	REQUIRE(statistics.max == static_cast<TestType>(dcOffset + amplitude));
+	REQUIRE(statistics.min == static_cast<TestType>(dcOffset - amplitude));
+	REQUIRE(statistics.peak == statistics.max);
+	REQUIRE(std::abs(double(statistics.dcOffset) - dcOffset) < amplitude * 1e-4);
+	REQUIRE(std::abs(double(statistics.rms) - expectedRMS) < amplitude * 1e-4);
+	REQUIRE(std::abs(double(statistics.crestFactor) - (dcOffset + amplitude) / expectedRMS) < 1e-4);
+}
+
+TEST_CASE("[AudioStatistics] Integral sums don't overflow", "[AudioStatistics]") {
+	abl::AudioBuffer<int16_t> buffer{100000, 1};
+	for(size_t index = 0; index < buffer.getBufferSize(); ++index) {
+		buffer.setSample(0, index, std::numeric_limits<int16_t>::max());
+	}
+
+	auto statistics = buffer[0].getStatistics();
+	REQUIRE(statistics.dcOffset == 32767.0);
+	REQUIRE(statistics.rms == 32767.0);
+	REQUIRE(statistics.crestFactor == 1.0);
+	REQUIRE(buffer[0].getRMSLevel() == 32767);
+
+	abl::AudioBuffer<int32_t> fullScaleBuffer{100000, 1};
+	for(size_t index = 0; index < fullScaleBuffer.getBufferSize(); ++index) {
+		fullScaleBuffer.setSample(0, index, index % 2 == 0 ? std::numeric_limits<int32_t>::max() : -std::numeric_limits<int32_t>::max());
+	}
+	auto fullScaleStatistics = fullScaleBuffer[0].getStatistics();
+	REQUIRE(fullScaleStatistics.dcOffset == 0.0);
+	REQUIRE(std::abs(fullScaleStatistics.rms / double(std::numeric_limits<int32_t>::max()) - 1.0) < 1e-12);
+}
+
+//A float running sum of these samples stops growing long before the end
+TEST_CASE("[AudioStatistics] Float sums keep their precision on long buffers", "[AudioStatistics]") {
+	const size_t bufferSize = 1 << 24;
+	std::vector<float> samples(bufferSize, 0.1f);
+	abl::AudioBufferChannelView<float> channelView{samples.data(), bufferSize};
+
+	auto statistics = channelView.getStatistics();
+	REQUIRE(std::abs(statistics.dcOffset - 0.1f) <= 1e-6f);
+	REQUIRE(std::abs(statistics.rms - 0.1f) <= 1e-6f);
+}
+
+TEST_CASE("[AudioStatistics] Peak is the first of the samples with the higher absolute value", "[AudioStatistics]") {
+	std::vector<double> samples(10000, 0.0);
+	abl::AudioBufferChannelView<double> channelView{samples.data(), samples.size()};
+	samples[20] = -3;
+	samples[30] = 3;
+	REQUIRE(channelView.getHigherPeak() == -3);
+	REQUIRE(channelView.getStatistics().min == -3);
+	REQUIRE(channelView.getStatistics().max == 3);
+	REQUIRE(channelView.getHigherPeak({25, 100}) == 3);
+
+	//In different blocks of the accumulator
+	samples[20] = 0;
+	samples[5000] = -3;
+	REQUIRE(channelView.getHigherPeak() == 3);
+	samples[6000] = -4;
+	REQUIRE(channelView.getHigherPeak() == -4);
+}
+
+TEST_CASE("[AudioStatistics] Merged accumulators equal a single pass", "[AudioStatistics]") {
+	std::vector<int> samples(9000);
+	for(size_t index = 0; index < samples.size(); ++index) {
+		samples[index] = int(index % 123) - 40;
+	}
+
+	abl::AudioStatisticsAccumulator<int> accumulator;
+	accumulator.process(samples.data(), samples.size());
+	abl::AudioStatisticsAccumulator<int> firstPart;
+	abl::AudioStatisticsAccumulator<int> secondPart;
+	firstPart.process(samples.data(), 5000);
+	secondPart.process(samples.data() + 5000, 4000);
+	firstPart.merge(secondPart);
+
+	auto expected = accumulator.getStatistics();
+	auto result = firstPart.getStatistics();
+	REQUIRE(result.peak == expected.peak);
+	REQUIRE(result.min == expected.min);
+	REQUIRE(result.max == expected.max);
+	REQUIRE(result.dcOffset == expected.dcOffset);
+	REQUIRE(result.rms == expected.rms);
+	REQUIRE(result.samplesCount == 9000);
+
+	firstPart.reset();
+	REQUIRE(firstPart.getStatistics().samplesCount == 0);
+	REQUIRE(firstPart.getStatistics().rms == 0);
+}
+
+TEMPLATE_TEST_CASE("[AudioStatistics] Circular and multichannel views", "[AudioStatistics]", int, float) {
+	const size_t singleBufferSize = 64;
+	abl::CircularAudioBuffer<TestType> circularBuffer{2 * singleBufferSize, singleBufferSize, 2, singleBufferSize + 40};
+	abl::AudioBuffer<TestType> block{singleBufferSize, 2};
+	for(size_t index = 0; index < singleBufferSize; ++index) {
+		block.setSample(0, index, TestType(index % 8));
+		block.setSample(1, index, TestType(-int(index % 4)));
+	}
+	REQUIRE(circularBuffer.tryWrite(block));
+
+	//The samples of the circular buffer wrap around its end
+	auto firstChannelStatistics = circularBuffer.getStatisticsForChannel(0);
+	REQUIRE(firstChannelStatistics.max == TestType(7));
+	REQUIRE(firstChannelStatistics.min == TestType(0));
+	REQUIRE(firstChannelStatistics.dcOffset == 3.5);
+	REQUIRE(std::abs(double(firstChannelStatistics.rms) - std::sqrt(140.0 / 8.0)) < 1e-5);
+	REQUIRE(circularBuffer[0].getStatistics().rms == firstChannelStatistics.rms);
+
+	auto statistics = circularBuffer.getStatistics();
+	auto blockStatistics = block.getStatistics();
+	REQUIRE(statistics.samplesCount == 2 * singleBufferSize);
+	REQUIRE(statistics.peak == TestType(7));
+	REQUIRE(statistics.min == TestType(-3));
+	REQUIRE(statistics.dcOffset == (3.5 - 1.5) / 2);
+	REQUIRE(statistics.rms == blockStatistics.rms);
+	REQUIRE(block.getStatisticsForChannel(1).peak == TestType(-3));
+
+	std::vector<TestType> interleavedSamples(2 * singleBufferSize);
+	abl::InterleavedAudioBufferView<TestType> interleavedView{interleavedSamples.data(), 2, singleBufferSize};
+	interleavedView.copyFrom(block);
+	REQUIRE(interleavedView.getStatistics().rms == blockStatistics.rms);
+	REQUIRE(interleavedView.getStatisticsForChannel(1).dcOffset == -1.5);
+	REQUIRE(interleavedView.getStatisticsForChannel(0, {8, 4}).max == TestType(3));
+}
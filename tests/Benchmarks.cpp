@@ -2,7 +2,23 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/AudioBufferChannelView.h"
+#include "../buffers/AudioBufferChannelViewWrapper.h"
 #include "../buffers/AudioBufferView.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/DelayedCircularAudioBuffer.h"
+#include "../buffers/SmallAudioBuffer.h"
+#include "../buffers/InterleavedAudioBufferView.h"
+#include "../buffers/SampleFormatConversion.h"
+#include "../parallel/WorkStealingThreadPool.h"
+#include "../parallel/AudioJobSystem.h"
+#include "../analysis/AudioLevelMeter.h"
+#include "../analysis/AudioStatistics.h"
+#include "../analysis/WaveformOverview.h"
+#include "../streaming/FramingAudioProcessor.h"
+#include <numeric>
+#include <thread>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
@@ -52,6 +68,64 @@ TEMPLATE_TEST_CASE("[AudioBufferChannelView] Benchmark normal access vs buffer v
 	delete[] data;
 }
 
+TEMPLATE_TEST_CASE("[AudioBufferChannelViewWrapper] Benchmark per sample access vs block level access", "[AudioBufferChannelViewWrapper]", float, double) {
+	const size_t bufferSize = 512;
+
+	std::vector<TestType> data(bufferSize);
+	std::iota(data.begin(), data.end(), 1);
+	abl::AudioBufferChannelViewWrapper<TestType> channelViewWrapper{abl::CircularAudioBufferChannelView<TestType>{data.data(), bufferSize, bufferSize, bufferSize / 2}};
+
+	BENCHMARK("Normal Iterator") {
+		TestType sum = 0;
+		for(size_t i = 0; i < bufferSize; ++i) {
+			sum += data[(i + bufferSize / 2) % bufferSize];
+		}
+		return sum;
+	};
+
+	BENCHMARK("AudioBufferChannelViewWrapper operator[]") {
+		TestType sum = 0;
+		for(size_t i = 0; i < bufferSize; ++i) {
+			sum += channelViewWrapper[i];
+		}
+		return sum;
+	};
+
+	BENCHMARK("AudioBufferChannelViewWrapper Iterator") {
+		TestType sum = 0;
+		for(auto&& sample: channelViewWrapper) {
+			sum += sample;
+		}
+		return sum;
+	};
+
+	BENCHMARK("AudioBufferChannelViewWrapper abl::ranges::for_each") {
+		TestType sum = 0;
+		abl::ranges::for_each(channelViewWrapper, [&sum](TestType sample) { sum += sample; });
+		return sum;
+	};
+
+	BENCHMARK("AudioBufferChannelViewWrapper withResolvedView") {
+		return channelViewWrapper.withResolvedView([](const auto& channelView) {
+			TestType sum = 0;
+			for(size_t i = 0; i < bufferSize; ++i) {
+				sum += channelView[i];
+			}
+			return sum;
+		});
+	};
+
+	BENCHMARK("AudioBufferChannelViewWrapper visitContiguous") {
+		TestType sum = 0;
+		channelViewWrapper.visitContiguous([&sum](TestType* part, size_t samplesCount, size_t) {
+			for(size_t i = 0; i < samplesCount; ++i) {
+				sum += part[i];
+			}
+		});
+		return sum;
+	};
+}
+
 TEMPLATE_TEST_CASE("[AudioBufferView] Benchmark normal access vs buffer view", "[AudioBufferView]", int, double) {
 	size_t channels = 2;
 	size_t bufferSize = 16;
@@ -115,4 +189,468 @@ TEMPLATE_TEST_CASE("[AudioBufferView] Benchmark normal access vs buffer view", "
 	delete[] data;
 }
 
+TEMPLATE_TEST_CASE("[AudioBufferView] Benchmark ranged view creation with channels mapping", "[AudioBufferView]", float, double) {
+	const size_t channels = 8;
+	const size_t bufferSize = 512;
+	abl::AudioBuffer<TestType> audioBuffer{bufferSize, channels, {7, 6, 5, 4, 3, 2, 1, 0}};
+
+	BENCHMARK("getRangedView of 64 samples blocks") {
+		TestType sum = 0;
+		for(size_t startSample = 0; startSample < bufferSize; startSample += 64) {
+			auto rangedView = audioBuffer.getRangedView({startSample, 64});
+			sum += rangedView.getSample(0, 0);
+		}
+		return sum;
+	};
+}
+
+TEMPLATE_TEST_CASE("[CircularAudioBuffer] Benchmark single producer/single consumer throughput", "[CircularAudioBuffer]", float, double) {
+	const size_t channels = 2;
+	const size_t blockSize = 256;
+	const size_t blocksCount = 4096;
+
+	abl::CircularAudioBuffer<TestType> ringBuffer{blockSize * 8, blockSize, channels};
+	abl::AudioBuffer<TestType> writeBlock{blockSize, channels};
+	abl::AudioBuffer<TestType> readBlock{blockSize, channels};
+	writeBlock.clear();
+
+	BENCHMARK("tryWrite/tryRead of " + std::to_string(blocksCount) + " blocks of " + std::to_string(blockSize) + " samples") {
+		std::thread producer([&]() {
+			for(size_t block = 0; block < blocksCount; ++block) {
+				while(!ringBuffer.tryWrite(writeBlock)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		size_t readBlocks = 0;
+		while(readBlocks < blocksCount) {
+			if(ringBuffer.tryRead(readBlock)) {
+				++readBlocks;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		producer.join();
+		return readBlock.getSample(0, 0);
+	};
+}
+
+TEMPLATE_TEST_CASE("[SmallAudioBuffer] Benchmark scratch buffer creation", "[SmallAudioBuffer]", float, double) {
+	const size_t blockSize = 64;
+	const size_t channels = 2;
+
+	BENCHMARK("AudioBuffer of " + std::to_string(blockSize) + " samples") {
+		abl::AudioBuffer<TestType> scratchBuffer{blockSize, channels};
+		scratchBuffer.setSample(1, blockSize - 1, TestType(1));
+		return scratchBuffer.getSample(1, blockSize - 1);
+	};
+
+	BENCHMARK("SmallAudioBuffer of " + std::to_string(blockSize) + " samples") {
+		abl::SmallAudioBuffer<TestType, channels, blockSize> scratchBuffer{blockSize, channels};
+		scratchBuffer.setSample(1, blockSize - 1, TestType(1));
+		return scratchBuffer.getSample(1, blockSize - 1);
+	};
+}
+
+TEMPLATE_TEST_CASE("[InterleavedAudioBufferView] Benchmark interleave/deinterleave kernels vs per sample loop", "[InterleavedAudioBufferView]", float, double) {
+	const size_t blockSize = 512;
+
+	for(size_t channels : {2, 6}) {
+		abl::AudioBuffer<TestType> planarBuffer{blockSize, channels};
+		planarBuffer.clear();
+		std::vector<TestType> interleavedData(blockSize * channels);
+		abl::InterleavedAudioBufferView<TestType> interleavedView{interleavedData.data(), channels, blockSize};
+
+		BENCHMARK("Per sample interleave of " + std::to_string(channels) + " channels") {
+			for(size_t frame = 0; frame < blockSize; ++frame) {
+				for(size_t channel = 0; channel < channels; ++channel) {
+					interleavedData[frame * channels + channel] = planarBuffer.getChannelRawData(channel)[frame];
+				}
+			}
+			return interleavedData[0];
+		};
+
+		BENCHMARK("InterleavedAudioBufferView::copyFrom of " + std::to_string(channels) + " channels") {
+			interleavedView.copyFrom(planarBuffer);
+			return interleavedData[0];
+		};
+
+		BENCHMARK("Per sample deinterleave of " + std::to_string(channels) + " channels") {
+			for(size_t frame = 0; frame < blockSize; ++frame) {
+				for(size_t channel = 0; channel < channels; ++channel) {
+					planarBuffer.getChannelRawData(channel)[frame] = interleavedData[frame * channels + channel];
+				}
+			}
+			return planarBuffer.getSample(0, 0);
+		};
+
+		BENCHMARK("AudioBufferView::copyFrom of " + std::to_string(channels) + " interleaved channels") {
+			planarBuffer.copyFrom(interleavedView);
+			return planarBuffer.getSample(0, 0);
+		};
+	}
+}
+
+TEST_CASE("[SampleFormatConversion] Benchmark sample format conversion vs per sample loop", "[SampleFormatConversion]") {
+	const size_t blockSize = 4096;
+	const size_t channels = 2;
+
+	abl::AudioBuffer<float> floatBuffer{blockSize, channels};
+	abl::AudioBuffer<int16_t> int16Buffer{blockSize, channels};
+	for(size_t index = 0; index < blockSize; ++index) {
+		floatBuffer.setSample(0, index, float(index) / float(blockSize));
+		floatBuffer.setSample(1, index, -float(index) / float(blockSize));
+	}
+	abl::TpdfDither dither;
+
+	BENCHMARK("Per sample float to int16") {
+		for(size_t channel = 0; channel < channels; ++channel) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				auto value = std::clamp(floatBuffer.getSample(channel, index) * 32768.0f, -32768.0f, 32767.0f);
+				int16Buffer.setSample(channel, index, int16_t(std::lrint(value)));
+			}
+		}
+		return int16Buffer.getSample(0, 1);
+	};
+
+	BENCHMARK("convertSampleFormat float to int16") {
+		abl::convertSampleFormat(int16Buffer, floatBuffer);
+		return int16Buffer.getSample(0, 1);
+	};
+
+	BENCHMARK("convertSampleFormat float to int16 with dither") {
+		abl::convertSampleFormat(int16Buffer, floatBuffer, {}, {.dither = &dither});
+		return int16Buffer.getSample(0, 1);
+	};
+
+	BENCHMARK("Per sample int16 to float") {
+		for(size_t channel = 0; channel < channels; ++channel) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				floatBuffer.setSample(channel, index, float(int16Buffer.getSample(channel, index)) / 32768.0f);
+			}
+		}
+		return floatBuffer.getSample(0, 1);
+	};
+
+	BENCHMARK("convertSampleFormat int16 to float") {
+		abl::convertSampleFormat(floatBuffer, int16Buffer);
+		return floatBuffer.getSample(0, 1);
+	};
+}
+
+TEMPLATE_TEST_CASE("[AudioBufferView] Benchmark mixFrom vs an addFrom for every source", "[AudioBufferView]", float, double) {
+	const size_t blockSize = 4096;
+	const size_t channels = 2;
+	const size_t sourcesCount = 8;
+
+	std::vector<abl::AudioBuffer<TestType>> sources;
+	std::vector<abl::AudioBufferMixSource<TestType>> mixSources;
+	sources.reserve(sourcesCount);
+	for(size_t source = 0; source < sourcesCount; ++source) {
+		auto& sourceBuffer = sources.emplace_back(blockSize, channels);
+		sourceBuffer.clear();
+		mixSources.emplace_back(sourceBuffer, TestType(0.5));
+	}
+	abl::AudioBuffer<TestType> destinationBuffer{blockSize, channels};
+	destinationBuffer.clear();
+
+	BENCHMARK("addFrom of " + std::to_string(sourcesCount) + " sources") {
+		destinationBuffer.clear();
+		for(auto& source : sources) {
+			destinationBuffer.addFrom(source, {}, TestType(0.5));
+		}
+		return destinationBuffer.getSample(0, 0);
+	};
+
+	BENCHMARK("mixFrom of " + std::to_string(sourcesCount) + " sources") {
+		destinationBuffer.clear();
+		destinationBuffer.mixFrom(mixSources);
+		return destinationBuffer.getSample(0, 0);
+	};
+}
+
+TEMPLATE_TEST_CASE("[ParallelExecutionPolicy] Benchmark parallel vs serial operations on many channels", "[ParallelExecutionPolicy]", float, double) {
+	const size_t channels = 64;
+	const size_t bufferSize = 48000;
+
+	abl::WorkStealingThreadPool threadPool;
+	abl::ParallelExecutionPolicy policy{threadPool};
+	abl::AudioBuffer<TestType> sourceBuffer{bufferSize, channels};
+	abl::AudioBuffer<TestType> destinationBuffer{bufferSize, channels};
+	sourceBuffer.clear();
+	destinationBuffer.clear();
+
+	BENCHMARK("Serial addFrom of " + std::to_string(channels) + " channels") {
+		destinationBuffer.addFrom(sourceBuffer, {}, TestType(0.5));
+		return destinationBuffer.getSample(0, 0);
+	};
+
+	BENCHMARK("Parallel addFrom of " + std::to_string(channels) + " channels with " + std::to_string(threadPool.getConcurrency()) + " threads") {
+		destinationBuffer.addFrom(policy, sourceBuffer, {}, TestType(0.5));
+		return destinationBuffer.getSample(0, 0);
+	};
+
+	BENCHMARK("Serial getHigherPeak of " + std::to_string(channels) + " channels") {
+		return destinationBuffer.getHigherPeak();
+	};
+
+	BENCHMARK("Parallel getHigherPeak of " + std::to_string(channels) + " channels") {
+		return destinationBuffer.getHigherPeak(policy);
+	};
+
+	//A 128 samples block of an audio callback stays under the threshold and runs inline
+	BENCHMARK("Parallel applyGain of a 128 samples block") {
+		destinationBuffer.applyGain(policy, TestType(0.5), abl::SamplesRange(0, 128));
+		return destinationBuffer.getSample(0, 0);
+	};
+}
+
+TEST_CASE("[AudioJobSystem] Benchmark graph of channels groups jobs vs serial", "[AudioJobSystem]") {
+	const size_t channels = 128;
+	const size_t channelsPerJob = 8;
+	const size_t blockSize = 512;
+
+	abl::AudioBuffer<float> buffer{blockSize, channels};
+	buffer.clear();
+	std::vector<abl::AudioBufferView<float>> channelsGroups;
+	channelsGroups.reserve(channels / channelsPerJob);
+	abl::AudioJobGraph graph;
+	for(size_t firstChannel = 0; firstChannel < channels; firstChannel += channelsPerJob) {
+		abl::ChannelsMapping channelsMapping;
+		channelsMapping.createSequential(firstChannel, channelsPerJob);
+		auto& channelsGroup = channelsGroups.emplace_back(buffer);
+		channelsGroup.setChannelsMapping(channelsMapping);
+		graph.addJob([&channelsGroup]() {
+			for(size_t pass = 0; pass < 16; ++pass) {
+				channelsGroup.applyGainRamp(0.5f, 1.0f);
+			}
+		}, {abl::AudioJobAccess::writing(channelsGroup)});
+	}
+	abl::AudioJobSystem jobSystem{graph.getJobsCount()};
+
+	BENCHMARK("Serial run of " + std::to_string(graph.getJobsCount()) + " jobs") {
+		graph.runSerially();
+		return buffer.getSample(0, 0);
+	};
+
+	BENCHMARK("AudioJobSystem run of " + std::to_string(graph.getJobsCount()) + " jobs with " + std::to_string(jobSystem.getConcurrency()) + " threads") {
+		jobSystem.run(graph);
+		return buffer.getSample(0, 0);
+	};
+}
+
+TEST_CASE("[AudioLevelMeter] Benchmark incremental metering vs rescanning the buffer", "[AudioLevelMeter]") {
+	const size_t channels = 64;
+	const size_t blockSize = 512;
+	const size_t meteredSamples = 8192;
+
+	abl::AudioBuffer<float> buffer{meteredSamples, channels};
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < meteredSamples; ++index) {
+			buffer.setSample(channel, index, float(index % 100) / 100.0f);
+		}
+	}
+	abl::AudioLevelMeter<float> meter{channels, {.rmsWindowSize = meteredSamples}};
+
+	BENCHMARK("Rescan of " + std::to_string(meteredSamples) + " samples of " + std::to_string(channels) + " channels") {
+		float levels = 0;
+		for(size_t channel = 0; channel < channels; ++channel) {
+			levels += buffer.getHigherPeakForChannel(channel) + buffer.getRMSLevelForChannel(channel);
+		}
+		return levels;
+	};
+
+	BENCHMARK("AudioLevelMeter process of a " + std::to_string(blockSize) + " samples block of " + std::to_string(channels) + " channels") {
+		meter.process(buffer, abl::SamplesRange(0, blockSize));
+		return meter.getProcessedSamplesCount();
+	};
+
+	BENCHMARK("AudioLevelMeter read of " + std::to_string(channels) + " channels") {
+		float levels = 0;
+		for(size_t channel = 0; channel < channels; ++channel) {
+			auto channelLevels = meter.getLevels(channel);
+			levels += channelLevels.heldPeak + channelLevels.rms;
+		}
+		return levels;
+	};
+}
+
+TEMPLATE_TEST_CASE("[AudioStatistics] Benchmark single pass statistics vs max_element and accumulate", "[AudioStatistics]", float, int16_t) {
+	const size_t bufferSize = 65536;
+	std::vector<TestType> samples(bufferSize);
+	for(size_t index = 0; index < bufferSize; ++index) {
+		samples[index] = static_cast<TestType>(std::is_integral_v<TestType> ? int(index % 2000) - 1000 : float(int(index % 2000) - 1000) / 1000.0f);
+	}
+	abl::AudioBufferChannelView<TestType> channelView{samples.data(), bufferSize};
+
+	BENCHMARK("max_element and accumulate of " + std::to_string(bufferSize) + " samples") {
+		auto peak = *std::max_element(samples.begin(), samples.end(), [](TestType a, TestType b) { return std::abs(a) < std::abs(b); });
+		auto squaresSum = std::accumulate(samples.begin(), samples.end(), 0.0, [](double sum, TestType sample) { return sum + double(sample) * double(sample); });
+		return double(peak) + std::sqrt(squaresSum / bufferSize);
+	};
+
+	BENCHMARK("getStatistics of " + std::to_string(bufferSize) + " samples") {
+		auto statistics = channelView.getStatistics();
+		return double(statistics.peak) + double(statistics.rms);
+	};
+}
+
+TEST_CASE("[WaveformOverview] Benchmark overview columns vs scanning every column", "[WaveformOverview]") {
+	const size_t bufferSize = 1 << 22;
+	const size_t columnsCount = 1000;
+	abl::AudioBuffer<float> buffer{bufferSize, 1};
+	for(size_t index = 0; index < bufferSize; ++index) {
+		buffer.setSample(0, index, float(index % 1000) / 1000.0f - 0.5f);
+	}
+	abl::WaveformOverview<float> overview{buffer};
+	std::vector<abl::WaveformSummary<float>> columns(columnsCount);
+
+	BENCHMARK("getHigherPeak of " + std::to_string(columnsCount) + " columns of " + std::to_string(bufferSize) + " samples") {
+		float peaks = 0;
+		for(size_t column = 0; column < columnsCount; ++column) {
+			auto startSample = column * bufferSize / columnsCount;
+			peaks += buffer.getHigherPeakForChannel(0, abl::SamplesRange(startSample, (column + 1) * bufferSize / columnsCount - startSample));
+		}
+		return peaks;
+	};
+
+	BENCHMARK("WaveformOverview " + std::to_string(columnsCount) + " columns of " + std::to_string(bufferSize) + " samples") {
+		overview.getColumns(0, columns);
+		return columns[0].max;
+	};
+
+	BENCHMARK("WaveformOverview update of a 512 samples block") {
+		overview.update(abl::SamplesRange(bufferSize / 2, 512));
+		return overview.getBlockSize();
+	};
+}
+
+TEST_CASE("[DelayedCircularAudioBuffer] Benchmark interpolated delay reads vs per sample reads", "[DelayedCircularAudioBuffer]") {
+	const size_t blockSize = 512;
+	abl::DelayedCircularAudioBuffer<float> delayBuffer{48000, blockSize, 1000, 1};
+	abl::AudioBuffer<float> block{blockSize, 1};
+	for(size_t index = 0; index < blockSize; ++index) {
+		block.setSample(0, index, float(index % 100) / 100.0f);
+	}
+	for(size_t blockStart = 0; blockStart < 48000; blockStart += blockSize) {
+		delayBuffer.copyFrom(block);
+		delayBuffer.incrementIndex();
+	}
+	std::vector<double> delays(blockSize);
+	for(size_t index = 0; index < blockSize; ++index) {
+		delays[index] = 1000.0 + 300.0 * std::sin(double(index) / 80);
+	}
+	std::vector<float> result(blockSize);
+	auto memoryView = delayBuffer.getContiguousView(0, 48000);
+	auto writeStart = long((delayBuffer.getIndex() + 1000) % 48000);
+
+	BENCHMARK("Per sample Hermite reads of a " + std::to_string(blockSize) + " samples block") {
+		for(size_t index = 0; index < blockSize; ++index) {
+			auto position = double(index) - delays[index];
+			auto integerPosition = static_cast<long>(std::floor(position));
+			auto fraction = float(position - double(integerPosition));
+			auto sampleAt = [&](long offset) { return memoryView.getSample(0, size_t((writeStart + integerPosition + offset + 48000) % 48000)); };
+			auto previous = sampleAt(-1), first = sampleAt(0), second = sampleAt(1), next = sampleAt(2);
+			auto c1 = 0.5f * (second - previous);
+			auto c2 = previous - 2.5f * first + 2.0f * second - 0.5f * next;
+			auto c3 = 0.5f * (next - previous) + 1.5f * (first - second);
+			result[index] = ((c3 * fraction + c2) * fraction + c1) * fraction + first;
+		}
+		return result[0];
+	};
+
+	for(auto [interpolation, name] : {std::pair{abl::InterpolationType::Linear, "linear"}, {abl::InterpolationType::Hermite, "Hermite"}, {abl::InterpolationType::Lagrange, "Lagrange"}, {abl::InterpolationType::WindowedSinc, "windowed sinc"}}) {
+		BENCHMARK("readInterpolated " + std::string(name) + " of a " + std::to_string(blockSize) + " samples block") {
+			delayBuffer.readInterpolated(0, result.data(), delays, interpolation);
+			return result[0];
+		};
+	}
+}
+
+TEST_CASE("[DelayedCircularAudioBuffer] Benchmark crossfaded delay change vs crossfade through block copies", "[DelayedCircularAudioBuffer]") {
+	const size_t blockSize = 512;
+	const size_t channels = 2;
+	abl::DelayedCircularAudioBuffer<float> delayBuffer{48000, blockSize, 1000, channels};
+	abl::AudioBuffer<float> oldDelayBlock{blockSize, channels};
+	abl::AudioBuffer<float> newDelayBlock{blockSize, channels};
+	abl::AudioBuffer<float> result{blockSize, channels};
+	delayBuffer.setDelayInSamples(3000, 48000);
+
+	BENCHMARK("Crossfade of two block copies of " + std::to_string(channels) + " channels") {
+		oldDelayBlock.copyFrom(delayBuffer);
+		newDelayBlock.copyFrom(delayBuffer);
+		result.copyWithRampFrom(newDelayBlock, 0.25f, 0.26f);
+		result.addWithRampFrom(oldDelayBlock, 0.75f, 0.74f);
+		return result.getSample(0, 0);
+	};
+
+	BENCHMARK("readCrossfaded of " + std::to_string(channels) + " channels") {
+		delayBuffer.readCrossfaded(result);
+		return result.getSample(0, 0);
+	};
+}
+
+TEST_CASE("[DelayedCircularAudioBuffer] Benchmark multi-tap read vs a pass for every tap", "[DelayedCircularAudioBuffer]") {
+	const size_t blockSize = 512;
+	const size_t tapsCount = 32;
+	abl::DelayedCircularAudioBuffer<float> delayBuffer{48000, blockSize, 1000, 1};
+	abl::AudioBuffer<float> result{blockSize, 1};
+	std::vector<abl::DelayTap<float>> taps;
+	for(size_t tap = 0; tap < tapsCount; ++tap) {
+		taps.emplace_back(100 + tap * 1013, 1.0f / float(tap + 1));
+	}
+	auto memoryView = delayBuffer.getContiguousView(0, 48000);
+	auto writeStart = (delayBuffer.getIndex() + 1000) % 48000;
+
+	BENCHMARK("Pass for every one of " + std::to_string(tapsCount) + " taps") {
+		for(const auto& tap : taps) {
+			auto tapStart = (writeStart + 48000 - tap.delayInSamples) % 48000;
+			for(size_t index = 0; index < blockSize; ++index) {
+				result.addSample(0, index, memoryView.getSample(0, (tapStart + index) % 48000) * tap.startGain);
+			}
+		}
+		return result.getSample(0, 0);
+	};
+
+	BENCHMARK("addTapsTo of " + std::to_string(tapsCount) + " taps") {
+		delayBuffer.addTapsTo(result, taps);
+		return result.getSample(0, 0);
+	};
+}
+
+TEST_CASE("[FramingAudioProcessor] Benchmark overlap-add framing vs indexed loops over the rings", "[FramingAudioProcessor]") {
+	const size_t frameSize = 1024;
+	const size_t hopSize = 256;
+	const size_t channels = 2;
+	const size_t ringSize = 4096;
+	abl::AudioBuffer<float> input{hopSize, channels};
+	abl::AudioBuffer<float> output{hopSize, channels};
+	abl::AudioBuffer<float> frame{frameSize, channels};
+	std::vector<float> inputRing(ringSize * channels, 0.25f);
+	std::vector<float> outputRing(ringSize * channels, 0.0f);
+	auto window = abl::FramingAudioProcessor<float>::getPeriodicSquareRootHannWindow(frameSize);
+	abl::FramingAudioProcessor<float> processor{channels, frameSize, hopSize, hopSize, [](abl::AudioBufferView<float>&) {}};
+	size_t frameStart = 0;
+
+	BENCHMARK("Indexed loops for a hop of " + std::to_string(channels) + " channels") {
+		for(size_t channel = 0; channel < channels; ++channel) {
+			for(size_t index = 0; index < frameSize; ++index) {
+				frame.setSample(channel, index, inputRing[channel * ringSize + (frameStart + index) % ringSize] * float(window[index]));
+			}
+			for(size_t index = 0; index < frameSize; ++index) {
+				outputRing[channel * ringSize + (frameStart + index) % ringSize] += frame.getSample(channel, index) * float(window[index]);
+			}
+		}
+		frameStart = (frameStart + hopSize) % ringSize;
+		return outputRing[frameStart];
+	};
+
+	BENCHMARK("FramingAudioProcessor push and pull of a hop of " + std::to_string(channels) + " channels") {
+		processor.push(input);
+		processor.pull(output);
+		return output.getSample(0, 0);
+	};
+}
+
 #endif //AUDIOBUFFERS_BENCHMARKS_H
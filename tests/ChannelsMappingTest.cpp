@@ -0,0 +1,144 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../datatypes/ChannelsMapping.h"
+#include "../buffers/AudioBufferView.h"
+#include "../buffers/CircularAudioBufferView.h"
+#include "../buffers/DelayedCircularAudioBufferView.h"
+#include <type_traits>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+//Copying the mapping (and so the views) never allocate
+static_assert(std::is_nothrow_copy_constructible_v<abl::ChannelsMapping>);
+static_assert(std::is_nothrow_move_constructible_v<abl::ChannelsMapping>);
+
+TEST_CASE("[ChannelsMapping] Mapping can be created and changed", "[ChannelsMapping]") {
+	abl::ChannelsMapping emptyMapping;
+	REQUIRE(emptyMapping.empty());
+	REQUIRE(emptyMapping.size() == 0);
+	REQUIRE(emptyMapping.begin() == emptyMapping.end());
+
+	std::vector<size_t> channels{3, 1, 2, 0, 1};
+	abl::ChannelsMapping vectorMapping = channels;
+	REQUIRE(vectorMapping.size() == 5);
+	REQUIRE(vectorMapping.toVector() == channels);
+	REQUIRE(vectorMapping == abl::ChannelsMapping{3, 1, 2, 0, 1});
+	REQUIRE_FALSE(vectorMapping == abl::ChannelsMapping{3, 1, 2});
+
+	size_t index = 0;
+	for(auto channel : vectorMapping) {
+		REQUIRE(channel == channels[index++]);
+	}
+
+	vectorMapping.resize(7);
+	REQUIRE(vectorMapping[4] == 1);
+	REQUIRE(vectorMapping[6] == 0);
+	vectorMapping.setChannel(6, 9);
+	REQUIRE(vectorMapping[6] == 9);
+
+	vectorMapping.createSequential(2, 3);
+	REQUIRE(vectorMapping == abl::ChannelsMapping{2, 3, 4});
+
+	abl::ChannelsMapping fullMapping;
+	fullMapping.createSequential(0, abl::ChannelsMapping::inlineMappedChannels);
+	REQUIRE(fullMapping.isInline());
+	REQUIRE(fullMapping.size() == abl::ChannelsMapping::inlineMappedChannels);
+	REQUIRE(fullMapping[abl::ChannelsMapping::inlineMappedChannels - 1] == abl::ChannelsMapping::inlineMappedChannels - 1);
+}
+
+TEST_CASE("[ChannelsMapping] Mapping bigger than the inline storage", "[ChannelsMapping]") {
+	const size_t channelsCount = 200;
+	std::vector<size_t> channels(channelsCount);
+	for(size_t index = 0; index < channelsCount; ++index) {
+		channels[index] = channelsCount - 1 - index;
+	}
+
+	abl::ChannelsMapping vectorMapping = channels;
+	REQUIRE_FALSE(vectorMapping.isInline());
+	REQUIRE(vectorMapping.size() == channelsCount);
+	REQUIRE(vectorMapping.toVector() == channels);
+
+	auto copiedMapping = vectorMapping;
+	copiedMapping.setChannel(150, 7);
+	REQUIRE(copiedMapping[150] == 7);
+	REQUIRE(vectorMapping[150] == channels[150]);
+
+	abl::ChannelsMapping growingMapping{1, 2, 3};
+	growingMapping.resize(100);
+	REQUIRE_FALSE(growingMapping.isInline());
+	REQUIRE(growingMapping[2] == 3);
+	REQUIRE(growingMapping[99] == 0);
+	growingMapping.setChannel(99, 99);
+	REQUIRE(growingMapping[99] == 99);
+
+	abl::ChannelsMapping sequentialMapping;
+	sequentialMapping.createSequential(10, 128);
+	REQUIRE(sequentialMapping.size() == 128);
+	REQUIRE(sequentialMapping[127] == 137);
+
+	auto movedMapping = std::move(sequentialMapping);
+	REQUIRE(movedMapping.size() == 128);
+	REQUIRE(sequentialMapping.empty());
+}
+
+TEST_CASE("[ChannelsMapping] Channels indexes bigger than 16 bits", "[ChannelsMapping]") {
+	const size_t bigChannel = size_t(UINT16_MAX) + 10;
+
+	abl::ChannelsMapping listMapping{0, bigChannel, 2};
+	REQUIRE_FALSE(listMapping.isInline());
+	REQUIRE(listMapping[1] == bigChannel);
+
+	abl::ChannelsMapping changedMapping{0, 1, 2};
+	REQUIRE(changedMapping.isInline());
+	changedMapping.setChannel(2, bigChannel);
+	REQUIRE(changedMapping[0] == 0);
+	REQUIRE(changedMapping[1] == 1);
+	REQUIRE(changedMapping[2] == bigChannel);
+	REQUIRE(changedMapping == abl::ChannelsMapping{0, 1, bigChannel});
+}
+
+TEST_CASE("[ChannelsMapping] Views with more channels than the inline storage", "[ChannelsMapping]") {
+	const size_t channels = 96;
+	const size_t bufferSize = 8;
+	float samples[channels][bufferSize]{};
+	float* data[channels];
+	for(size_t channel = 0; channel < channels; ++channel) {
+		data[channel] = samples[channel];
+		samples[channel][0] = float(channel);
+	}
+
+	abl::AudioBufferView<float> audioBufferView{data, channels, bufferSize};
+	audioBufferView.createSequentialChannelsMapping(16, 80);
+	auto rangedView = audioBufferView.getRangedView({0, 4});
+	REQUIRE(rangedView.getChannelsCount() == 80);
+	REQUIRE(rangedView.getSample(0, 0) == 16.f);
+	REQUIRE(rangedView.getSample(79, 0) == 95.f);
+}
+
+TEMPLATE_TEST_CASE("[ChannelsMapping] Ranged views keep the mapping", "[ChannelsMapping]", int, double) {
+	const size_t channels = 4;
+	const size_t bufferSize = 16;
+	TestType samples[channels][bufferSize]{};
+	TestType* data[channels];
+	for(size_t channel = 0; channel < channels; ++channel) {
+		data[channel] = samples[channel];
+		samples[channel][3] = TestType(channel + 1);
+	}
+
+	abl::AudioBufferView<TestType> audioBufferView{data, channels, bufferSize, {3, 0}};
+	auto rangedView = audioBufferView.getRangedView({2, 4});
+	REQUIRE(rangedView.getChannelsMapping() == abl::ChannelsMapping{3, 0});
+	REQUIRE(rangedView.getChannelsCount() == 2);
+	REQUIRE(rangedView.getSample(0, 1) == TestType(4));
+	REQUIRE(rangedView.getSample(1, 1) == TestType(1));
+
+	abl::CircularAudioBufferView<TestType> circularView{data, channels, bufferSize, 4, 0, {2}};
+	auto circularRangedView = circularView.getRangedView({1, 2});
+	REQUIRE(circularRangedView.getChannelsMapping() == abl::ChannelsMapping{2});
+	REQUIRE(circularRangedView.getChannelsCount() == 1);
+
+	abl::DelayedCircularAudioBufferView<TestType> delayedView{data, channels, bufferSize, 4, 4, 0, {1, 2}};
+	auto delayedRangedView = delayedView.getRangedView({1, 2});
+	REQUIRE(delayedRangedView.getChannelsMapping() == abl::ChannelsMapping{1, 2});
+}
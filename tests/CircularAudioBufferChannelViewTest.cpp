@@ -2,6 +2,7 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/CircularAudioBufferChannelView.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -387,9 +388,45 @@ TEMPLATE_TEST_CASE("[CircularAudioBufferChannelView] View report correct rms lev
 	const size_t startOffset = 28;
 	auto wrapper = CircularAudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize, singleBufferSize, startOffset);
 
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(16.5));
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 4)) == TestType(9.5));
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(4, 2)) == TestType(1.5));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(std::sqrt(3756.0 / 8)));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 4)) == TestType(std::sqrt(1038.0 / 4)));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(4, 2)) == TestType(std::sqrt((1.0 * 1.0 + 2.0 * 2.0) / 2)));
+}
+
+TEMPLATE_TEST_CASE("[CircularAudioBufferChannelView] Ranges are split in two contiguous spans at the end of the container buffer", "[CircularAudioBufferChannelView]", int, double) {
+	const size_t bufferSize = 32;
+	const size_t singleBufferSize = 8;
+	const size_t startOffset = 28;
+	auto wrapper = CircularAudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize, singleBufferSize, startOffset);
+
+	auto spans = wrapper.audioBufferChannelView.getReadSpans(abl::SamplesRange::allSamples());
+	REQUIRE(spans.isSplit());
+	REQUIRE(spans.first.data() == wrapper.data + startOffset);
+	REQUIRE(spans.first.size() == 4);
+	REQUIRE(spans.second.data() == wrapper.data);
+	REQUIRE(spans.second.size() == 4);
+
+	auto rangeSpans = wrapper.audioBufferChannelView.getWriteSpans(abl::SamplesRange(4, 3));
+	REQUIRE_FALSE(rangeSpans.isSplit());
+	REQUIRE(rangeSpans.first.data() == wrapper.data);
+	REQUIRE(rangeSpans.size() == 3);
+}
+
+TEMPLATE_TEST_CASE("[CircularAudioBufferChannelView] Buffer data is reversed with reverse() for every offset and range", "[CircularAudioBufferChannelView]", int, double) {
+	const size_t bufferSize = 16;
+	const size_t singleBufferSize = 7;
+	for (size_t startOffset = 0; startOffset < bufferSize; ++startOffset) {
+		for (size_t rangeCount = 1; rangeCount <= singleBufferSize; ++rangeCount) {
+			auto wrapper = CircularAudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize, singleBufferSize, startOffset);
+			auto reference = CircularAudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize, singleBufferSize, startOffset);
+			wrapper.audioBufferChannelView.reverse(abl::SamplesRange(0, rangeCount));
+
+			for (size_t i = 0; i < singleBufferSize; ++i) {
+				auto expectedIndex = i < rangeCount ? rangeCount - 1 - i : i;
+				REQUIRE(wrapper.audioBufferChannelView[i] == reference.audioBufferChannelView[expectedIndex]);
+			}
+		}
+	}
 }
 
 TEMPLATE_TEST_CASE("[CircularAudioBufferChannelView] View report correct buffer size", "[CircularAudioBufferChannelView]", int, double) {
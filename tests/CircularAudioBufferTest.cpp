@@ -2,6 +2,8 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/AudioBuffer.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -1240,10 +1242,10 @@ TEMPLATE_TEST_CASE("[CircularAudioBuffer] View report correct rms level for chan
 	const size_t startOffset = 28;
 	auto wrapper = CircularAudioBufferWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, singleBufferSize, startOffset);
 
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(16.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(48.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(9.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(33.5)); //33 + 34 / 2
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(std::sqrt(3756.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(std::sqrt(20396.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(std::sqrt(1038.0 / 4)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(std::sqrt((33.0 * 33.0 + 34.0 * 34.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[CircularAudioBuffer] View report correct buffer size and channel count", "[CircularAudioBuffer]", int, double) {
@@ -1305,4 +1307,31 @@ TEMPLATE_TEST_CASE("[CircularAudioBuffer] Channels are mapped correctly", "[Circ
 }
 
 
-//test channel out-of-bound assert?
\ No newline at end of file
+//test channel out-of-bound assert?
+
+TEMPLATE_TEST_CASE("[CircularAudioBuffer] mixFrom wrap around the end of the buffer", "[CircularAudioBuffer]", int, double) {
+	const size_t channels = 2;
+	const size_t bufferSize = 32;
+	const size_t singleBufferSize = 8;
+	const size_t startOffset = 28;
+	auto resultWrapper = CircularAudioBufferWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, singleBufferSize, startOffset);
+	auto expectedWrapper = CircularAudioBufferWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, singleBufferSize, startOffset);
+
+	abl::AudioBuffer<TestType> firstSource{singleBufferSize, channels};
+	abl::AudioBuffer<TestType> secondSource{singleBufferSize, channels};
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < singleBufferSize; ++index) {
+			firstSource.setSample(channel, index, TestType(100 + index * 4));
+			secondSource.setSample(channel, index, TestType(1000 * (channel + 1)));
+		}
+	}
+
+	resultWrapper.audioBuffer.mixFrom({{firstSource, 0.5}, {secondSource, 0, 1}}, abl::SamplesRange(1, 6));
+	expectedWrapper.audioBuffer.addFrom(firstSource, abl::SamplesRange(1, 6), 0.5);
+	expectedWrapper.audioBuffer.addWithRampFrom(secondSource, 0, 1, abl::SamplesRange(1, 6));
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < singleBufferSize; ++index) {
+			REQUIRE(resultWrapper.audioBuffer.getSample(channel, index) == expectedWrapper.audioBuffer.getSample(channel, index));
+		}
+	}
+}
@@ -2,6 +2,9 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/CircularAudioBufferView.h"
+#include "../buffers/AudioBufferView.h"
+#include <cmath>
+#include <thread>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -969,10 +972,10 @@ TEMPLATE_TEST_CASE("[CircularAudioBufferView] View report correct rms level for
 	const size_t startOffset = 28;
 	auto wrapper = CircularAudioBufferViewWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, singleBufferSize, startOffset);
 
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(16.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(48.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(9.5));
-	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(33.5)); //33 + 34 / 2
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(std::sqrt(3756.0 / 8)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(std::sqrt(20396.0 / 8)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(0, abl::SamplesRange(3, 4)) == TestType(std::sqrt(1038.0 / 4)));
+	REQUIRE(wrapper.audioBufferView.getRMSLevelForChannel(1, abl::SamplesRange(4, 2)) == TestType(std::sqrt((33.0 * 33.0 + 34.0 * 34.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[CircularAudioBufferView] View report correct buffer size and channel count", "[CircularAudioBufferView]", int, double) {
@@ -1034,4 +1037,95 @@ TEMPLATE_TEST_CASE("[CircularAudioBufferView] Channels are mapped correctly", "[
 }
 
 
-//test channel out-of-bound assert?
\ No newline at end of file
+//test channel out-of-bound assert?
+
+TEMPLATE_TEST_CASE("[CircularAudioBufferView] Available samples are reported and blocks are written and read with tryWrite() and tryRead()", "[CircularAudioBufferView]", int, double) {
+	const size_t channels = 2;
+	const size_t bufferSize = 32;
+	const size_t singleBufferSize = 8;
+	auto wrapper = CircularAudioBufferViewWrapper<TestType>::createWithFixedValue(channels, bufferSize, singleBufferSize, 0, 0);
+	auto blockWrapper = CircularAudioBufferViewWrapper<TestType>::createWithIncrementalNumbers(channels, singleBufferSize, singleBufferSize, 0);
+	std::vector<TestType> readData(channels * singleBufferSize, 0);
+	TestType* readChannels[] = {readData.data(), readData.data() + singleBufferSize};
+	abl::AudioBufferView<TestType> readBlock{readChannels, channels, singleBufferSize};
+
+	REQUIRE(wrapper.audioBufferView.availableToRead() == 0);
+	REQUIRE(wrapper.audioBufferView.availableToWrite() == bufferSize);
+	REQUIRE_FALSE(wrapper.audioBufferView.tryRead(readBlock));
+
+	for (size_t block = 0; block < bufferSize / singleBufferSize; ++block) {
+		REQUIRE(wrapper.audioBufferView.tryWrite(blockWrapper.audioBufferView));
+	}
+	REQUIRE(wrapper.audioBufferView.availableToRead() == bufferSize);
+	REQUIRE(wrapper.audioBufferView.availableToWrite() == 0);
+	REQUIRE_FALSE(wrapper.audioBufferView.tryWrite(blockWrapper.audioBufferView, 1));
+
+	REQUIRE(wrapper.audioBufferView.tryRead(readBlock, 5));
+	REQUIRE(wrapper.audioBufferView.availableToRead() == bufferSize - 5);
+	REQUIRE(wrapper.audioBufferView.availableToWrite() == 5);
+	for (size_t channel = 0; channel < channels; ++channel) {
+		for (size_t i = 0; i < 5; ++i) {
+			REQUIRE(readBlock.getSample(channel, i) == i + 1 + channel * singleBufferSize);
+		}
+	}
+
+	REQUIRE(wrapper.audioBufferView.tryRead(readBlock));
+	for (size_t channel = 0; channel < channels; ++channel) {
+		for (size_t i = 0; i < singleBufferSize; ++i) {
+			REQUIRE(readBlock.getSample(channel, i) == (i + 5) % singleBufferSize + 1 + channel * singleBufferSize);
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[CircularAudioBufferView] Single producer and single consumer threads transfer all the samples in order", "[CircularAudioBufferView]", int, double) {
+	const size_t channels = 2;
+	const size_t bufferSize = 64;
+	const size_t singleBufferSize = 16;
+	const size_t samplesCount = 200000;
+	auto wrapper = CircularAudioBufferViewWrapper<TestType>::createWithFixedValue(channels, bufferSize, singleBufferSize, 0, 0);
+	auto& ringBuffer = wrapper.audioBufferView;
+
+	std::thread producer([&ringBuffer, samplesCount]() {
+		std::vector<TestType> blockData(channels * singleBufferSize);
+		TestType* blockChannels[] = {blockData.data(), blockData.data() + singleBufferSize};
+		abl::AudioBufferView<TestType> block{blockChannels, channels, singleBufferSize};
+		size_t writtenSamples = 0;
+		size_t blockIndex = 0;
+		while (writtenSamples < samplesCount) {
+			auto blockSize = std::min(1 + (blockIndex++ % singleBufferSize), samplesCount - writtenSamples);
+			for (size_t i = 0; i < blockSize; ++i) {
+				blockChannels[0][i] = TestType((writtenSamples + i) % 100000);
+				blockChannels[1][i] = -TestType((writtenSamples + i) % 100000);
+			}
+			while (!ringBuffer.tryWrite(block, blockSize)) {
+				std::this_thread::yield();
+			}
+			writtenSamples += blockSize;
+		}
+	});
+
+	std::vector<TestType> blockData(channels * singleBufferSize);
+	TestType* blockChannels[] = {blockData.data(), blockData.data() + singleBufferSize};
+	abl::AudioBufferView<TestType> block{blockChannels, channels, singleBufferSize};
+	size_t readSamples = 0;
+	size_t blockIndex = 0;
+	size_t wrongSamples = 0;
+	while (readSamples < samplesCount) {
+		auto blockSize = std::min(1 + (blockIndex * 7 % singleBufferSize), samplesCount - readSamples);
+		if (!ringBuffer.tryRead(block, blockSize)) {
+			std::this_thread::yield();
+			continue;
+		}
+		for (size_t i = 0; i < blockSize; ++i) {
+			auto expectedSample = TestType((readSamples + i) % 100000);
+			wrongSamples += blockChannels[0][i] != expectedSample || blockChannels[1][i] != -expectedSample;
+		}
+		readSamples += blockSize;
+		++blockIndex;
+	}
+	producer.join();
+
+	REQUIRE(wrongSamples == 0);
+	REQUIRE(ringBuffer.availableToRead() == 0);
+	REQUIRE(ringBuffer.getReadIndex() == samplesCount);
+}
@@ -0,0 +1,101 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../memory/2DArrayAllocator.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/DelayedCircularAudioBuffer.h"
+#include <cstdint>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template<typename T>
+bool isAligned(const T* pointer, size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+TEMPLATE_TEST_CASE("[Contiguous2DArrayAllocator] Aligned allocator align and pad the rows", "[Contiguous2DArrayAllocator]", int, double) {
+	using Allocator = abl::AlignedContiguous2DArrayAllocator<>;
+
+	//Rows rounded up to 64 bytes
+	REQUIRE(Allocator::getRowStride<TestType>(1) == 64 / sizeof(TestType));
+	REQUIRE(Allocator::getRowStride<TestType>(100) * sizeof(TestType) == ((100 * sizeof(TestType) + 63) / 64) * 64);
+	//Rows multiple of 4KB get an extra cache line
+	REQUIRE(Allocator::getRowStride<TestType>(4096 / sizeof(TestType)) * sizeof(TestType) == 4096 + 64);
+	REQUIRE(Allocator::getRowStride<TestType>(8192 / sizeof(TestType)) * sizeof(TestType) == 8192 + 64);
+	REQUIRE(abl::AlignedContiguous2DArrayAllocator<64, false>::getRowStride<TestType>(4096 / sizeof(TestType)) * sizeof(TestType) == 4096);
+	REQUIRE(abl::NewContiguous2DArrayAllocator::getRowStride<TestType>(100) == 100);
+
+	const size_t rows = 3;
+	const size_t rowSize = 1024;
+	auto array = Allocator::allocate<TestType>(rows, rowSize);
+	REQUIRE(array != nullptr);
+	for(size_t row = 0; row < rows; ++row) {
+		REQUIRE(isAligned(array[row], 64));
+		REQUIRE(array[row] == array[0] + row * Allocator::getRowStride<TestType>(rowSize));
+		for(size_t index = 0; index < rowSize; ++index) {
+			REQUIRE(array[row][index] == TestType(0));
+		}
+	}
+	Allocator::deallocate(array);
+
+	REQUIRE(Allocator::allocate<TestType>(0, rowSize) == nullptr);
+	auto emptyRowsArray = Allocator::allocate<TestType>(2, 0);
+	REQUIRE(emptyRowsArray[0] == nullptr);
+	REQUIRE(emptyRowsArray[1] == nullptr);
+	delete[] emptyRowsArray;
+}
+
+TEMPLATE_TEST_CASE("[Contiguous2DArrayAllocator] Huge pages allocator align the big buffers to the huge page size", "[Contiguous2DArrayAllocator]", int, double) {
+	using Allocator = abl::HugePagesContiguous2DArrayAllocator<64 * 1024>;
+
+	auto smallArray = Allocator::allocate<TestType>(2, 16);
+	REQUIRE(isAligned(smallArray[0], 64));
+	REQUIRE(isAligned(smallArray[1], 64));
+	Allocator::deallocate(smallArray);
+
+	auto bigArray = Allocator::allocate<TestType>(2, 64 * 1024);
+	REQUIRE(isAligned(bigArray[0], Allocator::hugePageSize));
+	REQUIRE(isAligned(bigArray[1], 64));
+	bigArray[1][64 * 1024 - 1] = TestType(5);
+	REQUIRE(bigArray[1][64 * 1024 - 1] == TestType(5));
+	Allocator::deallocate(bigArray);
+}
+
+TEMPLATE_TEST_CASE("[Contiguous2DArrayAllocator] Buffers can use a custom allocator", "[Contiguous2DArrayAllocator]", int, double) {
+	abl::AudioBuffer<TestType> defaultAudioBuffer{1024, 2};
+	REQUIRE(isAligned(defaultAudioBuffer.getChannelRawData(0), 64));
+	REQUIRE(isAligned(defaultAudioBuffer.getChannelRawData(1), 64));
+	REQUIRE(defaultAudioBuffer.getChannelRawData(1) - defaultAudioBuffer.getChannelRawData(0) > 1024);
+
+	abl::AudioBuffer<TestType, abl::NewContiguous2DArrayAllocator> newAudioBuffer{1024, 2};
+	REQUIRE(newAudioBuffer.getChannelRawData(1) - newAudioBuffer.getChannelRawData(0) == 1024);
+
+	abl::AudioBuffer<TestType, abl::HugePagesContiguous2DArrayAllocator<1024>> hugePagesAudioBuffer{1024, 2};
+	REQUIRE(isAligned(hugePagesAudioBuffer.getChannelRawData(0), abl::HugePagesContiguous2DArrayAllocator<1024>::hugePageSize));
+	for(size_t channel = 0; channel < 2; ++channel) {
+		for(size_t index = 0; index < 1024; ++index) {
+			hugePagesAudioBuffer.setSample(channel, index, TestType(channel * 1024 + index));
+		}
+	}
+
+	//Resizing keep the content and the alignment, also reusing the allocated memory
+	hugePagesAudioBuffer.resize(2, 2048, true);
+	REQUIRE(isAligned(hugePagesAudioBuffer.getChannelRawData(1), 64));
+	REQUIRE(hugePagesAudioBuffer.getSample(1, 1023) == TestType(2047));
+	REQUIRE(hugePagesAudioBuffer.getSample(1, 2047) == TestType(0));
+	hugePagesAudioBuffer.resize(1, 100, false, true, true);
+	REQUIRE(hugePagesAudioBuffer.getChannelsCount() == 1);
+	REQUIRE(hugePagesAudioBuffer.getBufferSize() == 100);
+	REQUIRE(hugePagesAudioBuffer.getSample(0, 99) == TestType(0));
+
+	abl::CircularAudioBuffer<TestType, abl::NewContiguous2DArrayAllocator> circularAudioBuffer{32, 8, 2};
+	circularAudioBuffer.setSample(1, 7, TestType(3));
+	REQUIRE(circularAudioBuffer.getSample(1, 7) == TestType(3));
+
+	abl::DelayedCircularAudioBuffer<TestType, abl::AlignedContiguous2DArrayAllocator<128>> delayedAudioBuffer{32, 8, 8, 2};
+	REQUIRE(isAligned(delayedAudioBuffer.getContiguousView(0, 8).getChannelRawData(1), 128));
+	delayedAudioBuffer.resize(3, 64);
+	REQUIRE(delayedAudioBuffer.getChannelsCount() == 3);
+	REQUIRE(isAligned(delayedAudioBuffer.getContiguousView(0, 8).getChannelRawData(2), 128));
+}
@@ -2,6 +2,10 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/DelayedCircularAudioBuffer.h"
+#include "../buffers/AudioBuffer.h"
+#include <cmath>
+#include <numbers>
+#include <optional>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -1306,10 +1310,10 @@ TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] View report correct rms level f
 	auto wrapper = DelayedCircularAudioBufferWrapper<TestType>::createWithIncrementalNumbers(channels, bufferSize, singleBufferSize, delayInSamples, startOffset);
 	wrapper.audioBuffer.incrementIndex();
 
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(16.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(48.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3,4)) == TestType(9.5));
-	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4,2)) == TestType(33.5)); //33 + 34 / 2
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange::allSamples()) == TestType(std::sqrt(3756.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange::allSamples()) == TestType(std::sqrt(20396.0 / 8)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(0, abl::SamplesRange(3,4)) == TestType(std::sqrt(1038.0 / 4)));
+	REQUIRE(wrapper.audioBuffer.getRMSLevelForChannel(1, abl::SamplesRange(4,2)) == TestType(std::sqrt((33.0 * 33.0 + 34.0 * 34.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] View report correct buffer size and channel count", "[DelayedCircularAudioBuffer]", int, double) {
@@ -1376,4 +1380,235 @@ TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] Channels are mapped correctly",
 }
 
 
+double delayTestSignal(double time, size_t channel) {
+	return std::sin(2 * std::numbers::pi * time / 200) * (channel == 0 ? 1.0 : -0.5);
+}
+
+//Write blocks of a sine and read them back with fractional delays, for many rounds of the buffer (not a multiple of the block size, so the reads cross its end in every position)
+template<typename DelayFunction>
+void requireInterpolatedReads(abl::InterpolationType interpolation, double tolerance, DelayFunction getDelay) {
+	const size_t blockSize = 64;
+	abl::DelayedCircularAudioBuffer<double> delayBuffer{1000, blockSize, 100, 2, 30};
+	abl::AudioBuffer<double> block{blockSize, 2};
+	abl::AudioBuffer<double> delayedBlock{blockSize, 2};
+	std::vector<double> delays(blockSize);
+
+	for(size_t blockStart = 0; blockStart < 50 * blockSize; blockStart += blockSize) {
+		for(size_t index = 0; index < blockSize; ++index) {
+			for(size_t channel = 0; channel < 2; ++channel) {
+				block.setSample(channel, index, delayTestSignal(double(blockStart + index), channel));
+			}
+			delays[index] = getDelay(blockStart + index);
+		}
+		delayBuffer.copyFrom(block);
+		delayBuffer.readInterpolated(delayedBlock, delays, interpolation);
+		if(blockStart >= 1000) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				for(size_t channel = 0; channel < 2; ++channel) {
+					REQUIRE(std::abs(delayedBlock.getSample(channel, index) - delayTestSignal(double(blockStart + index) - delays[index], channel)) <= tolerance);
+				}
+			}
+		}
+		delayBuffer.incrementIndex();
+	}
+}
+
+TEST_CASE("[DelayedCircularAudioBuffer] Fractional delays are interpolated", "[DelayedCircularAudioBuffer]") {
+	for(auto [interpolation, tolerance] : {std::pair{abl::InterpolationType::Linear, 2e-4}, {abl::InterpolationType::Hermite, 1e-5}, {abl::InterpolationType::Lagrange, 1e-5}, {abl::InterpolationType::WindowedSinc, 1e-4}}) {
+		requireInterpolatedReads(interpolation, tolerance, [](size_t) { return 100.25; });
+		//Modulated delay, like a chorus
+		requireInterpolatedReads(interpolation, tolerance, [](size_t time) { return 300.0 + 200.0 * std::sin(double(time) / 500); });
+		//Delay changing faster than the blocks, every sample is interpolated on its own when the block cross the end of the buffer
+		requireInterpolatedReads(interpolation, tolerance, [](size_t time) { return 40.0 + double(time % 64) * 12.3; });
+	}
+}
+
+TEST_CASE("[DelayedCircularAudioBuffer] Integer delays read the stored samples", "[DelayedCircularAudioBuffer]") {
+	auto wrapper = DelayedCircularAudioBufferWrapper<float>::createWithIncrementalNumbers(2, 64, 16, 20, 5);
+	auto& delayBuffer = wrapper.audioBuffer;
+	delayBuffer.incrementIndex(50);
+	std::vector<float> result(16);
+	for(auto interpolation : {abl::InterpolationType::Linear, abl::InterpolationType::Hermite, abl::InterpolationType::Lagrange, abl::InterpolationType::WindowedSinc}) {
+		delayBuffer.readInterpolated(1, result.data(), result.size(), 20, 20, interpolation);
+		for(size_t index = 0; index < result.size(); ++index) {
+			REQUIRE(std::abs(result[index] - delayBuffer.getSample(1, index)) <= 1e-3f * delayBuffer.getSample(1, index));
+		}
+	}
+
+	//The delay increase by a sample every sample, so it reads always the same sample
+	delayBuffer.readInterpolated(0, result.data(), result.size(), 20, 36, abl::InterpolationType::Linear);
+	for(size_t index = 0; index < result.size(); ++index) {
+		REQUIRE(result[index] == delayBuffer.getSample(0, 0));
+	}
+}
+
+//The written signal is the time of the samples, so the read samples tell their delay
+TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] Crossfaded delay changes blend the old and the new delay", "[DelayedCircularAudioBuffer]", float, double) {
+	const size_t blockSize = 16;
+	abl::DelayedCircularAudioBuffer<TestType> delayBuffer{200, blockSize, 10, 2, 7};
+	abl::AudioBuffer<TestType> block{blockSize, 2};
+	abl::AudioBuffer<TestType> delayedBlock{blockSize, 2};
+	struct DelayChange { size_t time; size_t delay; size_t crossfadeSamplesCount; };
+	const std::vector<DelayChange> delayChanges{{160, 40, 50}, {320, 5, 32}, {400, 150, 0}, {480, 20, 100}, {528, 60, 24}};
+
+	size_t delay = 10;
+	size_t previousDelay = 10;
+	size_t transitionStart = 0;
+	size_t crossfadeSamplesCount = 0;
+	std::optional<DelayChange> pendingDelayChange;
+	for(size_t blockStart = 0; blockStart < 1000; blockStart += blockSize) {
+		for(const auto& delayChange : delayChanges) {
+			if(delayChange.time == blockStart) {
+				delayBuffer.setDelayInSamples(delayChange.delay, delayChange.crossfadeSamplesCount);
+				//The change at 528 arrives during the transition started at 480, so it waits for its end
+				if(blockStart < transitionStart + crossfadeSamplesCount) {
+					pendingDelayChange = delayChange;
+					REQUIRE(delayBuffer.hasPendingDelayChange());
+				} else {
+					previousDelay = delay;
+					delay = delayChange.delay;
+					transitionStart = blockStart;
+					crossfadeSamplesCount = delayChange.crossfadeSamplesCount;
+					REQUIRE(delayBuffer.isDelayTransitionActive() == (crossfadeSamplesCount > 0));
+				}
+			}
+		}
+		if(pendingDelayChange && blockStart >= transitionStart + crossfadeSamplesCount) {
+			previousDelay = delay;
+			delay = pendingDelayChange->delay;
+			transitionStart = blockStart;
+			crossfadeSamplesCount = pendingDelayChange->crossfadeSamplesCount;
+			pendingDelayChange.reset();
+			REQUIRE_FALSE(delayBuffer.hasPendingDelayChange());
+			REQUIRE(delayBuffer.isDelayTransitionActive());
+		}
+		REQUIRE(delayBuffer.getDelayInSamples() == delay);
+
+		for(size_t index = 0; index < blockSize; ++index) {
+			block.setSample(0, index, TestType(blockStart + index));
+			block.setSample(1, index, -TestType(blockStart + index));
+		}
+		delayBuffer.copyFrom(block);
+		delayBuffer.readCrossfaded(delayedBlock);
+		if(blockStart >= 160) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				auto time = double(blockStart + index);
+				auto expected = time - double(delay);
+				if(blockStart + index < transitionStart + crossfadeSamplesCount) {
+					auto gain = double(blockStart + index - transitionStart) / double(crossfadeSamplesCount);
+					expected = (1 - gain) * (time - double(previousDelay)) + gain * (time - double(delay));
+				}
+				REQUIRE(std::abs(double(delayedBlock.getSample(0, index)) - expected) < 1e-3);
+				REQUIRE(std::abs(double(delayedBlock.getSample(1, index)) + expected) < 1e-3);
+				//The read area has the samples of the new delay, without a gap
+				REQUIRE(delayBuffer.getSample(0, index) == TestType(time - double(delay)));
+			}
+		}
+		delayBuffer.incrementIndex();
+	}
+	REQUIRE_FALSE(delayBuffer.isDelayTransitionActive());
+	REQUIRE(delayBuffer.getIndex() == 1008);
+
+	//The copies continue the transition
+	delayBuffer.setDelayInSamples(30, 40);
+	abl::DelayedCircularAudioBuffer<TestType> copiedBuffer{delayBuffer};
+	copiedBuffer.readCrossfaded(delayedBlock, {2, 4});
+	REQUIRE(copiedBuffer.isDelayTransitionActive());
+	delayBuffer.readCrossfaded(block, {2, 4});
+	for(size_t index = 0; index < 4; ++index) {
+		REQUIRE(delayedBlock.getSample(0, index) == block.getSample(0, index));
+		REQUIRE(copiedBuffer.getSample(0, index) == delayBuffer.getSample(0, index));
+	}
+}
+
+//A ramp written in the buffer is read back as a ramp with slope 1, bent by the crossfades of the delay changes but never broken
+TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] Delay changes during a crossfade don't jump", "[DelayedCircularAudioBuffer]", float, double) {
+	const size_t blockSize = 8;
+	const size_t firstCrossfadeSamplesCount = 96;
+	const size_t secondCrossfadeSamplesCount = 40;
+	abl::DelayedCircularAudioBuffer<TestType> delayBuffer{200, blockSize, 10, 1};
+	abl::AudioBuffer<TestType> block{blockSize, 1};
+	abl::AudioBuffer<TestType> delayedBlock{blockSize, 1};
+
+	//The biggest change of the delay between two samples is the one of the fastest crossfade
+	const double maxDelayStep = std::max(50.0 / firstCrossfadeSamplesCount, 40.0 / secondCrossfadeSamplesCount);
+	std::optional<double> previousSample;
+	for(size_t blockStart = 0; blockStart < 480; blockStart += blockSize) {
+		if(blockStart == 160) {
+			delayBuffer.setDelayInSamples(60, firstCrossfadeSamplesCount);
+		}
+		//Halfway through the first crossfade
+		if(blockStart == 160 + firstCrossfadeSamplesCount / 2) {
+			delayBuffer.setDelayInSamples(20, secondCrossfadeSamplesCount);
+			REQUIRE(delayBuffer.hasPendingDelayChange());
+			REQUIRE(delayBuffer.getDelayInSamples() == 60);
+		}
+
+		for(size_t index = 0; index < blockSize; ++index) {
+			block.setSample(0, index, TestType(blockStart + index));
+		}
+		delayBuffer.copyFrom(block);
+		delayBuffer.readCrossfaded(delayedBlock);
+		if(blockStart >= 16) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				auto sample = double(delayedBlock.getSample(0, index));
+				if(previousSample) {
+					REQUIRE(std::abs(sample - *previousSample - 1) <= maxDelayStep + 1e-3);
+				}
+				previousSample = sample;
+			}
+		}
+		delayBuffer.incrementIndex();
+	}
+	REQUIRE(delayBuffer.getDelayInSamples() == 20);
+	REQUIRE_FALSE(delayBuffer.isDelayTransitionActive());
+	REQUIRE(double(delayedBlock.getSample(0, blockSize - 1)) == 479.0 - 20.0);
+}
+
+TEMPLATE_TEST_CASE("[DelayedCircularAudioBuffer] Multi-tap reads add all the taps", "[DelayedCircularAudioBuffer]", float, double) {
+	const size_t blockSize = 32;
+	abl::DelayedCircularAudioBuffer<TestType> delayBuffer{300, blockSize, 100, 2, 11};
+	abl::AudioBuffer<TestType> block{blockSize, 2};
+	abl::AudioBuffer<TestType> tapsBlock{blockSize, 2};
+	//More taps than the sources of a mix pass, some with ramps
+	std::vector<abl::DelayTap<TestType>> taps;
+	for(size_t tap = 0; tap < 20; ++tap) {
+		if(tap % 3 == 0) {
+			taps.emplace_back(tap * 13, TestType(0.5), TestType(-0.25));
+		} else {
+			taps.emplace_back(tap * 13, TestType(tap) / 10);
+		}
+	}
+
+	for(size_t blockStart = 0; blockStart < 40 * blockSize; blockStart += blockSize) {
+		for(size_t index = 0; index < blockSize; ++index) {
+			block.setSample(0, index, TestType(blockStart + index));
+			block.setSample(1, index, TestType(2 * (blockStart + index)));
+			tapsBlock.setSample(0, index, TestType(1));
+			tapsBlock.setSample(1, index, TestType(1));
+		}
+		delayBuffer.copyFrom(block);
+		delayBuffer.addTapsTo(tapsBlock, taps);
+		if(blockStart >= 300) {
+			for(size_t index = 0; index < blockSize; ++index) {
+				double expected = 1;
+				for(const auto& tap : taps) {
+					auto gain = double(tap.startGain) + (double(tap.endGain) - double(tap.startGain)) * double(index) / double(blockSize);
+					expected += gain * (double(blockStart + index) - double(tap.delayInSamples));
+				}
+				REQUIRE(std::abs(double(tapsBlock.getSample(0, index)) - expected) < 1e-2);
+				REQUIRE(std::abs(double(tapsBlock.getSample(1, index)) - (2 * expected - 1)) < 2e-2);
+			}
+		}
+		delayBuffer.incrementIndex();
+	}
+
+	//A single tap with the delay of the buffer reads the read area
+	std::fill_n(tapsBlock.getChannelRawData(0), blockSize, TestType(0));
+	delayBuffer.addTapsTo(0, tapsBlock.getChannelRawData(0), 16, std::vector<abl::DelayTap<TestType>>{{100}}, 8);
+	for(size_t index = 0; index < 16; ++index) {
+		REQUIRE(tapsBlock.getSample(0, index) == delayBuffer.getSample(0, index + 8));
+	}
+}
+
 //test channel out-of-bound assert?
\ No newline at end of file
@@ -0,0 +1,143 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../streaming/FramingAudioProcessor.h"
+#include "../buffers/AudioBuffer.h"
+#include <cmath>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+//Push random samples in parts of random size, pulling after every push the same samples count, and check the output against the filtered and delayed input
+template<typename T, typename FilterFunction>
+void requireStreamedOutput(abl::FramingAudioProcessor<T>& processor, size_t maxPushSize, double tolerance, FilterFunction&& filter) {
+	std::mt19937 generator{processor.getFrameSize()};
+	std::uniform_int_distribution<int> samplesDistribution{-10000, 10000};
+	std::uniform_int_distribution<size_t> pushSizeDistribution{1, maxPushSize};
+	std::vector<T> inputSamples;
+	abl::AudioBuffer<T> input{maxPushSize, 2};
+	abl::AudioBuffer<T> output{maxPushSize, 2};
+	for(size_t push = 0; push < 60; ++push) {
+		auto pushSize = pushSizeDistribution(generator);
+		auto startTime = inputSamples.size();
+		for(size_t index = 0; index < pushSize; ++index) {
+			inputSamples.push_back(static_cast<T>(samplesDistribution(generator)));
+			input.setSample(0, index, inputSamples.back());
+			input.setSample(1, index, -inputSamples.back());
+		}
+		REQUIRE(processor.push(input, pushSize));
+		REQUIRE(processor.availableToPull() >= pushSize);
+		REQUIRE(processor.pull(output, pushSize));
+		for(size_t index = 0; index < pushSize; ++index) {
+			auto time = startTime + index;
+			auto expected = time < processor.getLatency() ? 0.0 : filter(inputSamples, time - processor.getLatency());
+			REQUIRE(std::abs(double(output.getSample(0, index)) - expected) <= tolerance);
+			REQUIRE(std::abs(double(output.getSample(1, index)) + expected) <= tolerance);
+		}
+	}
+}
+
+template<typename T>
+double identity(const std::vector<T>& samples, size_t time) {
+	return double(samples[time]);
+}
+
+TEMPLATE_TEST_CASE("[FramingAudioProcessor] Overlap-add of frames not modified gives back the input delayed by the latency", "[FramingAudioProcessor]", float, double) {
+	for(size_t hopSize : {16, 32, 48}) {
+		size_t framesCount = 0;
+		abl::FramingAudioProcessor<TestType> processor{2, 64, hopSize, 200, [&](abl::AudioBufferView<TestType>& frame) {
+			REQUIRE(frame.getBufferSize() == 64);
+			++framesCount;
+		}};
+		REQUIRE(processor.getLatency() == 63);
+		REQUIRE(processor.getAnalysisWindow().size() == 64);
+		requireStreamedOutput(processor, 200, 0.05, identity<TestType>);
+		REQUIRE(framesCount > 0);
+	}
+}
+
+TEST_CASE("[FramingAudioProcessor] The frames are windowed, processed and overlap-added", "[FramingAudioProcessor]") {
+	abl::FramingOptions options;
+	options.analysisWindow.assign(8, 1.0);
+	options.analysisWindow[0] = 0.5;
+	options.synthesisWindow.assign(8, 1.0);
+	std::vector<std::vector<float>> frames;
+	abl::FramingAudioProcessor<float> processor{1, 8, 4, 16, [&](abl::AudioBufferView<float>& frame) {
+		frames.emplace_back(frame.getChannelRawData(0), frame.getChannelRawData(0) + 8);
+		frame.applyGain(3.0f);
+	}, options};
+	REQUIRE(processor.getRingSize() == 23);
+
+	//Every position is covered by two frames, and the first position of the hop has half of the analysis gain
+	REQUIRE(processor.getSynthesisWindow()[0] == 1.0f / 1.5f);
+	REQUIRE(processor.getSynthesisWindow()[1] == 0.5f);
+	REQUIRE(processor.getSynthesisWindow()[4] == 1.0f / 1.5f);
+
+	abl::AudioBuffer<float> input{16, 1};
+	for(size_t index = 0; index < 16; ++index) {
+		input.setSample(0, index, float(index + 1));
+	}
+	REQUIRE(processor.push(input));
+	REQUIRE(frames.size() == 4);
+	REQUIRE(frames[0] == std::vector<float>{0, 0, 0, 0, 0, 0, 0, 1});
+	REQUIRE(frames[2] == std::vector<float>{1, 3, 4, 5, 6, 7, 8, 9});
+	REQUIRE(processor.availableToPull() == 16);
+
+	//The ring holds the latency and the samples not pulled yet
+	REQUIRE_FALSE(processor.push(input, 1));
+	abl::AudioBuffer<float> output{20, 1};
+	REQUIRE_FALSE(processor.pull(output, 17));
+	REQUIRE(processor.pull(output, 16));
+	for(size_t index = 7; index < 16; ++index) {
+		REQUIRE(std::abs(output.getSample(0, index) - 3.0f * float(index - 6)) <= 1e-4f);
+	}
+	REQUIRE(processor.push(input, 1));
+	REQUIRE(frames.size() == 5);
+	REQUIRE(processor.availableToPull() == 4);
+
+	processor.reset();
+	REQUIRE(processor.availableToPull() == 0);
+	REQUIRE(processor.push(input));
+	REQUIRE(processor.pull(output, 16));
+	REQUIRE(output.getSample(0, 6) == 0.0f);
+	REQUIRE(std::abs(output.getSample(0, 7) - 3.0f) <= 1e-4f);
+}
+
+TEMPLATE_TEST_CASE("[FramingAudioProcessor] Frames not overlapping are not windowed", "[FramingAudioProcessor]", int16_t, int32_t, float) {
+	abl::FramingAudioProcessor<TestType> processor{2, 32, 32, 100, [](abl::AudioBufferView<TestType>&) {}};
+	REQUIRE(processor.getAnalysisWindow().empty());
+	requireStreamedOutput(processor, 100, 0, identity<TestType>);
+}
+
+TEMPLATE_TEST_CASE("[FramingAudioProcessor] Overlap-save outputs the last hop of the frames", "[FramingAudioProcessor]", int32_t, float, double) {
+	abl::FramingOptions options;
+	options.mode = abl::FramingMode::OverlapSave;
+
+	abl::FramingAudioProcessor<TestType> identityProcessor{2, 64, 16, 150, [](abl::AudioBufferView<TestType>&) {}, options};
+	REQUIRE(identityProcessor.getLatency() == 15);
+	REQUIRE(identityProcessor.getAnalysisWindow().empty());
+	requireStreamedOutput(identityProcessor, 150, 0, identity<TestType>);
+
+	//A FIR filter shorter than the discarded part of the frames, computed from the end of the frame so every sample still read its inputs
+	const std::vector<double> coefficients{0.5, 0.25, -0.125, 2};
+	abl::FramingAudioProcessor<TestType> filterProcessor{2, 32, 20, 150, [&](abl::AudioBufferView<TestType>& frame) {
+		for(size_t channel = 0; channel < frame.getChannelsCount(); ++channel) {
+			auto data = frame.getChannelRawData(channel);
+			for(size_t index = frame.getBufferSize() - 1; index >= coefficients.size() - 1; --index) {
+				double sample = 0;
+				for(size_t tap = 0; tap < coefficients.size(); ++tap) {
+					sample += coefficients[tap] * double(data[index - tap]);
+				}
+				data[index] = static_cast<TestType>(sample);
+			}
+		}
+	}, options};
+	requireStreamedOutput(filterProcessor, 150, std::is_integral_v<TestType> ? 1.0 : 1e-2, [&](const std::vector<TestType>& samples, size_t time) {
+		double sample = 0;
+		for(size_t tap = 0; tap < coefficients.size() && tap <= time; ++tap) {
+			sample += coefficients[tap] * double(samples[time - tap]);
+		}
+		return sample;
+	});
+}
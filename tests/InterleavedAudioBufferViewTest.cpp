@@ -0,0 +1,168 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/InterleavedAudioBufferView.h"
+#include "../buffers/AudioBuffer.h"
+#include "../kernels/InterleaveKernels.h"
+#include <numeric>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static_assert(abl::AudioBufferType<abl::InterleavedAudioBufferView<float>, float>);
+static_assert(abl::InterleavedAudioBufferReadableType<abl::InterleavedAudioBufferView<float>, float>);
+static_assert(!abl::ContiguousAudioBufferReadableType<abl::InterleavedAudioBufferView<float>, float>);
+static_assert(abl::AudioBufferChannelType<abl::StridedAudioBufferChannelView<double>, double>);
+
+//Every frames count up to 35 to cover the shuffle kernels with their scalar tails
+TEMPLATE_TEST_CASE("[InterleaveKernels] All the instruction sets give the same results of the scalar kernels", "[InterleaveKernels]", float, double, int16_t, int32_t) {
+	const std::vector<abl::SimdInstructionSet> instructionSets{abl::SimdInstructionSet::Sse2, abl::SimdInstructionSet::Avx2, abl::SimdInstructionSet::Avx512, abl::SimdInstructionSet::Neon};
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::InterleaveKernels<TestType>::getTableFor(instructionSet);
+		for(size_t channelsCount : {2, 4, 6, 8}) {
+			for(size_t framesCount = 0; framesCount < 36; ++framesCount) {
+				std::vector<TestType> interleaved(channelsCount * framesCount);
+				std::iota(interleaved.begin(), interleaved.end(), TestType(1));
+
+				std::vector<std::vector<TestType>> channels(channelsCount, std::vector<TestType>(framesCount));
+				std::vector<TestType*> channelsPointers;
+				for(auto& channel : channels) {
+					channelsPointers.push_back(channel.data());
+				}
+
+				switch(channelsCount) {
+					case 2: table.deinterleave2(channelsPointers.data(), interleaved.data(), framesCount); break;
+					case 4: table.deinterleave4(channelsPointers.data(), interleaved.data(), framesCount); break;
+					case 6: table.deinterleave6(channelsPointers.data(), interleaved.data(), framesCount); break;
+					case 8: table.deinterleave8(channelsPointers.data(), interleaved.data(), framesCount); break;
+				}
+				for(size_t channel = 0; channel < channelsCount; ++channel) {
+					for(size_t frame = 0; frame < framesCount; ++frame) {
+						REQUIRE(channels[channel][frame] == interleaved[frame * channelsCount + channel]);
+					}
+				}
+
+				std::vector<TestType> result(channelsCount * framesCount, TestType(0));
+				std::vector<const TestType*> sourcesPointers(channelsPointers.begin(), channelsPointers.end());
+				switch(channelsCount) {
+					case 2: table.interleave2(result.data(), sourcesPointers.data(), framesCount); break;
+					case 4: table.interleave4(result.data(), sourcesPointers.data(), framesCount); break;
+					case 6: table.interleave6(result.data(), sourcesPointers.data(), framesCount); break;
+					case 8: table.interleave8(result.data(), sourcesPointers.data(), framesCount); break;
+				}
+				REQUIRE(result == interleaved);
+			}
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[InterleavedAudioBufferView] Samples are read and written inside the frames", "[InterleavedAudioBufferView]", int, double) {
+	std::vector<TestType> data(3 * 8);
+	std::iota(data.begin(), data.end(), TestType(0));
+	abl::InterleavedAudioBufferView<TestType> view{data.data(), 3, 8};
+
+	REQUIRE_FALSE(view.isEmpty());
+	REQUIRE(view.getChannelsCount() == 3);
+	REQUIRE(view.getBufferSize() == 8);
+	REQUIRE(view.getSample(0, 0) == TestType(0));
+	REQUIRE(view.getSample(2, 1) == TestType(5));
+	REQUIRE(view[1][3] == TestType(10));
+	REQUIRE(view.getHigherPeakForChannel(1) == TestType(22));
+
+	view.setSample(1, 2, TestType(100));
+	view.addSample(2, 7, TestType(1));
+	REQUIRE(data[7] == TestType(100));
+	REQUIRE(data[23] == TestType(24));
+
+	std::vector<TestType> channelSamples(view[2].begin(), view[2].end());
+	REQUIRE(channelSamples == std::vector<TestType>{2, 5, 8, 11, 14, 17, 20, 24});
+
+	size_t channelsCount = 0;
+	for(auto&& channelView : view) {
+		REQUIRE(channelView.getBufferSize() == 8);
+		REQUIRE(channelView.getStride() == 3);
+		++channelsCount;
+	}
+	REQUIRE(channelsCount == 3);
+
+	auto rangedView = view.getRangedView(abl::SamplesRange(2, 4));
+	REQUIRE(rangedView.getBufferSize() == 4);
+	REQUIRE(rangedView.getSample(0, 0) == TestType(6));
+
+	view.setChannelsMapping({2, 0});
+	REQUIRE_FALSE(view.hasSequentialChannels());
+	REQUIRE(view.getChannelsCount() == 2);
+	REQUIRE(view.getSample(0, 1) == TestType(5));
+	view.clear();
+	REQUIRE(data[1] == TestType(1));
+	REQUIRE(data[2] == TestType(0));
+	REQUIRE(data[3] == TestType(0));
+}
+
+TEMPLATE_TEST_CASE("[InterleavedAudioBufferView] Copy between interleaved and planar buffers", "[InterleavedAudioBufferView]", float, double, int32_t) {
+	for(size_t channelsCount : {1, 2, 3, 4, 6, 8}) {
+		const size_t framesCount = 37;
+		abl::AudioBuffer<TestType> planarBuffer{framesCount, channelsCount};
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t frame = 0; frame < framesCount; ++frame) {
+				planarBuffer.setSample(channel, frame, TestType(channel * 100 + frame));
+			}
+		}
+
+		std::vector<TestType> data(channelsCount * framesCount, TestType(0));
+		abl::InterleavedAudioBufferView<TestType> view{data.data(), channelsCount, framesCount};
+		view.copyFrom(planarBuffer);
+		for(size_t frame = 0; frame < framesCount; ++frame) {
+			for(size_t channel = 0; channel < channelsCount; ++channel) {
+				REQUIRE(data[frame * channelsCount + channel] == TestType(channel * 100 + frame));
+			}
+		}
+
+		abl::AudioBuffer<TestType> resultBuffer{framesCount, channelsCount};
+		resultBuffer.copyFrom(view, {}, 2);
+		for(size_t channel = 0; channel < channelsCount; ++channel) {
+			for(size_t frame = 0; frame < framesCount; ++frame) {
+				REQUIRE(resultBuffer.getSample(channel, frame) == TestType((channel * 100 + frame) * 2));
+			}
+		}
+
+		view.applyGain(3);
+		REQUIRE(view.getSample(channelsCount - 1, framesCount - 1) == TestType(((channelsCount - 1) * 100 + framesCount - 1) * 3));
+	}
+}
+
+TEMPLATE_TEST_CASE("[InterleavedAudioBufferView] Copy and add with channels mapping and ranges", "[InterleavedAudioBufferView]", int, double) {
+	abl::AudioBuffer<TestType> planarBuffer{8, 2};
+	for(size_t frame = 0; frame < 8; ++frame) {
+		planarBuffer.setSample(0, frame, TestType(frame + 1));
+		planarBuffer.setSample(1, frame, TestType(frame + 11));
+	}
+
+	std::vector<TestType> data(3 * 8, TestType(0));
+	abl::InterleavedAudioBufferView<TestType> view{data.data(), 3, 8, {2, 1}};
+	view.copyFrom(planarBuffer, abl::SamplesRange(4, 4));
+	REQUIRE(data[4 * 3 + 2] == TestType(1));
+	REQUIRE(data[7 * 3 + 1] == TestType(14));
+	REQUIRE(data[3 * 3 + 2] == TestType(0));
+	REQUIRE(std::count(data.begin(), data.end(), TestType(0)) == 16);
+
+	view.addFrom(planarBuffer, abl::SamplesRange(4, 4));
+	REQUIRE(data[4 * 3 + 2] == TestType(2));
+	REQUIRE(data[7 * 3 + 1] == TestType(28));
+
+	view.addIntoChannelFrom(planarBuffer[0], 0, abl::SamplesRange(0, 2), 2);
+	REQUIRE(data[2] == TestType(2));
+	REQUIRE(data[3 + 2] == TestType(4));
+
+	//The planar buffer read only the mapped channels of the interleaved view
+	abl::AudioBuffer<TestType> resultBuffer{8, 2};
+	resultBuffer.copyFrom(view);
+	REQUIRE(resultBuffer.getSample(0, 4) == TestType(2));
+	REQUIRE(resultBuffer.getSample(1, 7) == TestType(28));
+	REQUIRE(resultBuffer.getSample(1, 0) == TestType(0));
+
+	view.copyWithRampFrom(planarBuffer, 0, 1);
+	REQUIRE(data[2] == TestType(0));
+	REQUIRE(data[4 * 3 + 1] == TestType(15 * 0.5));
+}
@@ -0,0 +1,173 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../memory/MonotonicArenaResource.h"
+#include "../memory/LockFreePoolResource.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include "../buffers/DelayedCircularAudioBuffer.h"
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+//Forward the allocations to the default resource, counting them
+class CountingResource : public std::pmr::memory_resource {
+public:
+	size_t allocationsCount = 0;
+	size_t deallocationsCount = 0;
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		++allocationsCount;
+		return std::pmr::get_default_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+		++deallocationsCount;
+		std::pmr::get_default_resource()->deallocate(memory, bytes, alignment);
+	}
+
+	[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& otherResource) const noexcept override {
+		return this == &otherResource;
+	}
+};
+
+TEST_CASE("[MonotonicArenaResource] Arena give out aligned memory until reset", "[MonotonicArenaResource]") {
+	CountingResource countingResource;
+	abl::MonotonicArenaResource arena{1024, &countingResource};
+	REQUIRE(countingResource.allocationsCount == 1);
+	REQUIRE(arena.getCapacity() == 1024);
+	REQUIRE(arena.getUsedBytes() == 0);
+
+	auto first = arena.allocate(10, 1);
+	auto second = arena.allocate(100, 64);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+	REQUIRE(static_cast<std::byte*>(second) >= static_cast<std::byte*>(first) + 10);
+	REQUIRE(arena.getUsedBytes() >= 110);
+
+	arena.deallocate(second, 100, 64);
+	REQUIRE_THROWS_AS(arena.allocate(2000, 8), std::bad_alloc);
+
+	arena.reset();
+	REQUIRE(arena.getUsedBytes() == 0);
+	REQUIRE(arena.allocate(10, 1) == first);
+	REQUIRE(countingResource.allocationsCount == 1);
+
+	//Bigger requests go to the fallback resource
+	abl::MonotonicArenaResource arenaWithFallback{64, &countingResource, &countingResource};
+	auto fallbackMemory = arenaWithFallback.allocate(128, 8);
+	REQUIRE(countingResource.allocationsCount == 3);
+	arenaWithFallback.deallocate(fallbackMemory, 128, 8);
+	REQUIRE(countingResource.deallocationsCount == 1);
+}
+
+TEST_CASE("[LockFreePoolResource] Pool give out and take back fixed size blocks", "[LockFreePoolResource]") {
+	CountingResource countingResource;
+	abl::LockFreePoolResource pool{100, 3, 64, &countingResource};
+	REQUIRE(pool.getBlockSize() == 128);
+	REQUIRE(pool.getBlocksCount() == 3);
+	REQUIRE(countingResource.allocationsCount == 1);
+
+	std::vector<void*> blocks;
+	for(size_t block = 0; block < 3; ++block) {
+		blocks.push_back(pool.allocate(100, 64));
+		REQUIRE(reinterpret_cast<std::uintptr_t>(blocks.back()) % 64 == 0);
+	}
+	REQUIRE(pool.getUsedBlocksCount() == 3);
+	REQUIRE(blocks[0] != blocks[1]);
+	REQUIRE(blocks[1] != blocks[2]);
+	REQUIRE_THROWS_AS(pool.allocate(10, 8), std::bad_alloc);
+	REQUIRE_THROWS_AS(pool.allocate(200, 8), std::bad_alloc);
+
+	pool.deallocate(blocks[1], 100, 64);
+	REQUIRE(pool.getUsedBlocksCount() == 2);
+	REQUIRE(pool.allocate(50, 8) == blocks[1]);
+	REQUIRE(countingResource.allocationsCount == 1);
+}
+
+TEST_CASE("[LockFreePoolResource] Blocks can be allocated and deallocated from more threads", "[LockFreePoolResource]") {
+	const size_t threadsCount = 4;
+	const size_t iterationsCount = 20000;
+	abl::LockFreePoolResource pool{64, 8};
+	std::atomic<size_t> corruptedBlocksCount{0};
+
+	std::vector<std::thread> threads;
+	for(size_t thread = 0; thread < threadsCount; ++thread) {
+		threads.emplace_back([&, thread]() {
+			for(size_t iteration = 0; iteration < iterationsCount; ++iteration) {
+				void* memory = nullptr;
+				while(!memory) {
+					try {
+						memory = pool.allocate(64, 64);
+					} catch(const std::bad_alloc&) {
+						std::this_thread::yield();
+					}
+				}
+
+				//Every thread write his id in the block, if two threads get the same block the value change
+				auto values = static_cast<size_t*>(memory);
+				std::fill_n(values, 8, thread);
+				std::this_thread::yield();
+				if(std::count(values, values + 8, thread) != 8) {
+					++corruptedBlocksCount;
+				}
+				pool.deallocate(memory, 64, 64);
+			}
+		});
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	REQUIRE(corruptedBlocksCount == 0);
+	REQUIRE(pool.getUsedBlocksCount() == 0);
+}
+
+TEMPLATE_TEST_CASE("[MemoryResourceContiguous2DArrayAllocator] Buffers allocated from an arena or a pool don't use the heap", "[MemoryResourceContiguous2DArrayAllocator]", int, double) {
+	using Allocator = abl::MemoryResourceContiguous2DArrayAllocator<>;
+	CountingResource countingResource;
+
+	SECTION("arena") {
+		abl::MonotonicArenaResource arena{64 * 1024, &countingResource};
+		for(size_t callback = 0; callback < 4; ++callback) {
+			{
+				abl::AudioBuffer<TestType, Allocator> scratchBuffer{256, 2, {}, &arena};
+				REQUIRE(scratchBuffer.getAllocator().getMemoryResource() == &arena);
+				REQUIRE(reinterpret_cast<std::uintptr_t>(scratchBuffer.getChannelRawData(1)) % 64 == 0);
+				REQUIRE(scratchBuffer.getSample(1, 255) == TestType(0));
+				scratchBuffer.setSample(1, 255, TestType(4));
+
+				abl::AudioBuffer<TestType, Allocator> copyBuffer{scratchBuffer};
+				REQUIRE(copyBuffer.getSample(1, 255) == TestType(4));
+				copyBuffer.resize(2, 512, true);
+				REQUIRE(copyBuffer.getSample(1, 255) == TestType(4));
+
+				abl::CircularAudioBuffer<TestType, Allocator> circularBuffer{64, 16, 2, 0, {}, 0, 0, &arena};
+				abl::DelayedCircularAudioBuffer<TestType, Allocator> delayedBuffer{64, 16, 16, 2, 0, {}, 0, &arena};
+				REQUIRE(circularBuffer.getSample(0, 0) == TestType(0));
+				REQUIRE(delayedBuffer.getSample(0, 0) == TestType(0));
+			}
+			arena.reset();
+		}
+		REQUIRE(countingResource.allocationsCount == 1);
+	}
+
+	SECTION("pool") {
+		abl::LockFreePoolResource pool{Allocator::getAllocationSize<TestType>(2, 256), 3, 64, &countingResource};
+		abl::AudioBuffer<TestType, Allocator> firstBuffer{256, 2, {}, &pool};
+		abl::AudioBuffer<TestType, Allocator> secondBuffer{128, 2, {}, &pool};
+		REQUIRE(pool.getUsedBlocksCount() == 2);
+
+		firstBuffer.setSample(0, 10, TestType(3));
+		secondBuffer = firstBuffer;
+		REQUIRE(secondBuffer.getSample(0, 10) == TestType(3));
+		REQUIRE(pool.getUsedBlocksCount() == 2);
+
+		abl::AudioBuffer<TestType, Allocator> movedBuffer{std::move(firstBuffer)};
+		REQUIRE(movedBuffer.getSample(0, 10) == TestType(3));
+		REQUIRE(pool.getUsedBlocksCount() == 2);
+		REQUIRE(countingResource.allocationsCount == 1);
+	}
+}
@@ -0,0 +1,171 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/MultiProducerMultiConsumerCircularAudioBuffer.h"
+#include "../buffers/AudioBuffer.h"
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEMPLATE_TEST_CASE("[MultiProducerMultiConsumerCircularAudioBuffer] Blocks are written and read in order without copies", "[MultiProducerMultiConsumerCircularAudioBuffer]", int, double) {
+	abl::MultiProducerMultiConsumerCircularAudioBuffer<TestType> queue{4, 8, 2};
+	REQUIRE(queue.getBlocksCount() == 4);
+	REQUIRE(queue.getSingleBufferSize() == 8);
+	REQUIRE(queue.getChannelsCount() == 2);
+	REQUIRE(queue.getWrittenBlocksCount() == 0);
+	REQUIRE_FALSE(queue.tryAcquireReadBlock().has_value());
+
+	for(size_t block = 0; block < 4; ++block) {
+		auto writeBlock = queue.tryAcquireWriteBlock();
+		REQUIRE(writeBlock.has_value());
+		REQUIRE(writeBlock->getView().getBufferSize() == 8);
+		REQUIRE(writeBlock->getView().getChannelsCount() == 2);
+		for(size_t channel = 0; channel < 2; ++channel) {
+			for(size_t index = 0; index < 8; ++index) {
+				writeBlock->getView().setSample(channel, index, TestType(block * 100 + channel * 10 + index));
+			}
+		}
+	}
+	REQUIRE(queue.getWrittenBlocksCount() == 4);
+	REQUIRE_FALSE(queue.tryAcquireWriteBlock().has_value());
+
+	auto firstReadBlock = queue.tryAcquireReadBlock();
+	auto secondReadBlock = queue.tryAcquireReadBlock();
+	REQUIRE(firstReadBlock.has_value());
+	REQUIRE(secondReadBlock.has_value());
+	REQUIRE(firstReadBlock->getView().getSample(1, 3) == TestType(13));
+	REQUIRE(secondReadBlock->getView().getSample(0, 7) == TestType(107));
+
+	auto firstBlockData = firstReadBlock->getView().getChannelRawData(0);
+
+	//The second block is freed but the writers must wait for the first one
+	secondReadBlock->commit();
+	REQUIRE(secondReadBlock->isCommitted());
+	REQUIRE_FALSE(queue.tryAcquireWriteBlock().has_value());
+	firstReadBlock->commit();
+
+	auto writeBlock = queue.tryAcquireWriteBlock();
+	REQUIRE(writeBlock.has_value());
+	//The new block use the memory of the first read block
+	REQUIRE(writeBlock->getView().getChannelRawData(0) == firstBlockData);
+	writeBlock->getView().clear();
+	writeBlock->commit();
+
+	for(size_t block = 2; block < 4; ++block) {
+		auto readBlock = queue.tryAcquireReadBlock();
+		REQUIRE(readBlock.has_value());
+		REQUIRE(readBlock->getView().getSample(1, 0) == TestType(block * 100 + 10));
+	}
+	auto readBlock = queue.tryAcquireReadBlock();
+	REQUIRE(readBlock.has_value());
+	REQUIRE(readBlock->getView().getSample(0, 0) == TestType(0));
+}
+
+TEMPLATE_TEST_CASE("[MultiProducerMultiConsumerCircularAudioBuffer] Blocks are copied with tryWrite() and tryRead() and the failures are counted", "[MultiProducerMultiConsumerCircularAudioBuffer]", int, double) {
+	abl::MultiProducerMultiConsumerCircularAudioBuffer<TestType> queue{2, 8, 2};
+	abl::AudioBuffer<TestType> sourceBuffer{6, 2};
+	abl::AudioBuffer<TestType> destinationBuffer{8, 2};
+	for(size_t channel = 0; channel < 2; ++channel) {
+		for(size_t index = 0; index < 6; ++index) {
+			sourceBuffer.setSample(channel, index, TestType(channel * 10 + index + 1));
+		}
+	}
+
+	REQUIRE_FALSE(queue.tryRead(destinationBuffer));
+	REQUIRE(queue.tryWrite(sourceBuffer));
+	REQUIRE(queue.tryWrite(sourceBuffer, 2));
+	REQUIRE_FALSE(queue.tryWrite(sourceBuffer));
+
+	auto counters = queue.getContentionCounters();
+	REQUIRE(counters.failedReads == 1);
+	REQUIRE(counters.failedWrites == 1);
+	REQUIRE(counters.writeRetries == 0);
+	REQUIRE(counters.readRetries == 0);
+
+	REQUIRE(queue.tryRead(destinationBuffer));
+	for(size_t channel = 0; channel < 2; ++channel) {
+		for(size_t index = 0; index < 8; ++index) {
+			REQUIRE(destinationBuffer.getSample(channel, index) == (index < 6 ? TestType(channel * 10 + index + 1) : TestType(0)));
+		}
+	}
+
+	REQUIRE(queue.tryRead(destinationBuffer));
+	REQUIRE(destinationBuffer.getSample(1, 5) == TestType(32));
+	REQUIRE_FALSE(queue.tryRead(destinationBuffer));
+
+	queue.resetContentionCounters();
+	REQUIRE(queue.getContentionCounters().failedReads == 0);
+	REQUIRE(queue.getContentionCounters().failedWrites == 0);
+}
+
+TEMPLATE_TEST_CASE("[MultiProducerMultiConsumerCircularAudioBuffer] Multiple producer and consumer threads transfer every block once", "[MultiProducerMultiConsumerCircularAudioBuffer]", int, double) {
+	const size_t producersCount = 4;
+	const size_t consumersCount = 3;
+	const size_t blocksPerProducer = 5000;
+	const size_t blockSize = 16;
+	abl::MultiProducerMultiConsumerCircularAudioBuffer<TestType> queue{8, blockSize, 2};
+
+	std::vector<std::thread> threads;
+	for(size_t producer = 0; producer < producersCount; ++producer) {
+		threads.emplace_back([&queue, producer]() {
+			for(size_t block = 0; block < blocksPerProducer; ++block) {
+				while(true) {
+					auto writeBlock = queue.tryAcquireWriteBlock();
+					if(!writeBlock.has_value()) {
+						std::this_thread::yield();
+						continue;
+					}
+
+					//The block number is written on all the samples, so a torn block can be detected
+					for(size_t channel = 0; channel < 2; ++channel) {
+						for(size_t index = 0; index < blockSize; ++index) {
+							writeBlock->getView().setSample(channel, index, TestType(producer * blocksPerProducer + block));
+						}
+					}
+					break;
+				}
+			}
+		});
+	}
+
+	std::vector<std::vector<size_t>> receivedBlocks(consumersCount);
+	std::atomic<size_t> readBlocksCount{0};
+	std::atomic<size_t> tornBlocksCount{0};
+	for(size_t consumer = 0; consumer < consumersCount; ++consumer) {
+		threads.emplace_back([&, consumer]() {
+			while(readBlocksCount.load() < producersCount * blocksPerProducer) {
+				auto readBlock = queue.tryAcquireReadBlock();
+				if(!readBlock.has_value()) {
+					std::this_thread::yield();
+					continue;
+				}
+
+				auto blockNumber = readBlock->getView().getSample(0, 0);
+				for(size_t channel = 0; channel < 2; ++channel) {
+					for(size_t index = 0; index < blockSize; ++index) {
+						if(readBlock->getView().getSample(channel, index) != blockNumber) {
+							++tornBlocksCount;
+						}
+					}
+				}
+				receivedBlocks[consumer].push_back(static_cast<size_t>(blockNumber));
+				++readBlocksCount;
+			}
+		});
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	REQUIRE(tornBlocksCount == 0);
+	std::vector<size_t> allReceivedBlocks;
+	for(const auto& consumerBlocks : receivedBlocks) {
+		allReceivedBlocks.insert(allReceivedBlocks.end(), consumerBlocks.begin(), consumerBlocks.end());
+	}
+	std::sort(allReceivedBlocks.begin(), allReceivedBlocks.end());
+	REQUIRE(allReceivedBlocks.size() == producersCount * blocksPerProducer);
+	for(size_t block = 0; block < allReceivedBlocks.size(); ++block) {
+		REQUIRE(allReceivedBlocks[block] == block);
+	}
+}
@@ -2,6 +2,7 @@
 // If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "../buffers/OffsettedReadCircularAudioBufferChannelView.h"
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -399,9 +400,9 @@ TEMPLATE_TEST_CASE("[OffsettedReadCircularAudioBufferChannelView] View report co
 	const size_t startOffset = 28;
 	auto wrapper = OffsettedReadCircularAudioBufferChannelViewWrapper<TestType>::createWithIncrementalNumbers(bufferSize, singleBufferSize, startOffset);
 
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(16.5));
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 4)) == TestType(9.5));
-	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(4, 2)) == TestType(1.5));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange::allSamples()) == TestType(std::sqrt(3756.0 / 8)));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(3, 4)) == TestType(std::sqrt(1038.0 / 4)));
+	REQUIRE(wrapper.audioBufferChannelView.getRMSLevel(abl::SamplesRange(4, 2)) == TestType(std::sqrt((1.0 * 1.0 + 2.0 * 2.0) / 2)));
 }
 
 TEMPLATE_TEST_CASE("[OffsettedReadCircularAudioBufferChannelView] View report correct buffer size", "[OffsettedReadCircularAudioBufferChannelView]", int, double) {
@@ -0,0 +1,178 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../parallel/WorkStealingThreadPool.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/CircularAudioBuffer.h"
+#include <atomic>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+//Executor that run the tasks on the calling thread and count the parallelFor calls
+struct CountingTaskExecutor : abl::TaskExecutor {
+	void parallelFor(size_t tasksCount, abl::TaskReference task) noexcept override {
+		++parallelForCalls;
+		for(size_t taskIndex = 0; taskIndex < tasksCount; ++taskIndex) {
+			task(taskIndex);
+		}
+	}
+
+	[[nodiscard]] size_t getConcurrency() const noexcept override { return 4; }
+
+	size_t parallelForCalls = 0;
+};
+
+template<typename T>
+abl::AudioBuffer<T> createBufferWithIncrementalNumbers(size_t bufferSize, size_t channels) {
+	abl::AudioBuffer<T> buffer{bufferSize, channels};
+	for(size_t channel = 0; channel < channels; ++channel) {
+		for(size_t index = 0; index < bufferSize; ++index) {
+			buffer.setSample(channel, index, T((channel * bufferSize + index) % 1000) - T(500));
+		}
+	}
+	return buffer;
+}
+
+template<typename T>
+void requireSameSamples(const abl::AudioBuffer<T>& buffer, const abl::AudioBuffer<T>& expectedBuffer) {
+	for(size_t channel = 0; channel < expectedBuffer.getChannelsCount(); ++channel) {
+		for(size_t index = 0; index < expectedBuffer.getBufferSize(); ++index) {
+			REQUIRE(buffer.getSample(channel, index) == expectedBuffer.getSample(channel, index));
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingThreadPool] Every task is executed once", "[WorkStealingThreadPool]") {
+	abl::WorkStealingThreadPool threadPool{3};
+	REQUIRE(threadPool.getConcurrency() == 4);
+
+	for(size_t tasksCount : {0, 1, 2, 3, 4, 7, 100, 1000}) {
+		for(size_t call = 0; call < 20; ++call) {
+			std::vector<std::atomic<int>> executions(tasksCount);
+			threadPool.parallelFor(tasksCount, [&](size_t taskIndex) {
+				executions[taskIndex].fetch_add(1, std::memory_order_relaxed);
+			});
+			for(auto& execution : executions) {
+				REQUIRE(execution.load() == 1);
+			}
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingThreadPool] Nested and concurrent calls run on the calling thread", "[WorkStealingThreadPool]") {
+	abl::WorkStealingThreadPool threadPool{2};
+	std::atomic<int> executions{0};
+	threadPool.parallelFor(8, [&](size_t) {
+		threadPool.parallelFor(4, [&](size_t) {
+			executions.fetch_add(1, std::memory_order_relaxed);
+		});
+	});
+	REQUIRE(executions.load() == 32);
+
+	executions = 0;
+	std::vector<std::thread> callers;
+	for(size_t caller = 0; caller < 4; ++caller) {
+		callers.emplace_back([&]() {
+			for(size_t call = 0; call < 50; ++call) {
+				threadPool.parallelFor(16, [&](size_t) { executions.fetch_add(1, std::memory_order_relaxed); });
+			}
+		});
+	}
+	for(auto& caller : callers) {
+		caller.join();
+	}
+	REQUIRE(executions.load() == 4 * 50 * 16);
+}
+
+TEST_CASE("[ParallelExecutionPolicy] Small operations run inline", "[ParallelExecutionPolicy]") {
+	CountingTaskExecutor executor;
+	auto buffer = createBufferWithIncrementalNumbers<float>(256, 2);
+	buffer.applyGain(abl::ParallelExecutionPolicy{executor}, 0.5f);
+	buffer.clear(abl::ParallelExecutionPolicy{executor});
+	REQUIRE(executor.parallelForCalls == 0);
+	REQUIRE(buffer.getSample(1, 10) == 0.0f);
+
+	buffer.clear(abl::ParallelExecutionPolicy{executor, 64});
+	REQUIRE(executor.parallelForCalls == 1);
+}
+
+TEST_CASE("[ParallelExecutionPolicy] Partition cover every sample once", "[ParallelExecutionPolicy]") {
+	CountingTaskExecutor executor;
+	for(size_t channelsCount : {1, 2, 3, 16, 64, 300}) {
+		for(size_t samplesCount : {100, 1000, 4097, 100000}) {
+			abl::ParallelExecutionPolicy policy{executor, 1000};
+			abl::parallelism::ChannelsPartition partition{policy, channelsCount, samplesCount, 256};
+			REQUIRE(partition.getTasksCount() <= 256);
+			std::vector<int> coveredSamples(channelsCount * samplesCount, 0);
+			for(size_t taskIndex = 0; taskIndex < partition.getTasksCount(); ++taskIndex) {
+				partition.forEachBlockOfTask(taskIndex, [&](size_t channel, size_t startSample, size_t blockSamplesCount) {
+					for(size_t index = startSample; index < startSample + blockSamplesCount; ++index) {
+						++coveredSamples[channel * samplesCount + index];
+					}
+				});
+			}
+			REQUIRE(std::all_of(coveredSamples.begin(), coveredSamples.end(), [](int covered) { return covered == 1; }));
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[ParallelExecutionPolicy] Parallel operations give the same results of the serial ones", "[ParallelExecutionPolicy]", int, float, double) {
+	abl::WorkStealingThreadPool threadPool{3};
+	abl::ParallelExecutionPolicy policy{threadPool, 256};
+	const abl::SamplesRange samplesRange{7, 4001};
+
+	for(size_t channelsCount : {1, 3, 40}) {
+		const size_t bufferSize = 4100;
+		auto source = createBufferWithIncrementalNumbers<TestType>(bufferSize, channelsCount);
+		auto buffer = createBufferWithIncrementalNumbers<TestType>(bufferSize, channelsCount);
+		auto expectedBuffer = createBufferWithIncrementalNumbers<TestType>(bufferSize, channelsCount);
+		for(size_t index = 0; index < bufferSize; ++index) {
+			source.setSample(0, index, TestType(index % 7));
+		}
+
+		buffer.applyGain(policy, TestType(2), samplesRange);
+		expectedBuffer.applyGain(TestType(2), samplesRange);
+		requireSameSamples(buffer, expectedBuffer);
+
+		buffer.reverse(policy, samplesRange);
+		expectedBuffer.reverse(samplesRange);
+		requireSameSamples(buffer, expectedBuffer);
+
+		buffer.addFrom(policy, source, samplesRange, TestType(3));
+		expectedBuffer.addFrom(source, samplesRange, TestType(3));
+		requireSameSamples(buffer, expectedBuffer);
+
+		buffer.copyFrom(policy, source, samplesRange);
+		expectedBuffer.copyFrom(source, samplesRange);
+		requireSameSamples(buffer, expectedBuffer);
+
+		buffer.setSample(channelsCount - 1, 3000, TestType(-2000));
+		expectedBuffer.setSample(channelsCount - 1, 3000, TestType(-2000));
+		REQUIRE(buffer.getHigherPeak(policy, samplesRange) == expectedBuffer.getHigherPeak(samplesRange));
+		REQUIRE(buffer.getHigherPeak(policy) == expectedBuffer.getHigherPeak());
+
+		buffer.clear(policy, samplesRange);
+		expectedBuffer.clear(samplesRange);
+		requireSameSamples(buffer, expectedBuffer);
+	}
+}
+
+TEMPLATE_TEST_CASE("[ParallelExecutionPolicy] Parallel copy from a circular buffer", "[ParallelExecutionPolicy]", int, double) {
+	abl::WorkStealingThreadPool threadPool{3};
+	abl::ParallelExecutionPolicy policy{threadPool, 64};
+	const size_t channelsCount = 4;
+	const size_t singleBufferSize = 1024;
+	abl::CircularAudioBuffer<TestType> source{4 * singleBufferSize, singleBufferSize, channelsCount, 3 * singleBufferSize + 100};
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		for(size_t index = 0; index < singleBufferSize; ++index) {
+			source.setSample(channel, index, TestType(channel * 10000 + index));
+		}
+	}
+
+	abl::AudioBuffer<TestType> buffer{singleBufferSize, channelsCount};
+	abl::AudioBuffer<TestType> expectedBuffer{singleBufferSize, channelsCount};
+	buffer.copyFrom(policy, source);
+	expectedBuffer.copyFrom(source);
+	requireSameSamples(buffer, expectedBuffer);
+}
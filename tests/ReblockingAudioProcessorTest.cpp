@@ -0,0 +1,92 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../streaming/ReblockingAudioProcessor.h"
+#include "../buffers/AudioBuffer.h"
+#include "../buffers/InterleavedAudioBufferView.h"
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEMPLATE_TEST_CASE("[ReblockingAudioProcessor] Pushes of any size are processed in fixed blocks and pulled after the latency", "[ReblockingAudioProcessor]", int, float) {
+	const size_t blockSize = 64;
+	const std::vector<size_t> pushSizes{37, 480, 1, 1024, 64, 63, 65, 200, 1000, 3};
+	size_t processedBlocksCount = 0;
+	abl::ReblockingAudioProcessor<TestType> processor{2, blockSize, 1024, [&](abl::AudioBufferView<TestType>& block) {
+		REQUIRE(block.getBufferSize() == blockSize);
+		block.applyGain(2);
+		++processedBlocksCount;
+	}};
+	REQUIRE(processor.getLatency() == blockSize - 1);
+	REQUIRE(processor.getRingSize() % blockSize == 0);
+
+	abl::AudioBuffer<TestType> input{1024, 2};
+	abl::AudioBuffer<TestType> output{1024, 2};
+	size_t time = 0;
+	for(size_t round = 0; round < 3; ++round) {
+		for(auto pushSize : pushSizes) {
+			for(size_t index = 0; index < pushSize; ++index) {
+				input.setSample(0, index, TestType(time + index));
+				input.setSample(1, index, -TestType(time + index));
+			}
+			REQUIRE(processor.push(input, pushSize));
+			REQUIRE(processor.availableToPull() >= pushSize);
+			REQUIRE(processor.getPendingSamplesCount() < blockSize);
+			REQUIRE(processor.pull(output, pushSize));
+			for(size_t index = 0; index < pushSize; ++index) {
+				auto delayedTime = time + index;
+				auto expected = delayedTime < processor.getLatency() ? TestType(0) : TestType(2 * (delayedTime - processor.getLatency()));
+				REQUIRE(output.getSample(0, index) == expected);
+				REQUIRE(output.getSample(1, index) == -expected);
+			}
+			time += pushSize;
+		}
+	}
+	REQUIRE(processedBlocksCount == (time + processor.getLatency()) / blockSize);
+}
+
+TEST_CASE("[ReblockingAudioProcessor] Pushes and pulls of different sizes", "[ReblockingAudioProcessor]") {
+	std::vector<const float*> blocksData;
+	abl::ReblockingAudioProcessor<float> processor{1, 16, 40, [&](const abl::AudioBufferView<float>& block) {
+		blocksData.push_back(block.getChannelRawData(0));
+	}};
+	REQUIRE(processor.getRingSize() == 64);
+	REQUIRE(processor.availableToPull() == 0);
+
+	std::vector<float> interleavedSamples(40, 1.0f);
+	abl::InterleavedAudioBufferView<float> interleavedInput{interleavedSamples.data(), 1, 40};
+	REQUIRE(processor.push(interleavedInput, 10));
+	REQUIRE(blocksData.size() == 1);
+	REQUIRE(processor.availableToPull() == 16);
+	REQUIRE(processor.getPendingSamplesCount() == 9);
+
+	//The ring is full until something is pulled
+	REQUIRE(processor.push(interleavedInput, 39));
+	REQUIRE_FALSE(processor.push(interleavedInput, 1));
+	REQUIRE(processor.availableToPull() == 64);
+	REQUIRE(processor.getPendingSamplesCount() == 0);
+
+	abl::AudioBuffer<float> output{80, 1};
+	REQUIRE(processor.pull(output, 20));
+	REQUIRE(output.getSample(0, 14) == 0.0f);
+	REQUIRE(output.getSample(0, 15) == 1.0f);
+	REQUIRE(processor.push(interleavedInput, 20));
+	REQUIRE(processor.getPendingSamplesCount() == 4);
+	REQUIRE_FALSE(processor.pull(output, 65));
+	REQUIRE(processor.pull(output, 60));
+	REQUIRE(processor.availableToPull() == 0);
+
+	//The blocks are views of the ring memory, aligned to the block size
+	REQUIRE(blocksData.size() == 5);
+	for(size_t block = 0; block < blocksData.size(); ++block) {
+		REQUIRE(blocksData[block] == blocksData[0] + (block % 4) * 16);
+	}
+
+	processor.reset();
+	REQUIRE(processor.availableToPull() == 0);
+	REQUIRE(processor.getPendingSamplesCount() == 15);
+	REQUIRE(processor.push(interleavedInput, 1));
+	REQUIRE(processor.pull(output, 16));
+	REQUIRE(output.getSample(0, 14) == 0.0f);
+	REQUIRE(output.getSample(0, 15) == 1.0f);
+}
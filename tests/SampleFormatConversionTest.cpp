@@ -0,0 +1,169 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/SampleFormatConversion.h"
+#include "../buffers/AudioBuffer.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template<typename T>
+std::vector<T> createRandomFloatingSamples(size_t size, unsigned int seed) {
+	std::mt19937 generator{seed};
+	std::uniform_real_distribution<T> distribution{-1.2, 1.2};
+	std::vector<T> samples(size);
+	std::generate(samples.begin(), samples.end(), [&]() { return distribution(generator); });
+	return samples;
+}
+
+//Every size up to 67 to cover all the vector widths with their scalar tails
+TEMPLATE_TEST_CASE("[SampleFormatKernels] All the instruction sets give the same results of the scalar kernels", "[SampleFormatKernels]", int16_t, int32_t) {
+	const std::vector<abl::SimdInstructionSet> instructionSets{abl::SimdInstructionSet::Sse2, abl::SimdInstructionSet::Avx2, abl::SimdInstructionSet::Avx512, abl::SimdInstructionSet::Neon};
+	const std::vector<size_t> significantBitsList = std::is_same_v<TestType, int16_t> ? std::vector<size_t>{16, 12} : std::vector<size_t>{32, 24, 16};
+	const auto scalarTable = abl::SampleFormatKernels<float, TestType>::getTableFor(abl::SimdInstructionSet::Scalar);
+
+	for(auto instructionSet : instructionSets) {
+		const auto table = abl::SampleFormatKernels<float, TestType>::getTableFor(instructionSet);
+		for(auto significantBits : significantBitsList) {
+			float fullScale = std::ldexp(1.0f, int(significantBits) - 1);
+			float maxValue = std::min(float((int64_t(1) << (significantBits - 1)) - 1), 2147483520.0f);
+			for(size_t size = 0; size < 68; ++size) {
+				auto source = createRandomFloatingSamples<float>(size, unsigned(size));
+				std::vector<TestType> expected(size);
+				std::vector<TestType> result(size);
+				abl::TpdfDither expectedDither{unsigned(size)};
+				abl::TpdfDither resultDither{unsigned(size)};
+
+				scalarTable.toIntegral(expected.data(), source.data(), size, fullScale, -fullScale, maxValue, nullptr);
+				table.toIntegral(result.data(), source.data(), size, fullScale, -fullScale, maxValue, nullptr);
+				REQUIRE(result == expected);
+
+				//Two calls, to check that the dither continue in the same way
+				for(size_t call = 0; call < 2; ++call) {
+					scalarTable.toIntegral(expected.data(), source.data(), size, fullScale, -fullScale, maxValue, expectedDither.getStates());
+					table.toIntegral(result.data(), source.data(), size, fullScale, -fullScale, maxValue, resultDither.getStates());
+					REQUIRE(result == expected);
+				}
+
+				std::vector<float> expectedFloating(size);
+				std::vector<float> resultFloating(size);
+				scalarTable.toFloating(expectedFloating.data(), expected.data(), size, 1.0f / fullScale);
+				table.toFloating(resultFloating.data(), expected.data(), size, 1.0f / fullScale);
+				REQUIRE(resultFloating == expectedFloating);
+			}
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("[SampleFormatKernels] Samples are normalized and clipped to the full scale", "[SampleFormatKernels]", float, double) {
+	using Int16Kernels = abl::SampleFormatKernels<TestType, int16_t>;
+	using Int32Kernels = abl::SampleFormatKernels<TestType, int32_t>;
+
+	std::vector<TestType> floatingSamples{-2, -1, -0.5, 0, 0.5, 1, 2, std::numeric_limits<TestType>::quiet_NaN()};
+	std::vector<int16_t> int16Samples(floatingSamples.size());
+	Int16Kernels::toIntegral(int16Samples.data(), floatingSamples.data(), floatingSamples.size());
+	REQUIRE(int16Samples == std::vector<int16_t>{-32768, -32768, -16384, 0, 16384, 32767, 32767, -32768});
+
+	std::vector<int32_t> int32Samples(floatingSamples.size());
+	Int32Kernels::toIntegral(int32Samples.data(), floatingSamples.data(), floatingSamples.size());
+	REQUIRE(int32Samples[1] == std::numeric_limits<int32_t>::min());
+	REQUIRE(int32Samples[5] > 2147483000);
+	REQUIRE(int32Samples[6] > 2147483000);
+
+	Int32Kernels::toIntegral(int32Samples.data(), floatingSamples.data(), floatingSamples.size(), 24);
+	REQUIRE(int32Samples == std::vector<int32_t>{-8388608, -8388608, -4194304, 0, 4194304, 8388607, 8388607, -8388608});
+
+	std::vector<TestType> result(int32Samples.size());
+	Int32Kernels::toFloating(result.data(), int32Samples.data(), int32Samples.size(), 24);
+	REQUIRE(result[0] == TestType(-1));
+	REQUIRE(result[2] == TestType(-0.5));
+	REQUIRE(result[4] == TestType(0.5));
+
+	Int16Kernels::toFloating(result.data(), int16Samples.data(), int16Samples.size());
+	REQUIRE(result[0] == TestType(-1));
+	REQUIRE(result[5] == TestType(32767) / TestType(32768));
+}
+
+TEST_CASE("[SampleFormatKernels] Dither add at most 1 LSB of triangular noise", "[SampleFormatKernels]") {
+	const size_t samplesCount = 4096;
+	std::vector<float> source(samplesCount, 0.25f / 32768.0f);
+	std::vector<int16_t> result(samplesCount);
+	abl::TpdfDither dither;
+	abl::SampleFormatKernels<float, int16_t>::toIntegral(result.data(), source.data(), samplesCount, 16, &dither);
+
+	REQUIRE(*std::min_element(result.begin(), result.end()) >= -1);
+	REQUIRE(*std::max_element(result.begin(), result.end()) <= 1);
+	//Without dither all the samples would be 0, with the dither their mean keep the value under the LSB
+	double mean = std::accumulate(result.begin(), result.end(), 0.0) / samplesCount;
+	REQUIRE(std::count(result.begin(), result.end(), int16_t(0)) < int(samplesCount));
+	REQUIRE(mean > 0.15);
+	REQUIRE(mean < 0.35);
+}
+
+TEMPLATE_TEST_CASE("[SampleFormatKernels] Packed 24 bits samples round trip", "[SampleFormatKernels]", float, double) {
+	//More than a block of the stack conversion
+	const size_t samplesCount = 300;
+	std::vector<TestType> source(samplesCount);
+	for(size_t index = 0; index < samplesCount; ++index) {
+		source[index] = TestType(int(index) - 150) / TestType(256);
+	}
+
+	std::vector<abl::PackedInt24> packedSamples(samplesCount);
+	abl::SampleFormatKernels<TestType, int32_t>::toPackedInt24(packedSamples.data(), source.data(), samplesCount);
+	REQUIRE(packedSamples[150].bytes[0] == 0);
+	REQUIRE(packedSamples[151].bytes[0] == 0);
+	REQUIRE(packedSamples[151].bytes[1] == 0x80);
+	REQUIRE(packedSamples[151].bytes[2] == 0);
+	REQUIRE(packedSamples[149].bytes[2] == 0xFF);
+
+	std::vector<TestType> result(samplesCount);
+	abl::SampleFormatKernels<TestType, int32_t>::fromPackedInt24(result.data(), packedSamples.data(), samplesCount);
+	REQUIRE(result == source);
+}
+
+TEST_CASE("[SampleFormatConversion] Buffers are converted between formats", "[SampleFormatConversion]") {
+	const size_t bufferSize = 37;
+	abl::AudioBuffer<int16_t> int16Buffer{bufferSize, 2};
+	for(size_t index = 0; index < bufferSize; ++index) {
+		int16Buffer.setSample(0, index, int16_t(int(index) * 1000 - 18000));
+		int16Buffer.setSample(1, index, int16_t(-int(index) * 800));
+	}
+
+	abl::AudioBuffer<float> floatBuffer{bufferSize, 2};
+	abl::convertSampleFormat(floatBuffer, int16Buffer);
+	REQUIRE(floatBuffer.getSample(0, 0) == -18000.0f / 32768.0f);
+	REQUIRE(floatBuffer.getSample(1, 10) == -8000.0f / 32768.0f);
+
+	abl::AudioBuffer<double> doubleBuffer{bufferSize, 2};
+	abl::convertSampleFormat(doubleBuffer, floatBuffer);
+	REQUIRE(doubleBuffer.getSample(0, 0) == double(-18000.0f / 32768.0f));
+
+	abl::AudioBuffer<int16_t> resultBuffer{bufferSize, 2};
+	resultBuffer.clear();
+	abl::convertSampleFormat(resultBuffer, doubleBuffer, abl::SamplesRange(2, 35));
+	REQUIRE(resultBuffer.getSample(0, 0) == 0);
+	REQUIRE(resultBuffer.getSample(0, 2) == int16Buffer.getSample(0, 0));
+	REQUIRE(resultBuffer.getSample(1, 36) == int16Buffer.getSample(1, 34));
+
+	//24 bits samples stored in int32
+	abl::AudioBuffer<int32_t> int24Buffer{bufferSize, 2};
+	abl::convertSampleFormat(int24Buffer, int16Buffer, {}, {.destinationSignificantBits = 24});
+	REQUIRE(int24Buffer.getSample(0, 0) == -18000 * 256);
+	REQUIRE(int24Buffer.getSample(1, 36) == -36 * 800 * 256);
+
+	abl::convertSampleFormat(floatBuffer, int24Buffer, {}, {.sourceSignificantBits = 24});
+	REQUIRE(floatBuffer.getSample(0, 0) == -18000.0f / 32768.0f);
+
+	abl::TpdfDither dither;
+	abl::convertSampleFormat(resultBuffer, int24Buffer, {}, {.sourceSignificantBits = 24, .dither = &dither});
+	for(size_t index = 0; index < bufferSize; ++index) {
+		REQUIRE(std::abs(resultBuffer.getSample(0, index) - int16Buffer.getSample(0, index)) <= 1);
+	}
+
+	abl::convertSampleFormat(int16Buffer, floatBuffer, {}, {.dither = &dither});
+	REQUIRE(std::abs(int16Buffer.getSample(0, 0) + 18000) <= 1);
+}
@@ -0,0 +1,77 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../memory/SegmentedIterator.h"
+#include "../buffers/AudioBufferChannelViewWrapper.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static_assert(std::random_access_iterator<abl::SegmentedIterator<float>>);
+static_assert(std::ranges::random_access_range<abl::AudioBufferChannelViewWrapper<float>>);
+static_assert(std::same_as<abl::CircularAudioBufferChannelView<float>::iterator, std::ranges::iterator_t<abl::CircularAudioBufferChannelView<float>>>);
+static_assert(std::same_as<abl::OffsettedReadCircularAudioBufferChannelView<float>::iterator, std::ranges::iterator_t<abl::OffsettedReadCircularAudioBufferChannelView<float>>>);
+
+TEMPLATE_TEST_CASE("[SegmentedIterator] Iterator move across the segments", "[SegmentedIterator]", int, double) {
+	std::vector<TestType> data(16);
+	std::iota(data.begin(), data.end(), 0);
+	abl::CircularSpans<TestType> spans(data.data(), 16, 12, 8);
+
+	abl::SegmentedIterator<TestType> begin(spans, 0);
+	abl::SegmentedIterator<TestType> end(spans, spans.size());
+	REQUIRE(end - begin == 8);
+	REQUIRE(begin.getContiguousSamplesCount() == 4);
+
+	std::vector<TestType> iteratedSamples(begin, end);
+	REQUIRE(iteratedSamples == std::vector<TestType>{12, 13, 14, 15, 0, 1, 2, 3});
+
+	auto iterator = begin + 4;
+	REQUIRE(*iterator == TestType(0));
+	REQUIRE(iterator.getContiguousSamplesCount() == 4);
+	REQUIRE(*--iterator == TestType(15));
+	REQUIRE(*++iterator == TestType(0));
+	REQUIRE(begin[6] == TestType(2));
+	REQUIRE(*(end - 1) == TestType(3));
+	REQUIRE(begin < iterator);
+
+	std::vector<TestType> reversedSamples(std::make_reverse_iterator(end), std::make_reverse_iterator(begin));
+	REQUIRE(reversedSamples == std::vector<TestType>{3, 2, 1, 0, 15, 14, 13, 12});
+}
+
+TEMPLATE_TEST_CASE("[SegmentedIterator] Segmented algorithms give the same results of the standard ones", "[SegmentedIterator]", int, double) {
+	std::vector<TestType> data(16);
+	std::iota(data.begin(), data.end(), 0);
+	std::vector<TestType> destinationData(16, 0);
+
+	abl::AudioBufferChannelViewWrapper<TestType> sourceWrapper{abl::CircularAudioBufferChannelView<TestType>{data.data(), 16, 8, 12}};
+	abl::AudioBufferChannelViewWrapper<TestType> destinationWrapper{abl::CircularAudioBufferChannelView<TestType>{destinationData.data(), 16, 8, 14}};
+
+	TestType sum = 0;
+	abl::ranges::for_each(sourceWrapper, [&sum](TestType sample) { sum += sample; });
+	REQUIRE(sum == TestType(60));
+	REQUIRE(sum == std::accumulate(sourceWrapper.begin(), sourceWrapper.end(), TestType(0)));
+
+	std::vector<TestType> copiedSamples;
+	auto copyResult = abl::ranges::copy(sourceWrapper, std::back_inserter(copiedSamples));
+	REQUIRE(copyResult.in == sourceWrapper.end());
+	REQUIRE(copiedSamples == std::vector<TestType>{12, 13, 14, 15, 0, 1, 2, 3});
+
+	//Source and destination split in different positions
+	abl::ranges::copy(sourceWrapper, destinationWrapper.begin());
+	REQUIRE(std::equal(destinationWrapper.begin(), destinationWrapper.end(), copiedSamples.begin(), copiedSamples.end()));
+	REQUIRE(destinationData[14] == TestType(12));
+	REQUIRE(destinationData[5] == TestType(3));
+	REQUIRE(destinationData[6] == TestType(0));
+
+	abl::ranges::transform(sourceWrapper, destinationWrapper.begin(), [](TestType sample) { return sample * 2; });
+	REQUIRE(destinationData[15] == TestType(26));
+	REQUIRE(destinationData[0] == TestType(28));
+
+	auto fillResult = abl::ranges::fill(destinationWrapper, TestType(7));
+	REQUIRE(fillResult == destinationWrapper.end());
+	REQUIRE(std::count(destinationData.begin(), destinationData.end(), TestType(7)) == 8);
+	REQUIRE(destinationData[6] == TestType(0));
+	REQUIRE(destinationData[13] == TestType(0));
+}
@@ -0,0 +1,161 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../buffers/SmallAudioBuffer.h"
+#include "../buffers/AudioBuffer.h"
+#include <cstdint>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template<typename BufferType, typename T>
+void fillWithIndexes(BufferType& buffer) {
+	for(size_t channel = 0; channel < buffer.getChannelsCount(); ++channel) {
+		for(size_t index = 0; index < buffer.getBufferSize(); ++index) {
+			buffer.setSample(channel, index, T(channel * 1000 + index));
+		}
+	}
+}
+
+template<typename BufferType, typename T>
+bool haveIndexes(const BufferType& buffer, size_t channelsCount, size_t bufferSize) {
+	for(size_t channel = 0; channel < channelsCount; ++channel) {
+		for(size_t index = 0; index < bufferSize; ++index) {
+			if(buffer.getSample(channel, index) != T(channel * 1000 + index)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TEMPLATE_TEST_CASE("[SmallAudioBuffer] Small buffers are stored inside the object", "[SmallAudioBuffer]", int, double) {
+	using SmallBuffer = abl::SmallAudioBuffer<TestType, 2, 64>;
+	static_assert(abl::AudioBufferType<SmallBuffer, TestType>);
+	static_assert(abl::AudioBufferReadableType<SmallBuffer, TestType>);
+
+	SmallBuffer smallBuffer{64, 2};
+	REQUIRE(smallBuffer.isUsingInlineStorage());
+	REQUIRE(smallBuffer.getChannelsCount() == 2);
+	REQUIRE(smallBuffer.getBufferSize() == 64);
+	REQUIRE_FALSE(smallBuffer.isEmpty());
+	REQUIRE(reinterpret_cast<std::uintptr_t>(smallBuffer.getChannelRawData(1)) % 64 == 0);
+	auto bufferStart = reinterpret_cast<const std::byte*>(&smallBuffer);
+	auto channelStart = reinterpret_cast<const std::byte*>(smallBuffer.getChannelRawData(1));
+	REQUIRE(channelStart > bufferStart);
+	REQUIRE(channelStart < bufferStart + sizeof(SmallBuffer));
+	REQUIRE(smallBuffer.getSample(1, 63) == TestType(0));
+
+	fillWithIndexes<SmallBuffer, TestType>(smallBuffer);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(smallBuffer, 2, 64));
+
+	//Works as the other buffers
+	abl::AudioBuffer<TestType> audioBuffer{64, 2};
+	audioBuffer.copyFrom(smallBuffer);
+	REQUIRE(haveIndexes<abl::AudioBuffer<TestType>, TestType>(audioBuffer, 2, 64));
+	smallBuffer.applyGain(2);
+	REQUIRE(smallBuffer.getSample(1, 10) == TestType(2020));
+	smallBuffer.copyFrom(audioBuffer);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(smallBuffer, 2, 64));
+
+	SmallBuffer copiedBuffer{audioBuffer};
+	REQUIRE(copiedBuffer.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(copiedBuffer, 2, 64));
+
+	SmallBuffer monoBuffer{16, 1};
+	REQUIRE(monoBuffer.isUsingInlineStorage());
+	REQUIRE(monoBuffer.getChannelsCount() == 1);
+}
+
+TEMPLATE_TEST_CASE("[SmallAudioBuffer] Bigger buffers are allocated", "[SmallAudioBuffer]", int, double) {
+	using SmallBuffer = abl::SmallAudioBuffer<TestType, 2, 64>;
+
+	SmallBuffer longBuffer{65, 2};
+	REQUIRE_FALSE(longBuffer.isUsingInlineStorage());
+	REQUIRE(longBuffer.getSample(1, 64) == TestType(0));
+
+	SmallBuffer manyChannelsBuffer{16, 3};
+	REQUIRE_FALSE(manyChannelsBuffer.isUsingInlineStorage());
+	fillWithIndexes<SmallBuffer, TestType>(manyChannelsBuffer);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(manyChannelsBuffer, 3, 16));
+
+	//Growing past the inline storage move the content to the allocated space, and shrinking bring it back
+	SmallBuffer buffer{32, 2};
+	fillWithIndexes<SmallBuffer, TestType>(buffer);
+	buffer.resize(2, 128, true);
+	REQUIRE_FALSE(buffer.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(buffer, 2, 32));
+	REQUIRE(buffer.getSample(1, 127) == TestType(0));
+
+	buffer.resize(3, 128, true);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(buffer, 2, 32));
+	REQUIRE(buffer.getSample(2, 0) == TestType(0));
+
+	buffer.resize(1, 48, true);
+	REQUIRE(buffer.isUsingInlineStorage());
+	REQUIRE(buffer.getChannelsCount() == 1);
+	REQUIRE(buffer.getBufferSize() == 48);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(buffer, 1, 32));
+	REQUIRE(buffer.getSample(0, 47) == TestType(0));
+
+	//Inside the inline storage the content stay in place
+	buffer.resize(2, 64, true);
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(buffer, 1, 32));
+	REQUIRE(buffer.getSample(0, 63) == TestType(0));
+	REQUIRE(buffer.getSample(1, 0) == TestType(0));
+	buffer.resize(2, 10);
+	REQUIRE(buffer.getSample(0, 5) == TestType(0));
+
+	buffer.resize(0, 0);
+	REQUIRE(buffer.isEmpty());
+	REQUIRE(buffer.isUsingInlineStorage());
+}
+
+TEMPLATE_TEST_CASE("[SmallAudioBuffer] Copy and move of inline and allocated buffers", "[SmallAudioBuffer]", int, double) {
+	using SmallBuffer = abl::SmallAudioBuffer<TestType, 2, 64>;
+
+	SmallBuffer inlineBuffer{64, 2};
+	fillWithIndexes<SmallBuffer, TestType>(inlineBuffer);
+	SmallBuffer allocatedBuffer{100, 2};
+	fillWithIndexes<SmallBuffer, TestType>(allocatedBuffer);
+
+	SmallBuffer inlineCopy{inlineBuffer};
+	REQUIRE(inlineCopy.isUsingInlineStorage());
+	REQUIRE(inlineCopy.getChannelRawData(0) != inlineBuffer.getChannelRawData(0));
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(inlineCopy, 2, 64));
+
+	SmallBuffer allocatedCopy{allocatedBuffer};
+	REQUIRE_FALSE(allocatedCopy.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(allocatedCopy, 2, 100));
+
+	//The inline samples are copied in the new object, the allocated ones are moved
+	SmallBuffer movedInline{std::move(inlineCopy)};
+	REQUIRE(movedInline.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(movedInline, 2, 64));
+	REQUIRE(inlineCopy.isEmpty());
+
+	auto allocatedData = allocatedCopy.getChannelRawData(1);
+	SmallBuffer movedAllocated{std::move(allocatedCopy)};
+	REQUIRE(movedAllocated.getChannelRawData(1) == allocatedData);
+	REQUIRE(allocatedCopy.isEmpty());
+	REQUIRE(allocatedCopy.isUsingInlineStorage());
+
+	SmallBuffer assignedBuffer{10, 1};
+	assignedBuffer = allocatedBuffer;
+	REQUIRE_FALSE(assignedBuffer.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(assignedBuffer, 2, 100));
+	assignedBuffer = inlineBuffer;
+	REQUIRE(assignedBuffer.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(assignedBuffer, 2, 64));
+
+	assignedBuffer = std::move(movedAllocated);
+	REQUIRE(assignedBuffer.getChannelRawData(1) == allocatedData);
+	assignedBuffer = std::move(movedInline);
+	REQUIRE(assignedBuffer.isUsingInlineStorage());
+	REQUIRE(haveIndexes<SmallBuffer, TestType>(assignedBuffer, 2, 64));
+	REQUIRE(movedInline.isEmpty());
+
+	//The moved from buffers can be used again
+	movedInline.resize(2, 8);
+	movedInline.setSample(1, 7, TestType(3));
+	REQUIRE(movedInline.getSample(1, 7) == TestType(3));
+}
@@ -0,0 +1,97 @@
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+// If a copy of the MPL was not distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "../analysis/WaveformOverview.h"
+#include "../buffers/AudioBuffer.h"
+#include <cmath>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template<typename T>
+void fillRandom(abl::AudioBuffer<T>& buffer, unsigned int seed) {
+	std::mt19937 generator{seed};
+	std::uniform_int_distribution<int> distribution{-10000, 10000};
+	for(size_t channel = 0; channel < buffer.getChannelsCount(); ++channel) {
+		for(size_t index = 0; index < buffer.getBufferSize(); ++index) {
+			buffer.setSample(channel, index, static_cast<T>(distribution(generator)));
+		}
+	}
+}
+
+template<typename T>
+void requireSummaryOfRange(const abl::WaveformOverview<T>& overview, const abl::AudioBuffer<T>& buffer, size_t channel, size_t startSample, size_t samplesCount) {
+	T min = buffer.getSample(channel, startSample);
+	T max = min;
+	double squaresSum = 0;
+	for(size_t index = startSample; index < startSample + samplesCount; ++index) {
+		auto sample = buffer.getSample(channel, index);
+		min = std::min(min, sample);
+		max = std::max(max, sample);
+		squaresSum += double(sample) * double(sample);
+	}
+
+	auto summary = overview.getSummary(channel, abl::SamplesRange(startSample, samplesCount));
+	REQUIRE(summary.min == min);
+	REQUIRE(summary.max == max);
+	REQUIRE(std::abs(double(summary.rms) - std::sqrt(squaresSum / double(samplesCount))) <= 1e-4 * std::sqrt(squaresSum / double(samplesCount)) + 1e-9);
+}
+
+TEMPLATE_TEST_CASE("[WaveformOverview] Summaries of any range equal a scan of the samples", "[WaveformOverview]", int16_t, int, float, double) {
+	abl::AudioBuffer<TestType> buffer{5000, 2};
+	fillRandom(buffer, 1);
+
+	for(size_t blockSize : {1, 16, 64, 300}) {
+		abl::WaveformOverview<TestType> overview{buffer, blockSize};
+		REQUIRE(overview.getBlockSize() == std::bit_ceil(blockSize));
+		REQUIRE(overview.getChannelsCount() == 2);
+
+		std::mt19937 generator{unsigned(blockSize)};
+		for(size_t test = 0; test < 200; ++test) {
+			auto startSample = std::uniform_int_distribution<size_t>{0, 4999}(generator);
+			auto samplesCount = std::uniform_int_distribution<size_t>{1, 5000 - startSample}(generator);
+			requireSummaryOfRange(overview, buffer, test % 2, startSample, samplesCount);
+		}
+		requireSummaryOfRange(overview, buffer, 0, 0, 5000);
+		requireSummaryOfRange(overview, buffer, 1, 4999, 1);
+	}
+}
+
+TEST_CASE("[WaveformOverview] Update recompute only the written ranges", "[WaveformOverview]") {
+	abl::AudioBuffer<float> buffer{10000, 1};
+	fillRandom(buffer, 2);
+	abl::WaveformOverview<float> overview{buffer, 64};
+
+	buffer.setSample(0, 7000, 50000.0f);
+	buffer.setSample(0, 7001, -50000.0f);
+	REQUIRE(overview.getSummary(0).max < 50000.0f);
+	overview.update(abl::SamplesRange(7000, 2));
+	REQUIRE(overview.getSummary(0).max == 50000.0f);
+	REQUIRE(overview.getSummary(0).min == -50000.0f);
+	REQUIRE(overview.getSummary(0, abl::SamplesRange(0, 7000)).max < 50000.0f);
+	requireSummaryOfRange(overview, buffer, 0, 6000, 4000);
+	requireSummaryOfRange(overview, buffer, 0, 0, 10000);
+}
+
+TEST_CASE("[WaveformOverview] Columns of a zoomed range", "[WaveformOverview]") {
+	abl::AudioBuffer<double> buffer{4096, 1};
+	for(size_t index = 0; index < buffer.getBufferSize(); ++index) {
+		buffer.setSample(0, index, double(index));
+	}
+	abl::WaveformOverview<double> overview{buffer, 32};
+	REQUIRE(overview.getLevelsCount() == 8);
+
+	std::vector<abl::WaveformSummary<double>> columns(16);
+	overview.getColumns(0, columns);
+	for(size_t column = 0; column < columns.size(); ++column) {
+		REQUIRE(columns[column].min == double(column * 256));
+		REQUIRE(columns[column].max == double(column * 256 + 255));
+	}
+
+	//More columns than samples
+	overview.getColumns(0, columns, abl::SamplesRange(100, 8));
+	REQUIRE(columns[0].min == 100.0);
+	REQUIRE(columns[0].max == 100.0);
+	REQUIRE(columns[15].min == 107.0);
+}